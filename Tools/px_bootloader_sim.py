@@ -0,0 +1,238 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+
+#
+# Stand-in for the PX4 bootloader, for testing px_uploader.py without hardware
+#
+# Serves the bootloader protocol on a pseudo-terminal and keeps the flash
+# contents in memory. Run it, then point the uploader at the printed port:
+#
+#   Tools/px_bootloader_sim.py --board-id 9 &
+#   Tools/px_uploader.py --port /dev/pts/N Images/px4fmu-v2_default.px4
+#
+# --latency delays the delivery of every reply without stalling the command
+# processing, like the USB/serial round trip does, which makes the effect of
+# the uploader's --window visible on a loopback port.
+#
+
+from __future__ import print_function
+
+import argparse
+import os
+import struct
+import sys
+import threading
+import time
+import tty
+import zlib
+
+try:
+        import queue
+except ImportError:
+        import Queue as queue
+
+INSYNC          = 0x12
+EOC             = 0x20
+
+OK              = 0x10
+FAILED          = 0x11
+INVALID         = 0x13
+
+GET_SYNC        = 0x21
+GET_DEVICE      = 0x22
+CHIP_ERASE      = 0x23
+CHIP_VERIFY     = 0x24
+PROG_MULTI      = 0x27
+READ_MULTI      = 0x28
+GET_CRC         = 0x29
+GET_OTP         = 0x2a
+GET_SN          = 0x2b
+REBOOT          = 0x30
+
+INFO_BL_REV     = 1
+INFO_BOARD_ID   = 2
+INFO_BOARD_REV  = 3
+INFO_FLASH_SIZE = 4
+
+
+class bootloader(object):
+        '''Bootloader protocol state machine on a file descriptor'''
+
+        def __init__(self, fd, args):
+                self.fd = fd
+                self.args = args
+                self.flash = bytearray(b'\xff' * args.flash_size)
+                self.address = 0
+                self.rebooted = False
+                self.replies = queue.Queue()
+                writer = threading.Thread(target=self.__writer)
+                writer.daemon = True
+                writer.start()
+
+        def __writer(self):
+                while True:
+                        due, data = self.replies.get()
+                        delay = due - time.time()
+                        if delay > 0:
+                                time.sleep(delay)
+                        os.write(self.fd, bytes(data))
+                        self.replies.task_done()
+
+        def __recv(self, count=1):
+                data = bytearray()
+                while len(data) < count:
+                        data += bytearray(os.read(self.fd, count - len(data)))
+                return data
+
+        def __reply(self, data=bytearray(), status=OK):
+                due = time.time() + self.args.latency / 1000.0
+                self.replies.put((due, bytearray(data) + bytearray([INSYNC, status])))
+
+        def flush(self):
+                self.replies.join()
+
+        def __eoc(self):
+                return self.__recv()[0] == EOC
+
+        def __crc(self):
+                return (zlib.crc32(bytes(self.flash), 0xffffffff) ^ 0xffffffff) & 0xffffffff
+
+        def command(self):
+                cmd = self.__recv()[0]
+
+                if cmd == GET_SYNC:
+                        if self.__eoc():
+                                self.__reply()
+
+                elif cmd == GET_DEVICE:
+                        param = self.__recv()[0]
+                        info = {
+                                INFO_BL_REV: self.args.bl_rev,
+                                INFO_BOARD_ID: self.args.board_id,
+                                INFO_BOARD_REV: self.args.board_rev,
+                                INFO_FLASH_SIZE: self.args.flash_size,
+                        }
+                        if not self.__eoc() or param not in info:
+                                self.__reply(status=INVALID)
+                        else:
+                                self.__reply(struct.pack("<I", info[param]))
+
+                elif cmd == CHIP_ERASE:
+                        if self.__eoc():
+                                self.flash = bytearray(b'\xff' * self.args.flash_size)
+                                self.address = 0
+                                self.__reply()
+
+                elif cmd == PROG_MULTI:
+                        length = self.__recv()[0]
+                        if length > self.args.prog_multi_max or (length % 4) != 0:
+                                # like the real bootloader the data is not consumed
+                                self.__reply(status=INVALID)
+                                return
+                        data = self.__recv(length)
+                        if not self.__eoc():
+                                self.__reply(status=INVALID)
+                        elif self.address + length > len(self.flash):
+                                self.__reply(status=FAILED)
+                        else:
+                                self.flash[self.address:self.address + length] = data
+                                self.address += length
+                                self.__reply()
+
+                elif cmd == CHIP_VERIFY and self.args.bl_rev == 2:
+                        if self.__eoc():
+                                self.address = 0
+                                self.__reply()
+
+                elif cmd == READ_MULTI and self.args.bl_rev == 2:
+                        length = self.__recv()[0]
+                        if self.__eoc():
+                                self.__reply(self.flash[self.address:self.address + length])
+                                self.address += length
+
+                elif cmd == GET_CRC and self.args.bl_rev >= 3:
+                        if self.__eoc():
+                                self.__reply(struct.pack("<I", self.__crc()))
+
+                elif cmd in (GET_OTP, GET_SN) and self.args.bl_rev >= 4:
+                        self.__recv(4)
+                        if self.__eoc():
+                                self.__reply(bytearray(4))
+
+                elif cmd == REBOOT:
+                        if self.__eoc():
+                                if self.args.bl_rev >= 3:
+                                        self.__reply()
+                                self.rebooted = True
+
+                elif cmd != 0:
+                        # NOP and unknown commands are discarded
+                        self.__reply(status=INVALID)
+
+
+def main():
+        parser = argparse.ArgumentParser(description="PX4 bootloader stand-in on a pseudo-terminal.")
+        parser.add_argument('--bl-rev', type=int, default=4, help="bootloader protocol revision (default 4)")
+        parser.add_argument('--board-id', type=int, default=9, help="board id (default 9, PX4FMUv2)")
+        parser.add_argument('--board-rev', type=int, default=0, help="board revision (default 0)")
+        parser.add_argument('--flash-size', type=int, default=1032192, help="application flash size in bytes")
+        parser.add_argument('--prog-multi-max', type=int, default=64, help="largest accepted PROG_MULTI block (default 64)")
+        parser.add_argument('--latency', type=float, default=0, help="reply turnaround in ms (default 0)")
+        parser.add_argument('--image', help="write the flash contents to this file after the reboot command")
+        args = parser.parse_args()
+
+        master, slave = os.openpty()
+        tty.setraw(slave)
+        print(os.ttyname(slave))
+        sys.stdout.flush()
+
+        bl = bootloader(master, args)
+
+        while not bl.rebooted:
+                bl.command()
+
+        bl.flush()
+
+        if args.image is not None:
+                with open(args.image, "wb") as f:
+                        f.write(bytes(bl.flash))
+
+        # let the uploader read the last reply before the port goes away
+        time.sleep(0.5)
+        return 0
+
+
+if __name__ == "__main__":
+        sys.exit(main())
@@ -0,0 +1,306 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+"""
+px_generate_uorb_topic_fields.py:
+Generate the uORB field layout descriptors (src/modules/uORB/topic_fields.h)
+from the structs in src/modules/uORB/topics/*.h.
+
+Only topics defined with ORB_DEFINE_FIELDS() in objects_common.cpp get a
+descriptor. Offsets and enum sizes are left to the compiler (offsetof /
+sizeof), so the output does not depend on the target ABI.
+
+Re-run this script (or 'make topic_fields') after changing a topic struct.
+"""
+
+from __future__ import print_function
+
+import argparse
+import glob
+import os
+import re
+import sys
+
+PRIMITIVES = {
+    "int8_t": "ORB_FIELD_INT8",
+    "uint8_t": "ORB_FIELD_UINT8",
+    "int16_t": "ORB_FIELD_INT16",
+    "uint16_t": "ORB_FIELD_UINT16",
+    "int32_t": "ORB_FIELD_INT32",
+    "uint32_t": "ORB_FIELD_UINT32",
+    "int64_t": "ORB_FIELD_INT64",
+    "uint64_t": "ORB_FIELD_UINT64",
+    "int": "ORB_FIELD_INT32",
+    "unsigned": "ORB_FIELD_UINT32",
+    "unsigned int": "ORB_FIELD_UINT32",
+    "float": "ORB_FIELD_FLOAT",
+    "double": "ORB_FIELD_DOUBLE",
+    "bool": "ORB_FIELD_BOOL",
+    "char": "ORB_FIELD_CHAR",
+}
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", " ", text, flags=re.S)
+    return re.sub(r"//[^\n]*", " ", text)
+
+
+def match_braces(text, start):
+    """Return the index just past the brace block opening at text[start]."""
+    depth = 0
+    for i in range(start, len(text)):
+        if text[i] == "{":
+            depth += 1
+        elif text[i] == "}":
+            depth -= 1
+            if depth == 0:
+                return i + 1
+    raise ValueError("unbalanced braces")
+
+
+class TopicParser(object):
+    def __init__(self):
+        self.defines = {}
+        self.enums = set()
+        self.structs = {}
+
+    def parse_file(self, fn):
+        with open(fn) as f:
+            text = strip_comments(f.read())
+
+        for m in re.finditer(r"^\s*#define\s+(\w+)\s+(\d+)\s*$", text, re.M):
+            self.defines[m.group(1)] = int(m.group(2))
+
+        for m in re.finditer(r"typedef\s+enum\s*\w*\s*\{[^}]*\}\s*(\w+)\s*;", text):
+            self.enums.add(m.group(1))
+
+        for m in re.finditer(r"enum\s*\w*\s*\{([^}]*)\}", text):
+            value = 0
+            for item in m.group(1).split(","):
+                item = item.strip()
+                if not item:
+                    continue
+                if "=" in item:
+                    name, expr = [x.strip() for x in item.split("=", 1)]
+                    try:
+                        value = int(expr, 0)
+                    except ValueError:
+                        value = self.defines.get(expr, 0)
+                else:
+                    name = item
+                self.defines[name] = value
+                value += 1
+
+        for m in re.finditer(r"^struct\s+(\w+)\s*\{", text, re.M):
+            end = match_braces(text, m.end() - 1)
+            self.structs[m.group(1)] = self.parse_body(text[m.end():end - 1])
+
+    def parse_body(self, body):
+        """Split a struct body into (type, name, dims) tuples; type is a tuple for inline structs."""
+        fields = []
+        pos = 0
+
+        while True:
+            m = re.compile(r"\s*struct\s*\{").match(body, pos)
+
+            if m:
+                end = match_braces(body, m.end() - 1)
+                sub = self.parse_body(body[m.end():end - 1])
+                semi = body.index(";", end)
+                for name, dims in self.declarators(body[end:semi]):
+                    fields.append((tuple(sub), name, dims))
+                pos = semi + 1
+                continue
+
+            semi = body.find(";", pos)
+
+            if semi < 0:
+                break
+
+            decl = body[pos:semi].strip()
+            pos = semi + 1
+
+            if not decl or decl.startswith("#"):
+                continue
+
+            m = re.match(r"((?:(?:struct|enum|unsigned|const)\s+)*\w+)\s+(.*)$", decl, re.S)
+
+            if not m:
+                raise ValueError("cannot parse declaration '%s'" % decl)
+
+            for name, dims in self.declarators(m.group(2)):
+                fields.append((" ".join(m.group(1).split()), name, dims))
+
+        return fields
+
+    def declarators(self, text):
+        result = []
+
+        for d in text.split(","):
+            if re.match(r"\s*\w+\s*:\s*\d+\s*$", d):
+                # bit-fields have no address, they end up as padding in the layout
+                continue
+
+            m = re.match(r"\s*(\w+)\s*((?:\[\s*\w+\s*\]\s*)*)$", d)
+
+            if not m:
+                raise ValueError("cannot parse declarator '%s'" % d)
+
+            result.append((m.group(1), re.findall(r"\[\s*(\w+)\s*\]", m.group(2))))
+
+        return result
+
+    def dim(self, token):
+        if token.isdigit():
+            return int(token)
+
+        if token in self.defines:
+            return self.defines[token]
+
+        raise ValueError("unknown array dimension '%s'" % token)
+
+    def flatten(self, fields, prefix=""):
+        """Yield (member designator, count expression, type) for every leaf field, type None for enums."""
+        for ftype, name, dims in fields:
+            path = prefix + name
+
+            if isinstance(ftype, tuple) or ftype.startswith("struct "):
+                sub = ftype if isinstance(ftype, tuple) else self.structs[ftype.split()[1]]
+
+                if not dims:
+                    for leaf in self.flatten(sub, path + "."):
+                        yield leaf
+
+                else:
+                    count = 1
+                    for d in dims:
+                        count *= self.dim(d)
+                    for i in range(count):
+                        for leaf in self.flatten(sub, "%s[%d]." % (path, i)):
+                            yield leaf
+
+                continue
+
+            # plain arrays keep their dimensions symbolic, the compiler resolves them
+            count = " * ".join(dims) if dims else "1"
+
+            if ftype in PRIMITIVES:
+                yield (path, count, PRIMITIVES[ftype])
+
+            elif ftype.startswith("enum ") or ftype in self.enums or ftype.endswith("_t"):
+                # enums and other integer typedefs, sized by the compiler
+                yield (path, count, None)
+
+            else:
+                raise ValueError("unsupported field type '%s' for '%s'" % (ftype, path))
+
+
+def main():
+    base = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    uorb_dir = os.path.join(base, "src", "modules", "uORB")
+
+    parser = argparse.ArgumentParser(description="Generate uORB topic field descriptors")
+    parser.add_argument("--output", default=os.path.join(uorb_dir, "topic_fields.h"), help="output header")
+    args = parser.parse_args()
+
+    tp = TopicParser()
+    headers = sorted(glob.glob(os.path.join(uorb_dir, "topics", "*.h")))
+
+    for fn in headers:
+        tp.parse_file(fn)
+
+    with open(os.path.join(uorb_dir, "objects_common.cpp")) as f:
+        objects = strip_comments(f.read())
+
+    defined = re.findall(r"ORB_DEFINE_FIELDS\(\s*(\w+)\s*,\s*(\w+)\s*\)", objects)
+    tags = []
+
+    for topic, tag in defined:
+        if tag not in tp.structs:
+            print("error: topic %s uses unknown struct %s" % (topic, tag), file=sys.stderr)
+            return 1
+
+        if tag not in tags:
+            tags.append(tag)
+
+    out = []
+    out.append("/*")
+    out.append(" * Generated by Tools/px_generate_uorb_topic_fields.py from the uORB topic headers.")
+    out.append(" * Do not edit, re-run 'make topic_fields' after changing a topic struct.")
+    out.append(" */")
+    out.append("")
+    out.append("#pragma once")
+    out.append("")
+    out.append("#include <stddef.h>")
+    out.append("")
+
+    for fn in headers:
+        out.append("#include \"topics/%s\"" % os.path.basename(fn))
+
+    out.append("")
+    out.append("#define __ORB_FIELD(_tag, _member, _count, _type) \\")
+    out.append("\t{ #_member, offsetof(struct _tag, _member), _count, _type }")
+    out.append("#define __ORB_FIELD_ENUM(_tag, _member, _count) \\")
+    out.append("\t__ORB_FIELD(_tag, _member, _count, ORB_FIELD_ENUM_TYPE(sizeof(((struct _tag *)0)->_member) / (_count)))")
+
+    for tag in tags:
+        out.append("")
+        out.append("static const struct orb_field __orb_fields_%s[] = {" % tag)
+
+        for path, count, ftype in tp.flatten(tp.structs[tag]):
+            if ftype is None:
+                out.append("\t__ORB_FIELD_ENUM(%s, %s, %s)," % (tag, path, count))
+
+            else:
+                out.append("\t__ORB_FIELD(%s, %s, %s, %s)," % (tag, path, count, ftype))
+
+        out.append("\t{ NULL, 0, 0, 0 }")
+        out.append("};")
+
+    out.append("")
+    out.append("#define ORB_TOPICS_WITH_FIELDS \\")
+
+    for i, (topic, tag) in enumerate(defined):
+        out.append("\tORB_ID(%s),%s" % (topic, " \\" if i < len(defined) - 1 else ""))
+
+    out.append("")
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(out))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,159 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+"""
+px_mixer_compile.py:
+Compile the text mixer definitions in the ROMFS to the binary records
+described in src/drivers/drv_mixer.h, so the mixers are loaded at boot
+without parsing text. The files keep their names.
+"""
+
+from __future__ import print_function
+import argparse
+import os
+import struct
+import sys
+
+# record tags, the text tag with bit 7 set
+MIXER_REC_NULL = 0x80 | ord('Z')
+MIXER_REC_SIMPLE = 0x80 | ord('M')
+MIXER_REC_MULTIROTOR = 0x80 | ord('R')
+
+# index in MultirotorMixer::Geometry
+GEOMETRIES = ["4x", "4+", "4v", "4w", "6x", "6+", "8x", "8+", "8c"]
+
+
+class MixerError(Exception):
+    pass
+
+
+def values(fields, count, line):
+    if len(fields) != count:
+        raise MixerError("expected %d values: %s" % (count, line))
+    try:
+        result = [int(f) for f in fields]
+    except ValueError:
+        raise MixerError("bad value: %s" % line)
+    for v in result:
+        if v < -32768 or v > 32767:
+            raise MixerError("value out of range: %s" % line)
+    return result
+
+
+def record(tag, payload):
+    if len(payload) > 255:
+        raise MixerError("mixer too large")
+    return struct.pack("<BB", tag, len(payload)) + payload
+
+
+def compile_mixer(lines):
+    """Compile the definition lines of one mixer file."""
+    out = b""
+    lines = [l.split() for l in lines if len(l) >= 2 and l[0].isupper() and l[1] == ':']
+    i = 0
+
+    while i < len(lines):
+        tag = lines[i][0]
+        line = " ".join(lines[i])
+        i += 1
+
+        if tag == "Z:":
+            out += record(MIXER_REC_NULL, b"")
+
+        elif tag == "M:":
+            (inputs,) = values(lines[i - 1][1:], 1, line)
+            if inputs < 0 or inputs > 255:
+                raise MixerError("bad control count: %s" % line)
+            if i >= len(lines) or lines[i][0] != "O:":
+                raise MixerError("missing output scaler: %s" % line)
+            payload = struct.pack("<B5h", inputs, *values(lines[i][1:], 5, " ".join(lines[i])))
+            i += 1
+            for n in range(inputs):
+                if i >= len(lines) or lines[i][0] != "S:":
+                    raise MixerError("missing control scaler: %s" % line)
+                s = values(lines[i][1:], 7, " ".join(lines[i]))
+                if not (0 <= s[0] <= 255 and 0 <= s[1] <= 255):
+                    raise MixerError("bad control: %s" % " ".join(lines[i]))
+                payload += struct.pack("<BB5h", *s)
+                i += 1
+            out += record(MIXER_REC_SIMPLE, payload)
+
+        elif tag == "R:":
+            if len(lines[i - 1]) < 2 or lines[i - 1][1] not in GEOMETRIES:
+                raise MixerError("unknown geometry: %s" % line)
+            s = values(lines[i - 1][2:], 4, line)
+            out += record(MIXER_REC_MULTIROTOR, struct.pack("<B4h", GEOMETRIES.index(lines[i - 1][1]), *s))
+
+        else:
+            raise MixerError("unexpected line: %s" % line)
+
+    return out
+
+
+def main():
+
+    # Parse commandline arguments
+    parser = argparse.ArgumentParser(description="Mixer compiler.")
+    parser.add_argument('--folder', action="store", help="ROMFS scratch folder.")
+    args = parser.parse_args()
+
+    print("Compiling mixers.")
+
+    for (root, dirs, files) in os.walk(args.folder):
+        for file in files:
+            if not file.endswith(".mix"):
+                continue
+
+            file_path = os.path.join(root, file)
+
+            with open(file_path, "r") as f:
+                lines = f.readlines()
+
+            # leave what we cannot compile to the text parser, which will
+            # reject it the same way at runtime
+            try:
+                compiled = compile_mixer(lines)
+            except MixerError as e:
+                print("WARNING: %s not compiled: %s" % (file, e), file=sys.stderr)
+                continue
+
+            # an empty mixer stays text, so it is not mistaken for a record
+            if len(compiled) == 0:
+                continue
+
+            with open(file_path, "wb") as f:
+                f.write(compiled)
+
+if __name__ == "__main__":
+    main()
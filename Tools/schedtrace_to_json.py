@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+
+#
+# Scheduler trace converter
+#
+# Converts a trace written by 'schedtrace stop <file>' into the Chrome
+# trace event format, to be viewed as a timeline in chrome://tracing:
+#     python schedtrace_to_json.py schedtrace.csv > schedtrace.json
+#
+
+import sys
+import json
+
+def convert(lines):
+    names = {}
+    switches = []
+    dropped = 0
+    last_time = None
+    wraps = 0
+
+    for line in lines:
+        fields = line.strip().split(',', 2)
+
+        if fields[0] == 'task':
+            names[int(fields[1])] = fields[2]
+
+        elif fields[0] == 'switch':
+            time, pids = int(fields[1]), fields[2].split(',')
+
+            # timestamps are the lower 32 bits of the system time
+            if last_time is not None and time < last_time:
+                wraps += 1
+
+            last_time = time
+            switches.append((time + (wraps << 32), int(pids[0]), int(pids[1])))
+
+        elif fields[0] == 'dropped':
+            dropped = int(fields[1])
+
+    events = []
+
+    for pid, name in names.items():
+        events.append({'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': pid, 'args': {'name': name}})
+
+    # every task runs from the switch to it until the next switch away from it
+    for (start, _, pid), (end, _, _) in zip(switches, switches[1:]):
+        events.append({'name': names.get(pid, 'pid %d' % pid), 'ph': 'X', 'pid': 0, 'tid': pid,
+                       'ts': start, 'dur': end - start})
+
+    if dropped:
+        sys.stderr.write('%d switches before the trace were dropped\n' % dropped)
+
+    return {'traceEvents': events, 'displayTimeUnit': 'ms'}
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        sys.stderr.write('usage: %s <schedtrace.csv>\n' % sys.argv[0])
+        sys.exit(1)
+
+    with open(sys.argv[1]) as f:
+        json.dump(convert(f), sys.stdout)
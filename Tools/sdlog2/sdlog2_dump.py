@@ -40,6 +40,23 @@ class SDLog2Parser:
     MSG_FORMAT_PACKET_LEN = 89
     MSG_FORMAT_STRUCT = "BB4s16s64s"
     MSG_TYPE_FORMAT = 0x80
+    MSG_TYPE_TOPIC_FORMAT = 0x84
+    MSG_TOPIC_FORMAT_HEADER_LEN = 40
+    MSG_TOPIC_FORMAT_STRUCT = "<BHH32s"
+    TOPIC_TYPE_TO_STRUCT = {
+        "int8_t": "b",
+        "uint8_t": "B",
+        "int16_t": "h",
+        "uint16_t": "H",
+        "int32_t": "i",
+        "uint32_t": "I",
+        "int64_t": "q",
+        "uint64_t": "Q",
+        "float": "f",
+        "double": "d",
+        "bool": "?",
+        "char": "c",
+    }
     FORMAT_TO_STRUCT = {
         "b": ("b", None),
         "B": ("B", None),
@@ -139,6 +156,14 @@ class SDLog2Parser:
                     if self.__bytesLeft() < self.MSG_FORMAT_PACKET_LEN:
                         break
                     self.__parseMsgDescr()
+                elif msg_type == self.MSG_TYPE_TOPIC_FORMAT:
+                    # parse TFMT message, variable length
+                    if self.__bytesLeft() < self.MSG_TOPIC_FORMAT_HEADER_LEN:
+                        break
+                    format_len = struct.unpack("<H", bytes(self.__buffer[self.__ptr + 6 : self.__ptr + 8]))[0]
+                    if self.__bytesLeft() < self.MSG_TOPIC_FORMAT_HEADER_LEN + format_len:
+                        break
+                    self.__parseTopicDescr(format_len)
                 else:
                     # parse data message
                     msg_descr = self.__msg_descrs[msg_type]
@@ -229,6 +254,51 @@ class SDLog2Parser:
                                 msg_type, msg_length, msg_name, msg_format, str(msg_labels), msg_struct, msg_mults))
         self.__ptr += self.MSG_FORMAT_PACKET_LEN
     
+    def __parseTopicDescr(self, format_len):
+        hdr_end = self.__ptr + self.MSG_TOPIC_FORMAT_HEADER_LEN
+        data = struct.unpack(self.MSG_TOPIC_FORMAT_STRUCT, bytes(self.__buffer[self.__ptr + 3 : hdr_end]))
+        msg_type = data[0]
+        msg_length = data[1]
+        msg_name = _parseCString(data[3])
+        msg_fields = bytes(self.__buffer[hdr_end : hdr_end + format_len]).decode("ascii")
+        # Convert field layout "type[count] name;" to struct.unpack format string, padding is skipped
+        msg_struct = "<"
+        msg_format = ""
+        msg_labels = []
+        msg_mults = []
+        for field in msg_fields.split(";"):
+            if not field:
+                continue
+            ftype, fname = field.split(" ")
+            count = 1
+            if "[" in ftype:
+                ftype, count = ftype[:-1].split("[")
+                count = int(count)
+            c = self.TOPIC_TYPE_TO_STRUCT.get(ftype)
+            if c == None:
+                raise Exception("Unsupported field type: %s in topic %s (%i)" % (ftype, msg_name, msg_type))
+            if fname.startswith("_padding"):
+                msg_struct += "%ix" % count
+            elif ftype == "char":
+                msg_struct += "%is" % count
+                msg_format += "s"
+                msg_labels.append(fname)
+                msg_mults.append(None)
+            else:
+                msg_struct += c * count
+                msg_format += c * count
+                for i in range(count):
+                    msg_labels.append(fname if count == 1 else "%s[%i]" % (fname, i))
+                    msg_mults.append(None)
+        self.__msg_descrs[msg_type] = (msg_length, msg_name, msg_format, msg_labels, msg_struct, msg_mults)
+        self.__msg_labels[msg_name] = msg_labels
+        self.__msg_names.append(msg_name)
+        if self.__debug_out:
+            if self.__filterMsg(msg_name) != None:
+                print("TOPIC FORMAT: type = %i, length = %i, name = %s, labels = %s, struct = %s" % (
+                            msg_type, msg_length, msg_name, str(msg_labels), msg_struct))
+        self.__ptr += self.MSG_TOPIC_FORMAT_HEADER_LEN + format_len
+
     def __parseMsg(self, msg_descr):
         msg_length, msg_name, msg_format, msg_labels, msg_struct, msg_mults = msg_descr
         if not self.__debug_out and self.__time_msg != None and msg_name == self.__time_msg and self.__csv_updated:
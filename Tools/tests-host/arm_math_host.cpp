@@ -0,0 +1,93 @@
+#include <math.h>
+#include "../../src/lib/mathlib/CMSIS/Include/arm_math.h"
+
+/*
+ * Portable versions of the CMSIS DSP matrix functions mathlib uses, the
+ * prebuilt libraries only exist for Cortex-M. Straightforward loops, so
+ * host numbers for these operations track mathlib overhead, not CMSIS.
+ */
+
+arm_status arm_mat_mult_f32(const arm_matrix_instance_f32 *pSrcA, const arm_matrix_instance_f32 *pSrcB,
+			    arm_matrix_instance_f32 *pDst)
+{
+	for (unsigned i = 0; i < pSrcA->numRows; i++) {
+		for (unsigned j = 0; j < pSrcB->numCols; j++) {
+			float32_t sum = 0.0f;
+
+			for (unsigned k = 0; k < pSrcA->numCols; k++) {
+				sum += pSrcA->pData[i * pSrcA->numCols + k] * pSrcB->pData[k * pSrcB->numCols + j];
+			}
+
+			pDst->pData[i * pDst->numCols + j] = sum;
+		}
+	}
+
+	return ARM_MATH_SUCCESS;
+}
+
+arm_status arm_mat_trans_f32(const arm_matrix_instance_f32 *pSrc, arm_matrix_instance_f32 *pDst)
+{
+	for (unsigned i = 0; i < pSrc->numRows; i++) {
+		for (unsigned j = 0; j < pSrc->numCols; j++) {
+			pDst->pData[j * pDst->numCols + i] = pSrc->pData[i * pSrc->numCols + j];
+		}
+	}
+
+	return ARM_MATH_SUCCESS;
+}
+
+arm_status arm_mat_inverse_f32(const arm_matrix_instance_f32 *pSrc, arm_matrix_instance_f32 *pDst)
+{
+	const unsigned n = pSrc->numRows;
+	float32_t a[n][n];
+
+	/* Gauss-Jordan elimination with partial pivoting */
+	for (unsigned i = 0; i < n; i++) {
+		for (unsigned j = 0; j < n; j++) {
+			a[i][j] = pSrc->pData[i * n + j];
+			pDst->pData[i * n + j] = (i == j) ? 1.0f : 0.0f;
+		}
+	}
+
+	for (unsigned c = 0; c < n; c++) {
+		unsigned pivot = c;
+
+		for (unsigned r = c + 1; r < n; r++) {
+			if (fabsf(a[r][c]) > fabsf(a[pivot][c]))
+				pivot = r;
+		}
+
+		if (a[pivot][c] == 0.0f)
+			return ARM_MATH_SINGULAR;
+
+		for (unsigned j = 0; j < n; j++) {
+			float32_t t = a[c][j];
+			a[c][j] = a[pivot][j];
+			a[pivot][j] = t;
+			t = pDst->pData[c * n + j];
+			pDst->pData[c * n + j] = pDst->pData[pivot * n + j];
+			pDst->pData[pivot * n + j] = t;
+		}
+
+		float32_t scale = 1.0f / a[c][c];
+
+		for (unsigned j = 0; j < n; j++) {
+			a[c][j] *= scale;
+			pDst->pData[c * n + j] *= scale;
+		}
+
+		for (unsigned r = 0; r < n; r++) {
+			if (r == c)
+				continue;
+
+			float32_t f = a[r][c];
+
+			for (unsigned j = 0; j < n; j++) {
+				a[r][j] -= f * a[c][j];
+				pDst->pData[r * n + j] -= f * pDst->pData[c * n + j];
+			}
+		}
+	}
+
+	return ARM_MATH_SUCCESS;
+}
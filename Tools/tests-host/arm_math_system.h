@@ -0,0 +1,7 @@
+/*
+ * arm_math.h is written for the 32 bit Cortex-M and casts pointers to
+ * int32_t. Pulled in first as a system header, so -fpermissive accepts
+ * those casts quietly and the warnings of the host code stay visible.
+ */
+#pragma GCC system_header
+#include "../../src/lib/mathlib/CMSIS/Include/arm_math.h"
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include <conversion/barometric.h>
+
+/*
+ * Accuracy and cost of the single precision barometric altitude against
+ * the double precision pow() formula the MS5611 driver used to evaluate.
+ */
+
+#define SAMPLES		100000
+
+static int fails = 0;
+
+static double now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* the previous driver implementation, pressures in kPa */
+static double altitude_reference(double p, double p1)
+{
+	const double T1 = 15.0 + 273.15;
+	const double a  = -6.5 / 1000;
+	const double g  = 9.80665;
+	const double R  = 287.05;
+
+	return (((pow((p / p1), (-(a * R) / g))) * T1) - T1) / a;
+}
+
+static void check(const char *name, double err, double limit)
+{
+	bool ok = (err <= limit);
+	printf("%-40s %10.6f (limit %g) %s\n", name, err, limit, ok ? "ok" : "FAIL");
+
+	if (!ok)
+		fails++;
+}
+
+int main(int argc, char *argv[])
+{
+	/* MSL references from a deep low to a strong high */
+	const float msl[] = { 95000.0f, 101325.0f, 105000.0f };
+
+	double max_err = 0.0;
+	double max_cal_err = 0.0;
+
+	for (unsigned m = 0; m < sizeof(msl) / sizeof(msl[0]); m++) {
+		/* 30..110 kPa in 1 Pa steps, the integer resolution of the driver */
+		for (int P = 30000; P <= 110000; P++) {
+			double ref = altitude_reference(P / 1000.0, msl[m] / 1000.0);
+			double alt = baro_altitude((float)P, msl[m]);
+
+			if (fabs(alt - ref) > max_err)
+				max_err = fabs(alt - ref);
+		}
+
+		/* calibrating at a known altitude must recover the reference */
+		for (int h = -500; h <= 9000; h += 10) {
+			double p = 0.0;
+
+			/* bisect the reference formula for the pressure at h */
+			double lo = 20.0, hi = 120.0;
+
+			for (unsigned i = 0; i < 60; i++) {
+				p = 0.5 * (lo + hi);
+
+				if (altitude_reference(p, msl[m] / 1000.0) > h)
+					lo = p;
+
+				else
+					hi = p;
+			}
+
+			double cal = baro_msl_pressure((float)p, (float)h);
+
+			if (fabs(cal * 1000.0 - msl[m]) > max_cal_err)
+				max_cal_err = fabs(cal * 1000.0 - msl[m]);
+		}
+	}
+
+	check("max altitude error [m]", max_err, 0.02);
+	check("max MSL calibration error [Pa]", max_cal_err, 0.5);
+
+	/* cost per conversion, the inputs are varied to defeat constant folding */
+	volatile float sink = 0.0f;
+	double t0 = now();
+
+	for (unsigned i = 0; i < SAMPLES; i++) {
+		sink += (float)altitude_reference((30000 + i % 80000) / 1000.0, 101.325);
+	}
+
+	double t_double = (now() - t0) / SAMPLES;
+
+	t0 = now();
+
+	for (unsigned i = 0; i < SAMPLES; i++) {
+		sink += baro_altitude((float)(30000 + i % 80000), 101325.0f);
+	}
+
+	double t_float = (now() - t0) / SAMPLES;
+
+	printf("double pow(): %8.1f ns/conversion\n", t_double * 1e9);
+	printf("float expf/logf: %8.1f ns/conversion\n", t_float * 1e9);
+
+	if (fails) {
+		printf("%d FAILED\n", fails);
+		return 1;
+	}
+
+	printf("PASS\n");
+	return 0;
+}
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <algorithm>
+
+#include "bench.h"
+
+static double now_ns()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double sample_ns(bench_fn fn, unsigned n)
+{
+	double t0 = now_ns();
+	fn(n);
+	return now_ns() - t0;
+}
+
+static double median(double *v, unsigned count)
+{
+	std::sort(v, v + count);
+	return (count % 2) ? v[count / 2] : 0.5 * (v[count / 2 - 1] + v[count / 2]);
+}
+
+int bench_main(const struct bench_s *benches, unsigned count, int argc, char *argv[])
+{
+	bool csv = false;
+	const char *filter = NULL;
+	unsigned samples = BENCH_SAMPLES;
+	int ch;
+
+	while ((ch = getopt(argc, argv, "cf:n:")) != -1) {
+		switch (ch) {
+		case 'c':
+			csv = true;
+			break;
+
+		case 'f':
+			filter = optarg;
+			break;
+
+		case 'n':
+			samples = strtoul(optarg, NULL, 10);
+			break;
+
+		default:
+			fprintf(stderr, "usage: %s [-c] [-f filter] [-n samples]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (samples < 3)
+		samples = 3;
+
+	double *t = new double[samples];
+	double *dev = new double[samples];
+
+	if (csv) {
+		printf("suite,benchmark,median_ns,min_ns,mad_ns,samples,ops_per_sample\n");
+
+	} else {
+		printf("%-12s %-32s %12s %12s %8s\n", "suite", "benchmark", "median ns", "min ns", "mad %");
+	}
+
+	for (unsigned b = 0; b < count; b++) {
+		char full[128];
+		snprintf(full, sizeof(full), "%s/%s", benches[b].suite, benches[b].name);
+
+		if (filter != NULL && strstr(full, filter) == NULL)
+			continue;
+
+		/* warm up caches and grow n until a sample is long enough to time */
+		unsigned n = 1;
+
+		while (sample_ns(benches[b].fn, n) < BENCH_SAMPLE_NS && n < (1u << 30))
+			n *= 2;
+
+		for (unsigned s = 0; s < samples; s++)
+			t[s] = sample_ns(benches[b].fn, n) / n;
+
+		double min = *std::min_element(t, t + samples);
+		double med = median(t, samples);
+
+		for (unsigned s = 0; s < samples; s++)
+			dev[s] = fabs(t[s] - med);
+
+		double mad = median(dev, samples);
+
+		if (csv) {
+			printf("%s,%s,%.3f,%.3f,%.3f,%u,%u\n", benches[b].suite, benches[b].name, med, min, mad, samples, n);
+
+		} else {
+			printf("%-12s %-32s %12.2f %12.2f %8.2f\n", benches[b].suite, benches[b].name, med, min,
+			       (med > 0.0) ? 100.0 * mad / med : 0.0);
+		}
+
+		fflush(stdout);
+	}
+
+	delete[] t;
+	delete[] dev;
+
+	return 0;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+/*
+ * Minimal micro-benchmark harness for the host.
+ *
+ * A benchmark is a function running its operation n times. The harness
+ * calibrates n so that one sample takes at least BENCH_SAMPLE_NS, takes
+ * a number of samples and reports the median, the minimum and the median
+ * absolute deviation of the time per operation.
+ *
+ * Results go to stdout as a table, or with -c as CSV for collecting them
+ * per commit:
+ *
+ *   suite,benchmark,median_ns,min_ns,mad_ns,samples,ops_per_sample
+ */
+
+#define BENCH_SAMPLE_NS		5000000		/**< minimum duration of one sample */
+#define BENCH_SAMPLES		15		/**< default number of samples */
+
+typedef void (*bench_fn)(unsigned n);
+
+struct bench_s {
+	const char	*suite;
+	const char	*name;
+	bench_fn	fn;
+};
+
+/**
+ * Keep the compiler from optimizing a result away.
+ */
+template<typename T>
+static inline void bench_keep(const T &value)
+{
+	__asm__ __volatile__("" : : "g"(&value) : "memory");
+}
+
+/**
+ * Run the benchmarks selected on the command line.
+ *
+ * Options: -c CSV output, -f <substring> only run benchmarks whose
+ * "suite/name" contains the substring, -n <samples> number of samples.
+ *
+ * @return 0, or 1 on invalid arguments
+ */
+int bench_main(const struct bench_s *benches, unsigned count, int argc, char *argv[]);
@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <controllib/blocks.hpp>
+#include <controllib/block/BlockGraph.hpp>
+#include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_status.h>
+#include <uORB/topics/manual_control_setpoint.h>
+#include <uORB/topics/parameter_update.h>
+#include <uORB/topics/actuator_controls.h>
+
+/*
+ * Per-step cost of the block update chain: the recursive list walk of
+ * SuperBlock against the flattened BlockGraph, on a tree shaped like the
+ * fixedwing backside autopilot. uORB and the parameter store are stubbed,
+ * every subscription reports new data on every step.
+ */
+
+ORB_DEFINE(vehicle_attitude, struct vehicle_attitude_s);
+ORB_DEFINE(vehicle_status, struct vehicle_status_s);
+ORB_DEFINE(manual_control_setpoint, struct manual_control_setpoint_s);
+ORB_DEFINE(parameter_update, struct parameter_update_s);
+ORB_DEFINE(actuator_controls_0, struct actuator_controls_s);
+
+static uint8_t orb_data[512];
+static int next_handle = 1;
+static unsigned copies = 0;
+static unsigned publishes = 0;
+
+int orb_subscribe(const struct orb_metadata *meta) { return next_handle++; }
+int orb_unsubscribe(int handle) { return 0; }
+int orb_set_interval(int handle, unsigned interval) { return 0; }
+int orb_check(int handle, bool *updated) { *updated = true; return 0; }
+int orb_copy(const struct orb_metadata *meta, int handle, void *buffer)
+{
+	memcpy(buffer, orb_data, meta->o_size);
+	copies++;
+	return 0;
+}
+orb_advert_t orb_advertise(const struct orb_metadata *meta, const void *data) { return next_handle++; }
+int orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void *data)
+{
+	publishes++;
+	return 0;
+}
+
+param_t param_find(const char *name) { return 0; }
+const char *param_name(param_t param) { return "BENCH"; }
+int param_get(param_t param, void *val) { *(float *)val = 0.1f; return 0; }
+
+using namespace control;
+
+class BenchAutopilot : public SuperBlock
+{
+public:
+	BenchAutopilot() :
+		SuperBlock(NULL, "FWB"),
+		_att(&getSubscriptions(), ORB_ID(vehicle_attitude), 20),
+		_status(&getSubscriptions(), ORB_ID(vehicle_status), 20),
+		_manual(&getSubscriptions(), ORB_ID(manual_control_setpoint), 20),
+		_param_update(&getSubscriptions(), ORB_ID(parameter_update), 1000),
+		_actuators(&getPublications(), ORB_ID(actuator_controls_0)),
+		_pLowPass(this, "P_LP"),
+		_qLowPass(this, "Q_LP"),
+		_rLowPass(this, "R_LP"),
+		_rWashout(this, "R_HP"),
+		_p2Ail(this, "P2AIL"),
+		_q2Elv(this, "Q2ELV"),
+		_r2Rdr(this, "R2RDR"),
+		_psi2Phi(this, "PSI2PHI"),
+		_phiLimit(this, "PHI_LIM"),
+		_v2Theta(this, "V2THE"),
+		_theta2Q(this, "THE2Q"),
+		_h2Thr(this, "H2THR"),
+		_cr2Thr(this, "CR2THR"),
+		_theLimit(this, "THE"),
+		_vLimit(this, "V"),
+		_graph(this) {
+	}
+	uORB::Subscription<vehicle_attitude_s> _att;
+	uORB::Subscription<vehicle_status_s> _status;
+	uORB::Subscription<manual_control_setpoint_s> _manual;
+	uORB::Subscription<parameter_update_s> _param_update;
+	uORB::Publication<actuator_controls_s> _actuators;
+	BlockLowPass _pLowPass;
+	BlockLowPass _qLowPass;
+	BlockLowPass _rLowPass;
+	BlockHighPass _rWashout;
+	BlockP _p2Ail;
+	BlockP _q2Elv;
+	BlockP _r2Rdr;
+	BlockP _psi2Phi;
+	BlockLimitSym _phiLimit;
+	BlockPID _v2Theta;
+	BlockPID _theta2Q;
+	BlockPID _h2Thr;
+	BlockPID _cr2Thr;
+	BlockLimit _theLimit;
+	BlockLimit _vLimit;
+	BlockGraph<48, 48, 8, 1> _graph;
+};
+
+static double now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+	const unsigned steps = 200000;
+	BenchAutopilot ap;
+	int fails = 0;
+
+	printf("graph: %u blocks, %u params, %u subscriptions, %u publications\n",
+	       ap._graph.getNumBlocks(), ap._graph.getNumParams(),
+	       ap._graph.getNumSubscriptions(), ap._graph.getNumPublications());
+
+	if (ap._graph.overflow() || ap._graph.getNumSubscriptions() != 4 ||
+	    ap._graph.getNumPublications() != 1) {
+		printf("FAIL: graph does not match the block tree\n");
+		fails++;
+	}
+
+	/* both chains must reach the same blocks */
+	ap.setDt(0.5f);
+	ap._graph.setDt(0.01f);
+
+	if (ap._v2Theta.getDt() != 0.01f || ap._phiLimit.getDt() != 0.01f) {
+		printf("FAIL: graph setDt missed a block\n");
+		fails++;
+	}
+
+	/* the first publication advertises the topic */
+	ap.updatePublications();
+
+	copies = 0;
+	publishes = 0;
+	ap.updateSubscriptions();
+	ap.updatePublications();
+	unsigned list_copies = copies, list_publishes = publishes;
+	copies = 0;
+	publishes = 0;
+	ap._graph.updateSubscriptions();
+	ap._graph.updatePublications();
+
+	if (copies != list_copies || publishes != list_publishes) {
+		printf("FAIL: graph updates %u/%u topics, list %u/%u\n",
+		       copies, publishes, list_copies, list_publishes);
+		fails++;
+	}
+
+	/* a graph too small for the tree falls back to the recursive updates */
+	BlockGraph<4, 4, 2, 1> small(&ap);
+	small.setDt(0.02f);
+	copies = 0;
+	publishes = 0;
+	small.updateSubscriptions();
+	small.updatePublications();
+
+	if (!small.overflow() || ap._cr2Thr.getDt() != 0.02f ||
+	    copies != list_copies || publishes != list_publishes) {
+		printf("FAIL: overflowing graph missed blocks or topics\n");
+		fails++;
+	}
+
+	double start = now();
+
+	for (unsigned i = 0; i < steps; i++) {
+		ap.setDt(0.01f);
+		ap.updateSubscriptions();
+		ap.updatePublications();
+	}
+
+	double list_ns = (now() - start) / steps * 1e9;
+
+	start = now();
+
+	for (unsigned i = 0; i < steps; i++) {
+		ap._graph.setDt(0.01f);
+		ap._graph.updateSubscriptions();
+		ap._graph.updatePublications();
+	}
+
+	double graph_ns = (now() - start) / steps * 1e9;
+
+	start = now();
+
+	for (unsigned i = 0; i < steps / 10; i++) {
+		ap.updateParams();
+	}
+
+	double list_param_ns = (now() - start) / (steps / 10) * 1e9;
+
+	start = now();
+
+	for (unsigned i = 0; i < steps / 10; i++) {
+		ap._graph.updateParams();
+	}
+
+	double graph_param_ns = (now() - start) / (steps / 10) * 1e9;
+
+	printf("per step   list: %7.1f ns  graph: %7.1f ns\n", list_ns, graph_ns);
+	printf("params     list: %7.1f ns  graph: %7.1f ns\n", list_param_ns, graph_param_ns);
+
+	printf("controllib bench %s\n", fails ? "FAILED" : "PASSED");
+	return fails ? 1 : 0;
+}
@@ -0,0 +1,236 @@
+#include <stdint.h>
+#include <string.h>
+#include <mathlib/mathlib.h>
+#include <mathlib/math/filter/LowPassFilter2p.hpp>
+#include <systemlib/mixer/mixer.h>
+
+#include "bench.h"
+
+/*
+ * Host micro-benchmarks of the core libraries, ns per operation.
+ *
+ *   make core_bench && ./core_bench -c > bench-$(git rev-parse --short HEAD).csv
+ */
+
+extern "C" {
+	void bench_geo_project(unsigned n);
+	void bench_geo_ref_project(unsigned n);
+	void bench_geo_distance(unsigned n);
+	void bench_geo_bearing(unsigned n);
+	void bench_inertial_filter(unsigned n);
+	void bench_logbuffer(unsigned n);
+	void bench_bson_encode(unsigned n);
+	void bench_bson_decode(unsigned n);
+	void bench_param_find(unsigned n);
+	void bench_param_find_miss(unsigned n);
+	void bench_param_get(unsigned n);
+	void bench_dataman_pack(unsigned n);
+	void bench_dataman_unpack(unsigned n);
+	void bench_dataman_mission(unsigned n);
+}
+
+static void bench_vector3_cross(unsigned n)
+{
+	math::Vector<3> a(0.1f, 0.2f, 0.3f);
+	math::Vector<3> b(-0.3f, 0.5f, 0.7f);
+
+	for (unsigned i = 0; i < n; i++) {
+		a = (a % b) * 0.5f + b;
+		bench_keep(a);
+	}
+}
+
+static void bench_vector3_normalize(unsigned n)
+{
+	math::Vector<3> a(0.1f, 0.2f, 0.3f);
+
+	for (unsigned i = 0; i < n; i++) {
+		a(0) += 0.001f;
+		a.normalize();
+		bench_keep(a);
+	}
+}
+
+static void bench_matrix3_vector(unsigned n)
+{
+	math::Matrix<3, 3> R;
+	math::Vector<3> v(1.0f, 2.0f, 3.0f);
+
+	R.from_euler(0.1f, 0.2f, 0.3f);
+
+	for (unsigned i = 0; i < n; i++) {
+		v = R * v;
+		bench_keep(v);
+	}
+}
+
+static void bench_matrix3_multiply(unsigned n)
+{
+	math::Matrix<3, 3> R, S;
+
+	R.from_euler(0.1f, 0.2f, 0.3f);
+	S.from_euler(0.01f, -0.02f, 0.03f);
+
+	for (unsigned i = 0; i < n; i++) {
+		R = R * S;
+		bench_keep(R);
+	}
+}
+
+static void bench_matrix3_euler(unsigned n)
+{
+	math::Matrix<3, 3> R;
+	math::Vector<3> euler;
+
+	for (unsigned i = 0; i < n; i++) {
+		R.from_euler(0.1f, 0.2f, 0.001f * (i & 255));
+		euler = R.to_euler();
+		bench_keep(euler);
+	}
+}
+
+static void bench_matrix3_inverse(unsigned n)
+{
+	math::Matrix<3, 3> R, I;
+
+	R.from_euler(0.1f, 0.2f, 0.3f);
+
+	for (unsigned i = 0; i < n; i++) {
+		I = R.inversed();
+		bench_keep(I);
+	}
+}
+
+static void bench_quaternion_multiply(unsigned n)
+{
+	math::Quaternion q, r;
+
+	q.from_euler(0.1f, 0.2f, 0.3f);
+	r.from_euler(0.01f, -0.02f, 0.03f);
+
+	for (unsigned i = 0; i < n; i++) {
+		q = q * r;
+		bench_keep(q);
+	}
+}
+
+static void bench_quaternion_dcm(unsigned n)
+{
+	math::Quaternion q;
+	math::Matrix<3, 3> R;
+
+	for (unsigned i = 0; i < n; i++) {
+		q.from_euler(0.1f, 0.2f, 0.001f * (i & 255));
+		R = q.to_dcm();
+		q.from_dcm(R);
+		bench_keep(q);
+	}
+}
+
+static void bench_lowpass_2p(unsigned n)
+{
+	math::LowPassFilter2p filter(1000.0f, 30.0f);
+	float out = 0.0f;
+
+	for (unsigned i = 0; i < n; i++) {
+		out += filter.apply((i & 1) ? 1.0f : -1.0f);
+	}
+
+	bench_keep(out);
+}
+
+static int mixer_control(uintptr_t handle, uint8_t control_group, uint8_t control_index, float &control)
+{
+	static const float controls[8] = { 0.1f, -0.2f, 0.05f, 0.6f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+	if (control_group != 0)
+		return -1;
+
+	control = controls[control_index & 7];
+	return 0;
+}
+
+/* FMU_quad_x.mix and FMU_AERT.mix without the comments */
+static const char mixer_quad_x[] = "R: 4x 10000 10000 10000 0\n";
+
+static const char mixer_simple[] =
+	"M: 1\n"
+	"O: 10000 10000 0 -10000 10000\n"
+	"S: 0 0 10000 10000 0 -10000 10000\n"
+	"M: 1\n"
+	"O: 10000 10000 0 -10000 10000\n"
+	"S: 0 1 -10000 -10000 0 -10000 10000\n"
+	"M: 1\n"
+	"O: 10000 10000 0 -10000 10000\n"
+	"S: 0 2 10000 10000 0 -10000 10000\n"
+	"M: 1\n"
+	"O: 10000 10000 0 -10000 10000\n"
+	"S: 0 3 0 20000 -10000 -10000 10000\n";
+
+static void bench_mix(const char *text, unsigned n)
+{
+	MixerGroup group(mixer_control, 0);
+	unsigned len = strlen(text);
+	float outputs[8];
+
+	group.load_from_buf(text, len);
+
+	for (unsigned i = 0; i < n; i++) {
+		group.mix(outputs, 8);
+		bench_keep(outputs);
+	}
+}
+
+static void bench_mixer_quad_x(unsigned n)
+{
+	bench_mix(mixer_quad_x, n);
+}
+
+static void bench_mixer_simple(unsigned n)
+{
+	bench_mix(mixer_simple, n);
+}
+
+static void bench_mixer_load(unsigned n)
+{
+	for (unsigned i = 0; i < n; i++) {
+		MixerGroup group(mixer_control, 0);
+		unsigned len = sizeof(mixer_simple) - 1;
+		group.load_from_buf(mixer_simple, len);
+		bench_keep(group);
+	}
+}
+
+static const struct bench_s benches[] = {
+	{ "mathlib",	"vector3_cross",	bench_vector3_cross },
+	{ "mathlib",	"vector3_normalize",	bench_vector3_normalize },
+	{ "mathlib",	"matrix3_vector",	bench_matrix3_vector },
+	{ "mathlib",	"matrix3_multiply",	bench_matrix3_multiply },
+	{ "mathlib",	"matrix3_euler",	bench_matrix3_euler },
+	{ "mathlib",	"matrix3_inverse",	bench_matrix3_inverse },
+	{ "mathlib",	"quaternion_multiply",	bench_quaternion_multiply },
+	{ "mathlib",	"quaternion_dcm",	bench_quaternion_dcm },
+	{ "filter",	"lowpass_2p",		bench_lowpass_2p },
+	{ "mixer",	"quad_x",		bench_mixer_quad_x },
+	{ "mixer",	"simple_4ch",		bench_mixer_simple },
+	{ "mixer",	"load_simple_4ch",	bench_mixer_load },
+	{ "geo",	"project",		bench_geo_project },
+	{ "geo",	"ref_project",		bench_geo_ref_project },
+	{ "geo",	"distance",		bench_geo_distance },
+	{ "geo",	"bearing",		bench_geo_bearing },
+	{ "inav",	"inertial_filter",	bench_inertial_filter },
+	{ "sdlog2",	"logbuffer_64b",	bench_logbuffer },
+	{ "bson",	"encode_8",		bench_bson_encode },
+	{ "bson",	"decode_8",		bench_bson_decode },
+	{ "param",	"find",			bench_param_find },
+	{ "param",	"find_miss",		bench_param_find_miss },
+	{ "param",	"get",			bench_param_get },
+	{ "dataman",	"pack_mission_item",	bench_dataman_pack },
+	{ "dataman",	"unpack_mission_item",	bench_dataman_unpack },
+	{ "dataman",	"mission_2000",		bench_dataman_mission },
+};
+
+int main(int argc, char *argv[])
+{
+	return bench_main(benches, sizeof(benches) / sizeof(benches[0]), argc, argv);
+}
@@ -0,0 +1,296 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <geo/geo.h>
+#include <position_estimator_inav/inertial_filter.h>
+#include <sdlog2/logbuffer.h>
+#include <systemlib/bson/tinybson.h>
+#include <systemlib/param/param.h>
+#include <uORB/uORB.h>
+#include <dataman/dataman.h>
+
+/*
+ * Benchmarks for the C libraries, called from core_bench.cpp. Each runs its
+ * operation n times, results are accumulated into a volatile sink so the
+ * work cannot be optimized away.
+ */
+
+volatile float bench_c_sink;
+
+/* param.c publishes parameter_update, nothing listens on the host */
+orb_advert_t orb_advertise(const struct orb_metadata *meta, const void *data) { return 1; }
+int orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void *data) { return 0; }
+
+/* a mission leg around Zurich, 20 m steps along it */
+#define GEO_LAT		47.397742
+#define GEO_LON		8.545594
+#define GEO_STEP	1.8e-4
+
+void bench_geo_project(unsigned n)
+{
+	float x, y, sum = 0.0f;
+
+	map_projection_init(GEO_LAT, GEO_LON);
+
+	for (unsigned i = 0; i < n; i++) {
+		map_projection_project(GEO_LAT + (i & 63) * GEO_STEP, GEO_LON + (i & 31) * GEO_STEP, &x, &y);
+		sum += x + y;
+	}
+
+	bench_c_sink = sum;
+}
+
+void bench_geo_ref_project(unsigned n)
+{
+	struct map_projection_reference_s ref;
+	float x, y, sum = 0.0f;
+
+	map_projection_ref_init(&ref, GEO_LAT, GEO_LON);
+
+	for (unsigned i = 0; i < n; i++) {
+		map_projection_ref_project(&ref, GEO_LAT + (i & 63) * GEO_STEP, GEO_LON + (i & 31) * GEO_STEP, &x, &y);
+		sum += x + y;
+	}
+
+	bench_c_sink = sum;
+}
+
+void bench_geo_distance(unsigned n)
+{
+	float sum = 0.0f;
+
+	for (unsigned i = 0; i < n; i++) {
+		sum += get_distance_to_next_waypoint(GEO_LAT, GEO_LON, GEO_LAT + (i & 63) * GEO_STEP, GEO_LON + (i & 31) * GEO_STEP);
+	}
+
+	bench_c_sink = sum;
+}
+
+void bench_geo_bearing(unsigned n)
+{
+	float sum = 0.0f;
+
+	for (unsigned i = 0; i < n; i++) {
+		sum += get_bearing_to_next_waypoint(GEO_LAT, GEO_LON, GEO_LAT + (i & 63) * GEO_STEP, GEO_LON + (i & 31) * GEO_STEP);
+	}
+
+	bench_c_sink = sum;
+}
+
+void bench_inertial_filter(unsigned n)
+{
+	float x[3] = { 0.0f, 0.0f, 0.0f };
+
+	/* one predict and one correction, as position_estimator_inav runs per axis */
+	for (unsigned i = 0; i < n; i++) {
+		inertial_filter_predict(0.004f, x);
+		inertial_filter_correct(0.01f * (i & 15), 0.004f, x, 0, 0.5f);
+	}
+
+	bench_c_sink = x[0] + x[1] + x[2];
+}
+
+void bench_logbuffer(unsigned n)
+{
+	static char data[8192];
+	struct logbuffer_s lb = { 0, 0, sizeof(data), data };
+	char msg[64];
+	void *ptr;
+	bool is_part;
+	int sum = 0;
+
+	memset(msg, 0x5a, sizeof(msg));
+
+	/* one log message in, and drained in chunks as the writer thread does */
+	for (unsigned i = 0; i < n; i++) {
+		logbuffer_write(&lb, msg, sizeof(msg));
+
+		if ((i & 7) == 7) {
+			int len;
+
+			while ((len = logbuffer_get_ptr(&lb, &ptr, &is_part)) > 0) {
+				sum += len;
+				logbuffer_mark_read(&lb, len);
+			}
+		}
+	}
+
+	bench_c_sink = sum;
+}
+
+static uint8_t bson_buf[512];
+static int bson_buf_len;
+
+static int bson_encode(void)
+{
+	struct bson_encoder_s encoder;
+
+	bson_encoder_init_buf(&encoder, bson_buf, sizeof(bson_buf));
+	bson_encoder_append_int(&encoder, "SYS_AUTOSTART", 4001);
+	bson_encoder_append_double(&encoder, "MC_ROLL_P", 6.5);
+	bson_encoder_append_double(&encoder, "MC_PITCH_P", 6.5);
+	bson_encoder_append_double(&encoder, "MC_YAW_P", 2.0);
+	bson_encoder_append_int(&encoder, "RC_MAP_MODE_SW", 5);
+	bson_encoder_append_double(&encoder, "SENS_BOARD_X_OFF", 0.01);
+	bson_encoder_append_string(&encoder, "NAME", "bench");
+	bson_encoder_append_bool(&encoder, "ARMED", false);
+	bson_encoder_fini(&encoder);
+
+	return bson_encoder_buf_size(&encoder);
+}
+
+void bench_bson_encode(unsigned n)
+{
+	int sum = 0;
+
+	for (unsigned i = 0; i < n; i++) {
+		sum += bson_encode();
+	}
+
+	bench_c_sink = sum;
+}
+
+static int bson_count(bson_decoder_t decoder, void *arg, bson_node_t node)
+{
+	if (node->type == BSON_EOO)
+		return 0;
+
+	(*(int *)arg)++;
+
+	/* strings and binary data have to be consumed */
+	if (node->type == BSON_STRING) {
+		char buf[32];
+		bson_decoder_copy_data(decoder, buf);
+	}
+
+	return 1;
+}
+
+void bench_bson_decode(unsigned n)
+{
+	struct bson_decoder_s decoder;
+	int count = 0;
+
+	if (bson_buf_len == 0)
+		bson_buf_len = bson_encode();
+
+	for (unsigned i = 0; i < n; i++) {
+		bson_decoder_init_buf(&decoder, bson_buf, bson_buf_len, bson_count, &count);
+
+		while (bson_decoder_next(&decoder) > 0)
+			;
+	}
+
+	bench_c_sink = count;
+}
+
+/* names spread over the table, the lookup is a linear scan */
+static const char *param_names[] = { "SENS_GYRO_XOFF", "RC1_MIN", "RC_MAP_THROTTLE", "BAT_V_SCALING", "RC_FS_THR" };
+
+void bench_param_find(unsigned n)
+{
+	int sum = 0;
+
+	for (unsigned i = 0; i < n; i++) {
+		sum += param_find(param_names[i % (sizeof(param_names) / sizeof(param_names[0]))]);
+	}
+
+	bench_c_sink = sum;
+}
+
+void bench_param_find_miss(unsigned n)
+{
+	int sum = 0;
+
+	for (unsigned i = 0; i < n; i++) {
+		sum += param_find("NO_SUCH_PARAM");
+	}
+
+	bench_c_sink = sum;
+}
+
+void bench_param_get(unsigned n)
+{
+	param_t param = param_find("RC_MAP_THROTTLE");
+	int32_t value, sum = 0;
+
+	for (unsigned i = 0; i < n; i++) {
+		param_get(param, &value);
+		sum += value;
+	}
+
+	bench_c_sink = sum;
+}
+
+static void dataman_mission_item(struct mission_item_s *item, unsigned i)
+{
+	memset(item, 0, sizeof(*item));
+	item->altitude_is_relative = true;
+	item->lat = GEO_LAT + (i & 63) * GEO_STEP;
+	item->lon = GEO_LON + (i & 31) * GEO_STEP;
+	item->altitude = 50.0f;
+	item->yaw = NAN;
+	item->loiter_radius = 20.0f;
+	item->loiter_direction = 1;
+	item->nav_cmd = NAV_CMD_WAYPOINT;
+	item->acceptance_radius = 2.5f;
+	item->autocontinue = true;
+}
+
+/* conversion done in the caller context on each dm_write_mission_item() / dm_read_mission_item() */
+void bench_dataman_pack(unsigned n)
+{
+	struct mission_item_s items[64];
+	struct dm_mission_item_s record;
+	int sum = 0;
+
+	for (unsigned i = 0; i < 64; i++)
+		dataman_mission_item(&items[i], i);
+
+	for (unsigned i = 0; i < n; i++) {
+		dm_pack_mission_item(&items[i & 63], &record);
+		sum += record.lat;
+	}
+
+	bench_c_sink = sum;
+}
+
+void bench_dataman_unpack(unsigned n)
+{
+	struct dm_mission_item_s records[64];
+	struct mission_item_s item;
+	float sum = 0.0f;
+
+	for (unsigned i = 0; i < 64; i++) {
+		dataman_mission_item(&item, i);
+		dm_pack_mission_item(&item, &records[i]);
+	}
+
+	for (unsigned i = 0; i < n; i++) {
+		dm_unpack_mission_item(&records[i & 63], &item);
+		sum += item.lat;
+	}
+
+	bench_c_sink = sum;
+}
+
+/* a full mission list through the store, the file replaced by a buffer of the record layout */
+void bench_dataman_mission(unsigned n)
+{
+	static struct dm_mission_item_s store[NUM_MISSIONS_SUPPORTED];
+	struct mission_item_s item;
+	float sum = 0.0f;
+
+	dataman_mission_item(&item, 0);
+
+	for (unsigned i = 0; i < n; i++) {
+		unsigned index = i % NUM_MISSIONS_SUPPORTED;
+		item.lat = GEO_LAT + (index & 63) * GEO_STEP;
+		dm_pack_mission_item(&item, &store[index]);
+		dm_unpack_mission_item(&store[(index * 7) % NUM_MISSIONS_SUPPORTED], &item);
+		sum += item.altitude;
+	}
+
+	bench_c_sink = sum;
+}
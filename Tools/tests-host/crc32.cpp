@@ -0,0 +1,20 @@
+#include <crc32.h>
+
+/* same polynomial and conventions as the NuttX implementation: no pre/post inversion */
+uint32_t crc32part(const uint8_t *src, size_t len, uint32_t crc32val)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc32val ^= src[i];
+
+		for (unsigned bit = 0; bit < 8; bit++) {
+			crc32val = (crc32val >> 1) ^ ((crc32val & 1) ? 0xedb88320 : 0);
+		}
+	}
+
+	return crc32val;
+}
+
+uint32_t crc32(const uint8_t *src, size_t len)
+{
+	return crc32part(src, len, 0);
+}
@@ -0,0 +1,19 @@
+/*
+ * Host stand-in for the NuttX crc32 helpers.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t crc32part(const uint8_t *src, size_t len, uint32_t crc32val);
+uint32_t crc32(const uint8_t *src, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
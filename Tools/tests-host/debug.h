@@ -0,0 +1 @@
+/* NuttX debug.h, param.c only needs it to exist */
@@ -0,0 +1,237 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <drivers/mkblctrl/esc_batch.h>
+
+/*
+ * ESC batch against a simulated I2C bus with eight ESCs. A batch is one
+ * bus transaction that stops at the first ESC not acknowledging, like the
+ * STM32 driver does. Every cycle must update all ESCs with a single
+ * transaction, read the status of one ESC every second cycle in rotation,
+ * and after a failed batch still reach the other ESCs and report the error
+ * for the right one.
+ */
+
+#define ESCS		8
+#define BASE_ADDR	0x29
+
+static int fails = 0;
+
+static void check(const char *what, bool ok)
+{
+	if (!ok) {
+		printf("FAIL: %s\n", what);
+		fails++;
+	}
+}
+
+class SimulatedBus
+{
+public:
+	SimulatedBus() : transactions(0), messages(0), singles(0)
+	{
+		memset(nack, 0, sizeof(nack));
+		memset(setpoint, 0, sizeof(setpoint));
+		memset(writes, 0, sizeof(writes));
+	}
+
+	bool		nack[ESCS];
+	uint8_t		setpoint[ESCS];
+	unsigned	writes[ESCS];
+	unsigned	transactions;
+	unsigned	messages;
+	unsigned	singles;
+
+	int write(uint16_t addr, const uint8_t *buf, unsigned len)
+	{
+		unsigned esc = addr - BASE_ADDR;
+
+		if (esc >= ESCS || nack[esc])
+			return -EIO;
+
+		setpoint[esc] = buf[0];
+		writes[esc]++;
+		return 0;
+	}
+
+	int read(uint16_t addr, uint8_t *buf, unsigned len)
+	{
+		unsigned esc = addr - BASE_ADDR;
+
+		if (esc >= ESCS || nack[esc])
+			return -EIO;
+
+		/* current, max PWM and temperature, tagged with the ESC */
+		for (unsigned i = 0; i < len; i++)
+			buf[i] = (esc << 4) | i;
+
+		return 0;
+	}
+
+	static int batch(void *arg, const ESC_Batch::Message *msgv, unsigned msgs);
+	static int transfer(void *arg, uint16_t addr, const uint8_t *send, unsigned send_len,
+			    uint8_t *recv, unsigned recv_len);
+	static void result(void *arg, unsigned chan, int result, const uint8_t *status, unsigned status_len);
+
+	/* what the driver got back per channel */
+	int		results[ESCS];
+	unsigned	reported[ESCS];
+	unsigned	status_reads[ESCS];
+	bool		status_ok;
+};
+
+int
+SimulatedBus::batch(void *arg, const ESC_Batch::Message *msgv, unsigned msgs)
+{
+	SimulatedBus *bus = (SimulatedBus *)arg;
+
+	bus->transactions++;
+
+	for (unsigned i = 0; i < msgs; i++) {
+		bus->messages++;
+
+		int ret = msgv[i].read ? bus->read(msgv[i].addr, msgv[i].buffer, msgv[i].length) :
+			  bus->write(msgv[i].addr, msgv[i].buffer, msgv[i].length);
+
+		/* a NACK aborts the rest of the transaction */
+		if (ret != 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+int
+SimulatedBus::transfer(void *arg, uint16_t addr, const uint8_t *send, unsigned send_len,
+		       uint8_t *recv, unsigned recv_len)
+{
+	SimulatedBus *bus = (SimulatedBus *)arg;
+
+	bus->singles++;
+
+	int ret = bus->write(addr, send, send_len);
+
+	if (ret == 0 && recv_len > 0)
+		ret = bus->read(addr, recv, recv_len);
+
+	return ret;
+}
+
+void
+SimulatedBus::result(void *arg, unsigned chan, int result, const uint8_t *status, unsigned status_len)
+{
+	SimulatedBus *bus = (SimulatedBus *)arg;
+
+	bus->results[chan] = result;
+	bus->reported[chan]++;
+
+	if (status != nullptr) {
+		bus->status_reads[chan]++;
+
+		if (status_len != 3 || status[0] != (chan << 4) || status[2] != ((chan << 4) | 2))
+			bus->status_ok = false;
+	}
+}
+
+static void queue_all(ESC_Batch &batch, uint8_t value)
+{
+	for (unsigned i = 0; i < ESCS; i++) {
+		uint8_t setpoint[2] = { (uint8_t)(value + i), 0 };
+		batch.queue(i, BASE_ADDR + i, setpoint, 1, 3);
+	}
+}
+
+static void batch_run()
+{
+	SimulatedBus bus;
+	ESC_Batch batch(&SimulatedBus::batch, &SimulatedBus::transfer, &SimulatedBus::result, &bus);
+
+	memset(bus.reported, 0, sizeof(bus.reported));
+	memset(bus.status_reads, 0, sizeof(bus.status_reads));
+	bus.status_ok = true;
+
+	/* nothing queued, nothing on the bus */
+	check("empty flush", batch.flush(ESCS) == 0 && bus.transactions == 0);
+
+	/* the empty cycle moved the status read on; run the rotation from cycle 1 */
+	for (unsigned cycle = 1; cycle <= 32; cycle++) {
+		queue_all(batch, cycle);
+
+		unsigned messages = bus.messages;
+		bool due = false;
+
+		for (unsigned i = 0; i < ESCS; i++)
+			due |= batch.status_due(i);
+
+		check("batch flushed", batch.flush(ESCS) == 0);
+		check("status read every second cycle", due == (cycle % 2 == 0));
+		check("one write per ESC, status read in the same transaction",
+		      bus.messages - messages == ESCS + (due ? 1 : 0));
+		check("setpoints delivered", bus.setpoint[0] == (uint8_t)cycle && bus.setpoint[7] == (uint8_t)(cycle + 7));
+	}
+
+	check("one transaction per cycle", bus.transactions == 32 && batch.batches() == 32);
+	check("no single transfers", bus.singles == 0 && batch.fallbacks() == 0);
+	check("every ESC read every 16 cycles", bus.status_reads[0] == 2 && bus.status_reads[3] == 2 &&
+	      bus.status_reads[7] == 2);
+	check("status handed to the right channel", bus.status_ok);
+	check("queue emptied", batch.queued() == 0);
+
+	/* a full batch refuses more */
+	queue_all(batch, 0);
+	uint8_t extra = 0;
+	check("full batch", batch.queue(0, BASE_ADDR, &extra, 1, 3) == -ENOSPC);
+	check("oversized setpoint", batch.flush(ESCS) == 0 &&
+	      batch.queue(0, BASE_ADDR, &extra, ESC_BATCH_SETPOINT_MAX + 1, 3) == -EINVAL);
+	batch.flush(ESCS);
+}
+
+static void error_run()
+{
+	SimulatedBus bus;
+	ESC_Batch batch(&SimulatedBus::batch, &SimulatedBus::transfer, &SimulatedBus::result, &bus);
+
+	memset(bus.reported, 0, sizeof(bus.reported));
+	memset(bus.status_reads, 0, sizeof(bus.status_reads));
+	bus.status_ok = true;
+
+	/* ESC 2 is gone and aborts every batch after the first two writes */
+	bus.nack[2] = true;
+
+	queue_all(batch, 100);
+	check("failed batch reported", batch.flush(ESCS) == -EIO);
+	check("fallback to single transfers", bus.transactions == 1 && bus.singles == ESCS && batch.fallbacks() == 1);
+	check("other ESCs still updated", bus.setpoint[1] == 101 && bus.setpoint[3] == 103 && bus.setpoint[7] == 107);
+	check("every ESC reported once", bus.reported[0] == 1 && bus.reported[2] == 1 && bus.reported[7] == 1);
+	check("error for the silent ESC only", bus.results[2] == -EIO && bus.results[1] == 0 && bus.results[3] == 0);
+	check("status read in the fallback", bus.status_reads[0] == 1 && bus.status_ok);
+
+	/* the silent ESC loses its status read, its result carries no status */
+	batch.flush(ESCS);
+	queue_all(batch, 110);
+	check("status of ESC 1 due", batch.status_due(1));
+	batch.flush(ESCS);
+	batch.flush(ESCS);
+	queue_all(batch, 120);
+	check("status of silent ESC due", batch.status_due(2));
+	unsigned reads = bus.status_reads[2];
+	check("silent ESC fails again", batch.flush(ESCS) == -EIO && bus.results[2] == -EIO);
+	check("no status from the silent ESC", bus.status_reads[2] == reads);
+
+	/* back on the bus, batches go through again */
+	bus.nack[2] = false;
+	unsigned singles = bus.singles;
+	queue_all(batch, 130);
+	check("recovered", batch.flush(ESCS) == 0 && bus.singles == singles && bus.results[2] == 0 &&
+	      bus.setpoint[2] == 132);
+}
+
+int main(int argc, char *argv[])
+{
+	batch_run();
+	error_run();
+
+	printf("esc batch test %s\n", fails ? "FAILED" : "PASSED");
+	return fails ? 1 : 0;
+}
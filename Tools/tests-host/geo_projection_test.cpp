@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include <geo/geo.h>
+
+/*
+ * Accuracy and cost of the float local reference frame against the double
+ * precision azimuthal equidistant map_projection_project(), on rings of
+ * points around origins at several latitudes.
+ */
+
+#define RING_POINTS	360
+#define BATCH_POINTS	1000
+
+static int fails = 0;
+
+static double now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static float ring_error(const struct map_projection_reference_s *ref, float radius, float *roundtrip)
+{
+	float max_err = 0.0f;
+	*roundtrip = 0.0f;
+
+	for (unsigned i = 0; i < RING_POINTS; i++) {
+		float bearing = i * 2.0f * M_PI_F / RING_POINTS;
+		double lat, lon;
+		float x_ref, y_ref, x, y;
+
+		/* exact point on the ring, as the azimuthal equidistant plane defines it */
+		map_projection_reproject(radius * cosf(bearing), radius * sinf(bearing), &lat, &lon);
+		map_projection_project(lat, lon, &x_ref, &y_ref);
+		map_projection_ref_project(ref, lat, lon, &x, &y);
+		max_err = fmaxf(max_err, sqrtf((x - x_ref) * (x - x_ref) + (y - y_ref) * (y - y_ref)));
+
+		double lat_back, lon_back;
+		float x_back, y_back;
+		map_projection_ref_reproject(ref, x, y, &lat_back, &lon_back);
+		map_projection_ref_project(ref, lat_back, lon_back, &x_back, &y_back);
+		*roundtrip = fmaxf(*roundtrip, sqrtf((x - x_back) * (x - x_back) + (y - y_back) * (y - y_back)));
+	}
+
+	return max_err;
+}
+
+int main(int argc, char *argv[])
+{
+	const double origins[][2] = { { 0.0, 0.0 }, { 47.397742, 8.545594 }, { 70.0, -150.0 } };
+	const float radii[] = { 100.0f, 1000.0f, 10000.0f, 50000.0f };
+	/* documented bound up to mid latitudes, looser at 70 deg */
+	const float limits[] = { 0.001f, 0.001f, 0.01f, 0.6f };
+
+	for (unsigned o = 0; o < sizeof(origins) / sizeof(origins[0]); o++) {
+		struct map_projection_reference_s ref;
+		map_projection_init(origins[o][0], origins[o][1]);
+		map_projection_ref_init(&ref, origins[o][0], origins[o][1]);
+
+		for (unsigned r = 0; r < sizeof(radii) / sizeof(radii[0]); r++) {
+			float roundtrip;
+			float err = ring_error(&ref, radii[r], &roundtrip);
+
+			printf("lat %6.2f radius %6.0f m: max error %.4f m, roundtrip %.4f m\n",
+			       origins[o][0], (double)radii[r], (double)err, (double)roundtrip);
+
+			if ((origins[o][0] < 60.0 && err > limits[r]) || (radii[r] <= 10000.0f && roundtrip > 0.001f)) {
+				printf("FAIL: projection error above the bound\n");
+				fails++;
+			}
+		}
+	}
+
+	/* cost per point, everything within 5 km of the origin */
+	static double lat[BATCH_POINTS], lon[BATCH_POINTS];
+	static float x[BATCH_POINTS], y[BATCH_POINTS];
+	const unsigned rounds = 200;
+	struct map_projection_reference_s ref;
+
+	map_projection_init(origins[1][0], origins[1][1]);
+	map_projection_ref_init(&ref, origins[1][0], origins[1][1]);
+
+	for (unsigned i = 0; i < BATCH_POINTS; i++) {
+		map_projection_reproject(5000.0f * cosf(i * 0.37f) * (i % 7) / 7.0f, 5000.0f * sinf(i * 0.37f), &lat[i], &lon[i]);
+	}
+
+	double t0 = now();
+
+	for (unsigned r = 0; r < rounds; r++) {
+		for (unsigned i = 0; i < BATCH_POINTS; i++) {
+			map_projection_project(lat[i], lon[i], &x[i], &y[i]);
+		}
+	}
+
+	double t1 = now();
+
+	for (unsigned r = 0; r < rounds; r++) {
+		for (unsigned i = 0; i < BATCH_POINTS; i++) {
+			map_projection_ref_project(&ref, lat[i], lon[i], &x[i], &y[i]);
+		}
+	}
+
+	double t2 = now();
+
+	for (unsigned r = 0; r < rounds; r++) {
+		map_projection_ref_project_array(&ref, lat, lon, x, y, BATCH_POINTS);
+	}
+
+	double t3 = now();
+
+	for (unsigned r = 0; r < rounds; r++) {
+		for (unsigned i = 0; i < BATCH_POINTS; i++) {
+			map_projection_reproject(x[i], y[i], &lat[i], &lon[i]);
+		}
+	}
+
+	double t4 = now();
+
+	for (unsigned r = 0; r < rounds; r++) {
+		map_projection_ref_reproject_array(&ref, x, y, lat, lon, BATCH_POINTS);
+	}
+
+	double t5 = now();
+	double n = (double)rounds * BATCH_POINTS;
+
+	printf("project    global: %6.1f ns  reference: %6.1f ns  array: %6.1f ns\n",
+	       (t1 - t0) / n * 1e9, (t2 - t1) / n * 1e9, (t3 - t2) / n * 1e9);
+	printf("reproject  global: %6.1f ns  array: %6.1f ns\n",
+	       (t4 - t3) / n * 1e9, (t5 - t4) / n * 1e9);
+
+	printf("geo projection test %s\n", fails ? "FAILED" : "PASSED");
+	return fails ? 1 : 0;
+}
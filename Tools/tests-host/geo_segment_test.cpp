@@ -0,0 +1,203 @@
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include <geo/geo.h>
+
+/*
+ * Per-update navigation geometry along a long survey mission: the
+ * haversine / great circle calls and the L1 planar vectors the navigator
+ * and the L1 controller used to evaluate on every position update, against
+ * a geo_segment_s that is set up once per leg.
+ *
+ * The L1 controller itself needs mathlib, which does not build on the host;
+ * its old get_local_planar_vector() is transcribed below.
+ */
+
+#define SURVEY_LEGS		200
+#define SURVEY_LEG_LENGTH	800.0f
+#define SURVEY_SPACING		50.0f
+#define ACCEPTANCE_RADIUS	25.0f
+#define AIRSPEED		20.0f
+#define RATE			20.0f
+
+struct waypoint {
+	double lat;
+	double lon;
+};
+
+struct sample {
+	double lat;
+	double lon;
+	unsigned leg;
+};
+
+static struct waypoint mission[SURVEY_LEGS + 1];
+static struct sample samples[200000];
+static unsigned num_samples = 0;
+
+static void planar_vector_ref(double lat_origin, double lon_origin, double lat_target, double lon_target, float *n, float *e)
+{
+	/* L1 works on float degrees */
+	float origin_lat = lat_origin, origin_lon = lon_origin, target_lat = lat_target, target_lon = lon_target;
+
+	*n = (target_lat - origin_lat) * M_DEG_TO_RAD_F * (float)CONSTANTS_RADIUS_OF_EARTH;
+	*e = (target_lon - origin_lon) * M_DEG_TO_RAD_F * cosf(origin_lat * M_DEG_TO_RAD_F) * (float)CONSTANTS_RADIUS_OF_EARTH;
+}
+
+static void build_mission()
+{
+	double lat = 47.397742, lon = 8.545594;
+
+	for (unsigned i = 0; i <= SURVEY_LEGS; i++) {
+		mission[i].lat = lat;
+		mission[i].lon = lon;
+
+		/* lawnmower: long legs north/south, short hops east */
+		if (i % 2 == 0) {
+			add_vector_to_global_position(lat, lon, (i % 4 == 0) ? SURVEY_LEG_LENGTH : -SURVEY_LEG_LENGTH, 0.0f, &lat, &lon);
+
+		} else {
+			add_vector_to_global_position(lat, lon, 0.0f, SURVEY_SPACING, &lat, &lon);
+		}
+	}
+}
+
+static void fly_mission()
+{
+	double lat = mission[0].lat, lon = mission[0].lon;
+	unsigned leg = 1;
+
+	while (leg <= SURVEY_LEGS && num_samples < sizeof(samples) / sizeof(samples[0])) {
+		samples[num_samples].lat = lat;
+		samples[num_samples].lon = lon;
+		samples[num_samples].leg = leg;
+		num_samples++;
+
+		float n, e;
+		get_vector_to_next_waypoint(lat, lon, mission[leg].lat, mission[leg].lon, &n, &e);
+		float dist = sqrtf(n * n + e * e);
+
+		if (dist < ACCEPTANCE_RADIUS) {
+			leg++;
+			continue;
+		}
+
+		/* pursuit with a small crosswind drift */
+		float step = AIRSPEED / RATE;
+		add_vector_to_global_position(lat, lon, n / dist * step, e / dist * step + 0.02f, &lat, &lon);
+	}
+}
+
+static double now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+	int fails = 0;
+
+	build_mission();
+	fly_mission();
+
+	if (samples[num_samples - 1].leg < SURVEY_LEGS) {
+		printf("FAIL: mission not completed\n");
+		fails++;
+	}
+
+	/* accuracy over the whole mission */
+	struct geo_segment_s seg;
+	geo_segment_init(&seg, 0.0, 0.0, 0.0, 0.0);
+	float max_dist_err = 0.0f, max_vec_err = 0.0f, max_bearing_err = 0.0f;
+	unsigned acceptance_mismatch = 0, inits = 0;
+
+	for (unsigned i = 0; i < num_samples; i++) {
+		const struct waypoint &a = mission[samples[i].leg - 1];
+		const struct waypoint &b = mission[samples[i].leg];
+
+		if (!geo_segment_matches(&seg, a.lat, a.lon, b.lat, b.lon)) {
+			geo_segment_init(&seg, a.lat, a.lon, b.lat, b.lon);
+			inits++;
+		}
+
+		float dist_xy, dist_z;
+		get_distance_to_point_global_wgs84(b.lat, b.lon, 0.0f, samples[i].lat, samples[i].lon, 0.0f, &dist_xy, &dist_z);
+		float dist = geo_segment_distance_to_end(&seg, samples[i].lat, samples[i].lon);
+		max_dist_err = fmaxf(max_dist_err, fabsf(dist - dist_xy));
+
+		/* only disagree on acceptance within centimeters of the radius */
+		if ((dist <= ACCEPTANCE_RADIUS) != (dist_xy <= ACCEPTANCE_RADIUS) && fabsf(dist_xy - ACCEPTANCE_RADIUS) > 0.05f) {
+			acceptance_mismatch++;
+		}
+
+		/* L1 gets its positions as float degrees, feed the leg the same */
+		struct geo_segment_s seg_l1;
+		float ref_n, ref_e, n, e;
+		geo_segment_init(&seg_l1, (float)a.lat, (float)a.lon, (float)b.lat, (float)b.lon);
+		planar_vector_ref(a.lat, a.lon, samples[i].lat, samples[i].lon, &ref_n, &ref_e);
+		geo_segment_project(&seg_l1, (float)samples[i].lat, (float)samples[i].lon, &n, &e);
+		max_vec_err = fmaxf(max_vec_err, sqrtf((n - ref_n) * (n - ref_n) + (e - ref_e) * (e - ref_e)));
+
+		if (dist_xy > 10.0f) {
+			float bearing_ref = get_bearing_to_next_waypoint(samples[i].lat, samples[i].lon, b.lat, b.lon);
+			geo_segment_project(&seg, samples[i].lat, samples[i].lon, &n, &e);
+			float bearing = atan2f(seg.end_e - e, seg.end_n - n);
+			max_bearing_err = fmaxf(max_bearing_err, fabsf(_wrap_pi(bearing - bearing_ref)));
+		}
+	}
+
+	printf("%u updates on %u legs (%u leg setups): max error distance %.3f m, vector %.3f m, bearing %.5f rad\n",
+	       num_samples, SURVEY_LEGS, inits, (double)max_dist_err, (double)max_vec_err, (double)max_bearing_err);
+
+	if (inits != SURVEY_LEGS || max_dist_err > 0.1f || max_vec_err > 0.1f || max_bearing_err > 1e-3f || acceptance_mismatch > 0) {
+		printf("FAIL: segment geometry differs from the reference\n");
+		fails++;
+	}
+
+	/* per-update cost: acceptance distance, bearing to B and the three L1 vectors */
+	volatile float sink = 0.0f;
+	double t0 = now();
+
+	for (unsigned i = 0; i < num_samples; i++) {
+		const struct waypoint &a = mission[samples[i].leg - 1];
+		const struct waypoint &b = mission[samples[i].leg];
+		float dist_xy, dist_z, ab_n, ab_e, ap_n, ap_e, bp_n, bp_e;
+
+		get_distance_to_point_global_wgs84(b.lat, b.lon, 0.0f, samples[i].lat, samples[i].lon, 0.0f, &dist_xy, &dist_z);
+		float bearing = get_bearing_to_next_waypoint(samples[i].lat, samples[i].lon, b.lat, b.lon);
+		planar_vector_ref(a.lat, a.lon, b.lat, b.lon, &ab_n, &ab_e);
+		planar_vector_ref(a.lat, a.lon, samples[i].lat, samples[i].lon, &ap_n, &ap_e);
+		planar_vector_ref(b.lat, b.lon, samples[i].lat, samples[i].lon, &bp_n, &bp_e);
+		sink = dist_xy + bearing + ab_n + ab_e + ap_n + ap_e + bp_n + bp_e;
+	}
+
+	double t1 = now();
+	geo_segment_init(&seg, 0.0, 0.0, 0.0, 0.0);
+
+	for (unsigned i = 0; i < num_samples; i++) {
+		const struct waypoint &a = mission[samples[i].leg - 1];
+		const struct waypoint &b = mission[samples[i].leg];
+		float ap_n, ap_e;
+
+		if (!geo_segment_matches(&seg, a.lat, a.lon, b.lat, b.lon)) {
+			geo_segment_init(&seg, a.lat, a.lon, b.lat, b.lon);
+		}
+
+		float dist_xy = geo_segment_distance_to_end(&seg, samples[i].lat, samples[i].lon);
+		geo_segment_project(&seg, samples[i].lat, samples[i].lon, &ap_n, &ap_e);
+		float bp_n = ap_n - seg.end_n, bp_e = ap_e - seg.end_e;
+		float bearing = atan2f(-bp_e, -bp_n);
+		sink = dist_xy + bearing + seg.dir_n + seg.dir_e + ap_n + ap_e + bp_n + bp_e;
+	}
+
+	double t2 = now();
+	(void)sink;
+
+	printf("per update   reference: %6.1f ns  segment: %6.1f ns\n",
+	       (t1 - t0) / num_samples * 1e9, (t2 - t1) / num_samples * 1e9);
+
+	printf("geo segment test %s\n", fails ? "FAILED" : "PASSED");
+	return fails ? 1 : 0;
+}
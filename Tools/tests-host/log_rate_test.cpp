@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <modules/sdlog2/log_rate.h>
+
+/*
+ * sdlog2 message rates: a message of each priority updated at 250 Hz for
+ * one second per case, written when log_rate_check() lets it through.
+ */
+
+#define MSG_CRITICAL	10
+#define MSG_HIGH	2
+#define MSG_NORMAL	5	/* no profile, normal priority */
+#define MSG_LOW		18
+#define MSG_SYSTEM	129	/* above LOG_RATE_MSG_MAX, never limited */
+
+#define UPDATE_INTERVAL	4000	/* us */
+
+static const struct log_rate_profile_s profiles[] = {
+	{ MSG_CRITICAL,	LOG_PRIO_CRITICAL,	{ 0,	0,	0,	0 } },
+	{ MSG_HIGH,	LOG_PRIO_HIGH,		{ 100,	0,	20,	0 } },
+	{ MSG_LOW,	LOG_PRIO_LOW,		{ 500,	100,	200,	100 } },
+};
+
+static int fails = 0;
+
+static uint64_t now = 1000000;
+
+static void check(const char *what, bool ok)
+{
+	if (!ok) {
+		printf("FAIL: %s\n", what);
+		fails++;
+	}
+}
+
+struct counts {
+	unsigned critical, high, normal, low, system;
+};
+
+static struct counts run_second(struct log_rate_s *r)
+{
+	struct counts c = { 0, 0, 0, 0, 0 };
+
+	for (unsigned i = 0; i < 1000000 / UPDATE_INTERVAL; i++, now += UPDATE_INTERVAL) {
+		c.critical += log_rate_check(r, MSG_CRITICAL, now);
+		c.high += log_rate_check(r, MSG_HIGH, now);
+		c.normal += log_rate_check(r, MSG_NORMAL, now);
+		c.low += log_rate_check(r, MSG_LOW, now);
+		c.system += log_rate_check(r, MSG_SYSTEM, now);
+	}
+
+	return c;
+}
+
+static void print_counts(const char *name, const struct log_rate_s *r, const struct counts &c)
+{
+	printf("%-16s level %u: critical %3u high %3u normal %3u low %3u system %3u\n",
+	       name, (unsigned)r->level, c.critical, c.high, c.normal, c.low, c.system);
+}
+
+static void profiles_run()
+{
+	struct log_rate_s r;
+	struct counts c;
+
+	log_rate_init(&r, profiles, sizeof(profiles) / sizeof(profiles[0]), true);
+
+	log_rate_set_phase(&r, LOG_PHASE_CRUISE);
+	c = run_second(&r);
+	print_counts("cruise", &r, c);
+	check("cruise intervals", c.critical == 250 && c.high == 50 && c.normal == 250 && c.low == 5 && c.system == 250);
+
+	log_rate_set_phase(&r, LOG_PHASE_TRANSITION);
+	c = run_second(&r);
+	print_counts("transition", &r, c);
+	check("transition intervals", c.high == 250 && c.low == 10);
+
+	/* without -p only the priorities are used */
+	log_rate_init(&r, profiles, sizeof(profiles) / sizeof(profiles[0]), false);
+	log_rate_set_phase(&r, LOG_PHASE_CRUISE);
+	c = run_second(&r);
+	print_counts("not adaptive", &r, c);
+	check("no limits without profiles", c.high == 250 && c.low == 250);
+	check("nothing decimated on an empty buffer",
+	      r.decimated[LOG_PRIO_HIGH] == 0 && r.decimated[LOG_PRIO_NORMAL] == 0 && r.decimated[LOG_PRIO_LOW] == 0);
+
+	/* messages of a type written more than once in a cycle share the decision */
+	check("same cycle shares the decision", log_rate_check(&r, MSG_LOW, now) && log_rate_check(&r, MSG_LOW, now));
+}
+
+static void levels_run()
+{
+	struct log_rate_s r;
+	struct counts c;
+
+	log_rate_init(&r, profiles, sizeof(profiles) / sizeof(profiles[0]), false);
+
+	/* thresholds at 50, 70 and 85 % */
+	check("level 0 below 50 %", !log_rate_update_level(&r, 49, 100) && r.level == 0);
+	check("level 1 at 50 %", log_rate_update_level(&r, 50, 100) && r.level == 1);
+	check("level 2 at 70 %", log_rate_update_level(&r, 70, 100) && r.level == 2);
+	check("level 3 at 85 %", log_rate_update_level(&r, 85, 100) && r.level == 3);
+	check("level 3 is the last", !log_rate_update_level(&r, 100, 100) && r.level == 3);
+
+	/* hysteresis, levels end 10 % below their threshold */
+	check("level 3 kept down to 75 %", !log_rate_update_level(&r, 75, 100) && r.level == 3);
+	check("level 2 below 75 %", log_rate_update_level(&r, 74, 100) && r.level == 2);
+	check("level 0 below 40 %", log_rate_update_level(&r, 39, 100) && r.level == 0);
+	check("jump to level 3", log_rate_update_level(&r, 90, 100) && r.level == 3);
+
+	c = run_second(&r);
+	print_counts("full buffer", &r, c);
+	check("critical never decimated", c.critical == 250 && r.decimated[LOG_PRIO_CRITICAL] == 0);
+	check("high decimated to 10 Hz", c.high == 10);
+	check("normal decimated to 5 Hz", c.normal == 5);
+	check("low decimated to 2.5 Hz", c.low == 3);
+	check("system messages not limited", c.system == 250);
+	check("decimated messages are counted", r.decimated[LOG_PRIO_HIGH] == 240 &&
+	      r.decimated[LOG_PRIO_NORMAL] == 245 && r.decimated[LOG_PRIO_LOW] == 247);
+
+	log_rate_update_level(&r, 55, 100);
+	c = run_second(&r);
+	print_counts("half full", &r, c);
+	check("only low decimated at level 1", r.level == 1 && c.critical == 250 && c.high == 250 &&
+	      c.normal == 250 && c.low == 10);
+
+	log_rate_reset(&r);
+	check("reset clears level and counters", r.level == 0 && r.decimated[LOG_PRIO_LOW] == 0);
+}
+
+int main(int argc, char *argv[])
+{
+	profiles_run();
+	levels_run();
+
+	printf("log rate test %s\n", fails ? "FAILED" : "PASSED");
+	return fails ? 1 : 0;
+}
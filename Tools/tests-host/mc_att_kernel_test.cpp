@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <mc_att_control/mc_att_control_kernel.h>
+
+/*
+ * Closed-loop comparison of the attitude controller kernel against the
+ * previous matrix based controller.
+ *
+ * mathlib depends on CMSIS and does not build on the host, so the
+ * reference below is a transcription of the old control_attitude() and
+ * control_attitude_rates() on small value types that create the same
+ * temporaries as math::Matrix/math::Vector.
+ */
+
+struct Vec3 {
+	float v[3];
+	Vec3() { v[0] = v[1] = v[2] = 0.0f; }
+	Vec3(float x, float y, float z) { v[0] = x; v[1] = y; v[2] = z; }
+	float &operator()(int i) { return v[i]; }
+	float operator()(int i) const { return v[i]; }
+	Vec3 operator+(const Vec3 &o) const { return Vec3(v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2]); }
+	Vec3 operator-(const Vec3 &o) const { return Vec3(v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2]); }
+	Vec3 operator*(float f) const { return Vec3(v[0] * f, v[1] * f, v[2] * f); }
+	Vec3 operator/(float f) const { return Vec3(v[0] / f, v[1] / f, v[2] / f); }
+	float operator*(const Vec3 &o) const { return v[0] * o.v[0] + v[1] * o.v[1] + v[2] * o.v[2]; }
+	Vec3 operator%(const Vec3 &o) const {
+		return Vec3(v[1] * o.v[2] - v[2] * o.v[1], v[2] * o.v[0] - v[0] * o.v[2], v[0] * o.v[1] - v[1] * o.v[0]);
+	}
+	Vec3 emult(const Vec3 &o) const { return Vec3(v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2]); }
+	float length() const { return sqrtf(*this * *this); }
+	void normalize() { *this = *this / length(); }
+};
+
+struct Mat3 {
+	float data[3][3];
+	Mat3() { memset(data, 0, sizeof(data)); }
+	float &operator()(int i, int j) { return data[i][j]; }
+	float operator()(int i, int j) const { return data[i][j]; }
+	Mat3 operator+(const Mat3 &o) const {
+		Mat3 r;
+		for (int i = 0; i < 3; i++) for (int j = 0; j < 3; j++) r.data[i][j] = data[i][j] + o.data[i][j];
+		return r;
+	}
+	Mat3 operator*(float f) const {
+		Mat3 r;
+		for (int i = 0; i < 3; i++) for (int j = 0; j < 3; j++) r.data[i][j] = data[i][j] * f;
+		return r;
+	}
+	Mat3 operator*(const Mat3 &o) const {
+		Mat3 r;
+		for (int i = 0; i < 3; i++) for (int j = 0; j < 3; j++)
+			for (int k = 0; k < 3; k++) r.data[i][j] += data[i][k] * o.data[k][j];
+		return r;
+	}
+	Vec3 operator*(const Vec3 &o) const {
+		Vec3 r;
+		for (int i = 0; i < 3; i++) for (int k = 0; k < 3; k++) r.v[i] += data[i][k] * o.v[k];
+		return r;
+	}
+	Mat3 transposed() const {
+		Mat3 r;
+		for (int i = 0; i < 3; i++) for (int j = 0; j < 3; j++) r.data[i][j] = data[j][i];
+		return r;
+	}
+	void identity() { memset(data, 0, sizeof(data)); data[0][0] = data[1][1] = data[2][2] = 1.0f; }
+	void from_euler(float roll, float pitch, float yaw) {
+		float cp = cosf(pitch), sp = sinf(pitch), sr = sinf(roll), cr = cosf(roll), sy = sinf(yaw), cy = cosf(yaw);
+		data[0][0] = cp * cy;
+		data[0][1] = (sr * sp * cy) - (cr * sy);
+		data[0][2] = (cr * sp * cy) + (sr * sy);
+		data[1][0] = cp * sy;
+		data[1][1] = (sr * sp * sy) + (cr * cy);
+		data[1][2] = (cr * sp * sy) - (sr * cy);
+		data[2][0] = -sp;
+		data[2][1] = sr * cp;
+		data[2][2] = cr * cp;
+	}
+};
+
+struct Reference {
+	Vec3 att_p, rate_p, rate_i, rate_d;
+	float yaw_ff;
+	Vec3 rates_prev, rates_int, rates_sp, att_control;
+	Mat3 I;
+
+	void control_attitude(const Mat3 &R, const Mat3 &R_sp, float yaw_sp_move_rate) {
+		Vec3 R_z(R(0, 2), R(1, 2), R(2, 2));
+		Vec3 R_sp_z(R_sp(0, 2), R_sp(1, 2), R_sp(2, 2));
+		Vec3 e_R = R.transposed() * (R_z % R_sp_z);
+		float e_R_z_sin = e_R.length();
+		float e_R_z_cos = R_z * R_sp_z;
+		float yaw_w = R_sp(2, 2) * R_sp(2, 2);
+		Mat3 R_rp;
+
+		if (e_R_z_sin > 0.0f) {
+			float e_R_z_angle = atan2f(e_R_z_sin, e_R_z_cos);
+			Vec3 e_R_z_axis = e_R / e_R_z_sin;
+			e_R = e_R_z_axis * e_R_z_angle;
+			Mat3 e_R_cp;
+			e_R_cp(0, 1) = -e_R_z_axis(2);
+			e_R_cp(0, 2) = e_R_z_axis(1);
+			e_R_cp(1, 0) = e_R_z_axis(2);
+			e_R_cp(1, 2) = -e_R_z_axis(0);
+			e_R_cp(2, 0) = -e_R_z_axis(1);
+			e_R_cp(2, 1) = e_R_z_axis(0);
+			R_rp = R * (I + e_R_cp * e_R_z_sin + e_R_cp * e_R_cp * (1.0f - e_R_z_cos));
+
+		} else {
+			R_rp = R;
+		}
+
+		Vec3 R_sp_x(R_sp(0, 0), R_sp(1, 0), R_sp(2, 0));
+		Vec3 R_rp_x(R_rp(0, 0), R_rp(1, 0), R_rp(2, 0));
+		e_R(2) = atan2f((R_rp_x % R_sp_x) * R_sp_z, R_rp_x * R_sp_x) * yaw_w;
+
+		if (e_R_z_cos < 0.0f) {
+			Mat3 m = R.transposed() * R_sp;
+			float q0 = 0.5f * sqrtf(1.0f + m(0, 0) + m(1, 1) + m(2, 2));
+			Vec3 e_R_d(0.5f * sqrtf(1.0f + m(0, 0) - m(1, 1) - m(2, 2)),
+				   0.5f * sqrtf(1.0f - m(0, 0) + m(1, 1) - m(2, 2)),
+				   0.5f * sqrtf(1.0f - m(0, 0) - m(1, 1) + m(2, 2)));
+			e_R_d.normalize();
+			e_R_d = e_R_d * (2.0f * atan2f(e_R_d.length(), q0));
+			float direct_w = e_R_z_cos * e_R_z_cos * yaw_w;
+			e_R = e_R * (1.0f - direct_w) + e_R_d * direct_w;
+		}
+
+		rates_sp = att_p.emult(e_R);
+		rates_sp(2) += yaw_sp_move_rate * yaw_w * yaw_ff;
+	}
+
+	void control_attitude_rates(const Vec3 &rates, float thrust_sp, float dt) {
+		Vec3 rates_err = rates_sp - rates;
+		att_control = rate_p.emult(rates_err) + rate_d.emult(rates_prev - rates) / dt + rates_int;
+		rates_prev = rates;
+
+		if (thrust_sp > MIN_TAKEOFF_THRUST) {
+			for (int i = 0; i < 3; i++) {
+				if (fabsf(att_control(i)) < thrust_sp) {
+					float rate_i = rates_int(i) + this->rate_i(i) * rates_err(i) * dt;
+
+					if (isfinite(rate_i) && rate_i > -RATES_I_LIMIT && rate_i < RATES_I_LIMIT &&
+					    att_control(i) > -RATES_I_LIMIT && att_control(i) < RATES_I_LIMIT) {
+						rates_int(i) = rate_i;
+					}
+				}
+			}
+		}
+	}
+};
+
+/* rigid body with diagonal inertia, torque proportional to the control output */
+struct Body {
+	Mat3 R;
+	Vec3 omega;
+
+	void step(const float control[3], float dt) {
+		static const float torque_per_inertia[3] = { 60.0f, 60.0f, 25.0f };
+
+		for (int i = 0; i < 3; i++)
+			omega(i) += control[i] * torque_per_inertia[i] * dt;
+
+		/* R += R * [omega]x * dt, then re-orthonormalize the columns */
+		Mat3 W;
+		W(0, 1) = -omega(2) * dt; W(0, 2) = omega(1) * dt;
+		W(1, 0) = omega(2) * dt;  W(1, 2) = -omega(0) * dt;
+		W(2, 0) = -omega(1) * dt; W(2, 1) = omega(0) * dt;
+		R = R + R * W;
+
+		Vec3 x(R(0, 0), R(1, 0), R(2, 0)), y(R(0, 1), R(1, 1), R(2, 1));
+		x.normalize();
+		Vec3 z = x % y;
+		z.normalize();
+		y = z % x;
+
+		for (int i = 0; i < 3; i++) {
+			R(i, 0) = x(i); R(i, 1) = y(i); R(i, 2) = z(i);
+		}
+	}
+};
+
+static double now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int fails = 0;
+
+static const int steps = 1000;
+static Body trajectory[steps];
+
+/* step response from level to the given attitude, both controllers in their own loop */
+static void step_response(float roll, float pitch, float yaw)
+{
+	const float dt = 0.004f;
+	const float thrust = 0.5f;
+
+	struct mc_att_kernel_gains_s gains = {
+		{ 6.0f, 6.0f, 2.0f },
+		{ 0.1f, 0.1f, 0.3f },
+		{ 0.05f, 0.05f, 0.0f },
+		{ 0.002f, 0.002f, 0.0f },
+		0.5f
+	};
+	struct mc_att_kernel_state_s state;
+	mc_att_kernel_reset(&state);
+
+	Reference ref;
+	ref.att_p = Vec3(gains.att_p[0], gains.att_p[1], gains.att_p[2]);
+	ref.rate_p = Vec3(gains.rate_p[0], gains.rate_p[1], gains.rate_p[2]);
+	ref.rate_i = Vec3(gains.rate_i[0], gains.rate_i[1], gains.rate_i[2]);
+	ref.rate_d = Vec3(gains.rate_d[0], gains.rate_d[1], gains.rate_d[2]);
+	ref.yaw_ff = gains.yaw_ff;
+	ref.I.identity();
+
+	Mat3 R_sp;
+	R_sp.from_euler(roll, pitch, yaw);
+
+	Body body_ref, body_kernel;
+	body_ref.R.identity();
+	body_kernel.R.identity();
+
+	float max_diff = 0.0f;
+
+	for (int n = 0; n < steps; n++) {
+		float rates_sp[3], att_control[3];
+
+		trajectory[n] = body_kernel;
+
+		ref.control_attitude(body_ref.R, R_sp, 0.0f);
+		ref.control_attitude_rates(body_ref.omega, thrust, dt);
+		mc_att_kernel_attitude(body_kernel.R.data, R_sp.data, 0.0f, &gains, rates_sp);
+		mc_att_kernel_rates(&state, &gains, rates_sp, body_kernel.omega.v, thrust, dt, att_control);
+
+		for (int i = 0; i < 3; i++) {
+			float d = fabsf(ref.att_control(i) - att_control[i]);
+
+			if (!(d <= max_diff))
+				max_diff = isfinite(d) ? d : INFINITY;
+		}
+
+		body_ref.step(ref.att_control.v, dt);
+		body_kernel.step(att_control, dt);
+	}
+
+	/* time both controllers on the recorded trajectory */
+	const int reps = 50;
+	/* keeps the compiler from dropping the timed calls */
+	volatile float sink = 0.0f;
+	double t0 = now();
+
+	for (int r = 0; r < reps; r++) {
+		for (int n = 0; n < steps; n++) {
+			ref.control_attitude(trajectory[n].R, R_sp, 0.0f);
+			ref.control_attitude_rates(trajectory[n].omega, thrust, dt);
+			sink += ref.att_control(0);
+		}
+	}
+
+	double t1 = now();
+
+	for (int r = 0; r < reps; r++) {
+		for (int n = 0; n < steps; n++) {
+			float rates_sp[3], att_control[3];
+			mc_att_kernel_attitude(trajectory[n].R.data, R_sp.data, 0.0f, &gains, rates_sp);
+			mc_att_kernel_rates(&state, &gains, rates_sp, trajectory[n].omega.v, thrust, dt, att_control);
+			sink += att_control[0];
+		}
+	}
+
+	double t2 = now();
+	double ref_time = (t1 - t0) / (reps * steps);
+	double kernel_time = (t2 - t1) / (reps * steps);
+
+	/* attitude error left at the end of the step response */
+	Vec3 x_sp(R_sp(0, 0), R_sp(1, 0), R_sp(2, 0)), x(body_kernel.R(0, 0), body_kernel.R(1, 0), body_kernel.R(2, 0));
+	Vec3 z_sp(R_sp(0, 2), R_sp(1, 2), R_sp(2, 2)), z(body_kernel.R(0, 2), body_kernel.R(1, 2), body_kernel.R(2, 2));
+	float settled = acosf(fminf(1.0f, z * z_sp)) + acosf(fminf(1.0f, x * x_sp));
+
+	printf("step %5.2f %5.2f %5.2f: max control diff %.2e, final error %.4f rad, ref %6.1f ns, kernel %6.1f ns\n",
+	       (double)roll, (double)pitch, (double)yaw, (double)max_diff, (double)settled,
+	       ref_time * 1e9, kernel_time * 1e9);
+
+	if (max_diff > 1e-3f) {
+		printf("FAIL: kernel step response differs from the reference\n");
+		fails++;
+	}
+
+	if (settled > 0.05f) {
+		printf("FAIL: step response did not settle\n");
+		fails++;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	step_response(0.5f, -0.3f, 1.0f);
+	step_response(0.0f, 0.0f, 3.0f);
+	/* thrust vector rotation beyond 90 deg takes the direct rotation path */
+	step_response(2.5f, 0.2f, 0.0f);
+
+	printf("mc_att kernel test %s\n", fails ? "FAILED" : "PASSED");
+	return fails ? 1 : 0;
+}
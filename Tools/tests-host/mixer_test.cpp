@@ -8,6 +8,12 @@ int main(int argc, char *argv[]) {
 	char* args[] = {argv[0], "../../ROMFS/px4fmu_common/mixers/IO_pass.mix",
 				 "../../ROMFS/px4fmu_common/mixers/FMU_quad_w.mix"};
 
+	/* e.g. compiled mixers, see Tools/px_mixer_compile.py */
+	if (argc > 2) {
+		args[1] = argv[1];
+		args[2] = argv[2];
+	}
+
 	test_mixer(3, args);
 
 	test_conv(1, args);
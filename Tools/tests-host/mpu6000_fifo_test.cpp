@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <errno.h>
+#include <drivers/mpu6000/mpu6000_fifo.h>
+
+/*
+ * MPU6000 FIFO reader against a simulated device. The device pushes a
+ * sample every millisecond into a 1024 byte FIFO that, like the real one,
+ * drops its oldest bytes when full. The reader is polled like the driver
+ * does it from the hrt and must deliver every sample in order with one
+ * transfer per burst instead of one per sample, and must recognise an
+ * overflow before handing out misaligned data.
+ */
+
+#define SAMPLE_INTERVAL		1000	/* us */
+#define SIM_TIME		10000000
+
+static int fails = 0;
+
+static void check(const char *what, bool ok)
+{
+	if (!ok) {
+		printf("FAIL: %s\n", what);
+		fails++;
+	}
+}
+
+class SimulatedMPU6000
+{
+public:
+	SimulatedMPU6000() : _head(0), _size(0), _next(0), _transfers(0) {}
+
+	/* sample k as the device writes it: k in the first two words, the others derived from it */
+	static void sample_data(unsigned k, uint8_t *data)
+	{
+		uint16_t w[7] = { (uint16_t)k, (uint16_t)(k >> 16) };
+
+		for (unsigned j = 2; j < 7; j++) {
+			w[j] = (uint16_t)(w[0] * j + w[1] + 1);
+		}
+
+		for (unsigned j = 0; j < 7; j++) {
+			data[2 * j] = w[j] >> 8;
+			data[2 * j + 1] = w[j] & 0xff;
+		}
+	}
+
+	/* recover k from a sample, -1 if the words do not belong together */
+	static int sample_index(const uint8_t *data)
+	{
+		uint16_t w[7];
+
+		for (unsigned j = 0; j < 7; j++) {
+			w[j] = (data[2 * j] << 8) | data[2 * j + 1];
+		}
+
+		for (unsigned j = 2; j < 7; j++) {
+			if (w[j] != (uint16_t)(w[0] * j + w[1] + 1))
+				return -1;
+		}
+
+		return w[0] | (w[1] << 16);
+	}
+
+	/* produce all samples up to time t */
+	void advance(uint64_t t)
+	{
+		while ((uint64_t)_next * SAMPLE_INTERVAL <= t) {
+			uint8_t data[MPU6000_FIFO_SAMPLE_SIZE];
+			sample_data(_next++, data);
+
+			for (unsigned i = 0; i < sizeof(data); i++) {
+				if (_size == MPU6000_FIFO_SIZE) {
+					/* full, the oldest byte is lost */
+					_head = (_head + 1) % MPU6000_FIFO_SIZE;
+					_size--;
+				}
+
+				_fifo[(_head + _size) % MPU6000_FIFO_SIZE] = data[i];
+				_size++;
+			}
+		}
+	}
+
+	void reset_fifo() { _size = 0; }
+
+	int transfer(uint8_t *buf, unsigned len)
+	{
+		_transfers++;
+
+		if (buf[0] == (0x80 | MPUREG_FIFO_COUNTH) && len == 3) {
+			buf[1] = _size >> 8;
+			buf[2] = _size & 0xff;
+			return 0;
+		}
+
+		if (buf[0] == (0x80 | MPUREG_FIFO_R_W)) {
+			for (unsigned i = 1; i < len; i++) {
+				if (_size == 0) {
+					buf[i] = 0;
+					continue;
+				}
+
+				buf[i] = _fifo[_head];
+				_head = (_head + 1) % MPU6000_FIFO_SIZE;
+				_size--;
+			}
+
+			return 0;
+		}
+
+		return -EIO;
+	}
+
+	unsigned produced() const { return _next; }
+	unsigned transfers() const { return _transfers; }
+
+private:
+	uint8_t		_fifo[MPU6000_FIFO_SIZE];
+	unsigned	_head;
+	unsigned	_size;
+	unsigned	_next;
+	unsigned	_transfers;
+};
+
+struct Run {
+	Run() : now(0), last(-1), delivered(0), corrupt(0), out_of_order(0), gaps(0), max_stamp_error(0) {}
+
+	SimulatedMPU6000 dev;
+	uint64_t now;
+	int last;
+	unsigned delivered;
+	unsigned corrupt;
+	unsigned out_of_order;
+	unsigned gaps;
+	unsigned max_stamp_error;
+};
+
+static int run_transfer(void *arg, uint8_t *buf, unsigned len)
+{
+	return ((Run *)arg)->dev.transfer(buf, len);
+}
+
+static void run_sample(void *arg, const uint8_t *sample, unsigned index, unsigned count)
+{
+	Run *r = (Run *)arg;
+	int k = SimulatedMPU6000::sample_index(sample);
+
+	if (k < 0) {
+		r->corrupt++;
+		return;
+	}
+
+	if (k <= r->last) {
+		r->out_of_order++;
+
+	} else if (r->last >= 0 && k != r->last + 1) {
+		r->gaps++;
+	}
+
+	r->last = k;
+	r->delivered++;
+
+	/* the driver's timestamp against the true sample time */
+	uint64_t stamp = r->now - (uint64_t)(count - 1 - index) * SAMPLE_INTERVAL;
+	uint64_t truth = (uint64_t)k * SAMPLE_INTERVAL;
+	unsigned err = (stamp > truth) ? stamp - truth : truth - stamp;
+
+	if (err > r->max_stamp_error)
+		r->max_stamp_error = err;
+}
+
+/*
+ * @param poll_interval	hrt callout interval
+ * @param stall_at	time of a stall in the polling, or 0
+ * @param stall		length of the stall
+ */
+static void fifo_run(const char *name, unsigned poll_interval, uint64_t stall_at, unsigned stall)
+{
+	Run r;
+
+	MPU6000_FIFO fifo(&run_transfer, &run_sample, &r);
+	unsigned overflows = 0;
+
+	/* callouts are not aligned with the sensor clock */
+	for (r.now = poll_interval + 337; r.now < SIM_TIME; r.now += poll_interval) {
+		if (stall_at && r.now >= stall_at && r.now < stall_at + poll_interval)
+			r.now += stall;
+
+		r.dev.advance(r.now);
+
+		if (fifo.read() == -EOVERFLOW) {
+			/* what the driver does: reset and start over */
+			r.dev.reset_fifo();
+			overflows++;
+		}
+	}
+
+	printf("%-12s %5u samples delivered of %5u, %4u transfers (%.2f per sample), "
+	       "%u overflows, %u gaps, max stamp error %u us\n",
+	       name, r.delivered, r.dev.produced(), r.dev.transfers(),
+	       (double)r.dev.transfers() / r.delivered, overflows, r.gaps, r.max_stamp_error);
+
+	check("no misaligned sample is delivered", r.corrupt == 0);
+	check("samples are delivered in order", r.out_of_order == 0);
+	check("sample timestamps are within one interval", r.max_stamp_error <= SAMPLE_INTERVAL);
+	check("reader counts the samples it delivered", fifo.samples() == r.delivered);
+
+	if (stall == 0) {
+		check("no sample is lost", r.gaps == 0 && overflows == 0 && r.delivered + 1 >= r.dev.produced() - poll_interval / SAMPLE_INTERVAL);
+		/* count plus one burst per callout */
+		check("two transfers per callout",
+		      r.dev.transfers() <= 2 * (SIM_TIME / poll_interval) || poll_interval > MPU6000_FIFO_MAX_BURST * SAMPLE_INTERVAL);
+
+	} else {
+		check("the overflow is detected once", overflows == 1 && fifo.overflows() == 1);
+		check("sampling resumes after the reset", r.gaps == 1 && r.last + 20 > (int)r.dev.produced());
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	fifo_run("poll 250 Hz", 4000, 0, 0);
+	fifo_run("poll 100 Hz", 10000, 0, 0);
+	fifo_run("poll 50 Hz", 20000, 0, 0);
+	fifo_run("stall", 10000, 5000000, 100000);
+
+	printf("mpu6000 fifo test %s\n", fails ? "FAILED" : "PASSED");
+	return fails ? 1 : 0;
+}
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <systemlib/param/param_journal.h>
+
+/*
+ * The journal runs on a plain file of the size of the FRAM parameter
+ * partition, which stands in for the MTD character device.
+ */
+#define PARTITION_SIZE	4096
+
+static const char *partition_file = "param_journal_test.bin";
+
+static int fails = 0;
+
+#define CHECK(_cond) do { if (!(_cond)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #_cond); fails++; } } while (0)
+
+struct replay_state {
+	int count;
+	int resets;
+	float last_gain;
+	int32_t last_mode;
+};
+
+static void replay_cb(void *arg, const char *name, uint16_t type, const void *val, unsigned len)
+{
+	struct replay_state *state = (struct replay_state *)arg;
+
+	state->count++;
+
+	if (val == NULL) {
+		state->resets++;
+
+	} else if (!strcmp(name, "MC_ROLL_P") && len == sizeof(float)) {
+		memcpy(&state->last_gain, val, len);
+
+	} else if (!strcmp(name, "SYS_AUTOSTART") && len == sizeof(int32_t)) {
+		memcpy(&state->last_mode, val, len);
+	}
+}
+
+static int open_partition(bool erase)
+{
+	int fd = open(partition_file, O_RDWR | O_CREAT | (erase ? O_TRUNC : 0), 0666);
+
+	if (erase) {
+		/* erased EEPROM reads as 0xff */
+		uint8_t blank[PARTITION_SIZE];
+		memset(blank, 0xff, sizeof(blank));
+		write(fd, blank, sizeof(blank));
+	}
+
+	return fd;
+}
+
+static struct replay_state replay(int fd, struct param_journal_s *j)
+{
+	struct replay_state state = { 0, 0, 0.0f, 0 };
+
+	CHECK(param_journal_open(j, fd) == 0);
+	param_journal_replay(j, replay_cb, &state);
+	return state;
+}
+
+int main(int argc, char *argv[])
+{
+	struct param_journal_s j;
+	struct replay_state state;
+	float gain = 0.1f;
+	int32_t mode = 4001;
+
+	/* fresh partition holds no journal */
+	int fd = open_partition(true);
+	CHECK(param_journal_open(&j, fd) == -ENOENT);
+
+	/* initial compaction with two values */
+	param_journal_compact(&j);
+	CHECK(param_journal_append(&j, "MC_ROLL_P", 1, &gain, sizeof(gain)) == 0);
+	CHECK(param_journal_append(&j, "SYS_AUTOSTART", 0, &mode, sizeof(mode)) == 0);
+	CHECK(param_journal_commit(&j) == 0);
+	close(fd);
+
+	fd = open_partition(false);
+	state = replay(fd, &j);
+	CHECK(state.count == 2);
+	CHECK(state.last_gain == 0.1f);
+	CHECK(state.last_mode == 4001);
+
+	/* saving one tuned gain is a single small record */
+	off_t end = j.end;
+	gain = 0.2f;
+	CHECK(param_journal_append(&j, "MC_ROLL_P", 1, &gain, sizeof(gain)) == 0);
+	CHECK(j.end - end == (off_t)(sizeof(struct param_journal_record_s) + strlen("MC_ROLL_P") + sizeof(gain)));
+	CHECK(param_journal_append(&j, "MC_ROLL_D", 1, NULL, 0) == 0);
+	close(fd);
+
+	fd = open_partition(false);
+	state = replay(fd, &j);
+	CHECK(state.count == 4);
+	CHECK(state.resets == 1);
+	CHECK(state.last_gain == 0.2f);
+
+	/* fill the bank until the journal asks for a compaction */
+	int appended = 0;
+	float last_gain = gain;
+
+	while (param_journal_append(&j, "MC_ROLL_P", 1, &gain, sizeof(gain)) == 0) {
+		last_gain = gain;
+		gain += 0.01f;
+		appended++;
+	}
+
+	CHECK(appended > 50);
+	CHECK(param_journal_append(&j, "MC_ROLL_P", 1, &gain, sizeof(gain)) == -ENOSPC);
+	unsigned old_bank = j.bank;
+
+	/* an interrupted compaction leaves the previous bank active */
+	param_journal_compact(&j);
+	CHECK(param_journal_append(&j, "MC_ROLL_P", 1, &gain, sizeof(gain)) == 0);
+	close(fd);
+
+	fd = open_partition(false);
+	state = replay(fd, &j);
+	CHECK(j.bank == old_bank);
+	CHECK(state.last_gain == last_gain);
+
+	/* a completed compaction switches banks and drops stale records */
+	param_journal_compact(&j);
+	CHECK(param_journal_append(&j, "MC_ROLL_P", 1, &gain, sizeof(gain)) == 0);
+	CHECK(param_journal_append(&j, "SYS_AUTOSTART", 0, &mode, sizeof(mode)) == 0);
+	CHECK(param_journal_commit(&j) == 0);
+	close(fd);
+
+	fd = open_partition(false);
+	state = replay(fd, &j);
+	CHECK(j.bank != old_bank);
+	CHECK(state.count == 2);
+	CHECK(state.last_gain == gain);
+	CHECK(state.last_mode == 4001);
+
+	/* a torn record at the end is not replayed */
+	end = j.end;
+	gain = 1.5f;
+	CHECK(param_journal_append(&j, "MC_ROLL_P", 1, &gain, sizeof(gain)) == 0);
+	uint8_t garbage = 0x5a;
+	lseek(fd, j.bank * j.bank_size + j.end - 1, SEEK_SET);
+	write(fd, &garbage, 1);
+	close(fd);
+
+	fd = open_partition(false);
+	state = replay(fd, &j);
+	CHECK(state.count == 2);
+	CHECK(j.end == end);
+	CHECK(state.last_gain != 1.5f);
+	close(fd);
+
+	unlink(partition_file);
+
+	printf("param journal test %s\n", fails ? "FAILED" : "PASSED");
+	return fails ? 1 : 0;
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <drivers/device/sample_tracker.h>
+
+/*
+ * Simulated sensor with a drifting output clock, sampled once from its
+ * data-ready edges and once from a fixed rate timer like the hrt callouts.
+ * The data-ready path must neither lose nor duplicate a sample and must
+ * stamp each one with its edge; the tracker must account for every sample
+ * that is lost or read twice.
+ */
+
+#define NOMINAL_INTERVAL	1000	/* us */
+#define SIM_SAMPLES		60000
+
+static int fails = 0;
+
+static uint32_t rand_state = 1;
+
+static unsigned rand_range(unsigned lo, unsigned hi)
+{
+	rand_state = rand_state * 1103515245 + 12345;
+	return lo + (rand_state >> 8) % (hi - lo + 1);
+}
+
+/* true time of sample k: 0.5 % slow plus a 2 % swing over 20 seconds */
+static uint64_t sample_time(unsigned k)
+{
+	static uint64_t t = 0;
+	static unsigned last = 0;
+
+	if (k == 0) {
+		t = 1000000;
+		last = 0;
+	}
+
+	while (last < k) {
+		double drift = 0.005 + 0.02 * sin(2.0 * M_PI * (double)t / 20e6);
+		t += (uint64_t)(NOMINAL_INTERVAL * (1.0 + drift));
+		last++;
+	}
+
+	return t;
+}
+
+static void check(const char *what, bool ok)
+{
+	if (!ok) {
+		printf("FAIL: %s\n", what);
+		fails++;
+	}
+}
+
+/*
+ * Data-ready sampling: the interrupt fires after a short latency and starts a
+ * read unless the previous one is still on the bus, the read completes some
+ * time later and collects the sample for the edge that started it.
+ *
+ * @param busy_every	make every n-th read slower than the output interval
+ * @param drop_every	lose every n-th edge in the interrupt controller
+ * @param glitch_every	add a spurious edge after every n-th edge
+ */
+static void drdy_run(const char *name, unsigned busy_every, unsigned drop_every, unsigned glitch_every)
+{
+	device::SampleTracker tracker;
+	tracker.set_interval(NOMINAL_INTERVAL);
+
+	uint64_t read_done = 0;
+	uint32_t read_sequence = 0;
+	unsigned skipped = 0, dropped = 0, glitches = 0, glitch_reads = 0, collected = 0;
+	unsigned max_stamp_error = 0;
+
+	for (unsigned k = 0; k < SIM_SAMPLES; k++) {
+		uint64_t t = sample_time(k);
+		uint64_t edge = t + rand_range(5, 40);
+
+		if (drop_every && (k % drop_every) == drop_every - 1) {
+			dropped++;
+			continue;
+		}
+
+		for (unsigned e = 0; e < ((glitch_every && (k % glitch_every) == 0) ? 2 : 1); e++) {
+			uint64_t now = edge + e * 100;
+			uint32_t sequence = tracker.edge(now);
+
+			if (e > 0)
+				glitches++;
+
+			/* previous read still in flight, the sample is lost */
+			if (read_sequence != 0 && read_done > now) {
+				if (e == 0)
+					skipped++;
+
+				continue;
+			}
+
+			/* finish the previous read before starting this one */
+			if (read_sequence != 0)
+				tracker.collect(read_sequence);
+
+			unsigned read_time = (busy_every && (k % busy_every) == 0) ? 1800 : rand_range(100, 500);
+			read_done = now + read_time;
+			read_sequence = sequence;
+			collected++;
+
+			if (e > 0)
+				glitch_reads++;
+
+			unsigned stamp_error = now - t;
+
+			if (e == 0 && stamp_error > max_stamp_error)
+				max_stamp_error = stamp_error;
+		}
+	}
+
+	tracker.collect(read_sequence);
+
+	printf("%-14s samples %5u lost %4u (skipped %4u dropped %4u) duplicates %3u (glitches %3u read %3u) "
+	       "interval %u us, max stamp error %u us\n",
+	       name, (unsigned)tracker.samples(), (unsigned)tracker.lost(), skipped, dropped,
+	       (unsigned)tracker.duplicates(), glitches, glitch_reads, tracker.interval(), max_stamp_error);
+
+	check("every read is collected", tracker.samples() + tracker.duplicates() == collected);
+	check("lost samples are accounted for", tracker.lost() == skipped + dropped);
+	check("duplicate reads are accounted for", tracker.duplicates() == glitch_reads);
+	check("spurious edges are recognised", tracker.spurious() == glitches);
+	check("samples are stamped at their edge", max_stamp_error <= 40);
+	check("interval follows the sensor clock",
+	      tracker.interval() > NOMINAL_INTERVAL * 0.97 && tracker.interval() < NOMINAL_INTERVAL * 1.03);
+}
+
+/*
+ * Timer sampling at the nominal rate: each callout reads whatever sample the
+ * sensor has last produced, which beats against the drifting output clock.
+ */
+static void timer_run()
+{
+	device::SampleTracker tracker;
+	tracker.set_interval(NOMINAL_INTERVAL);
+
+	unsigned k = 0;
+	sample_time(0);
+
+	for (uint64_t now = 1000000 + NOMINAL_INTERVAL; k + 1 < SIM_SAMPLES; now += NOMINAL_INTERVAL) {
+		while (k + 1 < SIM_SAMPLES && sample_time(k + 1) <= now)
+			k++;
+
+		tracker.collect(k + 1);
+	}
+
+	printf("%-14s samples %5u lost %4u duplicates %3u\n", "timer",
+	       (unsigned)tracker.samples(), (unsigned)tracker.lost(), (unsigned)tracker.duplicates());
+
+	check("timer sampling aliases against the sensor clock",
+	      tracker.lost() > 0 && tracker.duplicates() > 0 && tracker.samples() + tracker.lost() == SIM_SAMPLES);
+}
+
+int main(int argc, char *argv[])
+{
+	drdy_run("drdy", 0, 0, 0);
+	drdy_run("drdy busy", 97, 0, 0);
+	drdy_run("drdy dropped", 0, 89, 0);
+	drdy_run("drdy glitch", 0, 0, 101);
+	drdy_run("drdy all", 97, 89, 101);
+
+	timer_run();
+
+	printf("sample tracker test %s\n", fails ? "FAILED" : "PASSED");
+	return fails ? 1 : 0;
+}
@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <modules/sensors/sensor_failover.h>
+
+/*
+ * Gyro / accel failover as the sensors app runs it: three instances, each
+ * with the time of its last publication. The selected instance has to move
+ * to a calibrated one that is still publishing once it falls silent, and
+ * never to an uncalibrated or silent one.
+ */
+
+static int fails = 0;
+
+static void check(const char *what, bool ok)
+{
+	if (!ok) {
+		printf("FAIL: %s\n", what);
+		fails++;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	uint64_t last[SENSOR_COUNT_MAX] = { 0, 0, 0 };
+	uint64_t now = 1000000;
+
+	/* startup, nothing published yet */
+	check("stay before the first publication", sensor_failover_select(last, 0, 0x7, now) == 0);
+
+	/* all instances publishing at 1 kHz */
+	last[0] = now - 1000;
+	last[1] = now - 500;
+	last[2] = now - 800;
+	check("stay while publishing", sensor_failover_select(last, 0, 0x7, now) == 0);
+	check("stay just inside the timeout",
+	      sensor_failover_select(last, 0, 0x7, last[0] + SENSOR_FAILOVER_TIMEOUT - 1) == 0);
+
+	/* instance 0 falls silent, 1 and 2 keep going */
+	now += SENSOR_FAILOVER_TIMEOUT;
+	last[1] = now - 500;
+	last[2] = now - 800;
+	check("switch to instance 1", sensor_failover_select(last, 0, 0x7, now) == 1);
+
+	/* only calibrated instances take over */
+	check("no switch without calibration", sensor_failover_select(last, 0, 1 << 0, now) == 0);
+	check("uncalibrated instance 1 skipped", sensor_failover_select(last, 0, (1 << 0) | (1 << 2), now) == 2);
+
+	/* a silent instance is never picked over a newer one */
+	last[1] = last[0] - 1000;
+	last[2] = last[0] - 2000;
+	check("stay when the others are older", sensor_failover_select(last, 0, 0x7, now) == 0);
+
+	/* and back once instance 1 dies and 0 is the newest again */
+	last[0] = now - 100;
+	last[1] = now - SENSOR_FAILOVER_TIMEOUT;
+	check("switch back to instance 0", sensor_failover_select(last, 1, 0x7, now) == 0);
+
+	printf("sensor failover test %s\n", fails ? "FAILED" : "PASSED");
+	return fails ? 1 : 0;
+}
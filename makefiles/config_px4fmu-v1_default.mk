@@ -56,6 +56,8 @@ MODULES		+= systemcmds/tests
 MODULES		+= systemcmds/config
 MODULES		+= systemcmds/nshterm
 MODULES		+= systemcmds/hw_ver
+MODULES		+= systemcmds/boottrace
+MODULES		+= systemcmds/schedtrace
 MODULES		+= systemcmds/dumpfile
 
 #
@@ -113,6 +115,7 @@ MODULES		+= lib/mathlib/math/filter
 MODULES		+= lib/ecl
 MODULES		+= lib/external_lgpl
 MODULES		+= lib/geo
+MODULES		+= lib/telemetry
 MODULES		+= lib/conversion
 MODULES		+= lib/launchdetection
 
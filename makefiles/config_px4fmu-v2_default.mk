@@ -64,6 +64,8 @@ MODULES		+= systemcmds/config
 MODULES		+= systemcmds/nshterm
 MODULES		+= systemcmds/mtd
 MODULES		+= systemcmds/hw_ver
+MODULES		+= systemcmds/boottrace
+MODULES		+= systemcmds/schedtrace
 MODULES		+= systemcmds/dumpfile
 
 #
@@ -121,6 +123,7 @@ MODULES		+= lib/mathlib/math/filter
 MODULES		+= lib/ecl
 MODULES		+= lib/external_lgpl
 MODULES		+= lib/geo
+MODULES		+= lib/telemetry
 MODULES		+= lib/conversion
 MODULES		+= lib/launchdetection
 
@@ -358,6 +358,9 @@ LINK_DEPS		+= $(ROMFS_OBJ)
 # Remove all comments from startup and mixer files
 ROMFS_PRUNER	 = $(PX4_BASE)/Tools/px_romfs_pruner.py
 
+# Compile the pruned mixer files to binary records
+MIXER_COMPILER	 = $(PX4_BASE)/Tools/px_mixer_compile.py
+
 # Turn the ROMFS image into an object file
 $(ROMFS_OBJ): $(ROMFS_IMG) $(GLOBAL_DEPS)
 	$(call BIN_TO_OBJ,$<,$@,romfs_img)
@@ -376,6 +379,7 @@ ifneq ($(ROMFS_EXTRA_FILES),)
 	$(Q) $(COPY) $(ROMFS_EXTRA_FILES) $(ROMFS_SCRATCH)/extras
 endif
 	$(Q) $(PYTHON) -u $(ROMFS_PRUNER) --folder $(ROMFS_SCRATCH)
+	$(Q) $(PYTHON) -u $(MIXER_COMPILER) --folder $(ROMFS_SCRATCH)
 
 EXTRA_CLEANS		+= $(ROMGS_OBJ) $(ROMFS_IMG)
 
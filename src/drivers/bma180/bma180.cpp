@@ -153,6 +153,7 @@ private:
 	float			_accel_range_scale;
 	float			_accel_range_m_s2;
 	orb_advert_t		_accel_topic;
+	int			_orb_class_instance;
 	int			_class_instance;
 
 	unsigned		_current_lowpass;
@@ -239,6 +240,7 @@ BMA180::BMA180(int bus, spi_dev_e device) :
 	_accel_range_scale(0.0f),
 	_accel_range_m_s2(0.0f),
 	_accel_topic(-1),
+	_orb_class_instance(-1),
 	_class_instance(-1),
 	_current_lowpass(0),
 	_current_range(0),
@@ -324,13 +326,11 @@ BMA180::init()
 	/* advertise sensor topic, measure manually to initialize valid report */
 	measure();
 
-	if (_class_instance == CLASS_DEVICE_PRIMARY) {
-		struct accel_report arp;
-		_reports->get(&arp);
+	struct accel_report arp;
+	_reports->get(&arp);
 
-		/* measurement will have generated a report, publish */
-		_accel_topic = orb_advertise(ORB_ID(sensor_accel), &arp);
-	}
+	/* measurement will have generated a report, publish */
+	_accel_topic = orb_advertise_multi(ORB_ID(sensor_accel), &arp, &_orb_class_instance);
 
 out:
 	return ret;
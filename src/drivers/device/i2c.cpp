@@ -201,4 +201,22 @@ I2C::transfer(i2c_msg_s *msgv, unsigned msgs)
 	return ret;
 }
 
-} // namespace device
\ No newline at end of file
+int
+I2C::transfer_batch(i2c_msg_s *msgv, unsigned msgs)
+{
+	int ret;
+
+	if (msgs == 0)
+		return -EINVAL;
+
+	I2C_SETFREQUENCY(_dev, _frequency);
+	ret = I2C_TRANSFER(_dev, msgv, msgs);
+
+	/* leave the bus in a sane state for the caller's fallback */
+	if (ret != OK)
+		up_i2creset(_dev);
+
+	return ret;
+}
+
+} // namespace device
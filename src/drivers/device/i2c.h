@@ -122,6 +122,21 @@ protected:
 	 */
 	int		transfer(i2c_msg_s *msgv, unsigned msgs);
 
+	/**
+	 * Perform a batched I2C transaction to one or more devices.
+	 *
+	 * Unlike transfer(), the addresses in the message vector are used as
+	 * given, so messages to several devices on the bus go out back-to-back,
+	 * separated by repeated starts, in a single bus transaction. The whole
+	 * batch fails if any device does not respond; it is not retried.
+	 *
+	 * @param msgv		An I2C message vector with addresses set.
+	 * @param msgs		The number of entries in the message vector.
+	 * @return		OK if the transfer was successful, -errno
+	 *			otherwise.
+	 */
+	int		transfer_batch(i2c_msg_s *msgv, unsigned msgs);
+
 	/**
 	 * Change the bus address.
 	 *
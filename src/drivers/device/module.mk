@@ -39,4 +39,6 @@ SRCS		= cdev.cpp \
 		  device.cpp \
 		  i2c.cpp \
 		  pio.cpp \
-		  spi.cpp
+		  spi.cpp \
+		  spi_bus.cpp \
+		  sample_tracker.cpp
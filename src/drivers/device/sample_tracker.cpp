@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file sample_tracker.cpp
+ *
+ * Continuity checking for samples triggered by a sensor data-ready line.
+ */
+
+#include "sample_tracker.h"
+
+namespace device
+{
+
+SampleTracker::SampleTracker() :
+	_interval(0)
+{
+	reset();
+}
+
+void
+SampleTracker::set_interval(unsigned interval)
+{
+	_interval = interval << INTERVAL_SHIFT;
+	reset();
+}
+
+void
+SampleTracker::reset()
+{
+	_last_edge = 0;
+	_sequence = 0;
+	_collected = 0;
+	_samples = 0;
+	_lost = 0;
+	_duplicates = 0;
+	_spurious = 0;
+}
+
+uint32_t
+SampleTracker::edge(uint64_t timestamp)
+{
+	unsigned interval = _interval >> INTERVAL_SHIFT;
+
+	if ((_last_edge != 0) && (interval != 0)) {
+		uint32_t dt = timestamp - _last_edge;
+
+		if (dt < interval / 2) {
+			/* glitch on the line, there is no new sample behind it */
+			_spurious++;
+			return (_sequence != 0) ? _sequence : 1;
+		}
+
+		if (dt > interval + interval / 2) {
+			/* the interrupt missed edges, account for the samples behind them */
+			_sequence += (dt + interval / 2) / interval - 1;
+
+		} else {
+			/* follow the sensor clock */
+			_interval += ((int32_t)(dt << INTERVAL_SHIFT) - (int32_t)_interval) >> INTERVAL_SHIFT;
+		}
+	}
+
+	_last_edge = timestamp;
+
+	/* zero marks an untracked sample */
+	if (++_sequence == 0)
+		_sequence = 1;
+
+	return _sequence;
+}
+
+int
+SampleTracker::collect(uint32_t sequence)
+{
+	int32_t gap = sequence - _collected;
+
+	if ((_collected != 0) && (gap <= 0)) {
+		_duplicates++;
+		return -1;
+	}
+
+	_samples++;
+
+	/* the first sample after a reset has nothing to compare with */
+	int lost = (_collected != 0) ? gap - 1 : 0;
+
+	_collected = sequence;
+	_lost += lost;
+
+	return lost;
+}
+
+} // namespace device
@@ -0,0 +1,122 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file sample_tracker.h
+ *
+ * Continuity checking for samples triggered by a sensor data-ready line.
+ */
+
+#ifndef _DEVICE_SAMPLE_TRACKER_H
+#define _DEVICE_SAMPLE_TRACKER_H
+
+#include <stdint.h>
+
+namespace device __EXPORT
+{
+
+/**
+ * Tracks the data-ready edges of a sensor and the samples collected for them.
+ *
+ * Every edge is given a sequence number. Edges the interrupt did not see are
+ * inferred from the time since the previous edge, measured against an
+ * estimate of the sensor's output interval that follows the drift of the
+ * sensor clock. When a sample is collected its sequence number is checked
+ * against the previous one, so samples dropped because the bus was still
+ * busy and samples read twice both show up in the counters.
+ *
+ * edge() is safe to call from interrupt context; collect() may run on a
+ * different context as long as calls to it are not concurrent.
+ */
+class __EXPORT SampleTracker
+{
+public:
+	SampleTracker();
+
+	/**
+	 * Set the nominal output interval of the sensor and restart tracking.
+	 *
+	 * @param interval	Output interval in microseconds.
+	 */
+	void			set_interval(unsigned interval);
+
+	/**
+	 * Restart tracking, keeping the interval estimate.
+	 */
+	void			reset();
+
+	/**
+	 * Record a data-ready edge.
+	 *
+	 * @param timestamp	Time of the edge.
+	 * @return		Sequence number of the sample; never zero.
+	 */
+	uint32_t		edge(uint64_t timestamp);
+
+	/**
+	 * Check a collected sample against the previous one.
+	 *
+	 * @param sequence	Sequence number returned by edge() for the sample.
+	 * @return		Number of samples lost since the previous one, or
+	 *			-1 if the sample was already collected.
+	 */
+	int			collect(uint32_t sequence);
+
+	/**
+	 * @return		Estimated output interval in microseconds.
+	 */
+	unsigned		interval() const { return _interval >> INTERVAL_SHIFT; }
+
+	uint32_t		samples() const { return _samples; }
+	uint32_t		lost() const { return _lost; }
+	uint32_t		duplicates() const { return _duplicates; }
+	uint32_t		spurious() const { return _spurious; }
+
+private:
+	/** fixed point fraction bits of the interval estimate, also the filter gain */
+	static const unsigned	INTERVAL_SHIFT = 4;
+
+	uint32_t		_interval;	/**< estimated interval, fixed point */
+	uint64_t		_last_edge;
+	uint32_t		_sequence;	/**< sequence number of the last edge */
+	uint32_t		_collected;	/**< sequence number of the last collected sample */
+
+	uint32_t		_samples;
+	uint32_t		_lost;
+	uint32_t		_duplicates;
+	uint32_t		_spurious;	/**< edges too close to the previous one */
+};
+
+} // namespace device
+
+#endif /* _DEVICE_SAMPLE_TRACKER_H */
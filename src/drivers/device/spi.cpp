@@ -48,6 +48,7 @@
 #include <nuttx/arch.h>
 
 #include "spi.h"
+#include "spi_bus.h"
 
 #ifndef CONFIG_SPI_EXCHANGE
 # error This driver requires CONFIG_SPI_EXCHANGE
@@ -73,7 +74,8 @@ SPI::SPI(const char *name,
 	_device(device),
 	_mode(mode),
 	_frequency(frequency),
-	_dev(nullptr)
+	_dev(nullptr),
+	_priority(SPIBus::PRIORITY_NORMAL)
 {
 }
 
@@ -138,6 +140,24 @@ SPI::transfer(uint8_t *send, uint8_t *recv, unsigned len)
 	if ((send == nullptr) && (recv == nullptr))
 		return -EINVAL;
 
+	/* once the bus is scheduled, everything goes through the worker */
+	SPIBus *bus = SPIBus::instance(_bus);
+
+	if (bus != nullptr) {
+		if (up_interrupt_context())
+			return -EBUSY;
+
+		SPITransaction t;
+		t.send = send;
+		t.recv = recv;
+		t.len = len;
+		t.owner = this;
+		t.frequency = _frequency;
+		t.priority = _priority;
+
+		return bus->transfer(&t);
+	}
+
 	/* lock the bus as required */
 	if (!up_interrupt_context()) {
 		switch (locking_mode) {
@@ -181,6 +201,38 @@ SPI::transfer(uint8_t *send, uint8_t *recv, unsigned len)
 	return OK;
 }
 
+int
+SPI::transfer_async(SPITransaction *t)
+{
+	SPIBus *bus = SPIBus::instance(_bus);
+
+	if (bus == nullptr)
+		return -ENODEV;
+
+	if ((t->send == nullptr) && (t->recv == nullptr))
+		return -EINVAL;
+
+	t->owner = this;
+	t->frequency = _frequency;
+	t->priority = _priority;
+
+	return bus->submit(t);
+}
+
+int
+SPI::enable_async(uint8_t priority)
+{
+	if (_dev == nullptr)
+		return -ENODEV;
+
+	_priority = priority;
+
+	if (SPIBus::get(_bus, _dev) == nullptr)
+		return -ENOMEM;
+
+	return OK;
+}
+
 void 
 SPI::set_frequency(uint32_t frequency)
 {
@@ -47,6 +47,32 @@
 namespace device __EXPORT
 {
 
+class SPI;
+class SPIBus;
+
+/**
+ * Asynchronous SPI transaction.
+ *
+ * The descriptor and its buffers belong to the client and must remain valid
+ * until the callback has run; zero it before first use. The callback runs on
+ * the bus worker thread after the device has been deselected; it may queue
+ * the transaction again.
+ */
+struct SPITransaction {
+	uint8_t		*send;		/**< bytes to send, or nullptr */
+	uint8_t		*recv;		/**< buffer for received bytes, or nullptr */
+	unsigned	len;		/**< number of bytes to transfer */
+	void		(*callback)(void *arg, int result);	/**< completion, result is OK or -errno */
+	void		*arg;		/**< passed to the callback */
+
+	/* managed by the bus */
+	SPI		*owner;
+	uint32_t	frequency;
+	uint8_t		priority;
+	volatile bool	pending;
+	SPITransaction	*next;
+};
+
 /**
  * Abstract class for character device on SPI
  */
@@ -91,6 +117,12 @@ protected:
 	 *
 	 * At least one of send or recv must be non-null.
 	 *
+	 * Once the bus has a transaction scheduler (see enable_async()),
+	 * transfers from thread context of every device on the bus are queued
+	 * to it and this call blocks until the transfer is complete; transfers
+	 * from interrupt context are refused with -EBUSY, as they could
+	 * interrupt a transfer in progress.
+	 *
 	 * @param send		Bytes to send to the device, or nullptr if
 	 *			no data is to be sent.
 	 * @param recv		Buffer for receiving bytes from the device,
@@ -101,6 +133,37 @@ protected:
 	 */
 	int		transfer(uint8_t *send, uint8_t *recv, unsigned len);
 
+	/**
+	 * Queue an asynchronous SPI transfer.
+	 *
+	 * May be called from interrupt context, e.g. from a hrt callout. The
+	 * transfer is performed by the bus worker thread with interrupts
+	 * enabled (and by DMA if the board enables it), then the callback of
+	 * the transaction is invoked. The bus frequency at the time of the
+	 * call is used for the transfer.
+	 *
+	 * @param t		The transaction, with send, recv, len, callback
+	 *			and arg set.
+	 * @return		OK if the transaction was queued, -EBUSY if it
+	 *			is still pending, -ENODEV if the bus has no
+	 *			transaction scheduler.
+	 */
+	int		transfer_async(SPITransaction *t);
+
+	/**
+	 * Attach the device to the transaction scheduler of its bus,
+	 * starting the scheduler if this is the first device to use it.
+	 *
+	 * Must be called from thread context after init(). Pending
+	 * transactions are served highest priority first, in order of
+	 * submission within the same priority.
+	 *
+	 * @param priority	Scheduling priority of this device's transfers,
+	 *			see SPIBus::Priority.
+	 * @return		OK if the scheduler is running, -errno otherwise.
+	 */
+	int		enable_async(uint8_t priority);
+
 	/**
 	 * Set the SPI bus frequency
 	 * This is used to change frequency on the fly. Some sensors
@@ -124,11 +187,14 @@ protected:
 	LockMode	locking_mode;	/**< selected locking mode */
 
 private:
+	friend class SPIBus;
+
 	int			_bus;
 	enum spi_dev_e		_device;
 	enum spi_mode_e		_mode;
 	uint32_t		_frequency;
 	struct spi_dev_s	*_dev;
+	uint8_t			_priority;
 };
 
 } // namespace device
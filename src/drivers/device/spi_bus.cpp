@@ -0,0 +1,430 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file spi_bus.cpp
+ *
+ * Scheduler for asynchronous transfers on a SPI bus.
+ *
+ * The NuttX SPI driver only offers a blocking exchange, which with
+ * CONFIG_STM32_SPI_DMA sleeps on the DMA completion. Transfers are therefore
+ * performed on a worker task per bus; clients polled from hrt callouts only
+ * queue a descriptor and get their data in the completion callback.
+ */
+
+#include <nuttx/config.h>
+#include <nuttx/arch.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <systemlib/systemlib.h>
+
+#include "spi_bus.h"
+
+/* above the sensor consumers, so samples are on their way right after the transfer */
+#define SPI_BUS_WORKER_PRIORITY		(SCHED_PRIORITY_MAX - 2)
+#define SPI_BUS_WORKER_STACK		2048
+
+/* a transfer() still not done after this is given up, in milliseconds */
+#define SPI_BUS_TRANSFER_TIMEOUT	100
+
+namespace device
+{
+
+SPIBus *SPIBus::_buses[SPIBus::_max_buses];
+
+SPIBus::SPIBus(int bus, struct spi_dev_s *dev) :
+	_bus(bus),
+	_dev(dev),
+	_queue(nullptr),
+	_task(-1),
+	_running(false),
+	_should_exit(false),
+	_perf_exchange(nullptr),
+	_perf_busy(nullptr)
+{
+	sem_init(&_work, 0, 0);
+	snprintf(_name, sizeof(_name), "spi%d", bus);
+	snprintf(_name_busy, sizeof(_name_busy), "spi%d busy", bus);
+}
+
+SPIBus::~SPIBus()
+{
+	stop();
+
+	perf_free(_perf_exchange);
+	perf_free(_perf_busy);
+	sem_destroy(&_work);
+}
+
+SPIBus *
+SPIBus::get(int bus, struct spi_dev_s *dev)
+{
+	if (bus < 0 || (unsigned)bus >= _max_buses)
+		return nullptr;
+
+	/* drivers are started one after the other, but be safe */
+	sched_lock();
+
+	if (_buses[bus] == nullptr) {
+		SPIBus *b = new SPIBus(bus, dev);
+
+		if (b != nullptr && b->start() != OK) {
+			delete b;
+			b = nullptr;
+		}
+
+		_buses[bus] = b;
+	}
+
+	sched_unlock();
+
+	return _buses[bus];
+}
+
+SPIBus *
+SPIBus::instance(int bus)
+{
+	if (bus < 0 || (unsigned)bus >= _max_buses)
+		return nullptr;
+
+	return _buses[bus];
+}
+
+int
+SPIBus::start()
+{
+	if (_running)
+		return OK;
+
+	if (_perf_exchange == nullptr) {
+		_perf_exchange = perf_alloc(PC_ELAPSED, _name);
+		_perf_busy = perf_alloc(PC_COUNT, _name_busy);
+	}
+
+	/* the worker finds its bus through the argument */
+	char name[16];
+	char arg[16];
+	const char *argv[] = { arg, nullptr };
+
+	snprintf(name, sizeof(name), "spi%d_bus", _bus);
+	snprintf(arg, sizeof(arg), "%lx", (unsigned long)this);
+
+	_should_exit = false;
+	_running = true;
+
+	_task = task_spawn_cmd(name,
+			       SCHED_DEFAULT,
+			       SPI_BUS_WORKER_PRIORITY,
+			       SPI_BUS_WORKER_STACK,
+			       (main_t)&SPIBus::worker_trampoline,
+			       (char * const *)argv);
+
+	if (_task < 0) {
+		_task = -1;
+		_running = false;
+		return -errno;
+	}
+
+	return OK;
+}
+
+void
+SPIBus::stop()
+{
+	if (!_running)
+		return;
+
+	_should_exit = true;
+	sem_post(&_work);
+
+	/* the worker exits after the transaction in progress */
+	unsigned i = 10;
+
+	do {
+		usleep(10000);
+
+		/* if we have given up, kill it */
+		if (--i == 0) {
+			task_delete(_task);
+			_task = -1;
+			break;
+		}
+
+	} while (_task != -1);
+
+	_running = false;
+
+	/* drop whatever is left */
+	irqstate_t flags = irqsave();
+
+	while (_queue != nullptr) {
+		_queue->pending = false;
+		_queue = _queue->next;
+	}
+
+	irqrestore(flags);
+}
+
+int
+SPIBus::submit(SPITransaction *t)
+{
+	irqstate_t flags = irqsave();
+
+	if (t->pending) {
+		irqrestore(flags);
+		perf_count(_perf_busy);
+		return -EBUSY;
+	}
+
+	t->pending = true;
+	t->next = nullptr;
+
+	/* append, so equal priorities are served in order of submission */
+	SPITransaction **tail = &_queue;
+
+	while (*tail != nullptr)
+		tail = &(*tail)->next;
+
+	*tail = t;
+
+	irqrestore(flags);
+
+	sem_post(&_work);
+
+	return OK;
+}
+
+namespace
+{
+
+/* state of a blocking transfer() */
+struct transfer_wait {
+	sem_t	done;
+	int	result;
+};
+
+}
+
+void
+SPIBus::transfer_done(void *arg, int result)
+{
+	struct transfer_wait *w = (struct transfer_wait *)arg;
+
+	w->result = result;
+	sem_post(&w->done);
+}
+
+int
+SPIBus::transfer(SPITransaction *t)
+{
+	/* from a completion callback the bus is ours already */
+	if (_running && getpid() == _task)
+		return exchange(t);
+
+	struct transfer_wait w;
+
+	sem_init(&w.done, 0, 0);
+	w.result = -EIO;
+
+	t->callback = transfer_done;
+	t->arg = &w;
+	t->pending = false;
+
+	int ret = submit(t);
+
+	if (ret == OK) {
+		struct timespec abstime;
+		clock_gettime(CLOCK_REALTIME, &abstime);
+		abstime.tv_nsec += SPI_BUS_TRANSFER_TIMEOUT * 1000 * 1000;
+
+		if (abstime.tv_nsec >= 1000 * 1000 * 1000) {
+			abstime.tv_sec++;
+			abstime.tv_nsec -= 1000 * 1000 * 1000;
+		}
+
+		/* retry if interrupted by a signal */
+		while ((ret = sem_timedwait(&w.done, &abstime)) != 0 && errno == EINTR)
+			;
+
+		if (ret == OK) {
+			ret = w.result;
+
+		} else if (abandon(t)) {
+			ret = -ETIMEDOUT;
+
+		} else {
+			/*
+			 * The worker has taken it and writes to t and its buffers until
+			 * the callback; both live in our caller's frame, so wait for it.
+			 */
+			while (sem_wait(&w.done) != 0)
+				;
+
+			ret = w.result;
+		}
+	}
+
+	sem_destroy(&w.done);
+
+	return ret;
+}
+
+bool
+SPIBus::abandon(SPITransaction *t)
+{
+	bool removed = false;
+	irqstate_t flags = irqsave();
+
+	for (SPITransaction **p = &_queue; *p != nullptr; p = &(*p)->next) {
+		if (*p == t) {
+			*p = t->next;
+			t->next = nullptr;
+			t->pending = false;
+			removed = true;
+			break;
+		}
+	}
+
+	irqrestore(flags);
+
+	return removed;
+}
+
+SPITransaction *
+SPIBus::dequeue()
+{
+	irqstate_t flags = irqsave();
+
+	SPITransaction **best = nullptr;
+
+	for (SPITransaction **p = &_queue; *p != nullptr; p = &(*p)->next) {
+		if (best == nullptr || (*p)->priority > (*best)->priority)
+			best = p;
+	}
+
+	SPITransaction *t = nullptr;
+
+	if (best != nullptr) {
+		t = *best;
+		*best = t->next;
+		t->next = nullptr;
+	}
+
+	irqrestore(flags);
+
+	return t;
+}
+
+int
+SPIBus::exchange(SPITransaction *t)
+{
+	SPI *owner = t->owner;
+
+	if (_dev == nullptr || owner == nullptr)
+		return -ENODEV;
+
+	int ret = SPI_LOCK(_dev, true);
+
+	if (ret != OK)
+		return ret;
+
+	SPI_SETFREQUENCY(_dev, t->frequency);
+	SPI_SETMODE(_dev, owner->_mode);
+	SPI_SETBITS(_dev, 8);
+	SPI_SELECT(_dev, owner->_device, true);
+
+	SPI_EXCHANGE(_dev, t->send, t->recv, t->len);
+
+	SPI_SELECT(_dev, owner->_device, false);
+
+	SPI_LOCK(_dev, false);
+
+	return OK;
+}
+
+int
+SPIBus::worker_trampoline(int argc, char *argv[])
+{
+	if (argc < 2)
+		return 1;
+
+	SPIBus *bus = reinterpret_cast<SPIBus *>(strtoul(argv[1], nullptr, 16));
+
+	bus->worker();
+
+	bus->_task = -1;
+
+	return 0;
+}
+
+void
+SPIBus::worker()
+{
+	while (!_should_exit) {
+
+		/* one post per queued transaction, plus one to exit */
+		if (sem_wait(&_work) != 0)
+			continue;
+
+		SPITransaction *t = dequeue();
+
+		if (t == nullptr)
+			continue;
+
+		perf_begin(_perf_exchange);
+		int ret = exchange(t);
+		perf_end(_perf_exchange);
+
+		/* the callback may queue it again */
+		t->pending = false;
+
+		if (t->callback != nullptr)
+			t->callback(t->arg, ret);
+	}
+}
+
+void
+SPIBus::print_info()
+{
+	perf_print_counter(_perf_exchange);
+	perf_print_counter(_perf_busy);
+}
+
+} // namespace device
@@ -0,0 +1,186 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file spi_bus.h
+ *
+ * Scheduler for asynchronous transfers on a SPI bus.
+ */
+
+#ifndef _DEVICE_SPI_BUS_H
+#define _DEVICE_SPI_BUS_H
+
+#include <semaphore.h>
+
+#include <systemlib/perf_counter.h>
+
+#include "spi.h"
+
+namespace device __EXPORT
+{
+
+/**
+ * Per-bus transaction scheduler.
+ *
+ * Transactions are queued from any context and performed one at a time by
+ * a worker task owned by the bus, which holds the bus with SPI_LOCK rather than disabling
+ * interrupts. Completion callbacks run on the worker thread.
+ */
+class __EXPORT SPIBus
+{
+public:
+	/**
+	 * Transfer priorities of the devices sharing a bus, highest first.
+	 */
+	enum Priority {
+		PRIORITY_HIGHEST = 3,	/**< primary IMU, e.g. MPU6000 */
+		PRIORITY_HIGH = 2,	/**< secondary gyro, e.g. L3GD20 */
+		PRIORITY_NORMAL = 1,	/**< accel/mag, e.g. LSM303D */
+		PRIORITY_LOW = 0	/**< slow sensors polled from the work queue, e.g. MS5611 */
+	};
+
+	/**
+	 * Constructor
+	 *
+	 * @param bus		Bus number, used for naming only
+	 * @param dev		NuttX bus handle, or nullptr for a bus that
+	 *			overrides exchange()
+	 */
+	SPIBus(int bus, struct spi_dev_s *dev);
+	virtual ~SPIBus();
+
+	/**
+	 * Get the scheduler of a bus, starting it on first use.
+	 *
+	 * @return		The scheduler, or nullptr if it could not be
+	 *			started.
+	 */
+	static SPIBus	*get(int bus, struct spi_dev_s *dev);
+
+	/**
+	 * Get the scheduler of a bus if it has been started.
+	 */
+	static SPIBus	*instance(int bus);
+
+	/**
+	 * Start the worker task.
+	 *
+	 * The worker is a task of its own, so it does not depend on the task
+	 * that happened to start it.
+	 */
+	int		start();
+
+	/**
+	 * Stop the worker task. Transactions still queued are dropped
+	 * without their callbacks being run.
+	 */
+	void		stop();
+
+	/**
+	 * Queue a transaction; safe to call from interrupt context.
+	 *
+	 * @return		OK, or -EBUSY if the transaction is still
+	 *			pending.
+	 */
+	int		submit(SPITransaction *t);
+
+	/**
+	 * Perform a transaction and wait for it to complete.
+	 *
+	 * Must be called from thread context. The callback of the transaction
+	 * is not used. Called from a completion callback it transfers
+	 * directly, as the worker would otherwise wait for itself.
+	 *
+	 * @return		OK or -errno as returned by exchange(), -ETIMEDOUT
+	 *			if the transaction was still queued after the timeout.
+	 *			A transaction already being performed is waited for.
+	 */
+	int		transfer(SPITransaction *t);
+
+	/**
+	 * Print queue statistics.
+	 */
+	void		print_info();
+
+protected:
+	/**
+	 * Perform one transaction on the bus; called on the worker task.
+	 *
+	 * Overridden by simulated buses for testing.
+	 *
+	 * @return		OK, or -errno passed to the completion callback.
+	 */
+	virtual int	exchange(SPITransaction *t);
+
+private:
+	int		_bus;
+	struct spi_dev_s *_dev;
+
+	SPITransaction	*_queue;	/**< pending transactions in order of submission */
+	sem_t		_work;		/**< posted once per queued transaction */
+	int		_task;		/**< worker task, -1 if not running */
+	volatile bool	_running;
+	volatile bool	_should_exit;
+
+	char		_name[16];
+	char		_name_busy[16];
+	perf_counter_t	_perf_exchange;
+	perf_counter_t	_perf_busy;
+
+	static const unsigned	_max_buses = 4;
+	static SPIBus		*_buses[_max_buses];
+
+	static int	worker_trampoline(int argc, char *argv[]);
+	void		worker();
+
+	/**
+	 * Remove the highest priority transaction from the queue.
+	 */
+	SPITransaction	*dequeue();
+
+	/**
+	 * Give up on a transaction of transfer() that timed out.
+	 *
+	 * Only a transaction still waiting in the queue can be given up; once
+	 * the worker has taken it, it uses the transaction until the callback.
+	 *
+	 * @return		true if it was removed from the queue.
+	 */
+	bool		abandon(SPITransaction *t);
+
+	static void	transfer_done(void *arg, int result);
+};
+
+} // namespace device
+
+#endif /* _DEVICE_SPI_BUS_H */
@@ -105,9 +105,37 @@ struct mixer_simple_s {
 
 /**
  * Add mixer(s) from the buffer in (const char *)arg
+ *
+ * The buffer holds text definitions and/or compiled records (see below)
+ * and ends with a NUL outside of a compiled record.
  */
 #define MIXERIOCLOADBUF		_MIXERIOC(5)
 
+/*
+ * Compiled mixer records, as generated by Tools/px_mixer_compile.py.
+ *
+ * A record starts with the tag of the corresponding text definition with
+ * bit 7 set, followed by the length of the rest of the record in bytes.
+ * Values are signed 16 bit little-endian in units of 1/10000 as in the text
+ * format, without any padding:
+ *
+ *   null:       MIXER_REC_NULL 0
+ *   simple:     MIXER_REC_SIMPLE <len> <control count> <output scaler>
+ *                 { <control group> <control index> <control scaler> } ...
+ *   multirotor: MIXER_REC_MULTIROTOR 9 <geometry> <roll> <pitch> <yaw> <deadband>
+ *
+ * where a scaler is <-ve scale> <+ve scale> <offset> <lower limit> <upper limit>,
+ * counts, group and index are single bytes and the geometry is the index in
+ * MultirotorMixer::Geometry.
+ */
+#define MIXER_REC_FLAG		0x80
+#define MIXER_REC_NULL		('Z' | MIXER_REC_FLAG)
+#define MIXER_REC_SIMPLE	('M' | MIXER_REC_FLAG)
+#define MIXER_REC_MULTIROTOR	('R' | MIXER_REC_FLAG)
+
+#define MIXER_REC_HDR_SIZE	2	/**< tag and length */
+#define MIXER_REC_SCALER_SIZE	10	/**< five 16 bit values */
+
 /*
  * XXX Thoughts for additional operations:
  *
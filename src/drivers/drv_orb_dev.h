@@ -65,7 +65,15 @@
  * IOCTLs for the uORB control device
  */
 
-/** Advertise a new topic described by *(uorb_metadata *)arg */
+/**
+ * Topic node to create with ORBIOCADVERTISE.
+ */
+struct orb_advertdata {
+	const struct orb_metadata *meta;	/**< the topic */
+	int instance;				/**< instance of the topic, 0 for single instance topics */
+};
+
+/** Advertise a new topic instance described by *(struct orb_advertdata *)arg */
 #define ORBIOCADVERTISE		_ORBIOC(0)
 
 /*
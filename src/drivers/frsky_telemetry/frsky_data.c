@@ -47,11 +47,7 @@
 #include <string.h>
 #include <arch/math.h>
 #include <geo/geo.h>
-
-#include <uORB/topics/battery_status.h>
-#include <uORB/topics/sensor_combined.h>
-#include <uORB/topics/vehicle_global_position.h>
-#include <uORB/topics/vehicle_status.h>
+#include <telemetry/telemetry_snapshot.h>
 
 /* FrSky sensor hub data IDs */
 #define FRSKY_ID_GPS_ALT_BP     0x01
@@ -88,67 +84,90 @@
 
 #define frac(f) (f - (int)f)
 
-static int battery_sub = -1;
-static int sensor_sub = -1;
-static int global_position_sub = -1;
-static int vehicle_status_sub = -1;
+/* Largest frame: 15 id/value pairs, each fully byte-stuffed, plus the stop byte */
+#define FRSKY_FRAME_MAX         (15 * 7 + 1)
+
+static struct telemetry_snapshot_s telem;
+
+/* Frame being encoded, written to the UART in one go */
+static uint8_t frame_buf[FRSKY_FRAME_MAX];
+static unsigned frame_len = 0;
 
 /**
  * Initializes the uORB subscriptions.
  */
 void frsky_init()
 {
-	battery_sub = orb_subscribe(ORB_ID(battery_status));
-	global_position_sub = orb_subscribe(ORB_ID(vehicle_global_position));
-	sensor_sub = orb_subscribe(ORB_ID(sensor_combined));
-	vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
+	telemetry_snapshot_init(&telem, TELEMETRY_SENSOR | TELEMETRY_BATTERY |
+				TELEMETRY_GLOBAL_POS | TELEMETRY_STATUS);
+}
+
+/**
+ * Refreshes the topics that changed since the last call.
+ */
+void frsky_update()
+{
+	telemetry_snapshot_update(&telem);
 }
 
 /**
- * Sends a 0x5E start/stop byte.
+ * Appends a 0x5E start/stop byte.
  */
-static void frsky_send_startstop(int uart)
+static void frsky_send_startstop(void)
 {
-	static const uint8_t c = 0x5E;
-	write(uart, &c, sizeof(c));
+	if (frame_len < sizeof(frame_buf))
+		frame_buf[frame_len++] = 0x5E;
 }
 
 /**
- * Sends one byte, performing byte-stuffing if necessary.
+ * Appends one byte, performing byte-stuffing if necessary.
  */
-static void frsky_send_byte(int uart, uint8_t value)
+static void frsky_send_byte(uint8_t value)
 {
-	const uint8_t x5E[] = { 0x5D, 0x3E };
-	const uint8_t x5D[] = { 0x5D, 0x3D };
+	if (frame_len + 2 > sizeof(frame_buf))
+		return;
 
 	switch (value) {
 	case 0x5E:
-		write(uart, x5E, sizeof(x5E));
+		frame_buf[frame_len++] = 0x5D;
+		frame_buf[frame_len++] = 0x3E;
 		break;
 
 	case 0x5D:
-		write(uart, x5D, sizeof(x5D));
+		frame_buf[frame_len++] = 0x5D;
+		frame_buf[frame_len++] = 0x3D;
 		break;
 
 	default:
-		write(uart, &value, sizeof(value));
+		frame_buf[frame_len++] = value;
 		break;
 	}
 }
 
 /**
- * Sends one data id/value pair.
+ * Appends one data id/value pair.
  */
-static void frsky_send_data(int uart, uint8_t id, int16_t data)
+static void frsky_send_data(uint8_t id, int16_t data)
 {
 	/* Cast data to unsigned, because signed shift might behave incorrectly */
 	uint16_t udata = data;
 
-	frsky_send_startstop(uart);
+	frsky_send_startstop();
 
-	frsky_send_byte(uart, id);
-	frsky_send_byte(uart, udata);      /* LSB */
-	frsky_send_byte(uart, udata >> 8); /* MSB */
+	frsky_send_byte(id);
+	frsky_send_byte(udata);      /* LSB */
+	frsky_send_byte(udata >> 8); /* MSB */
+}
+
+/**
+ * Terminates the frame and writes it with a single write() call.
+ */
+static void frsky_send_frame(int uart)
+{
+	frsky_send_startstop();
+
+	write(uart, frame_buf, frame_len);
+	frame_len = 0;
 }
 
 /**
@@ -157,38 +176,31 @@ static void frsky_send_data(int uart, uint8_t id, int16_t data)
  */
 void frsky_send_frame1(int uart)
 {
-	/* get a local copy of the current sensor values */
-	struct sensor_combined_s raw;
-	memset(&raw, 0, sizeof(raw));
-	orb_copy(ORB_ID(sensor_combined), sensor_sub, &raw);
-
-	/* get a local copy of the battery data */
-	struct battery_status_s battery;
-	memset(&battery, 0, sizeof(battery));
-	orb_copy(ORB_ID(battery_status), battery_sub, &battery);
+	const struct sensor_combined_s *raw = &telem.sensor;
+	const struct battery_status_s *battery = &telem.battery;
 
 	/* send formatted frame */
-	frsky_send_data(uart, FRSKY_ID_ACCEL_X,
-			roundf(raw.accelerometer_m_s2[0] * 1000.0f));
-	frsky_send_data(uart, FRSKY_ID_ACCEL_Y,
-			roundf(raw.accelerometer_m_s2[1] * 1000.0f));
-	frsky_send_data(uart, FRSKY_ID_ACCEL_Z,
-			roundf(raw.accelerometer_m_s2[2] * 1000.0f));
-
-	frsky_send_data(uart, FRSKY_ID_BARO_ALT_BP,
-			raw.baro_alt_meter);
-	frsky_send_data(uart, FRSKY_ID_BARO_ALT_AP,
-			roundf(frac(raw.baro_alt_meter) * 100.0f));
-
-	frsky_send_data(uart, FRSKY_ID_TEMP1,
-			roundf(raw.baro_temp_celcius));
-
-	frsky_send_data(uart, FRSKY_ID_VFAS,
-			roundf(battery.voltage_v * 10.0f));
-	frsky_send_data(uart, FRSKY_ID_CURRENT,
-			(battery.current_a < 0) ? 0 : roundf(battery.current_a * 10.0f));
-
-	frsky_send_startstop(uart);
+	frsky_send_data(FRSKY_ID_ACCEL_X,
+			roundf(raw->accelerometer_m_s2[0] * 1000.0f));
+	frsky_send_data(FRSKY_ID_ACCEL_Y,
+			roundf(raw->accelerometer_m_s2[1] * 1000.0f));
+	frsky_send_data(FRSKY_ID_ACCEL_Z,
+			roundf(raw->accelerometer_m_s2[2] * 1000.0f));
+
+	frsky_send_data(FRSKY_ID_BARO_ALT_BP,
+			raw->baro_alt_meter);
+	frsky_send_data(FRSKY_ID_BARO_ALT_AP,
+			roundf(frac(raw->baro_alt_meter) * 100.0f));
+
+	frsky_send_data(FRSKY_ID_TEMP1,
+			roundf(raw->baro_temp_celcius));
+
+	frsky_send_data(FRSKY_ID_VFAS,
+			roundf(battery->voltage_v * 10.0f));
+	frsky_send_data(FRSKY_ID_CURRENT,
+			(battery->current_a < 0) ? 0 : roundf(battery->current_a * 10.0f));
+
+	frsky_send_frame(uart);
 }
 
 /**
@@ -211,58 +223,51 @@ static float frsky_format_gps(float dec)
  */
 void frsky_send_frame2(int uart)
 {
-	/* get a local copy of the global position data */
-	struct vehicle_global_position_s global_pos;
-	memset(&global_pos, 0, sizeof(global_pos));
-	orb_copy(ORB_ID(vehicle_global_position), global_position_sub, &global_pos);
-
-	/* get a local copy of the vehicle status data */
-	struct vehicle_status_s vehicle_status;
-	memset(&vehicle_status, 0, sizeof(vehicle_status));
-	orb_copy(ORB_ID(vehicle_status), vehicle_status_sub, &vehicle_status);
+	const struct vehicle_global_position_s *global_pos = &telem.global_pos;
+	const struct vehicle_status_s *vehicle_status = &telem.status;
 
 	/* send formatted frame */
 	float course = 0, lat = 0, lon = 0, speed = 0, alt = 0;
 	char lat_ns = 0, lon_ew = 0;
 	int sec = 0;
-	if (global_pos.global_valid) {
-		time_t time_gps = global_pos.time_gps_usec / 1000000;
+	if (global_pos->global_valid) {
+		time_t time_gps = global_pos->time_gps_usec / 1000000;
 		struct tm *tm_gps = gmtime(&time_gps);
 
-		course = (global_pos.yaw + M_PI_F) / M_PI_F * 180.0f;
-		lat    = frsky_format_gps(abs(global_pos.lat));
-		lat_ns = (global_pos.lat < 0) ? 'S' : 'N';
-		lon    = frsky_format_gps(abs(global_pos.lon));
-		lon_ew = (global_pos.lon < 0) ? 'W' : 'E';
-		speed  = sqrtf(global_pos.vel_n * global_pos.vel_n + global_pos.vel_e * global_pos.vel_e)
+		course = (global_pos->yaw + M_PI_F) / M_PI_F * 180.0f;
+		lat    = frsky_format_gps(abs(global_pos->lat));
+		lat_ns = (global_pos->lat < 0) ? 'S' : 'N';
+		lon    = frsky_format_gps(abs(global_pos->lon));
+		lon_ew = (global_pos->lon < 0) ? 'W' : 'E';
+		speed  = sqrtf(global_pos->vel_n * global_pos->vel_n + global_pos->vel_e * global_pos->vel_e)
 				* 25.0f / 46.0f;
-		alt    = global_pos.alt;
+		alt    = global_pos->alt;
 		sec    = tm_gps->tm_sec;
 	}
 
-	frsky_send_data(uart, FRSKY_ID_GPS_COURS_BP, course);
-	frsky_send_data(uart, FRSKY_ID_GPS_COURS_AP, frac(course) * 1000.0f);
+	frsky_send_data(FRSKY_ID_GPS_COURS_BP, course);
+	frsky_send_data(FRSKY_ID_GPS_COURS_AP, frac(course) * 1000.0f);
 
-	frsky_send_data(uart, FRSKY_ID_GPS_LAT_BP, lat);
-	frsky_send_data(uart, FRSKY_ID_GPS_LAT_AP, frac(lat) * 10000.0f);
-	frsky_send_data(uart, FRSKY_ID_GPS_LAT_NS, lat_ns);
+	frsky_send_data(FRSKY_ID_GPS_LAT_BP, lat);
+	frsky_send_data(FRSKY_ID_GPS_LAT_AP, frac(lat) * 10000.0f);
+	frsky_send_data(FRSKY_ID_GPS_LAT_NS, lat_ns);
 
-	frsky_send_data(uart, FRSKY_ID_GPS_LONG_BP, lon);
-	frsky_send_data(uart, FRSKY_ID_GPS_LONG_AP, frac(lon) * 10000.0f);
-	frsky_send_data(uart, FRSKY_ID_GPS_LONG_EW, lon_ew);
+	frsky_send_data(FRSKY_ID_GPS_LONG_BP, lon);
+	frsky_send_data(FRSKY_ID_GPS_LONG_AP, frac(lon) * 10000.0f);
+	frsky_send_data(FRSKY_ID_GPS_LONG_EW, lon_ew);
 
-	frsky_send_data(uart, FRSKY_ID_GPS_SPEED_BP, speed);
-	frsky_send_data(uart, FRSKY_ID_GPS_SPEED_AP, frac(speed) * 100.0f);
+	frsky_send_data(FRSKY_ID_GPS_SPEED_BP, speed);
+	frsky_send_data(FRSKY_ID_GPS_SPEED_AP, frac(speed) * 100.0f);
 
-	frsky_send_data(uart, FRSKY_ID_GPS_ALT_BP, alt);
-	frsky_send_data(uart, FRSKY_ID_GPS_ALT_AP, frac(alt) * 100.0f);
+	frsky_send_data(FRSKY_ID_GPS_ALT_BP, alt);
+	frsky_send_data(FRSKY_ID_GPS_ALT_AP, frac(alt) * 100.0f);
 
-	frsky_send_data(uart, FRSKY_ID_FUEL,
-			roundf(vehicle_status.battery_remaining * 100.0f));
+	frsky_send_data(FRSKY_ID_FUEL,
+			roundf(vehicle_status->battery_remaining * 100.0f));
 
-	frsky_send_data(uart, FRSKY_ID_GPS_SEC, sec);
+	frsky_send_data(FRSKY_ID_GPS_SEC, sec);
 
-	frsky_send_startstop(uart);
+	frsky_send_frame(uart);
 }
 
 /**
@@ -271,19 +276,16 @@ void frsky_send_frame2(int uart)
  */
 void frsky_send_frame3(int uart)
 {
-	/* get a local copy of the battery data */
-	struct vehicle_global_position_s global_pos;
-	memset(&global_pos, 0, sizeof(global_pos));
-	orb_copy(ORB_ID(vehicle_global_position), global_position_sub, &global_pos);
+	const struct vehicle_global_position_s *global_pos = &telem.global_pos;
 
 	/* send formatted frame */
-	time_t time_gps = global_pos.time_gps_usec / 1000000;
+	time_t time_gps = global_pos->time_gps_usec / 1000000;
 	struct tm *tm_gps = gmtime(&time_gps);
 	uint16_t hour_min = (tm_gps->tm_min << 8) | (tm_gps->tm_hour & 0xff);
-	frsky_send_data(uart, FRSKY_ID_GPS_DAY_MONTH, tm_gps->tm_mday);
-	frsky_send_data(uart, FRSKY_ID_GPS_YEAR, tm_gps->tm_year);
-	frsky_send_data(uart, FRSKY_ID_GPS_HOUR_MIN, hour_min);
-	frsky_send_data(uart, FRSKY_ID_GPS_SEC, tm_gps->tm_sec);
+	frsky_send_data(FRSKY_ID_GPS_DAY_MONTH, tm_gps->tm_mday);
+	frsky_send_data(FRSKY_ID_GPS_YEAR, tm_gps->tm_year);
+	frsky_send_data(FRSKY_ID_GPS_HOUR_MIN, hour_min);
+	frsky_send_data(FRSKY_ID_GPS_SEC, tm_gps->tm_sec);
 
-	frsky_send_startstop(uart);
+	frsky_send_frame(uart);
 }
@@ -44,6 +44,7 @@
 
 // Public functions
 void frsky_init(void);
+void frsky_update(void);
 void frsky_send_frame1(int uart);
 void frsky_send_frame2(int uart);
 void frsky_send_frame3(int uart);
@@ -173,6 +173,9 @@ static int frsky_telemetry_thread_main(int argc, char *argv[])
 		/* Sleep 200 ms */
 		usleep(200000);
 
+		/* Copy the topics that changed, all frames are encoded from this snapshot */
+		frsky_update();
+
 		/* Send frame 1 (every 200ms): acceleration values, altitude (vario), temperatures, current & voltages, RPM */
 		frsky_send_frame1(uart);
 
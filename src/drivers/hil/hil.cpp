@@ -606,7 +606,7 @@ HIL::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 
 	case MIXERIOCLOADBUF: {
 			const char *buf = (const char *)arg;
-			unsigned buflen = strnlen(buf, 1024);
+			unsigned buflen = mixer_buf_length(buf, 1024);
 
 			if (_mixers == nullptr)
 				_mixers = new MixerGroup(control_callback, (uintptr_t)&_controls);
@@ -158,6 +158,7 @@ private:
 	int			_class_instance;
 
 	orb_advert_t		_mag_topic;
+	int			_orb_class_instance;
 
 	perf_counter_t		_sample_perf;
 	perf_counter_t		_comms_errors;
@@ -326,6 +327,7 @@ HMC5883::HMC5883(int bus) :
 	_range_ga(1.3f),
 	_mag_topic(-1),
 	_class_instance(-1),
+	_orb_class_instance(-1),
 	_sample_perf(perf_alloc(PC_ELAPSED, "hmc5883_read")),
 	_comms_errors(perf_alloc(PC_COUNT, "hmc5883_comms_errors")),
 	_buffer_overflows(perf_alloc(PC_COUNT, "hmc5883_buffer_overflows")),
@@ -384,6 +386,22 @@ HMC5883::init()
 
 	_class_instance = register_class_devname(MAG_DEVICE_PATH);
 
+	/* advertise sensor topic, measure manually to initialize valid report */
+	if (OK == measure()) {
+		usleep(HMC5883_CONVERSION_INTERVAL);
+		collect();
+	}
+
+	struct mag_report mrp;
+	memset(&mrp, 0, sizeof(mrp));
+	_reports->get(&mrp);
+
+	/* advertised here and not on the first report, so the instance follows the start order */
+	_mag_topic = orb_advertise_multi(ORB_ID(sensor_mag), &mrp, &_orb_class_instance);
+
+	if (_mag_topic < 0)
+		debug("failed to create sensor_mag publication");
+
 	ret = OK;
 	/* sensor is ok, but not calibrated */
 	_sensor_ok = true;
@@ -859,17 +877,9 @@ HMC5883::collect()
 	/* z remains z */
 	new_report.z = ((report.z * _range_scale) - _scale.z_offset) * _scale.z_scale;
 
-	if (_class_instance == CLASS_DEVICE_PRIMARY && !(_pub_blocked)) {
-
-		if (_mag_topic != -1) {
-			/* publish it */
-			orb_publish(ORB_ID(sensor_mag), _mag_topic, &new_report);
-		} else {
-			_mag_topic = orb_advertise(ORB_ID(sensor_mag), &new_report);
-
-			if (_mag_topic < 0)
-				debug("failed to create sensor_mag publication");
-		}
+	if (!(_pub_blocked) && _mag_topic != -1) {
+		/* publish it */
+		orb_publish(ORB_ID(sensor_mag), _mag_topic, &new_report);
 	}
 
 	_last_report = new_report;
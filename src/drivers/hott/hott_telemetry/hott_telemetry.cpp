@@ -186,6 +186,9 @@ hott_telemetry_thread_main(int argc, char *argv[])
 				warnx("OK");
 			}
 
+			/* refresh the topics that changed since the last poll */
+			update_sub_messages();
+
 			switch (id) {
 			case EAM_SENSOR_ID:
 				build_eam_response(buffer, &size);
@@ -44,22 +44,12 @@
 #include <string.h>
 #include <geo/geo.h>
 #include <unistd.h>
-#include <uORB/topics/airspeed.h>
-#include <uORB/topics/battery_status.h>
-#include <uORB/topics/esc_status.h>
-#include <uORB/topics/home_position.h>
-#include <uORB/topics/sensor_combined.h>
-#include <uORB/topics/vehicle_gps_position.h>
+#include <telemetry/telemetry_snapshot.h>
 
 /* The board is very roughly 5 deg warmer than the surrounding air */
 #define BOARD_TEMP_OFFSET_DEG 5
 
-static int _battery_sub = -1;
-static int _gps_sub = -1;
-static int _home_sub = -1;
-static int _sensor_sub = -1;
-static int _airspeed_sub = -1;
-static int _esc_sub = -1;
+static struct telemetry_snapshot_s _telem;
 
 static orb_advert_t _esc_pub;
 struct esc_status_s _esc;
@@ -71,12 +61,20 @@ static double _home_lon = 0.0d;
 void 
 init_sub_messages(void)
 {
-	_battery_sub = orb_subscribe(ORB_ID(battery_status));
-	_gps_sub = orb_subscribe(ORB_ID(vehicle_gps_position));
-	_home_sub = orb_subscribe(ORB_ID(home_position));
-	_sensor_sub = orb_subscribe(ORB_ID(sensor_combined));
-	_airspeed_sub = orb_subscribe(ORB_ID(airspeed));
-	_esc_sub = orb_subscribe(ORB_ID(esc_status));
+	telemetry_snapshot_init(&_telem, TELEMETRY_SENSOR | TELEMETRY_BATTERY | TELEMETRY_GPS |
+				TELEMETRY_HOME | TELEMETRY_AIRSPEED | TELEMETRY_ESC);
+}
+
+void
+update_sub_messages(void)
+{
+	uint32_t updated = telemetry_snapshot_update(&_telem);
+
+	if (updated & TELEMETRY_HOME) {
+		_home_lat = _telem.home.lat;
+		_home_lon = _telem.home.lon;
+		_home_position_set = true;
+	}
 }
 
 void 
@@ -128,15 +126,8 @@ publish_gam_message(const uint8_t *buffer)
 void 
 build_eam_response(uint8_t *buffer, size_t *size)
 {
-	/* get a local copy of the current sensor values */
-	struct sensor_combined_s raw;
-	memset(&raw, 0, sizeof(raw));
-	orb_copy(ORB_ID(sensor_combined), _sensor_sub, &raw);
-
-	/* get a local copy of the battery data */
-	struct battery_status_s battery;
-	memset(&battery, 0, sizeof(battery));
-	orb_copy(ORB_ID(battery_status), _battery_sub, &battery);
+	const struct sensor_combined_s &raw = _telem.sensor;
+	const struct battery_status_s &battery = _telem.battery;
 
 	struct eam_module_msg msg;
 	*size = sizeof(msg);
@@ -155,12 +146,7 @@ build_eam_response(uint8_t *buffer, size_t *size)
 	msg.altitude_L = (uint8_t)alt & 0xff;
 	msg.altitude_H = (uint8_t)(alt >> 8) & 0xff;
 
-	/* get a local copy of the airspeed data */
-	struct airspeed_s airspeed;
-	memset(&airspeed, 0, sizeof(airspeed));
-	orb_copy(ORB_ID(airspeed), _airspeed_sub, &airspeed);
-
-	uint16_t speed = (uint16_t)(airspeed.indicated_airspeed_m_s * 3.6f);
+	uint16_t speed = (uint16_t)(_telem.airspeed.indicated_airspeed_m_s * 3.6f);
 	msg.speed_L = (uint8_t)speed & 0xff;
 	msg.speed_H = (uint8_t)(speed >> 8) & 0xff;
 
@@ -171,10 +157,7 @@ build_eam_response(uint8_t *buffer, size_t *size)
 void 
 build_gam_response(uint8_t *buffer, size_t *size)
 {
-	/* get a local copy of the ESC Status values */
-	struct esc_status_s esc;
-	memset(&esc, 0, sizeof(esc));
-	orb_copy(ORB_ID(esc_status), _esc_sub, &esc);
+	const struct esc_status_s &esc = _telem.esc;
 
 	struct gam_module_msg msg;
 	*size = sizeof(msg);
@@ -206,15 +189,7 @@ build_gam_response(uint8_t *buffer, size_t *size)
 void 
 build_gps_response(uint8_t *buffer, size_t *size)
 {
-	/* get a local copy of the current sensor values */
-	struct sensor_combined_s raw;
-	memset(&raw, 0, sizeof(raw));
-	orb_copy(ORB_ID(sensor_combined), _sensor_sub, &raw);
-
- 	/* get a local copy of the battery data */
-	struct vehicle_gps_position_s gps;
-	memset(&gps, 0, sizeof(gps));
-	orb_copy(ORB_ID(vehicle_gps_position), _gps_sub, &gps);
+	const struct vehicle_gps_position_s &gps = _telem.gps;
 
 	struct gps_module_msg msg;
 	*size = sizeof(msg);
@@ -286,20 +261,6 @@ build_gps_response(uint8_t *buffer, size_t *size)
 		msg.altitude_L = (uint8_t)alt & 0xff;
 		msg.altitude_H = (uint8_t)(alt >> 8) & 0xff;
 
-		/* Get any (and probably only ever one) _home_sub postion report */
-		bool updated;
-		orb_check(_home_sub, &updated);
-		if (updated) {
-			/* get a local copy of the home position data */
-			struct home_position_s home;
-			memset(&home, 0, sizeof(home));
-			orb_copy(ORB_ID(home_position), _home_sub, &home);
-
-			_home_lat = home.lat;
-			_home_lon = home.lon;
-			_home_position_set = true;
-		}
-
 		/* Distance from home */
 		if (_home_position_set) {
 			uint16_t dist = (uint16_t)get_distance_to_next_waypoint(_home_lat, _home_lon, lat, lon);
@@ -236,6 +236,7 @@ struct gps_module_msg {
 #define MAX_MESSAGE_BUFFER_SIZE 45
 
 void init_sub_messages(void);
+void update_sub_messages(void);
 void init_pub_messages(void);
 void build_gam_request(uint8_t *buffer, size_t *size);
 void publish_gam_message(const uint8_t *buffer);
@@ -60,6 +60,8 @@
 
 #include <drivers/drv_hrt.h>
 #include <drivers/device/spi.h>
+#include <drivers/device/spi_bus.h>
+#include <drivers/device/sample_tracker.h>
 #include <drivers/drv_gyro.h>
 #include <drivers/device/ringbuffer.h>
 
@@ -169,6 +171,12 @@ static const int ERROR = -1;
 #define L3GD20_DEFAULT_RANGE_DPS		2000
 #define L3GD20_DEFAULT_FILTER_FREQ		30
 
+#ifdef GPIO_EXTI_GYRO_DRDY
+# define L3GD20_USE_DRDY 1
+#else
+# define L3GD20_USE_DRDY 0
+#endif
+
 extern "C" { __EXPORT int l3gd20_main(int argc, char *argv[]); }
 
 class L3GD20 : public device::SPI
@@ -194,13 +202,36 @@ private:
 
 	struct hrt_call		_call;
 	unsigned		_call_interval;
-	
+
+	/* status register and data as read back from the device */
+#pragma pack(push, 1)
+	struct RawReport {
+		uint8_t		cmd;
+		uint8_t		temp;
+		uint8_t		status;
+		int16_t		x;
+		int16_t		y;
+		int16_t		z;
+	};
+#pragma pack(pop)
+
+	bool			_async;		/**< measurements are queued to the bus scheduler */
+	RawReport		_async_report;
+	device::SPITransaction	_async_transfer;
+	uint64_t		_async_timestamp;
+	uint32_t		_async_sequence;
+
+	bool			_drdy;		/**< measurements are triggered by the data-ready line */
+	device::SampleTracker	_drdy_tracker;
+	static L3GD20		*_drdy_instance;
+
 	RingBuffer		*_reports;
 
 	struct gyro_scale	_gyro_scale;
 	float			_gyro_range_scale;
 	float			_gyro_range_rad_s;
 	orb_advert_t		_gyro_topic;
+	int			_orb_class_instance;
 	int			_class_instance;
 
 	unsigned		_current_rate;
@@ -247,10 +278,36 @@ private:
 	 */
 	static void		measure_trampoline(void *arg);
 
+	/**
+	 * Data-ready interrupt handler; timestamps the edge and starts a
+	 * measurement for it.
+	 */
+	static int		data_ready_interrupt(int irq, void *context);
+
 	/**
 	 * Fetch measurements from the sensor and update the report ring.
+	 *
+	 * @param timestamp	Data-ready edge of the sample, or zero to
+	 *			timestamp it when it is read.
+	 * @param sequence	Sequence number of the edge, zero if untracked.
+	 */
+	void			measure(uint64_t timestamp = 0, uint32_t sequence = 0);
+
+	/**
+	 * Queue a measurement to the bus scheduler; called from the hrt or
+	 * the data-ready interrupt.
+	 */
+	void			measure_async(uint64_t timestamp = 0, uint32_t sequence = 0);
+
+	/**
+	 * Completion of a queued measurement, on the bus worker thread.
+	 */
+	static void		measure_complete(void *arg, int result);
+
+	/**
+	 * Convert a measurement and update the report ring.
 	 */
-	void			measure();
+	void			collect(RawReport &raw_report, uint64_t timestamp, uint32_t sequence);
 
 	/**
 	 * Read a register from the L3GD20
@@ -315,13 +372,20 @@ private:
 	 int 			self_test();
 };
 
+L3GD20 *L3GD20::_drdy_instance = nullptr;
+
 L3GD20::L3GD20(int bus, const char* path, spi_dev_e device) :
 	SPI("L3GD20", path, bus, device, SPIDEV_MODE3, 8000000),
 	_call_interval(0),
+	_async(false),
+	_async_timestamp(0),
+	_async_sequence(0),
+	_drdy(false),
 	_reports(nullptr),
 	_gyro_range_scale(0.0f),
 	_gyro_range_rad_s(0.0f),
 	_gyro_topic(-1),
+	_orb_class_instance(-1),
 	_class_instance(-1),
 	_current_rate(0),
 	_orientation(SENSOR_BOARD_ROTATION_270_DEG),
@@ -343,6 +407,13 @@ L3GD20::L3GD20(int bus, const char* path, spi_dev_e device) :
 	_gyro_scale.y_scale  = 1.0f;
 	_gyro_scale.z_offset = 0;
 	_gyro_scale.z_scale  = 1.0f;
+
+	memset(&_async_transfer, 0, sizeof(_async_transfer));
+	_async_transfer.send = (uint8_t *)&_async_report;
+	_async_transfer.recv = (uint8_t *)&_async_report;
+	_async_transfer.len = sizeof(_async_report);
+	_async_transfer.callback = &L3GD20::measure_complete;
+	_async_transfer.arg = this;
 }
 
 L3GD20::~L3GD20()
@@ -372,6 +443,12 @@ L3GD20::init()
 	if (SPI::init() != OK)
 		goto out;
 
+	/* poll through the bus scheduler, after the primary IMU */
+	_async = (enable_async(device::SPIBus::PRIORITY_HIGH) == OK);
+
+	if (!_async)
+		debug("no SPI scheduler, polling in interrupt context");
+
 	/* allocate basic report buffers */
 	_reports = new RingBuffer(2, sizeof(gyro_report));
 
@@ -384,18 +461,14 @@ L3GD20::init()
 
 	measure();
 
-	if (_class_instance == CLASS_DEVICE_PRIMARY) {
+	/* advertise sensor topic, measure manually to initialize valid report */
+	struct gyro_report grp;
+	_reports->get(&grp);
 
-		/* advertise sensor topic, measure manually to initialize valid report */
-		struct gyro_report grp;
-		_reports->get(&grp);
+	_gyro_topic = orb_advertise_multi(ORB_ID(sensor_gyro), &grp, &_orb_class_instance);
 
-		_gyro_topic = orb_advertise(ORB_ID(sensor_gyro), &grp);
-
-		if (_gyro_topic < 0)
-			debug("failed to create sensor_gyro publication");
-
-	}
+	if (_gyro_topic < 0)
+		debug("failed to create sensor_gyro publication");
 
 	ret = OK;
 out:
@@ -490,10 +563,21 @@ L3GD20::ioctl(struct file *filp, int cmd, unsigned long arg)
 			case SENSOR_POLLRATE_MANUAL:
 				stop();
 				_call_interval = 0;
+				_drdy = false;
 				return OK;
 
-				/* external signalling not supported */
+				/* sample on the data-ready line, at the sensor output rate */
 			case SENSOR_POLLRATE_EXTERNAL:
+#if L3GD20_USE_DRDY
+				stop();
+				_drdy = true;
+				_call_interval = 1000000 / _current_rate;
+				set_driver_lowpass_filter(_current_rate, _gyro_filter_x.get_cutoff_freq());
+				start();
+				return OK;
+#else
+				return -EINVAL;
+#endif
 
 				/* zero would be bad */
 			case 0:
@@ -507,7 +591,7 @@ L3GD20::ioctl(struct file *filp, int cmd, unsigned long arg)
 				/* adjust to a legal polling interval in Hz */
 			default: {
 					/* do we need to start internal polling? */
-					bool want_start = (_call_interval == 0);
+					bool want_start = (_call_interval == 0) || _drdy;
 
 					/* convert hz to hrt interval via microseconds */
 					unsigned ticks = 1000000 / arg;
@@ -516,6 +600,12 @@ L3GD20::ioctl(struct file *filp, int cmd, unsigned long arg)
 					if (ticks < 1000)
 						return -EINVAL;
 
+					/* leaving data-ready sampling */
+					if (_drdy) {
+						stop();
+						_drdy = false;
+					}
+
 					/* update interval for next measurement */
 					/* XXX this is a bit shady, but no other way to adjust... */
 					_call.period = _call_interval = ticks;
@@ -538,6 +628,9 @@ L3GD20::ioctl(struct file *filp, int cmd, unsigned long arg)
 		if (_call_interval == 0)
 			return SENSOR_POLLRATE_MANUAL;
 
+		if (_drdy)
+			return SENSOR_POLLRATE_EXTERNAL;
+
 		return 1000000 / _call_interval;
 
 	case SENSORIOCSQUEUEDEPTH: {
@@ -707,6 +800,12 @@ L3GD20::set_samplerate(unsigned frequency)
 
 	write_reg(ADDR_CTRL_REG1, bits);
 
+	/* data-ready edges follow the output rate */
+	_drdy_tracker.set_interval(1000000 / _current_rate);
+
+	if (_drdy)
+		_call_interval = 1000000 / _current_rate;
+
 	return OK;
 }
 
@@ -727,6 +826,16 @@ L3GD20::start()
 	/* reset the report ring */
 	_reports->flush();
 
+#if L3GD20_USE_DRDY
+	/* or on the rising edge of the data-ready line */
+	if (_drdy) {
+		_drdy_tracker.reset();
+		_drdy_instance = this;
+		stm32_gpiosetevent(GPIO_EXTI_GYRO_DRDY, true, false, true, &L3GD20::data_ready_interrupt);
+		return;
+	}
+#endif
+
 	/* start polling at the specified rate */
 	hrt_call_every(&_call, 1000, _call_interval, (hrt_callout)&L3GD20::measure_trampoline, this);
 }
@@ -735,6 +844,17 @@ void
 L3GD20::stop()
 {
 	hrt_cancel(&_call);
+
+#if L3GD20_USE_DRDY
+	if (_drdy_instance == this) {
+		stm32_gpiosetevent(GPIO_EXTI_GYRO_DRDY, false, false, false, nullptr);
+		_drdy_instance = nullptr;
+	}
+#endif
+
+	/* a queued measurement still uses our buffers */
+	while (_async_transfer.pending)
+		usleep(1000);
 }
 
 void
@@ -785,42 +905,49 @@ L3GD20::measure_trampoline(void *arg)
 	L3GD20 *dev = (L3GD20 *)arg;
 
 	/* make another measurement */
-	dev->measure();
+	if (dev->_async) {
+		dev->measure_async();
+
+	} else {
+		dev->measure();
+	}
 }
 
-#ifdef GPIO_EXTI_GYRO_DRDY
-# define L3GD20_USE_DRDY 1
-#else
-# define L3GD20_USE_DRDY 0
-#endif
+int
+L3GD20::data_ready_interrupt(int irq, void *context)
+{
+	L3GD20 *dev = _drdy_instance;
+
+	if (dev != nullptr) {
+		hrt_abstime now = hrt_absolute_time();
+		uint32_t sequence = dev->_drdy_tracker.edge(now);
+
+		if (dev->_async) {
+			dev->measure_async(now, sequence);
+
+		} else {
+			dev->measure(now, sequence);
+		}
+	}
+
+	return OK;
+}
 
 void
-L3GD20::measure()
+L3GD20::measure(uint64_t timestamp, uint32_t sequence)
 {
 #if L3GD20_USE_DRDY
 	// if the gyro doesn't have any data ready then re-schedule
 	// for 100 microseconds later. This ensures we don't double
 	// read a value and then miss the next value
-	if (stm32_gpioread(GPIO_EXTI_GYRO_DRDY) == 0) {
+	if (sequence == 0 && stm32_gpioread(GPIO_EXTI_GYRO_DRDY) == 0) {
 		perf_count(_reschedules);
 		hrt_call_delay(&_call, 100);
 		return;
 	}
 #endif
 
-	/* status register and data as read back from the device */
-#pragma pack(push, 1)
-	struct {
-		uint8_t		cmd;
-		uint8_t		temp;
-		uint8_t		status;
-		int16_t		x;
-		int16_t		y;
-		int16_t		z;
-	} raw_report;
-#pragma pack(pop)
-
-	gyro_report report;
+	RawReport raw_report;
 
 	/* start the performance counter */
 	perf_begin(_sample_perf);
@@ -830,6 +957,57 @@ L3GD20::measure()
 	raw_report.cmd = ADDR_OUT_TEMP | DIR_READ | ADDR_INCREMENT;
 	transfer((uint8_t *)&raw_report, (uint8_t *)&raw_report, sizeof(raw_report));
 
+	collect(raw_report, timestamp, sequence);
+}
+
+void
+L3GD20::measure_async(uint64_t timestamp, uint32_t sequence)
+{
+#if L3GD20_USE_DRDY
+	// if the gyro doesn't have any data ready then re-schedule
+	// for 100 microseconds later. This ensures we don't double
+	// read a value and then miss the next value
+	if (sequence == 0 && stm32_gpioread(GPIO_EXTI_GYRO_DRDY) == 0) {
+		perf_count(_reschedules);
+		hrt_call_delay(&_call, 100);
+		return;
+	}
+#endif
+
+	/* the previous transfer has not been served yet, its buffer is busy */
+	if (_async_transfer.pending)
+		return;
+
+	/* start the performance counter */
+	perf_begin(_sample_perf);
+
+	_async_timestamp = timestamp;
+	_async_sequence = sequence;
+	memset(&_async_report, 0, sizeof(_async_report));
+	_async_report.cmd = ADDR_OUT_TEMP | DIR_READ | ADDR_INCREMENT;
+
+	if (transfer_async(&_async_transfer) != OK)
+		perf_cancel(_sample_perf);
+}
+
+void
+L3GD20::measure_complete(void *arg, int result)
+{
+	L3GD20 *dev = (L3GD20 *)arg;
+
+	if (result != OK) {
+		perf_cancel(dev->_sample_perf);
+		return;
+	}
+
+	dev->collect(dev->_async_report, dev->_async_timestamp, dev->_async_sequence);
+}
+
+void
+L3GD20::collect(RawReport &raw_report, uint64_t timestamp, uint32_t sequence)
+{
+	gyro_report report;
+
 #if L3GD20_USE_DRDY
         if ((raw_report.status & 0xF) != 0xF) {
             /*
@@ -840,6 +1018,11 @@ L3GD20::measure()
             return;
         }
 #endif
+
+	/* check that no sample was lost or read twice since the last one */
+	if (sequence != 0)
+		_drdy_tracker.collect(sequence);
+
 	/*
 	 * 1) Scale raw value to SI units using scaling from datasheet.
 	 * 2) Subtract static offset (in SI units)
@@ -854,7 +1037,8 @@ L3GD20::measure()
 	 *	 	  the offset is 74 from the origin and subtracting
 	 *		  74 from all measurements centers them around zero.
 	 */
-	report.timestamp = hrt_absolute_time();
+	/* samples triggered by the data-ready line carry the time of their edge */
+	report.timestamp = (timestamp != 0) ? timestamp : hrt_absolute_time();
         report.error_count = 0; // not recorded
 	
 	switch (_orientation) {
@@ -918,6 +1102,15 @@ void
 L3GD20::print_info()
 {
 	printf("gyro reads:          %u\n", _read);
+	printf("polling %s\n", _async ? "through the SPI scheduler" : "in interrupt context");
+
+	if (_drdy) {
+		printf("data-ready: %u samples, %u lost, %u duplicated, %u spurious edges, interval %u us\n",
+		       (unsigned)_drdy_tracker.samples(), (unsigned)_drdy_tracker.lost(),
+		       (unsigned)_drdy_tracker.duplicates(), (unsigned)_drdy_tracker.spurious(),
+		       _drdy_tracker.interval());
+	}
+
 	perf_print_counter(_sample_perf);
 	perf_print_counter(_reschedules);
 	perf_print_counter(_errors);
@@ -61,6 +61,8 @@
 
 #include <drivers/drv_hrt.h>
 #include <drivers/device/spi.h>
+#include <drivers/device/spi_bus.h>
+#include <drivers/device/sample_tracker.h>
 #include <drivers/drv_accel.h>
 #include <drivers/drv_mag.h>
 #include <drivers/device/ringbuffer.h>
@@ -266,6 +268,33 @@ private:
 	unsigned		_call_accel_interval;
 	unsigned		_call_mag_interval;
 
+	/* status register and data as read back from the device */
+#pragma pack(push, 1)
+	struct RawReport {
+		uint8_t		cmd;
+		uint8_t		status;
+		int16_t		x;
+		int16_t		y;
+		int16_t		z;
+	};
+#pragma pack(pop)
+
+	bool			_async;		/**< measurements are queued to the bus scheduler */
+	RawReport		_accel_async_report;
+	RawReport		_mag_async_report;
+	device::SPITransaction	_accel_async_transfer;
+	device::SPITransaction	_mag_async_transfer;
+	uint64_t		_accel_async_timestamp;
+	uint64_t		_mag_async_timestamp;
+	uint32_t		_accel_async_sequence;
+	uint32_t		_mag_async_sequence;
+
+	bool			_accel_drdy;	/**< accel measurements are triggered by the data-ready line */
+	bool			_mag_drdy;	/**< mag measurements are triggered by the data-ready line */
+	device::SampleTracker	_accel_drdy_tracker;
+	device::SampleTracker	_mag_drdy_tracker;
+	static LSM303D		*_drdy_instance;
+
 	RingBuffer		*_accel_reports;
 	RingBuffer		*_mag_reports;
 
@@ -281,6 +310,7 @@ private:
 	unsigned		_mag_samplerate;
 
 	orb_advert_t		_accel_topic;
+	int			_accel_orb_class_instance;
 	int			_accel_class_instance;
 
 	unsigned		_accel_read;
@@ -351,15 +381,45 @@ private:
 	 */
 	static void		mag_measure_trampoline(void *arg);
 
+	/**
+	 * Accel/mag data-ready interrupt handlers; timestamp the edge and start
+	 * a measurement for it.
+	 */
+	static int		data_ready_interrupt(int irq, void *context);
+	static int		mag_data_ready_interrupt(int irq, void *context);
+
 	/**
 	 * Fetch accel measurements from the sensor and update the report ring.
+	 *
+	 * @param timestamp	Data-ready edge of the sample, or zero to
+	 *			timestamp it when it is read.
+	 * @param sequence	Sequence number of the edge, zero if untracked.
 	 */
-	void			measure();
+	void			measure(uint64_t timestamp = 0, uint32_t sequence = 0);
 
 	/**
 	 * Fetch mag measurements from the sensor and update the report ring.
 	 */
-	void			mag_measure();
+	void			mag_measure(uint64_t timestamp = 0, uint32_t sequence = 0);
+
+	/**
+	 * Queue an accel/mag measurement to the bus scheduler; called from the hrt
+	 * or the data-ready interrupt.
+	 */
+	void			measure_async(uint64_t timestamp = 0, uint32_t sequence = 0);
+	void			mag_measure_async(uint64_t timestamp = 0, uint32_t sequence = 0);
+
+	/**
+	 * Completion of a queued accel/mag measurement, on the bus worker thread.
+	 */
+	static void		measure_complete(void *arg, int result);
+	static void		mag_measure_complete(void *arg, int result);
+
+	/**
+	 * Convert an accel/mag measurement and update the report ring.
+	 */
+	void			collect(RawReport &raw_accel_report, uint64_t timestamp, uint32_t sequence);
+	void			mag_collect(RawReport &raw_mag_report, uint64_t timestamp, uint32_t sequence);
 
 	/**
 	 * Accel self test
@@ -481,6 +541,7 @@ private:
 	LSM303D				*_parent;
 
 	orb_advert_t			_mag_topic;
+	int				_mag_orb_class_instance;
 	int				_mag_class_instance;
 
 	void				measure();
@@ -489,11 +550,20 @@ private:
 };
 
 
+LSM303D *LSM303D::_drdy_instance = nullptr;
+
 LSM303D::LSM303D(int bus, const char* path, spi_dev_e device) :
 	SPI("LSM303D", path, bus, device, SPIDEV_MODE3, 8000000),
 	_mag(new LSM303D_mag(this)),
 	_call_accel_interval(0),
 	_call_mag_interval(0),
+	_async(false),
+	_accel_async_timestamp(0),
+	_mag_async_timestamp(0),
+	_accel_async_sequence(0),
+	_mag_async_sequence(0),
+	_accel_drdy(false),
+	_mag_drdy(false),
 	_accel_reports(nullptr),
 	_mag_reports(nullptr),
 	_accel_range_m_s2(0.0f),
@@ -504,6 +574,7 @@ LSM303D::LSM303D(int bus, const char* path, spi_dev_e device) :
 	_mag_range_scale(0.0f),
 	_mag_samplerate(0),
 	_accel_topic(-1),
+	_accel_orb_class_instance(-1),
 	_accel_class_instance(-1),
 	_accel_read(0),
 	_mag_read(0),
@@ -542,6 +613,20 @@ LSM303D::LSM303D(int bus, const char* path, spi_dev_e device) :
 	_mag_scale.y_scale = 1.0f;
 	_mag_scale.z_offset = 0.0f;
 	_mag_scale.z_scale = 1.0f;
+
+	memset(&_accel_async_transfer, 0, sizeof(_accel_async_transfer));
+	_accel_async_transfer.send = (uint8_t *)&_accel_async_report;
+	_accel_async_transfer.recv = (uint8_t *)&_accel_async_report;
+	_accel_async_transfer.len = sizeof(_accel_async_report);
+	_accel_async_transfer.callback = &LSM303D::measure_complete;
+	_accel_async_transfer.arg = this;
+
+	memset(&_mag_async_transfer, 0, sizeof(_mag_async_transfer));
+	_mag_async_transfer.send = (uint8_t *)&_mag_async_report;
+	_mag_async_transfer.recv = (uint8_t *)&_mag_async_report;
+	_mag_async_transfer.len = sizeof(_mag_async_report);
+	_mag_async_transfer.callback = &LSM303D::mag_measure_complete;
+	_mag_async_transfer.arg = this;
 }
 
 LSM303D::~LSM303D()
@@ -580,6 +665,12 @@ LSM303D::init()
 		goto out;
 	}
 
+	/* poll through the bus scheduler, after the gyros */
+	_async = (enable_async(device::SPIBus::PRIORITY_NORMAL) == OK);
+
+	if (!_async)
+		debug("no SPI scheduler, polling in interrupt context");
+
 	/* allocate basic report buffers */
 	_accel_reports = new RingBuffer(2, sizeof(accel_report));
 
@@ -604,35 +695,27 @@ LSM303D::init()
 	/* fill report structures */
 	measure();
 
-	if (_mag->_mag_class_instance == CLASS_DEVICE_PRIMARY) {
-
-		/* advertise sensor topic, measure manually to initialize valid report */
-		struct mag_report mrp;
-		_mag_reports->get(&mrp);
+	/* advertise sensor topic, measure manually to initialize valid report */
+	struct mag_report mrp;
+	_mag_reports->get(&mrp);
 
-		/* measurement will have generated a report, publish */
-		_mag->_mag_topic = orb_advertise(ORB_ID(sensor_mag), &mrp);
+	/* measurement will have generated a report, publish */
+	_mag->_mag_topic = orb_advertise_multi(ORB_ID(sensor_mag), &mrp, &_mag->_mag_orb_class_instance);
 
-		if (_mag->_mag_topic < 0)
-			debug("failed to create sensor_mag publication");
-
-	}
+	if (_mag->_mag_topic < 0)
+		debug("failed to create sensor_mag publication");
 
 	_accel_class_instance = register_class_devname(ACCEL_DEVICE_PATH);
 
-	if (_accel_class_instance == CLASS_DEVICE_PRIMARY) {
-
-		/* advertise sensor topic, measure manually to initialize valid report */
-		struct accel_report arp;
-		_accel_reports->get(&arp);
+	/* advertise sensor topic, measure manually to initialize valid report */
+	struct accel_report arp;
+	_accel_reports->get(&arp);
 
-		/* measurement will have generated a report, publish */
-		_accel_topic = orb_advertise(ORB_ID(sensor_accel), &arp);
+	/* measurement will have generated a report, publish */
+	_accel_topic = orb_advertise_multi(ORB_ID(sensor_accel), &arp, &_accel_orb_class_instance);
 
-		if (_accel_topic < 0)
-			debug("failed to create sensor_accel publication");
-
-	}
+	if (_accel_topic < 0)
+		debug("failed to create sensor_accel publication");
 
 out:
 	return ret;
@@ -907,10 +990,17 @@ LSM303D::ioctl(struct file *filp, int cmd, unsigned long arg)
 			case SENSOR_POLLRATE_MANUAL:
 				stop();
 				_call_accel_interval = 0;
+				_accel_drdy = false;
 				return OK;
 
-			/* external signalling not supported */
+			/* sample on the data-ready line, at the sensor output rate */
 			case SENSOR_POLLRATE_EXTERNAL:
+				stop();
+				_accel_drdy = true;
+				_call_accel_interval = 1000000 / _accel_samplerate;
+				accel_set_driver_lowpass_filter((float)_accel_samplerate, _accel_filter_x.get_cutoff_freq());
+				start();
+				return OK;
 
 			/* zero would be bad */
 			case 0:
@@ -926,7 +1016,7 @@ LSM303D::ioctl(struct file *filp, int cmd, unsigned long arg)
 				/* adjust to a legal polling interval in Hz */
 			default: {
 				/* do we need to start internal polling? */
-				bool want_start = (_call_accel_interval == 0);
+				bool want_start = (_call_accel_interval == 0) || _accel_drdy;
 
 				/* convert hz to hrt interval via microseconds */
 				unsigned ticks = 1000000 / arg;
@@ -935,6 +1025,12 @@ LSM303D::ioctl(struct file *filp, int cmd, unsigned long arg)
 				if (ticks < 500)
 					return -EINVAL;
 
+				/* leaving data-ready sampling */
+				if (_accel_drdy) {
+					stop();
+					_accel_drdy = false;
+				}
+
 				/* adjust filters */
 				accel_set_driver_lowpass_filter((float)arg, _accel_filter_x.get_cutoff_freq());
 
@@ -955,6 +1051,9 @@ LSM303D::ioctl(struct file *filp, int cmd, unsigned long arg)
 		if (_call_accel_interval == 0)
 			return SENSOR_POLLRATE_MANUAL;
 
+		if (_accel_drdy)
+			return SENSOR_POLLRATE_EXTERNAL;
+
 		return 1000000 / _call_accel_interval;
 
 	case SENSORIOCSQUEUEDEPTH: {
@@ -1038,10 +1137,16 @@ LSM303D::mag_ioctl(struct file *filp, int cmd, unsigned long arg)
 			case SENSOR_POLLRATE_MANUAL:
 				stop();
 				_call_mag_interval = 0;
+				_mag_drdy = false;
 				return OK;
 
-			/* external signalling not supported */
+			/* sample on the data-ready line, at the sensor output rate */
 			case SENSOR_POLLRATE_EXTERNAL:
+				stop();
+				_mag_drdy = true;
+				_call_mag_interval = 1000000 / _mag_samplerate;
+				start();
+				return OK;
 
 			/* zero would be bad */
 			case 0:
@@ -1056,7 +1161,7 @@ LSM303D::mag_ioctl(struct file *filp, int cmd, unsigned long arg)
 			/* adjust to a legal polling interval in Hz */
 			default: {
 					/* do we need to start internal polling? */
-					bool want_start = (_call_mag_interval == 0);
+					bool want_start = (_call_mag_interval == 0) || _mag_drdy;
 
 					/* convert hz to hrt interval via microseconds */
 					unsigned ticks = 1000000 / arg;
@@ -1065,6 +1170,12 @@ LSM303D::mag_ioctl(struct file *filp, int cmd, unsigned long arg)
 					if (ticks < 1000)
 						return -EINVAL;
 
+					/* leaving data-ready sampling */
+					if (_mag_drdy) {
+						stop();
+						_mag_drdy = false;
+					}
+
 					/* update interval for next measurement */
 					/* XXX this is a bit shady, but no other way to adjust... */
 					_mag_call.period = _call_mag_interval = ticks;
@@ -1082,6 +1193,9 @@ LSM303D::mag_ioctl(struct file *filp, int cmd, unsigned long arg)
 		if (_call_mag_interval == 0)
 			return SENSOR_POLLRATE_MANUAL;
 
+		if (_mag_drdy)
+			return SENSOR_POLLRATE_EXTERNAL;
+
 		return 1000000 / _call_mag_interval;
 	
 	case SENSORIOCSQUEUEDEPTH: {
@@ -1396,6 +1510,12 @@ LSM303D::accel_set_samplerate(unsigned frequency)
 	modify_reg(ADDR_CTRL_REG1, clearbits, setbits);
 	_reg1_expected = (_reg1_expected & ~clearbits) | setbits;
 
+	/* data-ready edges follow the output rate */
+	_accel_drdy_tracker.set_interval(1000000 / _accel_samplerate);
+
+	if (_accel_drdy)
+		_call_accel_interval = 1000000 / _accel_samplerate;
+
 	return OK;
 }
 
@@ -1426,6 +1546,12 @@ LSM303D::mag_set_samplerate(unsigned frequency)
 
 	modify_reg(ADDR_CTRL_REG5, clearbits, setbits);
 
+	/* data-ready edges follow the output rate */
+	_mag_drdy_tracker.set_interval(1000000 / _mag_samplerate);
+
+	if (_mag_drdy)
+		_call_mag_interval = 1000000 / _mag_samplerate;
+
 	return OK;
 }
 
@@ -1439,9 +1565,25 @@ LSM303D::start()
 	_accel_reports->flush();
 	_mag_reports->flush();
 
-	/* start polling at the specified rate */
-	hrt_call_every(&_accel_call, 1000, _call_accel_interval, (hrt_callout)&LSM303D::measure_trampoline, this);
-	hrt_call_every(&_mag_call, 1000, _call_mag_interval, (hrt_callout)&LSM303D::mag_measure_trampoline, this);
+	/* start polling at the specified rate, or on the rising edge of the data-ready lines */
+	if (_accel_drdy || _mag_drdy)
+		_drdy_instance = this;
+
+	if (_accel_drdy) {
+		_accel_drdy_tracker.reset();
+		stm32_gpiosetevent(GPIO_EXTI_ACCEL_DRDY, true, false, true, &LSM303D::data_ready_interrupt);
+
+	} else {
+		hrt_call_every(&_accel_call, 1000, _call_accel_interval, (hrt_callout)&LSM303D::measure_trampoline, this);
+	}
+
+	if (_mag_drdy) {
+		_mag_drdy_tracker.reset();
+		stm32_gpiosetevent(GPIO_EXTI_MAG_DRDY, true, false, true, &LSM303D::mag_data_ready_interrupt);
+
+	} else {
+		hrt_call_every(&_mag_call, 1000, _call_mag_interval, (hrt_callout)&LSM303D::mag_measure_trampoline, this);
+	}
 }
 
 void
@@ -1449,6 +1591,16 @@ LSM303D::stop()
 {
 	hrt_cancel(&_accel_call);
 	hrt_cancel(&_mag_call);
+
+	if (_drdy_instance == this) {
+		stm32_gpiosetevent(GPIO_EXTI_ACCEL_DRDY, false, false, false, nullptr);
+		stm32_gpiosetevent(GPIO_EXTI_MAG_DRDY, false, false, false, nullptr);
+		_drdy_instance = nullptr;
+	}
+
+	/* queued measurements still use our buffers */
+	while (_accel_async_transfer.pending || _mag_async_transfer.pending)
+		usleep(1000);
 }
 
 void
@@ -1457,7 +1609,12 @@ LSM303D::measure_trampoline(void *arg)
 	LSM303D *dev = (LSM303D *)arg;
 
 	/* make another measurement */
-	dev->measure();
+	if (dev->_async) {
+		dev->measure_async();
+
+	} else {
+		dev->measure();
+	}
 }
 
 void
@@ -1466,16 +1623,61 @@ LSM303D::mag_measure_trampoline(void *arg)
 	LSM303D *dev = (LSM303D *)arg;
 
 	/* make another measurement */
-	dev->mag_measure();
+	if (dev->_async) {
+		dev->mag_measure_async();
+
+	} else {
+		dev->mag_measure();
+	}
+}
+
+int
+LSM303D::data_ready_interrupt(int irq, void *context)
+{
+	LSM303D *dev = _drdy_instance;
+
+	if (dev != nullptr) {
+		hrt_abstime now = hrt_absolute_time();
+		uint32_t sequence = dev->_accel_drdy_tracker.edge(now);
+
+		if (dev->_async) {
+			dev->measure_async(now, sequence);
+
+		} else {
+			dev->measure(now, sequence);
+		}
+	}
+
+	return OK;
+}
+
+int
+LSM303D::mag_data_ready_interrupt(int irq, void *context)
+{
+	LSM303D *dev = _drdy_instance;
+
+	if (dev != nullptr) {
+		hrt_abstime now = hrt_absolute_time();
+		uint32_t sequence = dev->_mag_drdy_tracker.edge(now);
+
+		if (dev->_async) {
+			dev->mag_measure_async(now, sequence);
+
+		} else {
+			dev->mag_measure(now, sequence);
+		}
+	}
+
+	return OK;
 }
 
 void
-LSM303D::measure()
+LSM303D::measure(uint64_t timestamp, uint32_t sequence)
 {
 	// if the accel doesn't have any data ready then re-schedule
 	// for 100 microseconds later. This ensures we don't double
 	// read a value and then miss the next value
-	if (stm32_gpioread(GPIO_EXTI_ACCEL_DRDY) == 0) {
+	if (sequence == 0 && stm32_gpioread(GPIO_EXTI_ACCEL_DRDY) == 0) {
 		perf_count(_accel_reschedules);
 		hrt_call_delay(&_accel_call, 100);
 		return;
@@ -1486,19 +1688,7 @@ LSM303D::measure()
 		return;
 	}
 
-	/* status register and data as read back from the device */
-
-#pragma pack(push, 1)
-	struct {
-		uint8_t		cmd;
-		uint8_t		status;
-		int16_t		x;
-		int16_t		y;
-		int16_t		z;
-	} raw_accel_report;
-#pragma pack(pop)
-
-	accel_report accel_report;
+	RawReport raw_accel_report;
 
 	/* start the performance counter */
 	perf_begin(_accel_sample_perf);
@@ -1508,6 +1698,63 @@ LSM303D::measure()
 	raw_accel_report.cmd = ADDR_STATUS_A | DIR_READ | ADDR_INCREMENT;
 	transfer((uint8_t *)&raw_accel_report, (uint8_t *)&raw_accel_report, sizeof(raw_accel_report));
 
+	collect(raw_accel_report, timestamp, sequence);
+}
+
+void
+LSM303D::measure_async(uint64_t timestamp, uint32_t sequence)
+{
+	// if the accel doesn't have any data ready then re-schedule
+	// for 100 microseconds later. This ensures we don't double
+	// read a value and then miss the next value
+	if (sequence == 0 && stm32_gpioread(GPIO_EXTI_ACCEL_DRDY) == 0) {
+		perf_count(_accel_reschedules);
+		hrt_call_delay(&_accel_call, 100);
+		return;
+	}
+
+	/* the previous transfer has not been served yet, its buffer is busy */
+	if (_accel_async_transfer.pending)
+		return;
+
+	/* start the performance counter */
+	perf_begin(_accel_sample_perf);
+
+	_accel_async_timestamp = timestamp;
+	_accel_async_sequence = sequence;
+	memset(&_accel_async_report, 0, sizeof(_accel_async_report));
+	_accel_async_report.cmd = ADDR_STATUS_A | DIR_READ | ADDR_INCREMENT;
+
+	if (transfer_async(&_accel_async_transfer) != OK)
+		perf_cancel(_accel_sample_perf);
+}
+
+void
+LSM303D::measure_complete(void *arg, int result)
+{
+	LSM303D *dev = (LSM303D *)arg;
+
+	if (result != OK) {
+		perf_cancel(dev->_accel_sample_perf);
+		return;
+	}
+
+	/* brownout check, on the worker thread register reads go straight to the bus */
+	if (dev->read_reg(ADDR_CTRL_REG1) != dev->_reg1_expected) {
+		perf_cancel(dev->_accel_sample_perf);
+		perf_count(dev->_reg1_resets);
+		dev->reset();
+		return;
+	}
+
+	dev->collect(dev->_accel_async_report, dev->_accel_async_timestamp, dev->_accel_async_sequence);
+}
+
+void
+LSM303D::collect(RawReport &raw_accel_report, uint64_t timestamp, uint32_t sequence)
+{
+	accel_report accel_report;
+
 	/*
 	 * 1) Scale raw value to SI units using scaling from datasheet.
 	 * 2) Subtract static offset (in SI units)
@@ -1524,7 +1771,12 @@ LSM303D::measure()
 	 */
 
 
-	accel_report.timestamp = hrt_absolute_time();
+	/* check that no sample was lost or read twice since the last one */
+	if (sequence != 0)
+		_accel_drdy_tracker.collect(sequence);
+
+	/* samples triggered by the data-ready line carry the time of their edge */
+	accel_report.timestamp = (timestamp != 0) ? timestamp : hrt_absolute_time();
         accel_report.error_count = 0; // not reported
 
 	accel_report.x_raw = raw_accel_report.x;
@@ -1559,7 +1811,7 @@ LSM303D::measure()
 }
 
 void
-LSM303D::mag_measure()
+LSM303D::mag_measure(uint64_t timestamp, uint32_t sequence)
 {
 	if (read_reg(ADDR_CTRL_REG7) != _reg7_expected) {
 		perf_count(_reg7_resets);
@@ -1567,18 +1819,7 @@ LSM303D::mag_measure()
 		return;
 	}
 
-	/* status register and data as read back from the device */
-#pragma pack(push, 1)
-	struct {
-		uint8_t		cmd;
-		uint8_t		status;
-		int16_t		x;
-		int16_t		y;
-		int16_t		z;
-	} raw_mag_report;
-#pragma pack(pop)
-
-	mag_report mag_report;
+	RawReport raw_mag_report;
 
 	/* start the performance counter */
 	perf_begin(_mag_sample_perf);
@@ -1588,6 +1829,54 @@ LSM303D::mag_measure()
 	raw_mag_report.cmd = ADDR_STATUS_M | DIR_READ | ADDR_INCREMENT;
 	transfer((uint8_t *)&raw_mag_report, (uint8_t *)&raw_mag_report, sizeof(raw_mag_report));
 
+	mag_collect(raw_mag_report, timestamp, sequence);
+}
+
+void
+LSM303D::mag_measure_async(uint64_t timestamp, uint32_t sequence)
+{
+	/* the previous transfer has not been served yet, its buffer is busy */
+	if (_mag_async_transfer.pending)
+		return;
+
+	/* start the performance counter */
+	perf_begin(_mag_sample_perf);
+
+	_mag_async_timestamp = timestamp;
+	_mag_async_sequence = sequence;
+	memset(&_mag_async_report, 0, sizeof(_mag_async_report));
+	_mag_async_report.cmd = ADDR_STATUS_M | DIR_READ | ADDR_INCREMENT;
+
+	if (transfer_async(&_mag_async_transfer) != OK)
+		perf_cancel(_mag_sample_perf);
+}
+
+void
+LSM303D::mag_measure_complete(void *arg, int result)
+{
+	LSM303D *dev = (LSM303D *)arg;
+
+	if (result != OK) {
+		perf_cancel(dev->_mag_sample_perf);
+		return;
+	}
+
+	/* brownout check, on the worker thread register reads go straight to the bus */
+	if (dev->read_reg(ADDR_CTRL_REG7) != dev->_reg7_expected) {
+		perf_cancel(dev->_mag_sample_perf);
+		perf_count(dev->_reg7_resets);
+		dev->reset();
+		return;
+	}
+
+	dev->mag_collect(dev->_mag_async_report, dev->_mag_async_timestamp, dev->_mag_async_sequence);
+}
+
+void
+LSM303D::mag_collect(RawReport &raw_mag_report, uint64_t timestamp, uint32_t sequence)
+{
+	mag_report mag_report;
+
 	/*
 	 * 1) Scale raw value to SI units using scaling from datasheet.
 	 * 2) Subtract static offset (in SI units)
@@ -1604,7 +1893,12 @@ LSM303D::mag_measure()
 	 */
 
 
-	mag_report.timestamp = hrt_absolute_time();
+	/* check that no sample was lost or read twice since the last one */
+	if (sequence != 0)
+		_mag_drdy_tracker.collect(sequence);
+
+	/* samples triggered by the data-ready line carry the time of their edge */
+	mag_report.timestamp = (timestamp != 0) ? timestamp : hrt_absolute_time();
 
 	mag_report.x_raw = raw_mag_report.x;
 	mag_report.y_raw = raw_mag_report.y;
@@ -1637,6 +1931,22 @@ LSM303D::print_info()
 {
 	printf("accel reads:          %u\n", _accel_read);
 	printf("mag reads:            %u\n", _mag_read);
+	printf("polling %s\n", _async ? "through the SPI scheduler" : "in interrupt context");
+
+	if (_accel_drdy) {
+		printf("accel data-ready: %u samples, %u lost, %u duplicated, %u spurious edges, interval %u us\n",
+		       (unsigned)_accel_drdy_tracker.samples(), (unsigned)_accel_drdy_tracker.lost(),
+		       (unsigned)_accel_drdy_tracker.duplicates(), (unsigned)_accel_drdy_tracker.spurious(),
+		       _accel_drdy_tracker.interval());
+	}
+
+	if (_mag_drdy) {
+		printf("mag data-ready: %u samples, %u lost, %u duplicated, %u spurious edges, interval %u us\n",
+		       (unsigned)_mag_drdy_tracker.samples(), (unsigned)_mag_drdy_tracker.lost(),
+		       (unsigned)_mag_drdy_tracker.duplicates(), (unsigned)_mag_drdy_tracker.spurious(),
+		       _mag_drdy_tracker.interval());
+	}
+
 	perf_print_counter(_accel_sample_perf);
 	_accel_reports->print_info("accel reports");
 	_mag_reports->print_info("mag reports");
@@ -1717,6 +2027,7 @@ LSM303D_mag::LSM303D_mag(LSM303D *parent) :
 	CDev("LSM303D_mag", LSM303D_DEVICE_PATH_MAG),
 	_parent(parent),
 	_mag_topic(-1),
+	_mag_orb_class_instance(-1),
 	_mag_class_instance(-1)
 {
 }
@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file esc_batch.cpp
+ *
+ * Batched setpoint writes and status reads for I2C ESCs.
+ */
+
+#include <string.h>
+#include <errno.h>
+
+#include "esc_batch.h"
+
+ESC_Batch::ESC_Batch(batch_t batch, transfer_t transfer, result_t result, void *arg) :
+	_batch(batch),
+	_transfer(transfer),
+	_result(result),
+	_arg(arg),
+	_count(0),
+	_status_chan(0),
+	_cycle(0),
+	_batches(0),
+	_fallbacks(0)
+{
+}
+
+int
+ESC_Batch::queue(unsigned chan, uint16_t addr, const uint8_t *setpoint, unsigned len, unsigned status_len)
+{
+	if (_count >= ESC_BATCH_MAX)
+		return -ENOSPC;
+
+	if (len == 0 || len > ESC_BATCH_SETPOINT_MAX || status_len > ESC_BATCH_STATUS_MAX)
+		return -EINVAL;
+
+	Entry &entry = _entries[_count++];
+
+	entry.chan = chan;
+	entry.addr = addr;
+	memcpy(entry.setpoint, setpoint, len);
+	entry.setpoint_len = len;
+	entry.status_len = status_due(chan) ? status_len : 0;
+
+	return 0;
+}
+
+int
+ESC_Batch::flush(unsigned channels)
+{
+	Message msgv[2 * ESC_BATCH_MAX];
+	unsigned msgs = 0;
+	int ret = 0;
+
+	if (_count > 0) {
+		/* one write per ESC, plus the status read directly after its write */
+		for (unsigned i = 0; i < _count; i++) {
+			Entry &entry = _entries[i];
+
+			msgv[msgs].addr = entry.addr;
+			msgv[msgs].read = false;
+			msgv[msgs].buffer = &entry.setpoint[0];
+			msgv[msgs].length = entry.setpoint_len;
+			msgs++;
+
+			if (entry.status_len > 0) {
+				msgv[msgs].addr = entry.addr;
+				msgv[msgs].read = true;
+				msgv[msgs].buffer = &_status[0];
+				msgv[msgs].length = entry.status_len;
+				msgs++;
+			}
+		}
+
+		_batches++;
+		ret = _batch(_arg, &msgv[0], msgs);
+
+		for (unsigned i = 0; i < _count; i++) {
+			Entry &entry = _entries[i];
+			int result = 0;
+
+			/* an ESC that does not respond aborts the batch, retry one at a time */
+			if (ret != 0)
+				result = _transfer(_arg, entry.addr, &entry.setpoint[0], entry.setpoint_len,
+						   &_status[0], entry.status_len);
+
+			bool status = (result == 0) && (entry.status_len > 0);
+
+			_result(_arg, entry.chan, result, status ? &_status[0] : nullptr, status ? entry.status_len : 0);
+		}
+
+		if (ret != 0)
+			_fallbacks++;
+	}
+
+	/* advance the status read to the next ESC */
+	if (_cycle == 0 && channels > 0)
+		_status_chan = (_status_chan + 1) % channels;
+
+	_cycle = (_cycle + 1) % ESC_BATCH_STATUS_INTERVAL;
+	_count = 0;
+
+	return ret;
+}
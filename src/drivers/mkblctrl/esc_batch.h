@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file esc_batch.h
+ *
+ * Batched setpoint writes and status reads for I2C ESCs.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define ESC_BATCH_MAX			8	/**< ESCs per batch */
+#define ESC_BATCH_SETPOINT_MAX		2	/**< setpoint bytes per ESC */
+#define ESC_BATCH_STATUS_MAX		3	/**< status bytes read back */
+#define ESC_BATCH_STATUS_INTERVAL	2	/**< cycles between two status reads, one ESC per read */
+
+/**
+ * Collects the setpoints of one output cycle and sends them in a single
+ * bus transaction, so all ESCs are updated back-to-back.
+ *
+ * The status of one ESC is read right after its setpoint every
+ * ESC_BATCH_STATUS_INTERVAL cycles, in rotation over the channels. If the
+ * batch fails, the cycle falls back to one transfer per ESC, so the other
+ * ESCs still get their setpoint and the error is reported for the right one.
+ */
+class ESC_Batch
+{
+public:
+	/**
+	 * A message of the batch, a write or a read of one ESC.
+	 */
+	struct Message {
+		uint16_t	addr;
+		bool		read;
+		uint8_t		*buffer;
+		unsigned	length;
+	};
+
+	/**
+	 * Bus access; all messages in one transaction, separated by repeated starts.
+	 */
+	typedef int	(*batch_t)(void *arg, const Message *msgv, unsigned msgs);
+
+	/**
+	 * Bus access; write and optional read of a single ESC.
+	 */
+	typedef int	(*transfer_t)(void *arg, uint16_t addr, const uint8_t *send, unsigned send_len,
+				      uint8_t *recv, unsigned recv_len);
+
+	/**
+	 * Called for every queued ESC once the batch is done.
+	 *
+	 * @param chan		The channel of the ESC.
+	 * @param result	OK, or the error of its fallback transfer.
+	 * @param status	The status read back, or nullptr if none was due.
+	 * @param status_len	Number of status bytes.
+	 */
+	typedef void	(*result_t)(void *arg, unsigned chan, int result, const uint8_t *status, unsigned status_len);
+
+	ESC_Batch(batch_t batch, transfer_t transfer, result_t result, void *arg);
+
+	/**
+	 * Whether the status of a channel is read back in this cycle.
+	 */
+	bool			status_due(unsigned chan) const { return (_cycle == 0) && (chan == _status_chan); }
+
+	/**
+	 * Queue the setpoint of an ESC for this cycle.
+	 *
+	 * @param status_len	Number of status bytes to read back if due.
+	 * @return		OK, -ENOSPC if the batch is full, -EINVAL for an oversized setpoint.
+	 */
+	int			queue(unsigned chan, uint16_t addr, const uint8_t *setpoint, unsigned len,
+				      unsigned status_len);
+
+	/**
+	 * Send the queued setpoints and advance the status rotation.
+	 *
+	 * @param channels	Number of channels the status reads rotate over.
+	 * @return		OK, or the error of the batch if it fell back.
+	 */
+	int			flush(unsigned channels);
+
+	unsigned		queued() const { return _count; }
+	uint32_t		batches() const { return _batches; }
+	uint32_t		fallbacks() const { return _fallbacks; }
+
+private:
+	struct Entry {
+		unsigned	chan;
+		uint16_t	addr;
+		uint8_t		setpoint[ESC_BATCH_SETPOINT_MAX];
+		uint8_t		setpoint_len;
+		uint8_t		status_len;
+	};
+
+	batch_t			_batch;
+	transfer_t		_transfer;
+	result_t		_result;
+	void			*_arg;
+
+	Entry			_entries[ESC_BATCH_MAX];
+	unsigned		_count;
+	uint8_t			_status[ESC_BATCH_STATUS_MAX];
+	unsigned		_status_chan;
+	unsigned		_cycle;
+
+	uint32_t		_batches;
+	uint32_t		_fallbacks;
+};
@@ -70,6 +70,7 @@
 
 #include <systemlib/systemlib.h>
 #include <systemlib/err.h>
+#include <systemlib/perf_counter.h>
 #include <systemlib/mixer/mixer.h>
 #include <drivers/drv_mixer.h>
 
@@ -78,6 +79,8 @@
 #include <uORB/topics/actuator_armed.h>
 #include <uORB/topics/esc_status.h>
 
+#include "esc_batch.h"
+
 #include <systemlib/err.h>
 
 #define I2C_BUS_SPEED					400000
@@ -154,6 +157,14 @@ private:
 
 	actuator_controls_s _controls;
 
+	/**
+	 * Setpoint writes queued for the current cycle, sent as one I2C batch.
+	 */
+	ESC_Batch	_batch;
+
+	perf_counter_t	_perf_bus;
+	perf_counter_t	_perf_bus_errors;
+
 	static void	task_main_trampoline(int argc, char *argv[]);
 	void		task_main() __attribute__((noreturn));
 
@@ -174,7 +185,17 @@ private:
 	static const unsigned	_ngpio;
 
 	int			mk_servo_arm(bool status);
+	unsigned	mk_servo_setpoint(unsigned int chan, short val, uint8_t *msg);
+	void		mk_servo_debug();
 	int 		mk_servo_set(unsigned int chan, short val);
+	void		mk_servo_queue(unsigned int chan, short val);
+	int		mk_servo_flush();
+	void		mk_servo_telemetry(unsigned int chan, const uint8_t *result);
+
+	static int	batch_transfer(void *arg, const ESC_Batch::Message *msgv, unsigned msgs);
+	static int	batch_transfer_single(void *arg, uint16_t addr, const uint8_t *send, unsigned send_len,
+					      uint8_t *recv, unsigned recv_len);
+	static void	batch_result(void *arg, unsigned chan, int result, const uint8_t *status, unsigned status_len);
 	int 		mk_servo_set_value(unsigned int chan, short val);
 	int 		mk_servo_test(unsigned int chan);
 	short		scaling(float val, float inMin, float inMax, float outMin, float outMax);
@@ -237,7 +258,10 @@ MK::MK(int bus, const char *_device_path) :
 	_primary_pwm_device(false),
 	_task_should_exit(false),
 	_armed(false),
-	_mixers(nullptr)
+	_mixers(nullptr),
+	_batch(&MK::batch_transfer, &MK::batch_transfer_single, &MK::batch_result, this),
+	_perf_bus(perf_alloc(PC_ELAPSED, "mkblctrl_i2c")),
+	_perf_bus_errors(perf_alloc(PC_COUNT, "mkblctrl_i2c_err"))
 {
 	strncpy(_device, _device_path, sizeof(_device));
 	/* enforce null termination */
@@ -271,6 +295,9 @@ MK::~MK()
 	if (_primary_pwm_device)
 		unregister_driver(_device);
 
+	perf_free(_perf_bus);
+	perf_free(_perf_bus_errors);
+
 	g_mk = nullptr;
 }
 
@@ -570,11 +597,14 @@ MK::task_main()
 						//mk_servo_set_value(i, scaling(outputs.output[i], -1.0f, 1.0f, 0, 1024));	// scale the output to 0 - 1024 and sent to output routine
 						// 11 Bit
 						Motor[i].SetPoint_PX4 = outputs.output[i];
-						mk_servo_set(i, scaling(outputs.output[i], -1.0f, 1.0f, 0, 2047));	// scale the output to 0 - 2047 and sent to output routine
+						mk_servo_queue(i, scaling(outputs.output[i], -1.0f, 1.0f, 0, 2047));	// scale the output to 0 - 2047 and queue it for the output batch
 					}
 
 				}
 
+				/* send all motor setpoints of this cycle back-to-back */
+				mk_servo_flush();
+
 			}
 
 
@@ -732,17 +762,10 @@ MK::mk_check_for_blctrl(unsigned int count, bool showOutput, bool initI2C)
 	return foundMotorCount;
 }
 
-int
-MK::mk_servo_set(unsigned int chan, short val)
+unsigned
+MK::mk_servo_setpoint(unsigned int chan, short val, uint8_t *msg)
 {
-	short tmpVal = 0;
-	_retries = 0;
-	uint8_t result[3] = { 0, 0, 0 };
-	uint8_t msg[2] = { 0, 0 };
-	uint8_t rod = 0;
-	uint8_t bytesToSendBL2 = 2;
-
-	tmpVal = val;
+	short tmpVal = val;
 
 	if (tmpVal > 2047) {
 		tmpVal = 2047;
@@ -759,86 +782,156 @@ MK::mk_servo_set(unsigned int chan, short val)
 		Motor[chan].SetPointLowerBits = 0;
 	}
 
-	//if(Motor[chan].State & MOTOR_STATE_PRESENT_MASK) {
-	set_address(BLCTRL_BASE_ADDR + (chan + addrTranslator[chan]));
+	msg[0] = Motor[chan].SetPoint;
+	msg[1] = Motor[chan].SetPointLowerBits;
 
 	if (Motor[chan].Version == BLCTRL_OLD) {
-		/*
-		*	Old BL-Ctrl 8Bit served. Version < 2.0
-		*/
-		msg[0] = Motor[chan].SetPoint;
+		/* old BL-Ctrl 8Bit served. Version < 2.0 */
+		return 1;
+	}
 
-		if (Motor[chan].RoundCount >= 16) {
-			// on each 16th cyle we read out the status messages from the blctrl
-			if (OK == transfer(&msg[0], 1, &result[0], 2)) {
-				Motor[chan].Current = result[0];
-				Motor[chan].MaxPWM = result[1];
-				Motor[chan].Temperature = 255;;
+	/* new BL-Ctrl 11Bit served. Version >= 2.0, if setpoint lower bits are zero, we send only the higher bits - this saves time */
+	return (Motor[chan].SetPointLowerBits == 0) ? 1 : 2;
+}
 
-			} else {
-				if ((Motor[chan].State & MOTOR_STATE_ERROR_MASK) < MOTOR_STATE_ERROR_MASK) Motor[chan].State++;	// error
-			}
+void
+MK::mk_servo_debug()
+{
+	if (showDebug == true) {
+		debugCounter++;
 
-			Motor[chan].RoundCount = 0;
+		if (debugCounter == 2000) {
+			debugCounter = 0;
 
-		} else {
-			if (OK != transfer(&msg[0], 1, nullptr, 0)) {
-				if ((Motor[chan].State & MOTOR_STATE_ERROR_MASK) < MOTOR_STATE_ERROR_MASK) Motor[chan].State++;	// error
+			for (int i = 0; i < _num_outputs; i++) {
+				if (Motor[i].State & MOTOR_STATE_PRESENT_MASK) {
+					fprintf(stderr, "[mkblctrl] #%i:\tVer: %i\tVal: %i\tCurr: %i\tMaxPWM: %i\tTemp: %i\tState: %i\n", i, Motor[i].Version, Motor[i].SetPoint, Motor[i].Current, Motor[i].MaxPWM, Motor[i].Temperature, Motor[i].State);
+				}
 			}
-		}
 
-	} else {
-		/*
-		*	New BL-Ctrl 11Bit served. Version >= 2.0
-		*/
-		msg[0] = Motor[chan].SetPoint;
-		msg[1] = Motor[chan].SetPointLowerBits;
-
-		if (Motor[chan].SetPointLowerBits == 0) {
-			bytesToSendBL2 = 1;	// if setpoint lower bits are zero, we send only the higher bits - this saves time
+			fprintf(stderr, "\n");
 		}
+	}
+}
 
-		if (Motor[chan].RoundCount >= 16) {
-			// on each 16th cyle we read out the status messages from the blctrl
-			if (OK == transfer(&msg[0], bytesToSendBL2, &result[0], 3)) {
-				Motor[chan].Current = result[0];
-				Motor[chan].MaxPWM = result[1];
-				Motor[chan].Temperature = result[2];
+int
+MK::mk_servo_set(unsigned int chan, short val)
+{
+	_retries = 0;
+	uint8_t result[3] = { 0, 0, 0 };
+	uint8_t msg[2] = { 0, 0 };
+	unsigned len = mk_servo_setpoint(chan, val, &msg[0]);
 
-			} else {
-				if ((Motor[chan].State & MOTOR_STATE_ERROR_MASK) < MOTOR_STATE_ERROR_MASK) Motor[chan].State++;	// error
-			}
+	//if(Motor[chan].State & MOTOR_STATE_PRESENT_MASK) {
+	set_address(BLCTRL_BASE_ADDR + (chan + addrTranslator[chan]));
 
-			Motor[chan].RoundCount = 0;
+	if (Motor[chan].RoundCount >= 16) {
+		// on each 16th cyle we read out the status messages from the blctrl
+		if (OK == transfer(&msg[0], len, &result[0], (Motor[chan].Version == BLCTRL_OLD) ? 2 : 3)) {
+			mk_servo_telemetry(chan, &result[0]);
 
 		} else {
-			if (OK != transfer(&msg[0], bytesToSendBL2, nullptr, 0)) {
-				if ((Motor[chan].State & MOTOR_STATE_ERROR_MASK) < MOTOR_STATE_ERROR_MASK) Motor[chan].State++;	// error
-			}
+			if ((Motor[chan].State & MOTOR_STATE_ERROR_MASK) < MOTOR_STATE_ERROR_MASK) Motor[chan].State++;	// error
 		}
 
+		Motor[chan].RoundCount = 0;
+
+	} else {
+		if (OK != transfer(&msg[0], len, nullptr, 0)) {
+			if ((Motor[chan].State & MOTOR_STATE_ERROR_MASK) < MOTOR_STATE_ERROR_MASK) Motor[chan].State++;	// error
+		}
 	}
 
 	Motor[chan].RoundCount++;
 	//}
 
-	if (showDebug == true) {
-		debugCounter++;
+	mk_servo_debug();
 
-		if (debugCounter == 2000) {
-			debugCounter = 0;
+	return 0;
+}
 
-			for (int i = 0; i < _num_outputs; i++) {
-				if (Motor[i].State & MOTOR_STATE_PRESENT_MASK) {
-					fprintf(stderr, "[mkblctrl] #%i:\tVer: %i\tVal: %i\tCurr: %i\tMaxPWM: %i\tTemp: %i\tState: %i\n", i, Motor[i].Version, Motor[i].SetPoint, Motor[i].Current, Motor[i].MaxPWM, Motor[i].Temperature, Motor[i].State);
-				}
-			}
+void
+MK::mk_servo_queue(unsigned int chan, short val)
+{
+	uint8_t setpoint[2];
+	unsigned len = mk_servo_setpoint(chan, val, &setpoint[0]);
 
-			fprintf(stderr, "\n");
-		}
+	/* the batch picks the ESC to read the status from, batch_result() resets the count */
+	_batch.queue(chan, BLCTRL_BASE_ADDR + (chan + addrTranslator[chan]), &setpoint[0], len,
+		     (Motor[chan].Version == BLCTRL_OLD) ? 2 : 3);
+
+	Motor[chan].RoundCount++;
+
+	mk_servo_debug();
+}
+
+int
+MK::mk_servo_flush()
+{
+	return _batch.flush(_num_outputs);
+}
+
+int
+MK::batch_transfer(void *arg, const ESC_Batch::Message *msgv, unsigned msgs)
+{
+	MK *mk = reinterpret_cast<MK *>(arg);
+	i2c_msg_s i2c_msgv[2 * ESC_BATCH_MAX];
+
+	for (unsigned i = 0; i < msgs && i < 2 * ESC_BATCH_MAX; i++) {
+		i2c_msgv[i].addr = msgv[i].addr;
+		i2c_msgv[i].flags = msgv[i].read ? I2C_M_READ : 0;
+		i2c_msgv[i].buffer = msgv[i].buffer;
+		i2c_msgv[i].length = msgv[i].length;
 	}
 
-	return 0;
+	perf_begin(mk->_perf_bus);
+	int ret = mk->transfer_batch(&i2c_msgv[0], msgs);
+	perf_end(mk->_perf_bus);
+
+	if (ret != OK)
+		perf_count(mk->_perf_bus_errors);
+
+	return ret;
+}
+
+int
+MK::batch_transfer_single(void *arg, uint16_t addr, const uint8_t *send, unsigned send_len,
+			  uint8_t *recv, unsigned recv_len)
+{
+	MK *mk = reinterpret_cast<MK *>(arg);
+
+	mk->_retries = 0;
+	mk->set_address(addr);
+
+	return mk->transfer(send, send_len, recv, recv_len);
+}
+
+void
+MK::batch_result(void *arg, unsigned chan, int result, const uint8_t *status, unsigned status_len)
+{
+	MK *mk = reinterpret_cast<MK *>(arg);
+
+	if (result != OK) {
+		if ((Motor[chan].State & MOTOR_STATE_ERROR_MASK) < MOTOR_STATE_ERROR_MASK) Motor[chan].State++;	// error
+
+	} else if (status != nullptr) {
+		mk->mk_servo_telemetry(chan, status);
+		Motor[chan].RoundCount = 0;
+	}
+}
+
+void
+MK::mk_servo_telemetry(unsigned int chan, const uint8_t *result)
+{
+	Motor[chan].Current = result[0];
+	Motor[chan].MaxPWM = result[1];
+
+	if (Motor[chan].Version == BLCTRL_OLD) {
+		Motor[chan].Temperature = 255;
+
+	} else {
+		Motor[chan].Temperature = result[2];
+	}
 }
 
 int
@@ -1062,7 +1155,7 @@ MK::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 
 	case MIXERIOCLOADBUF: {
 			const char *buf = (const char *)arg;
-			unsigned buflen = strnlen(buf, 1024);
+			unsigned buflen = mixer_buf_length(buf, 1024);
 
 			if (_mixers == nullptr)
 				_mixers = new MixerGroup(control_callback, (uintptr_t)&_controls);
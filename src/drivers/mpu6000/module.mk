@@ -40,4 +40,5 @@ MODULE_COMMAND	= mpu6000
 # XXX seems excessive, check if 2048 is not sufficient
 MODULE_STACKSIZE	 = 4096
 
-SRCS		= mpu6000.cpp
+SRCS		= mpu6000.cpp \
+		  mpu6000_fifo.cpp
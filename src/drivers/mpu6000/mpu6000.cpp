@@ -67,11 +67,15 @@
 #include <drivers/drv_hrt.h>
 
 #include <drivers/device/spi.h>
+#include <drivers/device/spi_bus.h>
+#include <drivers/device/sample_tracker.h>
 #include <drivers/device/ringbuffer.h>
 #include <drivers/drv_accel.h>
 #include <drivers/drv_gyro.h>
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
 
+#include "mpu6000_fifo.h"
+
 #define DIR_READ			0x80
 #define DIR_WRITE			0x00
 
@@ -105,9 +109,6 @@
 #define MPUREG_USER_CTRL		0x6A
 #define MPUREG_PWR_MGMT_1		0x6B
 #define MPUREG_PWR_MGMT_2		0x6C
-#define MPUREG_FIFO_COUNTH		0x72
-#define MPUREG_FIFO_COUNTL		0x73
-#define MPUREG_FIFO_R_W			0x74
 #define MPUREG_PRODUCT_ID		0x0C
 
 // Configuration bits MPU 3000 and MPU 6000 (not revised)?
@@ -134,6 +135,9 @@
 #define BIT_INT_ANYRD_2CLEAR		0x10
 #define BIT_RAW_RDY_EN			0x01
 #define BIT_I2C_IF_DIS			0x10
+#define BIT_FIFO_EN			0x40
+#define BIT_FIFO_RESET			0x04
+#define BITS_FIFO_EN_SENSORS		0xF8	/* temperature, gyro X/Y/Z and accel */
 #define BIT_INT_STATUS_DATA		0x01
 
 // Product ID Description for MPU6000
@@ -172,6 +176,16 @@
 #define MPU6000_LOW_BUS_SPEED				1000*1000
 #define MPU6000_HIGH_BUS_SPEED				10*1000*1000
 
+/*
+  boards that route the INT pin to an EXTI capable input can trigger
+  measurements from it (SENSOR_POLLRATE_EXTERNAL)
+ */
+#ifdef GPIO_EXTI_MPU_DRDY
+# define MPU6000_USE_DRDY 1
+#else
+# define MPU6000_USE_DRDY 0
+#endif
+
 class MPU6000_gyro;
 
 class MPU6000 : public device::SPI
@@ -205,12 +219,51 @@ private:
 	struct hrt_call		_call;
 	unsigned		_call_interval;
 
+#pragma pack(push, 1)
+	/**
+	 * Report conversation within the MPU6000, including command byte and
+	 * interrupt status.
+	 */
+	struct MPUReport {
+		uint8_t		cmd;
+		uint8_t		status;
+		uint8_t		accel_x[2];
+		uint8_t		accel_y[2];
+		uint8_t		accel_z[2];
+		uint8_t		temp[2];
+		uint8_t		gyro_x[2];
+		uint8_t		gyro_y[2];
+		uint8_t		gyro_z[2];
+	};
+#pragma pack(pop)
+
+	bool			_async;		/**< measurements are queued to the bus scheduler */
+	MPUReport		_async_report;
+	device::SPITransaction	_async_transfer;
+	uint64_t		_async_timestamp;
+	uint32_t		_async_sequence;
+
+	bool			_drdy;		/**< measurements are triggered by the data-ready line */
+	device::SampleTracker	_drdy_tracker;
+	static MPU6000		*_drdy_instance;
+
+	bool			_fifo;		/**< samples are drained from the FIFO in bursts */
+	MPU6000_FIFO		_fifo_reader;
+	uint8_t			_fifo_count[3];	/**< FIFO byte count read through the bus scheduler */
+	device::SPITransaction	_fifo_transfer;
+	uint64_t		_fifo_timestamp;
+	unsigned		_fifo_reported;	/**< samples of the current burst that made it to the buffers */
+	accel_report		_fifo_accel;	/**< newest samples of the current burst */
+	gyro_report		_fifo_gyro;
+	perf_counter_t		_fifo_overflows;
+
 	RingBuffer		*_accel_reports;
 
 	struct accel_scale	_accel_scale;
 	float			_accel_range_scale;
 	float			_accel_range_m_s2;
 	orb_advert_t		_accel_topic;
+	int			_accel_orb_class_instance;
 	int			_accel_class_instance;
 
 	RingBuffer		*_gyro_reports;
@@ -261,10 +314,83 @@ private:
 	 */
 	static void		measure_trampoline(void *arg);
 
+	/**
+	 * Data-ready interrupt handler; timestamps the edge and starts a
+	 * measurement for it.
+	 */
+	static int		data_ready_interrupt(int irq, void *context);
+
 	/**
 	 * Fetch measurements from the sensor and update the report buffers.
+	 *
+	 * @param timestamp	Data-ready edge of the sample, or zero to
+	 *			timestamp it when it is read.
+	 * @param sequence	Sequence number of the edge, zero if untracked.
+	 */
+	void			measure(uint64_t timestamp = 0, uint32_t sequence = 0);
+
+	/**
+	 * Queue a measurement to the bus scheduler; called from the hrt or
+	 * the data-ready interrupt.
+	 */
+	void			measure_async(uint64_t timestamp = 0, uint32_t sequence = 0);
+
+	/**
+	 * Completion of a queued measurement, on the bus worker thread.
 	 */
-	void			measure();
+	static void		measure_complete(void *arg, int result);
+
+	/**
+	 * Convert a measurement and update the report buffers.
+	 */
+	void			collect(MPUReport &mpu_report, uint64_t timestamp, uint32_t sequence);
+
+	/**
+	 * Convert one sample and put it into the report buffers.
+	 *
+	 * @param data		Sample in the layout of the data registers,
+	 *			starting at ACCEL_XOUT_H.
+	 * @param timestamp	Time of the sample.
+	 * @param arb		Returns the accel report.
+	 * @param grb		Returns the gyro report.
+	 * @return		false if the sample was all zero, likely a bus error.
+	 */
+	bool			process_sample(const uint8_t *data, uint64_t timestamp, accel_report &arb, gyro_report &grb);
+
+	/**
+	 * Notify readers and publish the newest reports.
+	 */
+	void			publish(const accel_report &arb, const gyro_report &grb);
+
+	/**
+	 * Enable or disable the FIFO, discarding its contents.
+	 */
+	void			fifo_enable(bool enable);
+
+	/**
+	 * Drain the FIFO and process every sample in it; called from the hrt.
+	 */
+	void			measure_fifo();
+
+	/**
+	 * Queue a FIFO count read to the bus scheduler; the FIFO is then
+	 * drained on the bus worker thread.
+	 */
+	void			measure_fifo_async();
+	static void		measure_fifo_complete(void *arg, int result);
+
+	/**
+	 * Handle the result of draining the FIFO.
+	 *
+	 * @param ret		Number of samples read or a negative error.
+	 */
+	void			fifo_done(int ret);
+
+	/**
+	 * Bus access and sample callbacks for the FIFO reader.
+	 */
+	static int		fifo_transfer(void *arg, uint8_t *buf, unsigned len);
+	static void		fifo_sample(void *arg, const uint8_t *sample, unsigned index, unsigned count);
 
 	/**
 	 * Read a register from the MPU6000
@@ -362,6 +488,7 @@ protected:
 private:
 	MPU6000			*_parent;
 	orb_advert_t		_gyro_topic;
+	int			_gyro_orb_class_instance;
 	int			_gyro_class_instance;
 
 };
@@ -369,15 +496,27 @@ private:
 /** driver 'main' command */
 extern "C" { __EXPORT int mpu6000_main(int argc, char *argv[]); }
 
+MPU6000 *MPU6000::_drdy_instance = nullptr;
+
 MPU6000::MPU6000(int bus, spi_dev_e device) :
 	SPI("MPU6000", MPU_DEVICE_PATH_ACCEL, bus, device, SPIDEV_MODE3, MPU6000_LOW_BUS_SPEED),
 	_gyro(new MPU6000_gyro(this)),
 	_product(0),
 	_call_interval(0),
+	_async(false),
+	_async_timestamp(0),
+	_async_sequence(0),
+	_drdy(false),
+	_fifo(false),
+	_fifo_reader(&MPU6000::fifo_transfer, &MPU6000::fifo_sample, this),
+	_fifo_timestamp(0),
+	_fifo_reported(0),
+	_fifo_overflows(perf_alloc(PC_COUNT, "mpu6000_fifo_overflows")),
 	_accel_reports(nullptr),
 	_accel_range_scale(0.0f),
 	_accel_range_m_s2(0.0f),
 	_accel_topic(-1),
+	_accel_orb_class_instance(-1),
 	_accel_class_instance(-1),
 	_gyro_reports(nullptr),
 	_gyro_range_scale(0.0f),
@@ -415,6 +554,19 @@ MPU6000::MPU6000(int bus, spi_dev_e device) :
 	_gyro_scale.z_scale  = 1.0f;
 
 	memset(&_call, 0, sizeof(_call));
+	memset(&_async_transfer, 0, sizeof(_async_transfer));
+	_async_transfer.send = (uint8_t *)&_async_report;
+	_async_transfer.recv = (uint8_t *)&_async_report;
+	_async_transfer.len = sizeof(_async_report);
+	_async_transfer.callback = &MPU6000::measure_complete;
+	_async_transfer.arg = this;
+
+	memset(&_fifo_transfer, 0, sizeof(_fifo_transfer));
+	_fifo_transfer.send = &_fifo_count[0];
+	_fifo_transfer.recv = &_fifo_count[0];
+	_fifo_transfer.len = sizeof(_fifo_count);
+	_fifo_transfer.callback = &MPU6000::measure_fifo_complete;
+	_fifo_transfer.arg = this;
 }
 
 MPU6000::~MPU6000()
@@ -440,6 +592,7 @@ MPU6000::~MPU6000()
 	perf_free(_gyro_reads);
 	perf_free(_bad_transfers);
 	perf_free(_good_transfers);
+	perf_free(_fifo_overflows);
 }
 
 int
@@ -456,6 +609,12 @@ MPU6000::init()
 		return ret;
 	}
 
+	/* poll through the bus scheduler, the highest priority device on the bus */
+	_async = (enable_async(device::SPIBus::PRIORITY_HIGHEST) == OK);
+
+	if (!_async)
+		debug("no SPI scheduler, polling in interrupt context");
+
 	/* allocate basic report buffers */
 	_accel_reports = new RingBuffer(2, sizeof(accel_report));
 	if (_accel_reports == nullptr)
@@ -494,32 +653,24 @@ MPU6000::init()
 
 	measure();
 
-	if (_accel_class_instance == CLASS_DEVICE_PRIMARY) {
-
-		/* advertise sensor topic, measure manually to initialize valid report */
-		struct accel_report arp;
-		_accel_reports->get(&arp);
+	/* advertise sensor topic, measure manually to initialize valid report */
+	struct accel_report arp;
+	_accel_reports->get(&arp);
 
-		/* measurement will have generated a report, publish */
-		_accel_topic = orb_advertise(ORB_ID(sensor_accel), &arp);
+	/* measurement will have generated a report, publish */
+	_accel_topic = orb_advertise_multi(ORB_ID(sensor_accel), &arp, &_accel_orb_class_instance);
 
-		if (_accel_topic < 0)
-			debug("failed to create sensor_accel publication");
-
-	}
+	if (_accel_topic < 0)
+		debug("failed to create sensor_accel publication");
 
-	if (_gyro->_gyro_class_instance == CLASS_DEVICE_PRIMARY) {
+	/* advertise sensor topic, measure manually to initialize valid report */
+	struct gyro_report grp;
+	_gyro_reports->get(&grp);
 
-		/* advertise sensor topic, measure manually to initialize valid report */
-		struct gyro_report grp;
-		_gyro_reports->get(&grp);
+	_gyro->_gyro_topic = orb_advertise_multi(ORB_ID(sensor_gyro), &grp, &_gyro->_gyro_orb_class_instance);
 
-		_gyro->_gyro_topic = orb_advertise(ORB_ID(sensor_gyro), &grp);
-
-		if (_gyro->_gyro_topic < 0)
-			debug("failed to create sensor_gyro publication");
-
-	}
+	if (_gyro->_gyro_topic < 0)
+		debug("failed to create sensor_gyro publication");
 
 out:
 	return ret;
@@ -656,6 +807,11 @@ MPU6000::_set_sample_rate(uint16_t desired_sample_rate_hz)
   if(div<1) div=1;
   write_reg(MPUREG_SMPLRT_DIV, div-1);
   _sample_rate = 1000 / div;
+
+  /* data-ready edges follow the output rate */
+  _drdy_tracker.set_interval(1000000 / _sample_rate);
+  if (_drdy)
+	  _call_interval = 1000000 / _sample_rate;
 }
 
 /*
@@ -838,10 +994,26 @@ MPU6000::ioctl(struct file *filp, int cmd, unsigned long arg)
 			case SENSOR_POLLRATE_MANUAL:
 				stop();
 				_call_interval = 0;
+				_drdy = false;
 				return OK;
 
-				/* external signalling not supported */
+				/* sample on the data-ready line, at the sensor output rate */
 			case SENSOR_POLLRATE_EXTERNAL:
+#if MPU6000_USE_DRDY
+				stop();
+				_drdy = true;
+				_call_interval = 1000000 / _sample_rate;
+				_accel_filter_x.set_cutoff_frequency(_sample_rate, _accel_filter_x.get_cutoff_freq());
+				_accel_filter_y.set_cutoff_frequency(_sample_rate, _accel_filter_y.get_cutoff_freq());
+				_accel_filter_z.set_cutoff_frequency(_sample_rate, _accel_filter_z.get_cutoff_freq());
+				_gyro_filter_x.set_cutoff_frequency(_sample_rate, _gyro_filter_x.get_cutoff_freq());
+				_gyro_filter_y.set_cutoff_frequency(_sample_rate, _gyro_filter_y.get_cutoff_freq());
+				_gyro_filter_z.set_cutoff_frequency(_sample_rate, _gyro_filter_z.get_cutoff_freq());
+				start();
+				return OK;
+#else
+				return -EINVAL;
+#endif
 
 				/* zero would be bad */
 			case 0:
@@ -856,9 +1028,6 @@ MPU6000::ioctl(struct file *filp, int cmd, unsigned long arg)
 
 				/* adjust to a legal polling interval in Hz */
 			default: {
-					/* do we need to start internal polling? */
-					bool want_start = (_call_interval == 0);
-
 					/* convert hz to hrt interval via microseconds */
 					unsigned ticks = 1000000 / arg;
 
@@ -866,6 +1035,10 @@ MPU6000::ioctl(struct file *filp, int cmd, unsigned long arg)
 					if (ticks < 1000)
 						return -EINVAL;
 
+					/* do we need to start internal polling? Entering or leaving FIFO mode restarts it too */
+					bool want_start = (_call_interval == 0) || _drdy || _fifo ||
+							  (ticks > 1000000 / _sample_rate);
+
 					// adjust filters
 					float cutoff_freq_hz = _accel_filter_x.get_cutoff_freq();
 					float sample_rate = 1.0e6f/ticks;
@@ -879,6 +1052,12 @@ MPU6000::ioctl(struct file *filp, int cmd, unsigned long arg)
 					_gyro_filter_y.set_cutoff_frequency(sample_rate, cutoff_freq_hz_gyro);
 					_gyro_filter_z.set_cutoff_frequency(sample_rate, cutoff_freq_hz_gyro);
 
+					/* leaving data-ready sampling */
+					if (_drdy) {
+						stop();
+						_drdy = false;
+					}
+
 					/* update interval for next measurement */
 					/* XXX this is a bit shady, but no other way to adjust... */
 					_call.period = _call_interval = ticks;
@@ -896,6 +1075,9 @@ MPU6000::ioctl(struct file *filp, int cmd, unsigned long arg)
 		if (_call_interval == 0)
 			return SENSOR_POLLRATE_MANUAL;
 
+		if (_drdy)
+			return SENSOR_POLLRATE_EXTERNAL;
+
 		return 1000000 / _call_interval;
 
 	case SENSORIOCSQUEUEDEPTH: {
@@ -1153,6 +1335,49 @@ MPU6000::start()
 	_accel_reports->flush();
 	_gyro_reports->flush();
 
+#if MPU6000_USE_DRDY
+	/* or on the rising edge of the data-ready line */
+	if (_drdy) {
+		_drdy_tracker.reset();
+		_drdy_instance = this;
+		stm32_gpiosetevent(GPIO_EXTI_MPU_DRDY, true, false, true, &MPU6000::data_ready_interrupt);
+		return;
+	}
+#endif
+
+	/*
+	 * Polling slower than the sensor samples drains the FIFO in bursts,
+	 * so every sample still makes it to the report buffers.
+	 */
+	if (_call_interval > 1000000 / _sample_rate) {
+		_fifo = true;
+
+		_accel_filter_x.set_cutoff_frequency(_sample_rate, _accel_filter_x.get_cutoff_freq());
+		_accel_filter_y.set_cutoff_frequency(_sample_rate, _accel_filter_y.get_cutoff_freq());
+		_accel_filter_z.set_cutoff_frequency(_sample_rate, _accel_filter_z.get_cutoff_freq());
+		_gyro_filter_x.set_cutoff_frequency(_sample_rate, _gyro_filter_x.get_cutoff_freq());
+		_gyro_filter_y.set_cutoff_frequency(_sample_rate, _gyro_filter_y.get_cutoff_freq());
+		_gyro_filter_z.set_cutoff_frequency(_sample_rate, _gyro_filter_z.get_cutoff_freq());
+
+		/* room for a whole burst */
+		unsigned depth = _call_interval / (1000000 / _sample_rate) + 1;
+
+		if (depth > 100)
+			depth = 100;
+
+		irqstate_t flags = irqsave();
+
+		if (_accel_reports->size() < depth)
+			_accel_reports->resize(depth);
+
+		if (_gyro_reports->size() < depth)
+			_gyro_reports->resize(depth);
+
+		irqrestore(flags);
+
+		fifo_enable(true);
+	}
+
 	/* start polling at the specified rate */
 	hrt_call_every(&_call, 1000, _call_interval, (hrt_callout)&MPU6000::measure_trampoline, this);
 }
@@ -1161,6 +1386,22 @@ void
 MPU6000::stop()
 {
 	hrt_cancel(&_call);
+
+#if MPU6000_USE_DRDY
+	if (_drdy_instance == this) {
+		stm32_gpiosetevent(GPIO_EXTI_MPU_DRDY, false, false, false, nullptr);
+		_drdy_instance = nullptr;
+	}
+#endif
+
+	/* a queued measurement still uses our buffers */
+	while (_async_transfer.pending || _fifo_transfer.pending)
+		usleep(1000);
+
+	if (_fifo) {
+		fifo_enable(false);
+		_fifo = false;
+	}
 }
 
 void
@@ -1169,39 +1410,80 @@ MPU6000::measure_trampoline(void *arg)
 	MPU6000 *dev = reinterpret_cast<MPU6000 *>(arg);
 
 	/* make another measurement */
-	dev->measure();
+	if (dev->_fifo) {
+		if (dev->_async) {
+			dev->measure_fifo_async();
+
+		} else {
+			dev->measure_fifo();
+		}
+
+	} else if (dev->_async) {
+		dev->measure_async();
+
+	} else {
+		dev->measure();
+	}
+}
+
+int
+MPU6000::data_ready_interrupt(int irq, void *context)
+{
+	MPU6000 *dev = _drdy_instance;
+
+	if (dev != nullptr) {
+		hrt_abstime now = hrt_absolute_time();
+		uint32_t sequence = dev->_drdy_tracker.edge(now);
+
+		if (dev->_async) {
+			dev->measure_async(now, sequence);
+
+		} else {
+			dev->measure(now, sequence);
+		}
+	}
+
+	return OK;
 }
 
 void
-MPU6000::measure()
+MPU6000::measure_async(uint64_t timestamp, uint32_t sequence)
 {
-#pragma pack(push, 1)
-	/**
-	 * Report conversation within the MPU6000, including command byte and
-	 * interrupt status.
-	 */
-	struct MPUReport {
-		uint8_t		cmd;
-		uint8_t		status;
-		uint8_t		accel_x[2];
-		uint8_t		accel_y[2];
-		uint8_t		accel_z[2];
-		uint8_t		temp[2];
-		uint8_t		gyro_x[2];
-		uint8_t		gyro_y[2];
-		uint8_t		gyro_z[2];
-	} mpu_report;
-#pragma pack(pop)
+	/* the previous transfer has not been served yet, its buffer is busy */
+	if (_async_transfer.pending)
+		return;
 
-	struct Report {
-		int16_t		accel_x;
-		int16_t		accel_y;
-		int16_t		accel_z;
-		int16_t		temp;
-		int16_t		gyro_x;
-		int16_t		gyro_y;
-		int16_t		gyro_z;
-	} report;
+	/* start measuring */
+	perf_begin(_sample_perf);
+
+	_async_timestamp = timestamp;
+	_async_sequence = sequence;
+	_async_report.cmd = DIR_READ | MPUREG_INT_STATUS;
+
+	// sensor transfer at high clock speed
+	set_frequency(MPU6000_HIGH_BUS_SPEED);
+
+	if (transfer_async(&_async_transfer) != OK)
+		perf_cancel(_sample_perf);
+}
+
+void
+MPU6000::measure_complete(void *arg, int result)
+{
+	MPU6000 *dev = reinterpret_cast<MPU6000 *>(arg);
+
+	if (result != OK) {
+		perf_cancel(dev->_sample_perf);
+		return;
+	}
+
+	dev->collect(dev->_async_report, dev->_async_timestamp, dev->_async_sequence);
+}
+
+void
+MPU6000::measure(uint64_t timestamp, uint32_t sequence)
+{
+	MPUReport mpu_report;
 
 	/* start measuring */
 	perf_begin(_sample_perf);
@@ -1217,19 +1499,57 @@ MPU6000::measure()
 	if (OK != transfer((uint8_t *)&mpu_report, ((uint8_t *)&mpu_report), sizeof(mpu_report)))
 		return;
 
+	collect(mpu_report, timestamp, sequence);
+}
+
+void
+MPU6000::collect(MPUReport &mpu_report, uint64_t timestamp, uint32_t sequence)
+{
+	accel_report		arb;
+	gyro_report		grb;
+
+	/* samples triggered by the data-ready line carry the time of their edge */
+	if (!process_sample(&mpu_report.accel_x[0], (timestamp != 0) ? timestamp : hrt_absolute_time(), arb, grb)) {
+		perf_end(_sample_perf);
+		return;
+	}
+
+	/* check that no sample was lost or read twice since the last one */
+	if (sequence != 0)
+		_drdy_tracker.collect(sequence);
+
+	publish(arb, grb);
+
+	/* stop measuring */
+	perf_end(_sample_perf);
+}
+
+bool
+MPU6000::process_sample(const uint8_t *data, uint64_t timestamp, accel_report &arb, gyro_report &grb)
+{
+	struct Report {
+		int16_t		accel_x;
+		int16_t		accel_y;
+		int16_t		accel_z;
+		int16_t		temp;
+		int16_t		gyro_x;
+		int16_t		gyro_y;
+		int16_t		gyro_z;
+	} report;
+
 	/*
 	 * Convert from big to little endian
 	 */
 
-	report.accel_x = int16_t_from_bytes(mpu_report.accel_x);
-	report.accel_y = int16_t_from_bytes(mpu_report.accel_y);
-	report.accel_z = int16_t_from_bytes(mpu_report.accel_z);
+	report.accel_x = int16_t_from_bytes((uint8_t *)&data[0]);
+	report.accel_y = int16_t_from_bytes((uint8_t *)&data[2]);
+	report.accel_z = int16_t_from_bytes((uint8_t *)&data[4]);
 
-	report.temp = int16_t_from_bytes(mpu_report.temp);
+	report.temp = int16_t_from_bytes((uint8_t *)&data[6]);
 
-	report.gyro_x = int16_t_from_bytes(mpu_report.gyro_x);
-	report.gyro_y = int16_t_from_bytes(mpu_report.gyro_y);
-	report.gyro_z = int16_t_from_bytes(mpu_report.gyro_z);
+	report.gyro_x = int16_t_from_bytes((uint8_t *)&data[8]);
+	report.gyro_y = int16_t_from_bytes((uint8_t *)&data[10]);
+	report.gyro_z = int16_t_from_bytes((uint8_t *)&data[12]);
 
 	if (report.accel_x == 0 &&
 	    report.accel_y == 0 &&
@@ -1240,13 +1560,11 @@ MPU6000::measure()
 	    report.gyro_z == 0) {
 		// all zero data - probably a SPI bus error
 		perf_count(_bad_transfers);
-		perf_end(_sample_perf);
 		//reset();
-		return;
+		return false;
 	}
 
 	perf_count(_good_transfers);
-	    
 
 	/*
 	 * Swap axes and negate y
@@ -1265,16 +1583,10 @@ MPU6000::measure()
 	report.gyro_x = gyro_xt;
 	report.gyro_y = gyro_yt;
 
-	/*
-	 * Report buffers.
-	 */
-	accel_report		arb;
-	gyro_report		grb;
-
 	/*
 	 * Adjust and scale results to m/s^2.
 	 */
-	grb.timestamp = arb.timestamp = hrt_absolute_time();
+	grb.timestamp = arb.timestamp = timestamp;
         grb.error_count = arb.error_count = 0; // not reported
 
 	/*
@@ -1334,6 +1646,12 @@ MPU6000::measure()
 	_accel_reports->force(&arb);
 	_gyro_reports->force(&grb);
 
+	return true;
+}
+
+void
+MPU6000::publish(const accel_report &arb, const gyro_report &grb)
+{
 	/* notify anyone waiting for data */
 	poll_notify(POLLIN);
 	_gyro->parent_poll_notify();
@@ -1347,19 +1665,125 @@ MPU6000::measure()
 		/* publish it */
 		orb_publish(ORB_ID(sensor_gyro), _gyro->_gyro_topic, &grb);
 	}
+}
+
+void
+MPU6000::fifo_enable(bool enable)
+{
+	write_reg(MPUREG_FIFO_EN, enable ? BITS_FIFO_EN_SENSORS : 0);
+	write_reg(MPUREG_USER_CTRL, BIT_I2C_IF_DIS | BIT_FIFO_RESET);
+
+	if (enable)
+		write_reg(MPUREG_USER_CTRL, BIT_I2C_IF_DIS | BIT_FIFO_EN);
+}
+
+void
+MPU6000::measure_fifo()
+{
+	perf_begin(_sample_perf);
+
+	// FIFO transfers at high clock speed
+	set_frequency(MPU6000_HIGH_BUS_SPEED);
+
+	_fifo_timestamp = hrt_absolute_time();
+	fifo_done(_fifo_reader.read());
+}
+
+void
+MPU6000::measure_fifo_async()
+{
+	/* the previous burst has not been served yet */
+	if (_fifo_transfer.pending)
+		return;
+
+	perf_begin(_sample_perf);
+
+	_fifo_count[0] = DIR_READ | MPUREG_FIFO_COUNTH;
+
+	// FIFO transfers at high clock speed
+	set_frequency(MPU6000_HIGH_BUS_SPEED);
+
+	if (transfer_async(&_fifo_transfer) != OK)
+		perf_cancel(_sample_perf);
+}
+
+void
+MPU6000::measure_fifo_complete(void *arg, int result)
+{
+	MPU6000 *dev = reinterpret_cast<MPU6000 *>(arg);
+
+	if (result != OK) {
+		perf_cancel(dev->_sample_perf);
+		return;
+	}
+
+	/* on the worker thread the bursts go straight to the bus */
+	dev->set_frequency(MPU6000_HIGH_BUS_SPEED);
+	dev->_fifo_timestamp = hrt_absolute_time();
+	dev->fifo_done(dev->_fifo_reader.drain(&dev->_fifo_count[1]));
+}
+
+void
+MPU6000::fifo_done(int ret)
+{
+	if (ret == -EOVERFLOW) {
+		/* sample boundaries are lost, start over */
+		perf_count(_fifo_overflows);
+		fifo_enable(true);
+
+	} else if (_fifo_reported > 0) {
+		/* one notification and publication for the whole burst */
+		publish(_fifo_accel, _fifo_gyro);
+	}
+
+	_fifo_reported = 0;
 
-	/* stop measuring */
 	perf_end(_sample_perf);
 }
 
+int
+MPU6000::fifo_transfer(void *arg, uint8_t *buf, unsigned len)
+{
+	MPU6000 *dev = reinterpret_cast<MPU6000 *>(arg);
+
+	return dev->transfer(buf, buf, len);
+}
+
+void
+MPU6000::fifo_sample(void *arg, const uint8_t *sample, unsigned index, unsigned count)
+{
+	MPU6000 *dev = reinterpret_cast<MPU6000 *>(arg);
+
+	/* the newest sample was written just before the count was read */
+	uint64_t timestamp = dev->_fifo_timestamp - (uint64_t)(count - 1 - index) * (1000000 / dev->_sample_rate);
+
+	if (dev->process_sample(sample, timestamp, dev->_fifo_accel, dev->_fifo_gyro))
+		dev->_fifo_reported++;
+}
+
 void
 MPU6000::print_info()
 {
+	printf("polling %s\n", _async ? "through the SPI scheduler" : "in interrupt context");
+
+	if (_drdy) {
+		printf("data-ready: %u samples, %u lost, %u duplicated, %u spurious edges, interval %u us\n",
+		       (unsigned)_drdy_tracker.samples(), (unsigned)_drdy_tracker.lost(),
+		       (unsigned)_drdy_tracker.duplicates(), (unsigned)_drdy_tracker.spurious(),
+		       _drdy_tracker.interval());
+	}
+
 	perf_print_counter(_sample_perf);
 	perf_print_counter(_accel_reads);
 	perf_print_counter(_gyro_reads);
 	perf_print_counter(_bad_transfers);
 	perf_print_counter(_good_transfers);
+
+	if (_fifo) {
+		printf("FIFO: %u samples in %u transfers\n",
+		       (unsigned)_fifo_reader.samples(), (unsigned)_fifo_reader.transfers());
+		perf_print_counter(_fifo_overflows);
+	}
 	_accel_reports->print_info("accel queue");
 	_gyro_reports->print_info("gyro queue");
 }
@@ -1368,6 +1792,7 @@ MPU6000_gyro::MPU6000_gyro(MPU6000 *parent) :
 	CDev("MPU6000_gyro", MPU_DEVICE_PATH_GYRO),
 	_parent(parent),
 	_gyro_topic(-1),
+	_gyro_orb_class_instance(-1),
 	_gyro_class_instance(-1)
 {
 }
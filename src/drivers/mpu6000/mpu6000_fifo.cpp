@@ -0,0 +1,110 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mpu6000_fifo.cpp
+ *
+ * Burst reads from the MPU6000 FIFO.
+ */
+
+#include <errno.h>
+
+#include "mpu6000_fifo.h"
+
+#define DIR_READ			0x80
+
+MPU6000_FIFO::MPU6000_FIFO(transfer_t transfer, sample_t sample, void *arg) :
+	_transfer(transfer),
+	_sample(sample),
+	_arg(arg),
+	_samples(0),
+	_transfers(0),
+	_overflows(0)
+{
+}
+
+int
+MPU6000_FIFO::read()
+{
+	uint8_t cmd[3] = { DIR_READ | MPUREG_FIFO_COUNTH, 0, 0 };
+
+	_transfers++;
+
+	int ret = _transfer(_arg, cmd, sizeof(cmd));
+
+	if (ret != 0)
+		return ret;
+
+	return drain(&cmd[1]);
+}
+
+int
+MPU6000_FIFO::drain(const uint8_t *counth)
+{
+	unsigned bytes = (counth[0] << 8) | counth[1];
+
+	/* no room left for a whole sample, the device has dropped data or is about to */
+	if (bytes + MPU6000_FIFO_SAMPLE_SIZE > MPU6000_FIFO_SIZE) {
+		_overflows++;
+		return -EOVERFLOW;
+	}
+
+	/* a sample still being written is left for the next read */
+	unsigned count = bytes / MPU6000_FIFO_SAMPLE_SIZE;
+	unsigned index = 0;
+
+	while (index < count) {
+		unsigned burst = count - index;
+
+		if (burst > MPU6000_FIFO_MAX_BURST)
+			burst = MPU6000_FIFO_MAX_BURST;
+
+		_buffer[0] = DIR_READ | MPUREG_FIFO_R_W;
+		_transfers++;
+
+		int ret = _transfer(_arg, _buffer, 1 + burst * MPU6000_FIFO_SAMPLE_SIZE);
+
+		if (ret != 0)
+			return ret;
+
+		for (unsigned i = 0; i < burst; i++) {
+			_sample(_arg, &_buffer[1 + i * MPU6000_FIFO_SAMPLE_SIZE], index + i, count);
+		}
+
+		index += burst;
+	}
+
+	_samples += count;
+
+	return count;
+}
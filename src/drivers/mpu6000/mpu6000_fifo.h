@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mpu6000_fifo.h
+ *
+ * Burst reads from the MPU6000 FIFO.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define MPUREG_FIFO_COUNTH		0x72
+#define MPUREG_FIFO_COUNTL		0x73
+#define MPUREG_FIFO_R_W			0x74
+
+#define MPU6000_FIFO_SIZE		1024
+#define MPU6000_FIFO_SAMPLE_SIZE	14	/**< accel, temperature and gyro, big endian */
+#define MPU6000_FIFO_MAX_BURST		16	/**< samples read in one transfer */
+
+/**
+ * Drains the samples buffered in the MPU6000 FIFO.
+ *
+ * The FIFO is expected to hold accel, temperature and gyro in register
+ * order, so each sample has the layout of the data registers starting at
+ * ACCEL_XOUT_H. The byte count is read first, then all complete samples
+ * are read in bursts of up to MPU6000_FIFO_MAX_BURST samples.
+ *
+ * Once the FIFO overflows the device drops the oldest bytes, so the
+ * sample boundaries are lost and the FIFO must be reset by the caller.
+ */
+class MPU6000_FIFO
+{
+public:
+	/**
+	 * Bus access; send and receive the same buffer of len bytes, the
+	 * first byte being the register command.
+	 */
+	typedef int	(*transfer_t)(void *arg, uint8_t *buf, unsigned len);
+
+	/**
+	 * Called for every sample read, oldest first.
+	 *
+	 * @param sample	MPU6000_FIFO_SAMPLE_SIZE bytes of sample data.
+	 * @param index		Index of the sample in this read.
+	 * @param count		Number of samples in this read.
+	 */
+	typedef void	(*sample_t)(void *arg, const uint8_t *sample, unsigned index, unsigned count);
+
+	MPU6000_FIFO(transfer_t transfer, sample_t sample, void *arg);
+
+	/**
+	 * Read the FIFO byte count and drain the FIFO.
+	 *
+	 * @return		Number of samples read, -EOVERFLOW if the FIFO
+	 *			overflowed and needs a reset, or a bus error.
+	 */
+	int			read();
+
+	/**
+	 * Drain the FIFO with a byte count that has already been read.
+	 *
+	 * @param counth	FIFO_COUNTH and FIFO_COUNTL as read from the device.
+	 */
+	int			drain(const uint8_t *counth);
+
+	uint32_t		samples() const { return _samples; }
+	uint32_t		transfers() const { return _transfers; }
+	uint32_t		overflows() const { return _overflows; }
+
+private:
+	transfer_t		_transfer;
+	sample_t		_sample;
+	void			*_arg;
+
+	uint32_t		_samples;
+	uint32_t		_transfers;
+	uint32_t		_overflows;
+
+	uint8_t			_buffer[1 + MPU6000_FIFO_MAX_BURST * MPU6000_FIFO_SAMPLE_SIZE];
+};
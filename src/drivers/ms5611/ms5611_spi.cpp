@@ -51,6 +51,7 @@
 #include <arch/board/board.h>
 
 #include <drivers/device/spi.h>
+#include <drivers/device/spi_bus.h>
 
 #include "ms5611.h"
 #include "board_config.h"
@@ -110,6 +111,9 @@ private:
 	 * from pre-empting us. The sensor may (does) share a bus with sensors
 	 * that are polled from interrupt context (or we may be pre-empted)
 	 * so we need to guarantee that transfers complete without interruption.
+	 *
+	 * With the bus scheduler running, transfers are queued to it like those
+	 * of the other sensors and served after theirs.
 	 */
 	int		_transfer(uint8_t *send, uint8_t *recv, unsigned len);
 };
@@ -143,6 +147,11 @@ MS5611_SPI::init()
 		goto out;
 	}
 
+	/* queue our transfers behind the IMUs sharing the bus */
+	if (enable_async(device::SPIBus::PRIORITY_LOW) != OK) {
+		debug("no SPI scheduler");
+	}
+
 	/* send reset command */
 	ret = _reset();
 	if (ret != OK) {
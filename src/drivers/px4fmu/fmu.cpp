@@ -66,6 +66,7 @@
 #include <systemlib/mixer/mixer.h>
 #include <systemlib/pwm_limit/pwm_limit.h>
 #include <systemlib/board_serial.h>
+#include <systemlib/perf_counter.h>
 #include <drivers/drv_mixer.h>
 #include <drivers/drv_rc_input.h>
 
@@ -142,6 +143,8 @@ private:
 	unsigned	_num_failsafe_set;
 	unsigned	_num_disarmed_set;
 
+	perf_counter_t	_latency_perf;
+
 	static void	task_main_trampoline(int argc, char *argv[]);
 	void		task_main() __attribute__((noreturn));
 
@@ -228,7 +231,8 @@ PX4FMU::PX4FMU() :
 	_failsafe_pwm({0}),
 	      _disarmed_pwm({0}),
 	      _num_failsafe_set(0),
-	      _num_disarmed_set(0)
+	      _num_disarmed_set(0),
+	      _latency_perf(perf_alloc(PC_LATENCY, "fmu_latency"))
 {
 	for (unsigned i = 0; i < _max_actuators; i++) {
 		_min_pwm[i] = PWM_DEFAULT_MIN;
@@ -263,6 +267,8 @@ PX4FMU::~PX4FMU()
 	if (_primary_pwm_device)
 		unregister_driver(PWM_OUTPUT_DEVICE_PATH);
 
+	perf_free(_latency_perf);
+
 	g_fmu = nullptr;
 }
 
@@ -595,6 +601,13 @@ PX4FMU::task_main()
 						up_pwm_servo_set(i, pwm_limited[i]);
 					}
 
+					/* sensor sample the outputs are based on, 0 if the controller does not know it */
+					outputs.timestamp_sample = _controls.timestamp_sample;
+
+					if (outputs.timestamp_sample != 0) {
+						perf_latency(_latency_perf, hrt_absolute_time() - outputs.timestamp_sample);
+					}
+
 					/* and publish for anyone that cares to see */
 					orb_publish(_primary_pwm_device ? ORB_ID_VEHICLE_CONTROLS : ORB_ID(actuator_outputs_1), _t_outputs, &outputs);
 				}
@@ -1080,7 +1093,7 @@ PX4FMU::pwm_ioctl(file *filp, int cmd, unsigned long arg)
 
 	case MIXERIOCLOADBUF: {
 			const char *buf = (const char *)arg;
-			unsigned buflen = strnlen(buf, 1024);
+			unsigned buflen = mixer_buf_length(buf, 1024);
 
 			if (_mixers == nullptr)
 				_mixers = new MixerGroup(control_callback, (uintptr_t)&_controls);
@@ -54,7 +54,6 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <math.h>
-#include <crc32.h>
 
 #include <arch/board/board.h>
 
@@ -258,6 +257,7 @@ private:
 	perf_counter_t		_perf_update;		///<local performance counter for status updates
 	perf_counter_t		_perf_write;		///<local performance counter for PWM control writes
 	perf_counter_t		_perf_chan_count;	///<local performance counter for channel number changes
+	perf_counter_t		_perf_latency;		///<sensor sample to IO control write latency
 
 	/* cached IO state */
 	uint16_t		_status;		///< Various IO status flags
@@ -290,6 +290,7 @@ private:
 	float			_battery_amp_bias;	///< current sensor bias
 	float			_battery_mamphour_total;///< amp hours consumed so far
 	uint64_t		_battery_last_timestamp;///< last amp hour calculation timestamp
+	uint64_t		_controls_timestamp_sample;///< sensor sample of the last controls sent to IO
 
 #ifdef CONFIG_ARCH_BOARD_PX4FMU_V1
 	bool			_dsm_vcc_ctl;		///< true if relay 1 controls DSM satellite RX power
@@ -485,6 +486,7 @@ PX4IO::PX4IO(device::Device *interface) :
 	_perf_update(perf_alloc(PC_ELAPSED, "io update")),
 	_perf_write(perf_alloc(PC_ELAPSED, "io write")),
 	_perf_chan_count(perf_alloc(PC_COUNT, "io rc #")),
+	_perf_latency(perf_alloc(PC_LATENCY, "io latency")),
 	_status(0),
 	_alarms(0),
 	_t_actuator_controls_0(-1),
@@ -505,7 +507,8 @@ PX4IO::PX4IO(device::Device *interface) :
 	_battery_amp_per_volt(90.0f / 5.0f), // this matches the 3DR current sensor
 	_battery_amp_bias(0),
 	_battery_mamphour_total(0),
-	_battery_last_timestamp(0)
+	_battery_last_timestamp(0),
+	_controls_timestamp_sample(0)
 #ifdef CONFIG_ARCH_BOARD_PX4FMU_V1
 	, _dsm_vcc_ctl(false)
 #endif
@@ -1044,7 +1047,18 @@ PX4IO::io_set_control_state(unsigned group)
 		regs[i] = FLOAT_TO_REG(controls.control[i]);
 
 	/* copy values to registers in IO */
-	return io_reg_set(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT, regs, _max_controls);
+	int ret = io_reg_set(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT, regs, _max_controls);
+
+	/* IO mixes and outputs on receipt, the write completing is as close as we get to the pulse */
+	if (ret == OK && group == 0) {
+		_controls_timestamp_sample = controls.timestamp_sample;
+
+		if (controls.timestamp_sample != 0) {
+			perf_latency(_perf_latency, hrt_absolute_time() - controls.timestamp_sample);
+		}
+	}
+
+	return ret;
 }
 
 
@@ -1515,6 +1529,7 @@ PX4IO::io_publish_pwm_outputs()
 	/* data we are going to fetch */
 	actuator_outputs_s outputs;
 	outputs.timestamp = hrt_absolute_time();
+	outputs.timestamp_sample = _controls_timestamp_sample;
 
 	/* get servo values from IO */
 	uint16_t ctl[_max_actuators];
@@ -2276,7 +2291,7 @@ PX4IO::ioctl(file * filep, int cmd, unsigned long arg)
 
 	case MIXERIOCLOADBUF: {
 			const char *buf = (const char *)arg;
-			ret = mixer_send(buf, strnlen(buf, 2048));
+			ret = mixer_send(buf, mixer_buf_length(buf, 2048));
 			break;
 		}
 
@@ -2587,29 +2602,23 @@ checkcrc(int argc, char *argv[])
 		printf("usage: px4io checkcrc filename\n");
 		exit(1);
 	}
-	int fd = open(argv[1], O_RDONLY);
-	if (fd == -1) {
-		printf("open of %s failed - %d\n", argv[1], errno);
-		exit(1);			
-	}
 	const uint32_t app_size_max = 0xf000;
-	uint32_t fw_crc = 0;
-	uint32_t nbytes = 0;
-	while (true) {
-		uint8_t buf[16];
-		int n = read(fd, buf, sizeof(buf));
-		if (n <= 0) break;
-		fw_crc = crc32part(buf, n, fw_crc);
-		nbytes += n;
-	}
-	close(fd);
-	while (nbytes < app_size_max) {
-		uint8_t b = 0xff;
-		fw_crc = crc32part(&b, 1, fw_crc);			
-		nbytes++;
-	}
-
-	int ret = g_dev->ioctl(nullptr, PX4IO_CHECK_CRC, fw_crc);
+	uint32_t fw_crc;
+
+	int ret = PX4IO_Uploader::image_crc(argv[1], app_size_max, fw_crc);
+
+	if (ret != OK) {
+		printf("read of %s failed - %d\n", argv[1], ret);
+
+		if (!keep_running) {
+			delete g_dev;
+			g_dev = nullptr;
+		}
+
+		exit(1);
+	}
+
+	ret = g_dev->ioctl(nullptr, PX4IO_CHECK_CRC, fw_crc);
 
 	if (!keep_running) {
 		delete g_dev;
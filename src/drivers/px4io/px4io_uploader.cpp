@@ -64,7 +64,8 @@
 
 PX4IO_Uploader::PX4IO_Uploader() :
 	_io_fd(-1),
-	_fw_fd(-1)
+	_fw_fd(-1),
+	_fw_filename(nullptr)
 {
 }
 
@@ -94,6 +95,7 @@ PX4IO_Uploader::upload(const char *filenames[])
 
 		log("using firmware from %s", filenames[i]);
 		filename = filenames[i];
+		_fw_filename = filename;
 		break;
 	}
 
@@ -187,6 +189,22 @@ PX4IO_Uploader::upload(const char *filenames[])
 			}
 		}
 
+		/* if the IO already holds this image, skip erasing and programming it */
+		if (bl_rev >= 3) {
+			uint32_t flash_size;
+			uint32_t io_crc;
+			uint32_t fw_crc;
+
+			if ((get_info(INFO_FLASH_SIZE, flash_size) == OK) &&
+			    (image_crc(filename, flash_size, fw_crc) == OK) &&
+			    (get_crc(io_crc) == OK) &&
+			    (io_crc == fw_crc)) {
+				log("firmware unchanged, not programming");
+				ret = reboot();
+				break;
+			}
+		}
+
 		ret = erase();
 
 		if (ret != OK) {
@@ -380,6 +398,22 @@ PX4IO_Uploader::get_info(int param, uint32_t &val)
 	return get_sync();
 }
 
+int
+PX4IO_Uploader::get_crc(uint32_t &crc)
+{
+	int ret;
+
+	send(PROTO_GET_CRC);
+	send(PROTO_EOC);
+
+	ret = recv((uint8_t *)&crc, sizeof(crc));
+
+	if (ret != OK)
+		return ret;
+
+	return get_sync();
+}
+
 int
 PX4IO_Uploader::erase()
 {
@@ -535,66 +569,29 @@ int
 PX4IO_Uploader::verify_rev3(size_t fw_size_local)
 {
 	int ret;
-	uint8_t	file_buf[4];
-	ssize_t count;
 	uint32_t sum = 0;
-	uint32_t bytes_read = 0;
 	uint32_t crc = 0;
 	uint32_t fw_size_remote;
-	uint8_t fill_blank = 0xff;
 
 	log("verify...");
-	lseek(_fw_fd, 0, SEEK_SET);
 
 	ret = get_info(INFO_FLASH_SIZE, fw_size_remote);
-	send(PROTO_EOC);
 
 	if (ret != OK) {
 		log("could not read firmware size");
 		return ret;
 	}
 
-	/* read through the firmware file again and calculate the checksum*/
-	while (bytes_read < fw_size_local) {
-		size_t n = fw_size_local - bytes_read;
-		if (n > sizeof(file_buf)) {
-			n = sizeof(file_buf);
-		}
-		count = read_with_retry(_fw_fd, file_buf, n);
-
-		if (count != (ssize_t)n) {
-			log("firmware read of %u bytes at %u failed -> %d errno %d", 
-			    (unsigned)n,
-			    (unsigned)bytes_read,
-			    (int)count,
-			    (int)errno);
-		}
-
-		/* set the rest to ff */
-		if (count == 0) {
-			break;
-		}
-		/* stop if the file cannot be read */
-		if (count < 0)
-			return -errno;
-
-		/* calculate crc32 sum */
-		sum = crc32part((uint8_t *)&file_buf, sizeof(file_buf), sum);
+	/* calculate the checksum of the firmware file, padded to the flash size */
+	ret = image_crc(_fw_filename, fw_size_remote, sum);
 
-		bytes_read += count;
-	}
-
-	/* fill the rest with 0xff */
-	while (bytes_read < fw_size_remote) {
-		sum = crc32part(&fill_blank, sizeof(fill_blank), sum);
-		bytes_read += sizeof(fill_blank);
+	if (ret != OK) {
+		log("firmware read failed -> %d", ret);
+		return ret;
 	}
 
 	/* request CRC from IO */
-	send(PROTO_GET_CRC);
-	send(PROTO_EOC);
-
-	ret = recv((uint8_t*)(&crc), sizeof(crc));
+	ret = get_crc(crc);
 
 	if (ret != OK) {
 		log("did not receive CRC checksum");
@@ -610,6 +607,46 @@ PX4IO_Uploader::verify_rev3(size_t fw_size_local)
 	return OK;
 }
 
+int
+PX4IO_Uploader::image_crc(const char *filename, uint32_t flash_size, uint32_t &crc)
+{
+	int fd = open(filename, O_RDONLY);
+
+	if (fd < 0)
+		return -errno;
+
+	uint8_t buf[256];
+	uint32_t sum = 0;
+	uint32_t bytes_read = 0;
+	ssize_t count;
+
+	while ((count = read_with_retry(fd, buf, sizeof(buf))) > 0) {
+		sum = crc32part(buf, count, sum);
+		bytes_read += count;
+	}
+
+	close(fd);
+
+	if (count < 0)
+		return -EIO;
+
+	/* fill the rest with 0xff */
+	memset(buf, 0xff, sizeof(buf));
+
+	while (bytes_read < flash_size) {
+		uint32_t n = flash_size - bytes_read;
+
+		if (n > sizeof(buf))
+			n = sizeof(buf);
+
+		sum = crc32part(buf, n, sum);
+		bytes_read += n;
+	}
+
+	crc = sum;
+	return OK;
+}
+
 int
 PX4IO_Uploader::reboot()
 {
@@ -51,6 +51,18 @@ public:
 
 	int			upload(const char *filenames[]);
 
+	/**
+	 * Compute the CRC of a firmware image as reported by the IO bootloader.
+	 *
+	 * The image is padded with 0xff to the flash size.
+	 *
+	 * @param filename		The firmware image.
+	 * @param flash_size		The application flash size of the IO.
+	 * @param crc			Returns the CRC.
+	 * @return			OK, or a negative errno if the file cannot be read.
+	 */
+	static int		image_crc(const char *filename, uint32_t flash_size, uint32_t &crc);
+
 private:
 	enum {
 
@@ -81,6 +93,7 @@ private:
 
 	int			_io_fd;
 	int			_fw_fd;
+	const char		*_fw_filename;
 
 	uint32_t	bl_rev; /**< bootloader revision */
 
@@ -94,6 +107,7 @@ private:
 	int			get_sync(unsigned timeout = 40);
 	int			sync();
 	int			get_info(int param, uint32_t &val);
+	int			get_crc(uint32_t &crc);
 	int			erase();
 	int			program(size_t fw_size);
 	int			verify_rev2(size_t fw_size);
@@ -0,0 +1,84 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file barometric.cpp
+ *
+ * Barometric altitude conversion
+ */
+
+#include <math.h>
+
+#include "barometric.h"
+
+/* altitude calculations based on http://www.kansasflyer.org/index.asp?nav=Avi&sec=Alti&tab=Theory&pg=1 */
+
+/* tropospheric properties (0-11km) for standard atmosphere */
+#define BARO_T1		(15.0f + 273.15f)	/**< temperature at base height in Kelvin */
+#define BARO_A		(-6.5f / 1000.0f)	/**< temperature gradient in degrees per metre */
+#define BARO_G		9.80665f		/**< gravity constant in m/s/s */
+#define BARO_R		287.05f			/**< ideal gas constant in J/kg/K */
+
+/* the exponents and scale fold to constants, leaving one logf and one expf per call */
+static const float baro_exponent = -(BARO_A * BARO_R) / BARO_G;
+static const float baro_scale = BARO_T1 / BARO_A;
+
+float
+baro_altitude(float pressure, float msl_pressure)
+{
+	/*
+	 * Solve:
+	 *
+	 *     /        -(aR / g)     \
+	 *    | (p / p1)          . T1 | - T1
+	 *     \                      /
+	 * h = -------------------------------
+	 *                   a
+	 *
+	 * with x^y evaluated as exp(y ln x).
+	 */
+	return (expf(baro_exponent * logf(pressure / msl_pressure)) - 1.0f) * baro_scale;
+}
+
+float
+baro_msl_pressure(float pressure, float altitude)
+{
+	/*
+	 * Solve:
+	 *
+	 *           /  T1 + a h  \ (g / aR)
+	 * p1 = p . | ------------ |
+	 *           \     T1     /
+	 */
+	return pressure * expf(-logf(1.0f + altitude / baro_scale) / baro_exponent);
+}
@@ -0,0 +1,75 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file barometric.h
+ *
+ * Barometric altitude conversion for the standard atmosphere troposphere
+ * (0-11 km), in single precision.
+ */
+
+#ifndef BAROMETRIC_H_
+#define BAROMETRIC_H_
+
+#include <unistd.h>
+
+__BEGIN_DECLS
+
+/**
+ * Altitude above the mean sea level reference from a static pressure.
+ *
+ * Evaluates the standard atmosphere formula with expf/logf instead of
+ * pow(), which the single precision FPU would have to emulate. Within
+ * 30..110 kPa the result stays within 0.02 m of the double precision
+ * formula.
+ *
+ * @param pressure	measured static pressure
+ * @param msl_pressure	pressure at mean sea level, same unit as pressure
+ * @return		altitude in meters
+ */
+__EXPORT float baro_altitude(float pressure, float msl_pressure);
+
+/**
+ * Mean sea level pressure given a static pressure measured at a known altitude.
+ *
+ * Inverse of baro_altitude(), used to calibrate the reference pressure.
+ *
+ * @param pressure	measured static pressure
+ * @param altitude	altitude of the measurement in meters
+ * @return		pressure at mean sea level, same unit as pressure
+ */
+__EXPORT float baro_msl_pressure(float pressure, float altitude);
+
+__END_DECLS
+
+#endif /* BAROMETRIC_H_ */
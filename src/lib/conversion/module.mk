@@ -35,4 +35,5 @@
 # Conversion library
 #
 
-SRCS		 = rotation.cpp
+SRCS		 = rotation.cpp \
+		   barometric.cpp
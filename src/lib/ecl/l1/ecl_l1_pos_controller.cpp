@@ -95,8 +95,19 @@ void ECL_L1_Pos_Controller::navigate_waypoints(const math::Vector<2> &vector_A,
 	float xtrack_vel;
 	float ltrack_vel;
 
+	/* the leg only changes with the waypoints, everything below is in its local plane */
+	update_segment(&_leg, vector_A, vector_B);
+
+	/* calculate the vector from waypoint A to the aircraft */
+	float a_to_p_n, a_to_p_e;
+	geo_segment_project(&_leg, vector_curr_position(0), vector_curr_position(1), &a_to_p_n, &a_to_p_e);
+	math::Vector<2> vector_A_to_airplane(a_to_p_n, a_to_p_e);
+
+	/* estimate airplane position WRT to B */
+	math::Vector<2> vector_B_to_P(a_to_p_n - _leg.end_n, a_to_p_e - _leg.end_e);
+
 	/* get the direction between the last (visited) and next waypoint */
-	_target_bearing = get_bearing_to_next_waypoint(vector_curr_position(0), vector_curr_position(1), vector_B(0), vector_B(1));
+	_target_bearing = atan2f(-vector_B_to_P(1), -vector_B_to_P(0));
 
 	/* enforce a minimum ground speed of 0.1 m/s to avoid singularities */
 	float ground_speed = math::max(ground_speed_vector.length(), 0.1f);
@@ -104,22 +115,18 @@ void ECL_L1_Pos_Controller::navigate_waypoints(const math::Vector<2> &vector_A,
 	/* calculate the L1 length required for the desired period */
 	_L1_distance = _L1_ratio * ground_speed;
 
-	/* calculate vector from A to B */
-	math::Vector<2> vector_AB = get_local_planar_vector(vector_A, vector_B);
+	/* unit vector from A to B */
+	math::Vector<2> vector_AB(_leg.dir_n, _leg.dir_e);
 
 	/*
 	 * check if waypoints are on top of each other. If yes,
 	 * skip A and directly continue to B
 	 */
-	if (vector_AB.length() < 1.0e-6f) {
-		vector_AB = get_local_planar_vector(vector_curr_position, vector_B);
+	if (_leg.length < 1.0e-3f) {
+		vector_AB = -vector_B_to_P;
+		vector_AB.normalize();
 	}
 
-	vector_AB.normalize();
-
-	/* calculate the vector from waypoint A to the aircraft */
-	math::Vector<2> vector_A_to_airplane = get_local_planar_vector(vector_A, vector_curr_position);
-
 	/* calculate crosstrack error (output only) */
 	_crosstrack_error = vector_AB % vector_A_to_airplane;
 
@@ -131,8 +138,7 @@ void ECL_L1_Pos_Controller::navigate_waypoints(const math::Vector<2> &vector_A,
 	float distance_A_to_airplane = vector_A_to_airplane.length();
 	float alongTrackDist = vector_A_to_airplane * vector_AB;
 
-	/* estimate airplane position WRT to B */
-	math::Vector<2> vector_B_to_P_unit = get_local_planar_vector(vector_B, vector_curr_position).normalized();
+	math::Vector<2> vector_B_to_P_unit = vector_B_to_P.normalized();
 	
 	/* calculate angle of airplane position vector relative to line) */
 
@@ -221,8 +227,15 @@ void ECL_L1_Pos_Controller::navigate_loiter(const math::Vector<2> &vector_A, con
 	float K_crosstrack = omega * omega;
 	float K_velocity = 2.0f * _L1_damping * omega;
 
+	/* calculate the vector from waypoint A to current position */
+	update_segment(&_loiter_center, vector_A, vector_A);
+
+	float a_to_p_n, a_to_p_e;
+	geo_segment_project(&_loiter_center, vector_curr_position(0), vector_curr_position(1), &a_to_p_n, &a_to_p_e);
+	math::Vector<2> vector_A_to_airplane(a_to_p_n, a_to_p_e);
+
 	/* update bearing to next waypoint */
-	_target_bearing = get_bearing_to_next_waypoint(vector_curr_position(0), vector_curr_position(1), vector_A(0), vector_A(1));
+	_target_bearing = atan2f(-a_to_p_e, -a_to_p_n);
 
 	/* ground speed, enforce minimum of 0.1 m/s to avoid singularities */
 	float ground_speed = math::max(ground_speed_vector.length() , 0.1f);
@@ -230,9 +243,6 @@ void ECL_L1_Pos_Controller::navigate_loiter(const math::Vector<2> &vector_A, con
 	/* calculate the L1 length required for the desired period */
 	_L1_distance = _L1_ratio * ground_speed;
 
-	/* calculate the vector from waypoint A to current position */
-	math::Vector<2> vector_A_to_airplane = get_local_planar_vector(vector_A, vector_curr_position);
-
 	math::Vector<2> vector_A_to_airplane_unit;
 
 	/* prevent NaN when normalizing */
@@ -361,12 +371,10 @@ void ECL_L1_Pos_Controller::navigate_level_flight(float current_heading)
 }
 
 
-math::Vector<2> ECL_L1_Pos_Controller::get_local_planar_vector(const math::Vector<2> &origin, const math::Vector<2> &target) const
+void ECL_L1_Pos_Controller::update_segment(struct geo_segment_s *seg, const math::Vector<2> &origin, const math::Vector<2> &target)
 {
-	/* this is an approximation for small angles, proposed by [2] */
-
-	math::Vector<2> out(math::radians((target(0) - origin(0))), math::radians((target(1) - origin(1))*cosf(math::radians(origin(0)))));
-
-	return out * static_cast<float>(CONSTANTS_RADIUS_OF_EARTH);
+	if (!geo_segment_matches(seg, origin(0), origin(1), target(0), target(1))) {
+		geo_segment_init(seg, origin(0), origin(1), target(0), target(1));
+	}
 }
 
@@ -73,6 +73,8 @@ public:
 	ECL_L1_Pos_Controller() {
 		_L1_period = 25;
 		_L1_damping = 0.75f;
+		geo_segment_init(&_leg, 0.0, 0.0, 0.0, 0.0);
+		geo_segment_init(&_loiter_center, 0.0, 0.0, 0.0, 0.0);
 	}
 
 	/**
@@ -249,18 +251,13 @@ private:
 
 	float _roll_lim_rad;  ///<maximum roll angle
 
+	struct geo_segment_s _leg;		///< current leg from waypoint A to B, only redone when A or B move
+	struct geo_segment_s _loiter_center;	///< current loiter center
+
 	/**
-	 * Convert a 2D vector from WGS84 to planar coordinates.
-	 *
-	 * This converts from latitude and longitude to planar
-	 * coordinates with (0,0) being at the position of ref and
-	 * returns a vector in meters towards wp.
-	 *
-	 * @param ref The reference position in WGS84 coordinates
-	 * @param wp The point to convert to into the local coordinates, in WGS84 coordinates
-	 * @return The vector in meters pointing from the reference position to the coordinates
+	 * Update a cached leg if its end points changed.
 	 */
-	math::Vector<2> get_local_planar_vector(const math::Vector<2> &origin, const math::Vector<2> &target) const;
+	void update_segment(struct geo_segment_s *seg, const math::Vector<2> &origin, const math::Vector<2> &target);
 
 };
 
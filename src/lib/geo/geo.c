@@ -172,6 +172,64 @@ __EXPORT void map_projection_reproject(float x, float y, double *lat, double *lo
 
 }
 
+__EXPORT void map_projection_ref_init(struct map_projection_reference_s *ref, double lat_0, double lon_0)
+{
+	double phi = lat_0 * M_DEG_TO_RAD;
+	double deg = M_DEG_TO_RAD;
+
+	ref->lat = lat_0;
+	ref->lon = lon_0;
+
+	/*
+	 * Second order expansion of the azimuthal equidistant projection around
+	 * the origin, in degrees:
+	 *   x = R * (dlat + sin(phi) * cos(phi) / 2 * dlon^2)
+	 *   y = R * (cos(phi) - sin(phi) * dlat) * dlon
+	 */
+	ref->scale_n = CONSTANTS_RADIUS_OF_EARTH * deg;
+	ref->scale_e = CONSTANTS_RADIUS_OF_EARTH * deg * cos(phi);
+	ref->scale_e_dlat = -CONSTANTS_RADIUS_OF_EARTH * deg * deg * sin(phi);
+	ref->curv_n = CONSTANTS_RADIUS_OF_EARTH * deg * deg * sin(phi) * cos(phi) / 2.0;
+}
+
+__EXPORT void map_projection_ref_project(const struct map_projection_reference_s *ref, double lat, double lon, float *x, float *y)
+{
+	/* the differences fit a float, the absolute coordinates do not */
+	float dlat = (float)(lat - ref->lat);
+	float dlon = (float)(lon - ref->lon);
+
+	*x = dlat * ref->scale_n + dlon * dlon * ref->curv_n;
+	*y = dlon * (ref->scale_e + dlat * ref->scale_e_dlat);
+}
+
+__EXPORT void map_projection_ref_reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat, double *lon)
+{
+	/* invert the expansion, one correction step is enough for its order */
+	float dlat = x / ref->scale_n;
+	float dlon = y / (ref->scale_e + dlat * ref->scale_e_dlat);
+
+	dlat = (x - dlon * dlon * ref->curv_n) / ref->scale_n;
+	dlon = y / (ref->scale_e + dlat * ref->scale_e_dlat);
+
+	*lat = ref->lat + dlat;
+	*lon = ref->lon + dlon;
+}
+
+__EXPORT void map_projection_ref_project_array(const struct map_projection_reference_s *ref, const double *lat, const double *lon,
+		float *x, float *y, unsigned count)
+{
+	for (unsigned i = 0; i < count; i++) {
+		map_projection_ref_project(ref, lat[i], lon[i], &x[i], &y[i]);
+	}
+}
+
+__EXPORT void map_projection_ref_reproject_array(const struct map_projection_reference_s *ref, const float *x, const float *y,
+		double *lat, double *lon, unsigned count)
+{
+	for (unsigned i = 0; i < count; i++) {
+		map_projection_ref_reproject(ref, x[i], y[i], &lat[i], &lon[i]);
+	}
+}
 
 __EXPORT float get_distance_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next)
 {
@@ -247,6 +305,54 @@ __EXPORT void add_vector_to_global_position(double lat_now, double lon_now, floa
 	*lon_res = (lon_now_rad + v_e / (CONSTANTS_RADIUS_OF_EARTH * cos(lat_now_rad))) * M_RAD_TO_DEG;
 }
 
+__EXPORT void geo_segment_init(struct geo_segment_s *seg, double lat_start, double lon_start, double lat_end, double lon_end)
+{
+	seg->lat_start = lat_start;
+	seg->lon_start = lon_start;
+	seg->lat_end = lat_end;
+	seg->lon_end = lon_end;
+
+	/* the only trig of the leg, everything per update is a scale and an offset */
+	seg->scale_lat = CONSTANTS_RADIUS_OF_EARTH * M_DEG_TO_RAD_F;
+	seg->scale_lon = seg->scale_lat * cosf((float)(lat_start * M_DEG_TO_RAD));
+
+	seg->end_n = (float)(lat_end - lat_start) * seg->scale_lat;
+	seg->end_e = (float)(lon_end - lon_start) * seg->scale_lon;
+	seg->length = sqrtf(seg->end_n * seg->end_n + seg->end_e * seg->end_e);
+
+	if (seg->length > 1e-3f) {
+		seg->dir_n = seg->end_n / seg->length;
+		seg->dir_e = seg->end_e / seg->length;
+		seg->bearing = atan2f(seg->end_e, seg->end_n);
+
+	} else {
+		seg->dir_n = 0.0f;
+		seg->dir_e = 0.0f;
+		seg->bearing = 0.0f;
+	}
+}
+
+__EXPORT bool geo_segment_matches(const struct geo_segment_s *seg, double lat_start, double lon_start, double lat_end, double lon_end)
+{
+	return seg->lat_start == lat_start && seg->lon_start == lon_start &&
+	       seg->lat_end == lat_end && seg->lon_end == lon_end;
+}
+
+__EXPORT void geo_segment_project(const struct geo_segment_s *seg, double lat, double lon, float *n, float *e)
+{
+	/* subtract in double, the difference fits a float without losing the centimeters */
+	*n = (float)(lat - seg->lat_start) * seg->scale_lat;
+	*e = (float)(lon - seg->lon_start) * seg->scale_lon;
+}
+
+__EXPORT float geo_segment_distance_to_end(const struct geo_segment_s *seg, double lat, double lon)
+{
+	float d_n = (float)(seg->lat_end - lat) * seg->scale_lat;
+	float d_e = (float)(seg->lon_end - lon) * seg->scale_lon;
+
+	return sqrtf(d_n * d_n + d_e * d_e);
+}
+
 // Additional functions - @author Doug Weibel <douglas.weibel@colorado.edu>
 
 __EXPORT int get_distance_to_line(struct crosstrack_error_s * crosstrack_error, double lat_now, double lon_now, double lat_start, double lon_start, double lat_end, double lon_end)
@@ -95,6 +95,71 @@ __EXPORT void map_projection_project(double lat, double lon, float *x, float *y)
  */
 __EXPORT void map_projection_reproject(float x, float y, double *lat, double *lon);
 
+/**
+ * Local reference frame for repeated projections around one origin.
+ *
+ * Unlike map_projection_init()/map_projection_project() this keeps no global
+ * state and does not use double precision trig per point: the origin
+ * dependent terms of the azimuthal equidistant projection are expanded to
+ * second order once, every point is then a handful of float multiplies.
+ *
+ * Compared to map_projection_project() up to mid latitudes the error is
+ * below 1 mm within 1 km of the origin, about 5 mm at 10 km and 0.5 m at
+ * 50 km. It grows faster towards the poles (35 mm at 10 km at 70 degrees),
+ * keep the origin within a few kilometers there.
+ */
+struct map_projection_reference_s {
+	double lat;		/**< origin in degrees */
+	double lon;		/**< origin in degrees */
+	float scale_n;		/**< meters per degree of latitude */
+	float scale_e;		/**< meters per degree of longitude at the origin */
+	float scale_e_dlat;	/**< change of scale_e per degree of latitude */
+	float curv_n;		/**< northward offset per square degree of longitude (meridian convergence) */
+};
+
+/**
+ * Initializes a local reference frame.
+ *
+ * @param ref the reference frame to initialize
+ * @param lat_0 origin in degrees (47.1234567°, not 471234567°)
+ * @param lon_0 origin in degrees (8.1234567°, not 81234567°)
+ */
+__EXPORT void map_projection_ref_init(struct map_projection_reference_s *ref, double lat_0, double lon_0);
+
+/**
+ * Transforms a point in the geographic coordinate system to the local reference frame
+ *
+ * @param ref the reference frame
+ * @param lat in degrees (47.1234567°, not 471234567°)
+ * @param lon in degrees (8.1234567°, not 81234567°)
+ * @param x north
+ * @param y east
+ */
+__EXPORT void map_projection_ref_project(const struct map_projection_reference_s *ref, double lat, double lon, float *x, float *y);
+
+/**
+ * Transforms a point in the local reference frame to the geographic coordinate system
+ *
+ * @param ref the reference frame
+ * @param x north
+ * @param y east
+ * @param lat in degrees (47.1234567°, not 471234567°)
+ * @param lon in degrees (8.1234567°, not 81234567°)
+ */
+__EXPORT void map_projection_ref_reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat, double *lon);
+
+/**
+ * Transforms count points to the local reference frame, see map_projection_ref_project().
+ */
+__EXPORT void map_projection_ref_project_array(const struct map_projection_reference_s *ref, const double *lat, const double *lon,
+		float *x, float *y, unsigned count);
+
+/**
+ * Transforms count points from the local reference frame, see map_projection_ref_reproject().
+ */
+__EXPORT void map_projection_ref_reproject_array(const struct map_projection_reference_s *ref, const float *x, const float *y,
+		double *lat, double *lon, unsigned count);
+
 /**
  * Returns the distance to the next waypoint in meters.
  *
@@ -126,6 +191,61 @@ __EXPORT int get_distance_to_line(struct crosstrack_error_s * crosstrack_error,
 __EXPORT int get_distance_to_arc(struct crosstrack_error_s * crosstrack_error, double lat_now, double lon_now, double lat_center, double lon_center,
 		float radius, float arc_start_bearing, float arc_sweep);
 
+/**
+ * Straight leg between two waypoints, precomputed once per leg.
+ *
+ * Positions along the leg are projected into a local north/east plane with its
+ * origin at the start of the leg (equirectangular, scale taken at the start
+ * latitude), so per-update distances and bearings are float arithmetic only.
+ * Accurate to well below a meter for legs of a few kilometers.
+ */
+struct geo_segment_s {
+	double lat_start;	/**< start of the leg in degrees */
+	double lon_start;
+	double lat_end;		/**< end of the leg in degrees */
+	double lon_end;
+	float scale_lat;	/**< meters per degree of latitude */
+	float scale_lon;	/**< meters per degree of longitude at the start latitude */
+	float end_n;		/**< end of the leg relative to its start, north, meters */
+	float end_e;		/**< end of the leg relative to its start, east, meters */
+	float dir_n;		/**< unit vector along the leg, zero for a degenerate leg */
+	float dir_e;
+	float length;		/**< length of the leg in meters */
+	float bearing;		/**< bearing of the leg in radians */
+};
+
+/**
+ * Precomputes a leg.
+ *
+ * @param seg the leg to initialize
+ * @param lat_start start of the leg in degrees (47.1234567°, not 471234567°)
+ * @param lon_start start of the leg in degrees (8.1234567°, not 81234567°)
+ * @param lat_end end of the leg in degrees (47.1234567°, not 471234567°)
+ * @param lon_end end of the leg in degrees (8.1234567°, not 81234567°)
+ */
+__EXPORT void geo_segment_init(struct geo_segment_s *seg, double lat_start, double lon_start, double lat_end, double lon_end);
+
+/**
+ * Returns true if the leg was initialized with the given end points.
+ */
+__EXPORT bool geo_segment_matches(const struct geo_segment_s *seg, double lat_start, double lon_start, double lat_end, double lon_end);
+
+/**
+ * Projects a position into the plane of the leg.
+ *
+ * @param seg the leg
+ * @param lat position in degrees
+ * @param lon position in degrees
+ * @param n north relative to the start of the leg, meters
+ * @param e east relative to the start of the leg, meters
+ */
+__EXPORT void geo_segment_project(const struct geo_segment_s *seg, double lat, double lon, float *n, float *e);
+
+/**
+ * Returns the horizontal distance from a position to the end of the leg in meters.
+ */
+__EXPORT float geo_segment_distance_to_end(const struct geo_segment_s *seg, double lat, double lon);
+
 /*
  * Calculate distance in global frame
  */
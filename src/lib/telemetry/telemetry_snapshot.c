@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file telemetry_snapshot.c
+ *
+ * Cached copy of the uORB topics reported by the serial telemetry drivers.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "telemetry_snapshot.h"
+
+static const struct {
+	uint32_t			topic;
+	const struct orb_metadata	*meta;
+	size_t				offset;
+} telemetry_topics[TELEMETRY_TOPIC_COUNT] = {
+	{ TELEMETRY_SENSOR,	ORB_ID(sensor_combined),	offsetof(struct telemetry_snapshot_s, sensor) },
+	{ TELEMETRY_BATTERY,	ORB_ID(battery_status),		offsetof(struct telemetry_snapshot_s, battery) },
+	{ TELEMETRY_GPS,	ORB_ID(vehicle_gps_position),	offsetof(struct telemetry_snapshot_s, gps) },
+	{ TELEMETRY_GLOBAL_POS,	ORB_ID(vehicle_global_position), offsetof(struct telemetry_snapshot_s, global_pos) },
+	{ TELEMETRY_STATUS,	ORB_ID(vehicle_status),		offsetof(struct telemetry_snapshot_s, status) },
+	{ TELEMETRY_HOME,	ORB_ID(home_position),		offsetof(struct telemetry_snapshot_s, home) },
+	{ TELEMETRY_AIRSPEED,	ORB_ID(airspeed),		offsetof(struct telemetry_snapshot_s, airspeed) },
+	{ TELEMETRY_ESC,	ORB_ID(esc_status),		offsetof(struct telemetry_snapshot_s, esc) },
+};
+
+void
+telemetry_snapshot_init(struct telemetry_snapshot_s *snapshot, uint32_t topics)
+{
+	memset(snapshot, 0, sizeof(*snapshot));
+	snapshot->topics = topics;
+
+	for (unsigned i = 0; i < TELEMETRY_TOPIC_COUNT; i++) {
+		snapshot->subs[i] = (topics & telemetry_topics[i].topic) ? orb_subscribe(telemetry_topics[i].meta) : -1;
+	}
+}
+
+uint32_t
+telemetry_snapshot_update(struct telemetry_snapshot_s *snapshot)
+{
+	uint32_t updated_topics = 0;
+
+	for (unsigned i = 0; i < TELEMETRY_TOPIC_COUNT; i++) {
+		bool updated = false;
+
+		if (snapshot->subs[i] < 0)
+			continue;
+
+		/* orb_check is cheap, the copy is only made for changed topics */
+		if (orb_check(snapshot->subs[i], &updated) == OK && updated &&
+		    orb_copy(telemetry_topics[i].meta, snapshot->subs[i],
+			     (uint8_t *)snapshot + telemetry_topics[i].offset) == OK) {
+			updated_topics |= telemetry_topics[i].topic;
+		}
+	}
+
+	snapshot->valid |= updated_topics;
+
+	return updated_topics;
+}
+
+void
+telemetry_snapshot_deinit(struct telemetry_snapshot_s *snapshot)
+{
+	for (unsigned i = 0; i < TELEMETRY_TOPIC_COUNT; i++) {
+		if (snapshot->subs[i] >= 0) {
+			orb_unsubscribe(snapshot->subs[i]);
+			snapshot->subs[i] = -1;
+		}
+	}
+
+	snapshot->topics = 0;
+}
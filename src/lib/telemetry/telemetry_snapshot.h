@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file telemetry_snapshot.h
+ *
+ * Cached copy of the uORB topics reported by the serial telemetry drivers
+ * (HoTT, FrSky).
+ *
+ * A driver keeps one snapshot, refreshes it once before encoding its frames
+ * and builds all frames from the cached copies, so each topic is subscribed
+ * once and only copied when it was actually updated.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <uORB/uORB.h>
+#include <uORB/topics/airspeed.h>
+#include <uORB/topics/battery_status.h>
+#include <uORB/topics/esc_status.h>
+#include <uORB/topics/home_position.h>
+#include <uORB/topics/sensor_combined.h>
+#include <uORB/topics/vehicle_global_position.h>
+#include <uORB/topics/vehicle_gps_position.h>
+#include <uORB/topics/vehicle_status.h>
+
+__BEGIN_DECLS
+
+/**
+ * Topics in the snapshot, as bit masks.
+ */
+enum telemetry_topic {
+	TELEMETRY_SENSOR	= (1 << 0),	/**< sensor_combined */
+	TELEMETRY_BATTERY	= (1 << 1),	/**< battery_status */
+	TELEMETRY_GPS		= (1 << 2),	/**< vehicle_gps_position */
+	TELEMETRY_GLOBAL_POS	= (1 << 3),	/**< vehicle_global_position */
+	TELEMETRY_STATUS	= (1 << 4),	/**< vehicle_status */
+	TELEMETRY_HOME		= (1 << 5),	/**< home_position */
+	TELEMETRY_AIRSPEED	= (1 << 6),	/**< airspeed */
+	TELEMETRY_ESC		= (1 << 7),	/**< esc_status */
+};
+
+#define TELEMETRY_TOPIC_COUNT	8
+
+struct telemetry_snapshot_s {
+	struct sensor_combined_s		sensor;
+	struct battery_status_s			battery;
+	struct vehicle_gps_position_s		gps;
+	struct vehicle_global_position_s	global_pos;
+	struct vehicle_status_s			status;
+	struct home_position_s			home;
+	struct airspeed_s			airspeed;
+	struct esc_status_s			esc;
+
+	uint32_t	topics;		/**< topics subscribed to */
+	uint32_t	valid;		/**< topics received at least once */
+	int		subs[TELEMETRY_TOPIC_COUNT];
+};
+
+/**
+ * Subscribe to a set of topics and clear the snapshot.
+ *
+ * Topics not received yet read as zero.
+ *
+ * @param snapshot		The snapshot.
+ * @param topics		Mask of enum telemetry_topic values to subscribe to.
+ */
+__EXPORT void		telemetry_snapshot_init(struct telemetry_snapshot_s *snapshot, uint32_t topics);
+
+/**
+ * Copy the topics that changed since the last call into the snapshot.
+ *
+ * @param snapshot		The snapshot.
+ * @return			Mask of the topics that were updated.
+ */
+__EXPORT uint32_t	telemetry_snapshot_update(struct telemetry_snapshot_s *snapshot);
+
+/**
+ * Unsubscribe from all topics.
+ *
+ * @param snapshot		The snapshot.
+ */
+__EXPORT void		telemetry_snapshot_deinit(struct telemetry_snapshot_s *snapshot);
+
+__END_DECLS
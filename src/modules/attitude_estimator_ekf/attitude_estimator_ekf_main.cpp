@@ -519,6 +519,7 @@ const unsigned int loop_interval_alarm = 6500;	// loop interval in microseconds
 
 					/* send out */
 					att.timestamp = raw.timestamp;
+					att.timestamp_sample = raw.timestamp;
 
 					att.roll = euler[0];
 					att.pitch = euler[1];
@@ -623,6 +623,7 @@ int attitude_estimator_so3_thread_main(int argc, char *argv[])
 
 					/* send out */
 					att.timestamp = raw.timestamp;
+					att.timestamp_sample = raw.timestamp;
 					
 					// Quaternion
 					att.q[0] = q0;
@@ -75,6 +75,7 @@
 #include <uORB/topics/parameter_update.h>
 #include <uORB/topics/differential_pressure.h>
 #include <uORB/topics/safety.h>
+#include <uORB/topics/telemetry_status.h>
 
 #include <drivers/drv_led.h>
 #include <drivers/drv_hrt.h>
@@ -85,6 +86,7 @@
 #include <systemlib/systemlib.h>
 #include <systemlib/err.h>
 #include <systemlib/cpuload.h>
+#include <systemlib/boot_trace.h>
 #include <systemlib/rc_check.h>
 
 #include "px4_custom_mode.h"
@@ -106,19 +108,30 @@ static const int ERROR = -1;
 
 extern struct system_load_s system_load;
 
-/* Decouple update interval and hysteris counters, all depends on intervals */
+/*
+ * The main loop sleeps until one of its inputs changes or a deadline expires,
+ * the monitoring interval only paces the housekeeping work (LEDs, tunes, load).
+ */
+#ifdef CONFIG_ARCH_BOARD_PX4FMU_V1
+/* the FMUv1 status LED is blinked in software at 20 Hz */
 #define COMMANDER_MONITORING_INTERVAL 50000
-#define COMMANDER_MONITORING_LOOPSPERMSEC (1/(COMMANDER_MONITORING_INTERVAL/1000.0f))
+#else
+#define COMMANDER_MONITORING_INTERVAL 200000
+#endif
+#define COMMANDER_STATUS_INTERVAL 200000	/**< publish states at least with 5 Hz */
+#define COMMANDER_LOAD_INTERVAL 1000000
+#define COMMANDER_INPUT_INTERVAL 50		/**< minimum interval in ms between updates of fast inputs */
 
-#define MAVLINK_OPEN_INTERVAL 50000
+#define MAVLINK_OPEN_INTERVAL 1000000
 
 #define STICK_ON_OFF_LIMIT 0.75f
 #define STICK_THRUST_RANGE 1.0f
-#define STICK_ON_OFF_HYSTERESIS_TIME_MS 1000
-#define STICK_ON_OFF_COUNTER_LIMIT (STICK_ON_OFF_HYSTERESIS_TIME_MS*COMMANDER_MONITORING_LOOPSPERMSEC)
+#define STICK_ON_OFF_HYSTERESIS_TIME 1000000
 
 #define POSITION_TIMEOUT 1000000 /**< consider the local or global position estimate invalid after 1s */
 #define RC_TIMEOUT 100000
+#define OFFBOARD_TIMEOUT 200000
+#define DATA_LINK_TIMEOUT 3000000 /**< consider the telemetry link lost after 3s without radio status */
 #define DIFFPRESS_TIMEOUT 2000000
 
 #define PRINT_INTERVAL	5000000
@@ -174,6 +187,38 @@ typedef enum {
 
 static low_prio_task_t low_prio_task = LOW_PRIO_TASK_NONE;
 
+/* inputs the main loop sleeps on, index into its pollfd array */
+enum COMMANDER_INPUT {
+	INPUT_PARAM = 0,
+	INPUT_MANUAL,
+	INPUT_OFFBOARD,
+	INPUT_SAFETY,
+	INPUT_GLOBAL_POSITION,
+	INPUT_LOCAL_POSITION,
+	INPUT_GPS,
+	INPUT_DIFF_PRES,
+	INPUT_BATTERY,
+	INPUT_SUBSYS,
+	INPUT_TELEMETRY,
+	INPUT_CMD,
+	INPUT_MAX
+};
+
+/* timeouts the main loop has to wake up for even if none of its inputs changed */
+enum COMMANDER_DEADLINE {
+	DEADLINE_MONITORING = 0,
+	DEADLINE_RC,
+	DEADLINE_STICK,
+	DEADLINE_OFFBOARD,
+	DEADLINE_DATA_LINK,
+	DEADLINE_GLOBAL_POSITION,
+	DEADLINE_LOCAL_POSITION,
+	DEADLINE_AIRSPEED,
+	DEADLINE_MAX
+};
+
+static hrt_abstime deadlines[DEADLINE_MAX];	/**< absolute expiry time of each deadline, 0 if not armed */
+
 /**
  * The daemon app only briefly exists to start
  * the background job. The stack size assigned in the
@@ -205,6 +250,23 @@ void control_status_leds(vehicle_status_s *status, const actuator_armed_s *actua
 
 void check_valid(hrt_abstime timestamp, hrt_abstime timeout, bool valid_in, bool *valid_out, bool *changed);
 
+/**
+ * Arm a deadline, replacing its previous expiry time. An expiry time of 0 disarms it.
+ */
+void deadline_set(enum COMMANDER_DEADLINE deadline, hrt_abstime t);
+
+/**
+ * Poll timeout in milliseconds until the nearest armed deadline expires.
+ */
+int deadline_poll_timeout(hrt_abstime now);
+
+/**
+ * Disarm all expired deadlines.
+ *
+ * @return bitmask of the deadlines that expired
+ */
+unsigned deadlines_expire(hrt_abstime now);
+
 void check_mode_switches(struct manual_control_setpoint_s *sp_man, struct vehicle_status_s *status);
 
 transition_result_t set_main_state_rc(struct vehicle_status_s *status);
@@ -676,6 +738,7 @@ int commander_thread_main(int argc, char *argv[])
 	/* mark all signals lost as long as they haven't been found */
 	status.rc_signal_lost = true;
 	status.offboard_control_signal_lost = true;
+	status.data_link_lost = true;
 
 	/* set battery warning flag */
 	status.battery_warning = VEHICLE_BATTERY_WARNING_NONE;
@@ -730,9 +793,8 @@ int commander_thread_main(int argc, char *argv[])
 	pthread_attr_destroy(&commander_low_prio_attr);
 
 	/* Start monitoring loop */
-	unsigned counter = 0;
-	unsigned stick_off_counter = 0;
-	unsigned stick_on_counter = 0;
+	hrt_abstime stick_off_time = 0;		/**< time the disarm stick position was entered, 0 if not held */
+	hrt_abstime stick_on_time = 0;		/**< time the arm stick position was entered, 0 if not held */
 
 	bool low_battery_voltage_actions_done = false;
 	bool critical_battery_voltage_actions_done = false;
@@ -740,11 +802,13 @@ int commander_thread_main(int argc, char *argv[])
 	uint64_t last_idle_time = 0;
 	uint64_t start_time = 0;
 
+	hrt_abstime last_load_time = 0;
+	hrt_abstime last_status_publish = 0;
+	hrt_abstime last_mavlink_open = 0;
+
 	bool status_changed = true;
 	bool param_init_forced = true;
 
-	bool updated = false;
-
 	bool rc_calibration_ok = (OK == rc_calibration_check(mavlink_fd));
 
 	/* Subscribe to safety topic */
@@ -784,11 +848,6 @@ int commander_thread_main(int argc, char *argv[])
 	struct vehicle_gps_position_s gps_position;
 	memset(&gps_position, 0, sizeof(gps_position));
 
-	/* Subscribe to sensor topic */
-	int sensor_sub = orb_subscribe(ORB_ID(sensor_combined));
-	struct sensor_combined_s sensors;
-	memset(&sensors, 0, sizeof(sensors));
-
 	/* Subscribe to differential pressure topic */
 	int diff_pres_sub = orb_subscribe(ORB_ID(differential_pressure));
 	struct differential_pressure_s diff_pres;
@@ -814,25 +873,83 @@ int commander_thread_main(int argc, char *argv[])
 	struct subsystem_info_s info;
 	memset(&info, 0, sizeof(info));
 
+	/* Subscribe to telemetry status topic */
+	int telemetry_sub = orb_subscribe(ORB_ID(telemetry_status));
+	struct telemetry_status_s telemetry;
+	memset(&telemetry, 0, sizeof(telemetry));
+
+	/*
+	 * Estimates, airspeed and battery are published much faster than the
+	 * state machine needs them, their validity is tracked by deadlines anyway.
+	 */
+	orb_set_interval(global_position_sub, COMMANDER_INPUT_INTERVAL);
+	orb_set_interval(local_position_sub, COMMANDER_INPUT_INTERVAL);
+	orb_set_interval(diff_pres_sub, COMMANDER_INPUT_INTERVAL);
+	orb_set_interval(battery_sub, COMMANDER_INPUT_INTERVAL);
+
+	/* wakeup sources */
+	struct pollfd fds[INPUT_MAX];
+	fds[INPUT_PARAM].fd = param_changed_sub;
+	fds[INPUT_MANUAL].fd = sp_man_sub;
+	fds[INPUT_OFFBOARD].fd = sp_offboard_sub;
+	fds[INPUT_SAFETY].fd = safety_sub;
+	fds[INPUT_GLOBAL_POSITION].fd = global_position_sub;
+	fds[INPUT_LOCAL_POSITION].fd = local_position_sub;
+	fds[INPUT_GPS].fd = gps_sub;
+	fds[INPUT_DIFF_PRES].fd = diff_pres_sub;
+	fds[INPUT_BATTERY].fd = battery_sub;
+	fds[INPUT_SUBSYS].fd = subsys_sub;
+	fds[INPUT_TELEMETRY].fd = telemetry_sub;
+	fds[INPUT_CMD].fd = cmd_sub;
+
+	for (unsigned i = 0; i < INPUT_MAX; i++) {
+		fds[i].events = POLLIN;
+		fds[i].revents = 0;
+	}
+
+	memset(deadlines, 0, sizeof(deadlines));
+
 	control_status_leds(&status, &armed, true);
 
 	/* now initialized */
 	commander_initialized = true;
 	thread_running = true;
 
+	boot_trace_mark("commander_init");
+
 	start_time = hrt_absolute_time();
+	deadline_set(DEADLINE_MONITORING, start_time);
 
 	while (!thread_should_exit) {
 
-		if (mavlink_fd < 0 && counter % (1000000 / MAVLINK_OPEN_INTERVAL) == 0) {
+		/* sleep until an input changes or the nearest deadline expires */
+		int pret = poll(&fds[0], INPUT_MAX, deadline_poll_timeout(hrt_absolute_time()));
+
+		if (pret < 0) {
+			/* this is undesirable but not much we can do, don't spin on it */
+			warn("poll error %d, %d", pret, errno);
+			usleep(COMMANDER_MONITORING_INTERVAL);
+			continue;
+		}
+
+		hrt_abstime now = hrt_absolute_time();
+		unsigned expired = deadlines_expire(now);
+
+		/* housekeeping runs at the monitoring interval whether or not anything changed */
+		bool monitoring = (expired & (1 << DEADLINE_MONITORING));
+
+		if (monitoring) {
+			deadline_set(DEADLINE_MONITORING, now + COMMANDER_MONITORING_INTERVAL);
+		}
+
+		if (monitoring && mavlink_fd < 0 && now > last_mavlink_open + MAVLINK_OPEN_INTERVAL) {
 			/* try to open the mavlink log device every once in a while */
 			mavlink_fd = open(MAVLINK_LOG_DEVICE, 0);
+			last_mavlink_open = now;
 		}
 
 		/* update parameters */
-		orb_check(param_changed_sub, &updated);
-
-		if (updated || param_init_forced) {
+		if ((fds[INPUT_PARAM].revents & POLLIN) || param_init_forced) {
 			param_init_forced = false;
 			/* parameters changed */
 			orb_copy(ORB_ID(parameter_update), param_changed_sub, &param_changed);
@@ -869,36 +986,25 @@ int commander_thread_main(int argc, char *argv[])
 			param_get(_param_enable_parachute, &parachute_enabled);
 		}
 
-		orb_check(sp_man_sub, &updated);
-
-		if (updated) {
+		if (fds[INPUT_MANUAL].revents & POLLIN) {
 			orb_copy(ORB_ID(manual_control_setpoint), sp_man_sub, &sp_man);
+			deadline_set(DEADLINE_RC, sp_man.timestamp + RC_TIMEOUT);
 		}
 
-		orb_check(sp_offboard_sub, &updated);
-
-		if (updated) {
+		if (fds[INPUT_OFFBOARD].revents & POLLIN) {
 			orb_copy(ORB_ID(offboard_control_setpoint), sp_offboard_sub, &sp_offboard);
+			deadline_set(DEADLINE_OFFBOARD, sp_offboard.timestamp + OFFBOARD_TIMEOUT);
 		}
 
-		orb_check(sensor_sub, &updated);
-
-		if (updated) {
-			orb_copy(ORB_ID(sensor_combined), sensor_sub, &sensors);
-		}
-
-		orb_check(diff_pres_sub, &updated);
-
-		if (updated) {
+		if (fds[INPUT_DIFF_PRES].revents & POLLIN) {
 			orb_copy(ORB_ID(differential_pressure), diff_pres_sub, &diff_pres);
+			deadline_set(DEADLINE_AIRSPEED, diff_pres.timestamp + DIFFPRESS_TIMEOUT);
 		}
 
 		check_valid(diff_pres.timestamp, DIFFPRESS_TIMEOUT, true, &(status.condition_airspeed_valid), &status_changed);
 
 		/* update safety topic */
-		orb_check(safety_sub, &updated);
-
-		if (updated) {
+		if (fds[INPUT_SAFETY].revents & POLLIN) {
 			orb_copy(ORB_ID(safety), safety_sub, &safety);
 
 			/* disarm if safety is now on and still armed */
@@ -911,22 +1017,20 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* update global position estimate */
-		orb_check(global_position_sub, &updated);
-
-		if (updated) {
+		if (fds[INPUT_GLOBAL_POSITION].revents & POLLIN) {
 			/* position changed */
 			orb_copy(ORB_ID(vehicle_global_position), global_position_sub, &global_position);
+			deadline_set(DEADLINE_GLOBAL_POSITION, global_position.timestamp + POSITION_TIMEOUT);
 		}
 
 		/* update condition_global_position_valid */
 		check_valid(global_position.timestamp, POSITION_TIMEOUT, global_position.global_valid, &(status.condition_global_position_valid), &status_changed);
 
 		/* update local position estimate */
-		orb_check(local_position_sub, &updated);
-
-		if (updated) {
+		if (fds[INPUT_LOCAL_POSITION].revents & POLLIN) {
 			/* position changed */
 			orb_copy(ORB_ID(vehicle_local_position), local_position_sub, &local_position);
+			deadline_set(DEADLINE_LOCAL_POSITION, local_position.timestamp + POSITION_TIMEOUT);
 		}
 
 		/* update condition_local_position_valid and condition_local_altitude_valid */
@@ -956,13 +1060,11 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* update battery status */
-		orb_check(battery_sub, &updated);
-
-		if (updated) {
+		if (fds[INPUT_BATTERY].revents & POLLIN) {
 			orb_copy(ORB_ID(battery_status), battery_sub, &battery);
 
 			/* only consider battery voltage if system has been running 2s and battery voltage is valid */
-			if (status.hil_state == HIL_STATE_OFF && hrt_absolute_time() > start_time + 2000000 && battery.voltage_filtered_v > 0.0f) {
+			if (status.hil_state == HIL_STATE_OFF && now > start_time + 2000000 && battery.voltage_filtered_v > 0.0f) {
 				status.battery_voltage = battery.voltage_filtered_v;
 				status.battery_current = battery.current_a;
 				status.condition_battery_voltage_valid = true;
@@ -971,9 +1073,7 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* update subsystem */
-		orb_check(subsys_sub, &updated);
-
-		if (updated) {
+		if (fds[INPUT_SUBSYS].revents & POLLIN) {
 			orb_copy(ORB_ID(subsystem_info), subsys_sub, &info);
 
 			warnx("subsystem changed: %d\n", (int)info.subsystem_type);
@@ -1005,14 +1105,63 @@ int commander_thread_main(int argc, char *argv[])
 			status_changed = true;
 		}
 
-		if (counter % (1000000 / COMMANDER_MONITORING_INTERVAL) == 0) {
+		/* update telemetry link */
+		if (fds[INPUT_TELEMETRY].revents & POLLIN) {
+			orb_copy(ORB_ID(telemetry_status), telemetry_sub, &telemetry);
+			deadline_set(DEADLINE_DATA_LINK, telemetry.timestamp + DATA_LINK_TIMEOUT);
+		}
+
+		if (telemetry.timestamp != 0 && now < telemetry.timestamp + DATA_LINK_TIMEOUT) {
+			if (!status.data_link_found_once) {
+				status.data_link_found_once = true;
+				status_changed = true;
+
+			} else if (status.data_link_lost) {
+				mavlink_log_critical(mavlink_fd, "#audio: data link regained");
+				status_changed = true;
+			}
+
+			status.data_link_lost = false;
+
+		} else if (status.data_link_found_once && !status.data_link_lost) {
+			mavlink_log_critical(mavlink_fd, "#audio: CRITICAL: DATA LINK LOST");
+			status.data_link_lost = true;
+			status_changed = true;
+		}
+
+		/* update offboard control signal */
+		if (sp_offboard.timestamp != 0 && now < sp_offboard.timestamp + OFFBOARD_TIMEOUT) {
+			if (!status.offboard_control_signal_found_once) {
+				status.offboard_control_signal_found_once = true;
+				mavlink_log_info(mavlink_fd, "[cmd] detected offboard signal first time");
+				status_changed = true;
+
+			} else if (status.offboard_control_signal_lost) {
+				mavlink_log_info(mavlink_fd, "[cmd] offboard signal regained");
+				status_changed = true;
+			}
+
+			status.offboard_control_signal_lost = false;
+
+		} else if (status.offboard_control_signal_found_once && !status.offboard_control_signal_lost) {
+			mavlink_log_critical(mavlink_fd, "#audio: offboard signal lost");
+			status.offboard_control_signal_lost = true;
+			status_changed = true;
+		}
+
+		if (sp_offboard.timestamp != 0) {
+			status.offboard_control_signal_lost_interval = now - sp_offboard.timestamp;
+		}
+
+		if (monitoring && now >= last_load_time + COMMANDER_LOAD_INTERVAL) {
 			/* compute system load */
 			uint64_t interval_runtime = system_load.tasks[0].total_runtime - last_idle_time;
 
 			if (last_idle_time > 0)
-				status.load = 1.0f - ((float)interval_runtime / 1e6f);	//system load is time spent in non-idle
+				status.load = 1.0f - ((float)interval_runtime / (float)(now - last_load_time));	//system load is time spent in non-idle
 
 			last_idle_time = system_load.tasks[0].total_runtime;
+			last_load_time = now;
 
 			/* check if board is connected via USB */
 			//struct stat statbuf;
@@ -1063,9 +1212,7 @@ int commander_thread_main(int argc, char *argv[])
 		 * set of position measurements is available.
 		 */
 
-		orb_check(gps_sub, &updated);
-
-		if (updated) {
+		if (fds[INPUT_GPS].revents & POLLIN) {
 			orb_copy(ORB_ID(vehicle_gps_position), gps_sub, &gps_position);
 			/* check if GPS fix is ok */
 			float hdop_threshold_m = 4.0f;
@@ -1083,7 +1230,7 @@ int commander_thread_main(int argc, char *argv[])
 
 			if (!status.condition_home_position_valid && gps_position.fix_type >= 3 &&
 			    (gps_position.eph_m < hdop_threshold_m) && (gps_position.epv_m < vdop_threshold_m) &&
-			    (hrt_absolute_time() < gps_position.timestamp_position + POSITION_TIMEOUT) && !armed.armed
+			    (now < gps_position.timestamp_position + POSITION_TIMEOUT) && !armed.armed
 			    && global_position.global_valid) {
 
 				/* copy position data to uORB home message, store it locally as well */
@@ -1109,7 +1256,7 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* start RC input check */
-		if (!status.rc_input_blocked && sp_man.timestamp != 0 && hrt_absolute_time() < sp_man.timestamp + RC_TIMEOUT) {
+		if (!status.rc_input_blocked && sp_man.timestamp != 0 && now < sp_man.timestamp + RC_TIMEOUT) {
 			/* handle the case where RC signal was regained */
 			if (!status.rc_signal_found_once) {
 				status.rc_signal_found_once = true;
@@ -1137,24 +1284,30 @@ int commander_thread_main(int argc, char *argv[])
 			    (status.main_state == MAIN_STATE_MANUAL || status.condition_landed) &&
 			    sp_man.yaw < -STICK_ON_OFF_LIMIT && sp_man.throttle < STICK_THRUST_RANGE * 0.1f) {
 
-				if (stick_off_counter > STICK_ON_OFF_COUNTER_LIMIT) {
+				if (stick_off_time == 0) {
+					/* wake up when the stick has been held long enough, even if RC input stops changing */
+					stick_off_time = now;
+					deadline_set(DEADLINE_STICK, now + STICK_ON_OFF_HYSTERESIS_TIME);
+
+				} else if (now >= stick_off_time + STICK_ON_OFF_HYSTERESIS_TIME) {
 					/* disarm to STANDBY if ARMED or to STANDBY_ERROR if ARMED_ERROR */
 					arming_state_t new_arming_state = (status.arming_state == ARMING_STATE_ARMED ? ARMING_STATE_STANDBY : ARMING_STATE_STANDBY_ERROR);
 					res = arming_state_transition(&status, &safety, new_arming_state, &armed);
-					stick_off_counter = 0;
-
-				} else {
-					stick_off_counter++;
+					stick_off_time = 0;
 				}
 
 			} else {
-				stick_off_counter = 0;
+				stick_off_time = 0;
 			}
 
 			/* check if left stick is in lower right position and we're in MANUAL mode -> arm */
 			if (status.arming_state == ARMING_STATE_STANDBY &&
 			    sp_man.yaw > STICK_ON_OFF_LIMIT && sp_man.throttle < STICK_THRUST_RANGE * 0.1f) {
-				if (stick_on_counter > STICK_ON_OFF_COUNTER_LIMIT) {
+				if (stick_on_time == 0) {
+					stick_on_time = now;
+					deadline_set(DEADLINE_STICK, now + STICK_ON_OFF_HYSTERESIS_TIME);
+
+				} else if (now >= stick_on_time + STICK_ON_OFF_HYSTERESIS_TIME) {
 					if (safety.safety_switch_available && !safety.safety_off && status.hil_state == HIL_STATE_OFF) {
 						print_reject_arm("NOT ARMING: Press safety switch first.");
 
@@ -1165,14 +1318,11 @@ int commander_thread_main(int argc, char *argv[])
 						res = arming_state_transition(&status, &safety, ARMING_STATE_ARMED, &armed);
 					}
 
-					stick_on_counter = 0;
-
-				} else {
-					stick_on_counter++;
+					stick_on_time = 0;
 				}
 
 			} else {
-				stick_on_counter = 0;
+				stick_on_time = 0;
 			}
 
 			if (res == TRANSITION_CHANGED) {
@@ -1209,6 +1359,9 @@ int commander_thread_main(int argc, char *argv[])
 			}
 
 		} else {
+			stick_off_time = 0;
+			stick_on_time = 0;
+
 			if (!status.rc_signal_lost) {
 				mavlink_log_critical(mavlink_fd, "#audio: CRITICAL: RC SIGNAL LOST");
 				status.rc_signal_lost = true;
@@ -1262,9 +1415,7 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* handle commands last, as the system needs to be updated to handle them */
-		orb_check(cmd_sub, &updated);
-
-		if (updated) {
+		if (fds[INPUT_CMD].revents & POLLIN) {
 			/* got command */
 			orb_copy(ORB_ID(vehicle_command), cmd_sub, &cmd);
 
@@ -1278,8 +1429,6 @@ int commander_thread_main(int argc, char *argv[])
 		bool main_state_changed = check_main_state_changed();
 		bool failsafe_state_changed = check_failsafe_state_changed();
 
-		hrt_abstime t1 = hrt_absolute_time();
-
 		/* print new state */
 		if (arming_state_changed) {
 			status_changed = true;
@@ -1297,16 +1446,18 @@ int commander_thread_main(int argc, char *argv[])
 		}
 
 		/* publish states (armed, control mode, vehicle status) at least with 5 Hz */
-		if (counter % (200000 / COMMANDER_MONITORING_INTERVAL) == 0 || status_changed) {
+		if (now >= last_status_publish + COMMANDER_STATUS_INTERVAL || status_changed) {
 			set_control_mode();
-			control_mode.timestamp = t1;
+			control_mode.timestamp = now;
 			orb_publish(ORB_ID(vehicle_control_mode), control_mode_pub, &control_mode);
 
-			status.timestamp = t1;
+			status.timestamp = now;
 			orb_publish(ORB_ID(vehicle_status), status_pub, &status);
 
-			armed.timestamp = t1;
+			armed.timestamp = now;
 			orb_publish(ORB_ID(actuator_armed), armed_pub, &armed);
+
+			last_status_publish = now;
 		}
 
 		/* play arming and battery warning tunes */
@@ -1332,8 +1483,9 @@ int commander_thread_main(int argc, char *argv[])
 			arm_tune_played = false;
 		}
 
-		fflush(stdout);
-		counter++;
+		if (monitoring) {
+			fflush(stdout);
+		}
 
 		int blink_state = blink_msg_state();
 
@@ -1344,14 +1496,12 @@ int commander_thread_main(int argc, char *argv[])
 				control_status_leds(&status, &armed, true);
 			}
 
-		} else {
+		} else if (monitoring || status_changed) {
 			/* normal state */
 			control_status_leds(&status, &armed, status_changed);
 		}
 
 		status_changed = false;
-
-		usleep(COMMANDER_MONITORING_INTERVAL);
 	}
 
 	/* wait for threads to complete */
@@ -1371,10 +1521,10 @@ int commander_thread_main(int argc, char *argv[])
 	close(local_position_sub);
 	close(global_position_sub);
 	close(gps_sub);
-	close(sensor_sub);
 	close(safety_sub);
 	close(cmd_sub);
 	close(subsys_sub);
+	close(telemetry_sub);
 	close(diff_pres_sub);
 	close(param_changed_sub);
 	close(battery_sub);
@@ -1396,6 +1546,45 @@ check_valid(hrt_abstime timestamp, hrt_abstime timeout, bool valid_in, bool *val
 	}
 }
 
+void
+deadline_set(enum COMMANDER_DEADLINE deadline, hrt_abstime t)
+{
+	deadlines[deadline] = t;
+}
+
+int
+deadline_poll_timeout(hrt_abstime now)
+{
+	/* the monitoring deadline is always armed, so this is bounded by its interval */
+	hrt_abstime nearest = now + COMMANDER_MONITORING_INTERVAL;
+
+	for (unsigned i = 0; i < DEADLINE_MAX; i++) {
+		if (deadlines[i] != 0 && deadlines[i] < nearest)
+			nearest = deadlines[i];
+	}
+
+	if (nearest <= now)
+		return 0;
+
+	/* round up, waking before the deadline would just mean another poll */
+	return (nearest - now + 999) / 1000;
+}
+
+unsigned
+deadlines_expire(hrt_abstime now)
+{
+	unsigned expired = 0;
+
+	for (unsigned i = 0; i < DEADLINE_MAX; i++) {
+		if (deadlines[i] != 0 && deadlines[i] <= now) {
+			deadlines[i] = 0;
+			expired |= (1 << i);
+		}
+	}
+
+	return expired;
+}
+
 void
 control_status_leds(vehicle_status_s *status, const actuator_armed_s *actuator_armed, bool changed)
 {
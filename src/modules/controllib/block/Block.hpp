@@ -62,6 +62,7 @@ static const uint8_t blockNameLengthMax = 80;
 // forward declaration
 class BlockParamBase;
 class SuperBlock;
+template <uint16_t, uint16_t, uint16_t, uint16_t> class BlockGraph;
 
 /**
  */
@@ -70,6 +71,7 @@ class __EXPORT Block :
 {
 public:
 	friend class BlockParamBase;
+	template <uint16_t, uint16_t, uint16_t, uint16_t> friend class BlockGraph;
 // methods
 	Block(SuperBlock *parent, const char *name);
 	void getName(char *name, size_t n);
@@ -86,6 +88,7 @@ protected:
 	List<uORB::SubscriptionBase *> & getSubscriptions() { return _subscriptions; }
 	List<uORB::PublicationBase *> & getPublications() { return _publications; }
 	List<BlockParamBase *> & getParams() { return _params; }
+	virtual List<Block *> *getChildList() { return NULL; }
 // attributes
 	const char *_name;
 	SuperBlock *_parent;
@@ -125,6 +128,7 @@ public:
 protected:
 // methods
 	List<Block *> & getChildren() { return _children; }
+	virtual List<Block *> *getChildList() { return &_children; }
 	void updateChildParams();
 	void updateChildSubscriptions();
 	void updateChildPublications();
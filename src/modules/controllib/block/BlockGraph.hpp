@@ -0,0 +1,211 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file BlockGraph.hpp
+ *
+ * Flattened update chain of a block tree.
+ *
+ * Block/SuperBlock keep their children, params, subscriptions and
+ * publications in linked lists, and every control step walks the whole
+ * tree recursively with virtual calls. A BlockGraph walks the tree once,
+ * after all blocks are constructed, and keeps flat arrays sized at compile
+ * time, so the per-step updates become plain loops.
+ *
+ * The graph is a snapshot: blocks, params, subscriptions or publications
+ * added after it was built are not updated through it. Blocks updated via
+ * a graph must not override setDt(). If the tree does not fit the arrays,
+ * the graph falls back to the recursive updates of the root block.
+ */
+
+#pragma once
+
+#include <stdio.h>
+
+#include <uORB/Subscription.hpp>
+#include <uORB/Publication.hpp>
+
+#include "Block.hpp"
+#include "BlockParam.hpp"
+
+namespace control
+{
+
+template <uint16_t maxBlocks, uint16_t maxParams,
+	  uint16_t maxSubscriptions, uint16_t maxPublications>
+class __EXPORT BlockGraph
+{
+public:
+	/**
+	 * Flatten the tree below root, call once all blocks are constructed.
+	 */
+	BlockGraph(SuperBlock *root) :
+		_root(root),
+		_numBlocks(0),
+		_numParams(0),
+		_numSubscriptions(0),
+		_numPublications(0),
+		_overflow(false) {
+		add(root);
+
+		if (_overflow) {
+			char name[blockNameLengthMax];
+			root->getName(name, blockNameLengthMax);
+			printf("block graph too small for block: %s, using recursive updates\n", name);
+		}
+	}
+	void setDt(float dt) {
+		if (_overflow) {
+			_root->setDt(dt);
+			return;
+		}
+
+		for (uint16_t i = 0; i < _numBlocks; i++) {
+			_blocks[i]->_dt = dt;
+		}
+	}
+	void updateParams() {
+		if (_overflow) {
+			_root->updateParams();
+			return;
+		}
+
+		for (uint16_t i = 0; i < _numParams; i++) {
+			_params[i]->update();
+		}
+	}
+	void updateSubscriptions() {
+		if (_overflow) {
+			_root->updateSubscriptions();
+			return;
+		}
+
+		for (uint16_t i = 0; i < _numSubscriptions; i++) {
+			bool updated = false;
+			orb_check(_subscriptions[i].handle, &updated);
+
+			if (updated) {
+				orb_copy(_subscriptions[i].meta, _subscriptions[i].handle,
+					 _subscriptions[i].data);
+			}
+		}
+	}
+	void updatePublications() {
+		if (_overflow) {
+			_root->updatePublications();
+			return;
+		}
+
+		for (uint16_t i = 0; i < _numPublications; i++) {
+			// the first update advertises the topic
+			_publications[i]->update();
+		}
+	}
+// accessors
+	uint16_t getNumBlocks() { return _numBlocks; }
+	uint16_t getNumParams() { return _numParams; }
+	uint16_t getNumSubscriptions() { return _numSubscriptions; }
+	uint16_t getNumPublications() { return _numPublications; }
+	bool overflow() { return _overflow; }
+private:
+	struct Subscription {
+		const struct orb_metadata *meta;
+		int handle;
+		void *data;
+	};
+	void add(Block *block) {
+		if (_numBlocks < maxBlocks) {
+			_blocks[_numBlocks++] = block;
+
+		} else {
+			_overflow = true;
+		}
+
+		for (BlockParamBase *param = block->getParams().getHead();
+		     param != NULL; param = param->getSibling()) {
+			if (_numParams < maxParams) {
+				_params[_numParams++] = param;
+
+			} else {
+				_overflow = true;
+			}
+		}
+
+		for (uORB::SubscriptionBase *sub = block->getSubscriptions().getHead();
+		     sub != NULL; sub = sub->getSibling()) {
+			if (_numSubscriptions < maxSubscriptions) {
+				// resolve the data pointer once instead of every step
+				_subscriptions[_numSubscriptions].meta = sub->getMeta();
+				_subscriptions[_numSubscriptions].handle = sub->getHandle();
+				_subscriptions[_numSubscriptions].data = sub->getDataVoidPtr();
+				_numSubscriptions++;
+
+			} else {
+				_overflow = true;
+			}
+		}
+
+		for (uORB::PublicationBase *pub = block->getPublications().getHead();
+		     pub != NULL; pub = pub->getSibling()) {
+			if (_numPublications < maxPublications) {
+				_publications[_numPublications++] = pub;
+
+			} else {
+				_overflow = true;
+			}
+		}
+
+		List<Block *> *children = block->getChildList();
+
+		if (children == NULL) return;
+
+		for (Block *child = children->getHead();
+		     child != NULL; child = child->getSibling()) {
+			add(child);
+		}
+	}
+// attributes
+	SuperBlock *_root;
+	Block *_blocks[maxBlocks];
+	BlockParamBase *_params[maxParams];
+	Subscription _subscriptions[maxSubscriptions];
+	uORB::PublicationBase *_publications[maxPublications];
+	uint16_t _numBlocks;
+	uint16_t _numParams;
+	uint16_t _numSubscriptions;
+	uint16_t _numPublications;
+	bool _overflow;
+};
+
+} // namespace control
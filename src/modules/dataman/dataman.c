@@ -61,8 +61,8 @@
  */
 
 __EXPORT int dataman_main(int argc, char *argv[]);
-__EXPORT ssize_t dm_read(dm_item_t item, unsigned char index, void *buffer, size_t buflen);
-__EXPORT ssize_t dm_write(dm_item_t  item, unsigned char index, dm_persitence_t persistence, const void *buffer, size_t buflen);
+__EXPORT ssize_t dm_read(dm_item_t item, unsigned index, void *buffer, size_t buflen);
+__EXPORT ssize_t dm_write(dm_item_t  item, unsigned index, dm_persitence_t persistence, const void *buffer, size_t buflen);
 __EXPORT int dm_clear(dm_item_t item);
 __EXPORT int dm_restart(dm_reset_reason restart_type);
 
@@ -84,14 +84,14 @@ typedef struct {
 	union {
 		struct {
 			dm_item_t item;
-			unsigned char index;
+			unsigned index;
 			dm_persitence_t persistence;
 			const void *buf;
 			size_t count;
 		} write_params;
 		struct {
 			dm_item_t item;
-			unsigned char index;
+			unsigned index;
 			void *buf;
 			size_t count;
 		} read_params;
@@ -116,6 +116,15 @@ static const unsigned g_per_item_max_index[DM_KEY_NUM_KEYS] = {
 	DM_KEY_WAYPOINTS_ONBOARD_MAX
 };
 
+/* table of instance size for each item type */
+static const unsigned g_per_item_size[DM_KEY_NUM_KEYS] = {
+	DM_KEY_SAFE_POINTS_SIZE,
+	DM_KEY_FENCE_POINTS_SIZE,
+	DM_KEY_WAYPOINTS_OFFBOARD_0_SIZE,
+	DM_KEY_WAYPOINTS_OFFBOARD_1_SIZE,
+	DM_KEY_WAYPOINTS_ONBOARD_SIZE
+};
+
 /* Table of offset for index 0 of each item type */
 static unsigned int g_key_offsets[DM_KEY_NUM_KEYS];
 
@@ -140,8 +149,26 @@ sem_t g_init_sema;
 
 static bool g_task_should_exit;		/**< if true, dataman task should exit */
 
+/* File header in front of the items, a file written with another item layout is reset */
+#define DM_FILE_MAGIC	0x4e414d44	/* "DMAN" */
+#define DM_FILE_VERSION	2		/* compact mission item and fence vertex records */
+
+struct dm_file_header_s {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t reserved;
+	uint32_t size;		/* file size the items need, changes with their counts and sizes */
+};
+
 #define DM_SECTOR_HDR_SIZE 4	/* data manager per item header overhead */
-static const unsigned k_sector_size = DM_MAX_DATA_SIZE + DM_SECTOR_HDR_SIZE; /* total item sorage space */
+static const unsigned k_sector_size = DM_MAX_DATA_SIZE + DM_SECTOR_HDR_SIZE; /* largest item storage space */
+
+/* Storage space of an item of the given type */
+static inline unsigned
+item_sector_size(dm_item_t item)
+{
+	return g_per_item_size[item] + DM_SECTOR_HDR_SIZE;
+}
 
 static void init_q(work_q_t *q)
 {
@@ -251,7 +278,7 @@ enqueue_work_item_and_wait_for_result(work_q_item_t *item)
 
 /* Calculate the offset in file of specific item */
 static int
-calculate_offset(dm_item_t item, unsigned char index)
+calculate_offset(dm_item_t item, unsigned index)
 {
 
 	/* Make sure the item type is valid */
@@ -263,7 +290,7 @@ calculate_offset(dm_item_t item, unsigned char index)
 		return -1;
 
 	/* Calculate and return the item index based on type and index */
-	return g_key_offsets[item] + (index * k_sector_size);
+	return g_key_offsets[item] + (index * item_sector_size(item));
 }
 
 /* Each data item is stored as follows
@@ -274,12 +301,13 @@ calculate_offset(dm_item_t item, unsigned char index)
  * byte 3: Unused (for future use)
  * byte DM_SECTOR_HDR_SIZE... : data item value
  *
- * The total size must not exceed k_sector_size
+ * The total size is the item size of the type plus the header, items of a
+ * type are stored back to back
  */
 
 /* write to the data manager file */
 static ssize_t
-_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
+_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
 {
 	unsigned char buffer[k_sector_size];
 	size_t len;
@@ -293,7 +321,7 @@ _write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const v
 		return -1;
 
 	/* Make sure caller has not given us more data than we can handle */
-	if (count > DM_MAX_DATA_SIZE) 
+	if (count > g_per_item_size[item])
 		return -1;
 
 	/* Write out the data, prefixed with length and persistence level */
@@ -321,7 +349,7 @@ _write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const v
 
 /* Retrieve from the data manager file */
 static ssize_t
-_read(dm_item_t item, unsigned char index, void *buf, size_t count)
+_read(dm_item_t item, unsigned index, void *buf, size_t count)
 {
 	unsigned char buffer[k_sector_size];
 	int len, offset;
@@ -337,6 +365,10 @@ _read(dm_item_t item, unsigned char index, void *buf, size_t count)
 	if (count > DM_MAX_DATA_SIZE)
 		return -1;
 
+	/* Don't read into the next item */
+	if (count > g_per_item_size[item])
+		count = g_per_item_size[item];
+
 	/* Read the prefix and data */
 	len = -1;
 	if (lseek(g_task_fd, offset, SEEK_SET) == offset)
@@ -404,7 +436,7 @@ _clear(dm_item_t item)
 			}
 		}
 
-		offset += k_sector_size;
+		offset += item_sector_size(item);
 	}
 
 	/* Make sure data is actually written to physical media */
@@ -423,8 +455,10 @@ _restart(dm_reset_reason reason)
 
 	/* Loop through all of the data segments and delete those that are not persistent */
 	offset = 0;
+	dm_item_t item = DM_KEY_SAFE_POINTS;
+	unsigned index = 0;
 
-	while (1) {
+	while (item < DM_KEY_NUM_KEYS) {
 		size_t len;
 
 		/* Get data segment at current offset */
@@ -472,7 +506,13 @@ _restart(dm_reset_reason reason)
 			}
 		}
 
-		offset += k_sector_size;
+		offset += item_sector_size(item);
+
+		/* items of the next type follow the last one of this type */
+		if (++index >= g_per_item_max_index[item]) {
+			item++;
+			index = 0;
+		}
 	}
 
 	fsync(g_task_fd);
@@ -483,7 +523,7 @@ _restart(dm_reset_reason reason)
 
 /* write to the data manager file */
 __EXPORT ssize_t
-dm_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
+dm_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
 {
 	work_q_item_t *work;
 
@@ -508,7 +548,7 @@ dm_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const
 
 /* Retrieve from the data manager file */
 __EXPORT ssize_t
-dm_read(dm_item_t item, unsigned char index, void *buf, size_t count)
+dm_read(dm_item_t item, unsigned index, void *buf, size_t count)
 {
 	work_q_item_t *work;
 
@@ -530,6 +570,68 @@ dm_read(dm_item_t item, unsigned char index, void *buf, size_t count)
 	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
 }
 
+/* Retrieve a mission item, stored as compact record */
+__EXPORT ssize_t
+dm_read_mission_item(dm_item_t item, unsigned index, struct mission_item_s *mission_item)
+{
+	struct dm_mission_item_s record;
+	ssize_t len = dm_read(item, index, &record, sizeof(record));
+
+	/* Empty or error */
+	if (len != sizeof(record))
+		return (len == 0) ? 0 : -1;
+
+	dm_unpack_mission_item(&record, mission_item);
+	return sizeof(*mission_item);
+}
+
+/* Store a mission item as compact record */
+__EXPORT ssize_t
+dm_write_mission_item(dm_item_t item, unsigned index, dm_persitence_t persistence, const struct mission_item_s *mission_item)
+{
+	struct dm_mission_item_s record;
+
+	/* The record has a byte for the command, don't store a truncated one */
+	if ((unsigned)mission_item->nav_cmd > UINT8_MAX)
+		return -1;
+
+	dm_pack_mission_item(mission_item, &record);
+
+	if (dm_write(item, index, persistence, &record, sizeof(record)) != sizeof(record))
+		return -1;
+
+	return sizeof(*mission_item);
+}
+
+/* Retrieve a fence vertex, stored as compact record */
+__EXPORT ssize_t
+dm_read_fence_vertex(unsigned index, struct fence_vertex_s *vertex)
+{
+	struct dm_fence_vertex_s record;
+	ssize_t len = dm_read(DM_KEY_FENCE_POINTS, index, &record, sizeof(record));
+
+	/* Empty or error */
+	if (len != sizeof(record))
+		return (len == 0) ? 0 : -1;
+
+	dm_unpack_fence_vertex(&record, vertex);
+	return sizeof(*vertex);
+}
+
+/* Store a fence vertex as compact record */
+__EXPORT ssize_t
+dm_write_fence_vertex(unsigned index, dm_persitence_t persistence, const struct fence_vertex_s *vertex)
+{
+	struct dm_fence_vertex_s record;
+
+	dm_pack_fence_vertex(vertex, &record);
+
+	if (dm_write(DM_KEY_FENCE_POINTS, index, persistence, &record, sizeof(record)) != sizeof(record))
+		return -1;
+
+	return sizeof(*vertex);
+}
+
 __EXPORT int
 dm_clear(dm_item_t item)
 {
@@ -580,12 +682,13 @@ task_main(int argc, char *argv[])
 	warnx("Initializing..");
 
 	/* Initialize global variables */
-	g_key_offsets[0] = 0;
+	g_key_offsets[0] = sizeof(struct dm_file_header_s);
 
 	for (unsigned i = 0; i < (DM_KEY_NUM_KEYS - 1); i++)
-		g_key_offsets[i + 1] = g_key_offsets[i] + (g_per_item_max_index[i] * k_sector_size);
+		g_key_offsets[i + 1] = g_key_offsets[i] + (g_per_item_max_index[i] * item_sector_size(i));
 
-	unsigned max_offset = g_key_offsets[DM_KEY_NUM_KEYS - 1] + (g_per_item_max_index[DM_KEY_NUM_KEYS - 1] * k_sector_size);
+	unsigned max_offset = g_key_offsets[DM_KEY_NUM_KEYS - 1] +
+			      (g_per_item_max_index[DM_KEY_NUM_KEYS - 1] * item_sector_size(DM_KEY_NUM_KEYS - 1));
 
 	for (unsigned i = 0; i < dm_number_of_funcs; i++)
 		g_func_counts[i] = 0;
@@ -604,6 +707,31 @@ task_main(int argc, char *argv[])
 		sem_post(&g_init_sema); /* Don't want to hang startup */
 		return -1;
 	}
+
+	/* Items of an older layout would be misread, start over with an empty file */
+	struct dm_file_header_s hdr;
+
+	if ((read(g_task_fd, &hdr, sizeof(hdr)) != sizeof(hdr)) || (hdr.magic != DM_FILE_MAGIC) ||
+	    (hdr.version != DM_FILE_VERSION) || (hdr.size != max_offset)) {
+		close(g_task_fd);
+		g_task_fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_TRUNC | O_BINARY);
+
+		hdr.magic = DM_FILE_MAGIC;
+		hdr.version = DM_FILE_VERSION;
+		hdr.reserved = 0;
+		hdr.size = max_offset;
+
+		if ((g_task_fd < 0) || (write(g_task_fd, &hdr, sizeof(hdr)) != sizeof(hdr))) {
+			if (g_task_fd >= 0)
+				close(g_task_fd);
+			warnx("Could not reset data manager file %s", k_data_manager_device_path);
+			sem_post(&g_init_sema); /* Don't want to hang startup */
+			return -1;
+		}
+
+		warnx("Data manager file %s reset, it had another layout", k_data_manager_device_path);
+	}
+
 	if (lseek(g_task_fd, max_offset, SEEK_SET) != max_offset) {
 		close(g_task_fd);
 		warnx("Could not seek data manager file %s", k_data_manager_device_path);
@@ -56,6 +56,43 @@ extern "C" {
 		DM_KEY_NUM_KEYS			/* Total number of item types defined */
 	} dm_item_t;
 
+	/* Mission items and safe points as stored, 24 bytes instead of the 64 of struct mission_item_s */
+#pragma pack(push, 1)
+	struct dm_mission_item_s {
+		int32_t lat;			/* Latitude in 1e-7 degrees */
+		int32_t lon;			/* Longitude in 1e-7 degrees */
+		float altitude;			/* Altitude in meters */
+		int16_t yaw;			/* Yaw in 1e-4 radians, DM_YAW_NONE for NAN */
+		uint16_t loiter_radius;		/* Loiter radius in decimeters */
+		uint16_t acceptance_radius;	/* Acceptance radius in decimeters */
+		uint16_t time_inside;		/* Time inside the radius in deciseconds */
+		int16_t pitch_min;		/* Minimal takeoff pitch in centidegrees */
+		uint8_t nav_cmd;		/* enum NAV_CMD, commands above 255 cannot be stored */
+		uint8_t flags;			/* DM_MISSION_ITEM_* */
+	};
+
+	/* Fence vertices as stored */
+	struct dm_fence_vertex_s {
+		int32_t lat;			/* Latitude in 1e-7 degrees */
+		int32_t lon;			/* Longitude in 1e-7 degrees */
+	};
+#pragma pack(pop)
+
+	#define DM_YAW_NONE			INT16_MIN
+	#define DM_MISSION_ITEM_ALT_RELATIVE	(1 << 0)
+	#define DM_MISSION_ITEM_AUTOCONTINUE	(1 << 1)
+	#define DM_MISSION_ITEM_ORIGIN_ONBOARD	(1 << 2)
+	#define DM_MISSION_ITEM_LOITER_CCW	(1 << 3)
+
+	/* The size of an instance of each item type */
+	enum {
+		DM_KEY_SAFE_POINTS_SIZE = sizeof(struct dm_mission_item_s),
+		DM_KEY_FENCE_POINTS_SIZE = sizeof(struct dm_fence_vertex_s),
+		DM_KEY_WAYPOINTS_OFFBOARD_0_SIZE = sizeof(struct dm_mission_item_s),
+		DM_KEY_WAYPOINTS_OFFBOARD_1_SIZE = sizeof(struct dm_mission_item_s),
+		DM_KEY_WAYPOINTS_ONBOARD_SIZE = sizeof(struct dm_mission_item_s)
+	};
+
 	/* The maximum number of instances for each item type */
 	enum {
 		DM_KEY_SAFE_POINTS_MAX = 8,
@@ -78,14 +115,14 @@ extern "C" {
 		DM_INIT_REASON_IN_FLIGHT	/* Data survives in-flight resets only */
 	} dm_reset_reason;
 
-	/* Maximum size in bytes of a single item instance */
+	/* Upper bound of the size in bytes of a single item instance of any type */
 	#define DM_MAX_DATA_SIZE 126
 
 	/* Retrieve from the data manager store */
 	__EXPORT ssize_t
 	dm_read(
 		dm_item_t item,			/* The item type to retrieve */
-		unsigned char index,		/* The index of the item */
+		unsigned index,			/* The index of the item */
 		void *buffer,			/* Pointer to caller data buffer */
 		size_t buflen			/* Length in bytes of data to retrieve */
 	);
@@ -94,12 +131,50 @@ extern "C" {
 	__EXPORT ssize_t
 	dm_write(
 		dm_item_t  item,		/* The item type to store */
-		unsigned char index,		/* The index of the item */
+		unsigned index,			/* The index of the item */
 		dm_persitence_t persistence,	/* The persistence level of this item */
 		const void *buffer,		/* Pointer to caller data buffer */
 		size_t buflen			/* Length in bytes of data to retrieve */
 	);
 
+	/* Retrieve a mission item or safe point, returns sizeof(struct mission_item_s) if found */
+	__EXPORT ssize_t
+	dm_read_mission_item(
+		dm_item_t item,			/* The item type to retrieve */
+		unsigned index,			/* The index of the item */
+		struct mission_item_s *mission_item
+	);
+
+	/* Store a mission item or safe point, returns sizeof(struct mission_item_s) if written, -1 on error or for a nav_cmd above 255 */
+	__EXPORT ssize_t
+	dm_write_mission_item(
+		dm_item_t item,			/* The item type to store */
+		unsigned index,			/* The index of the item */
+		dm_persitence_t persistence,	/* The persistence level of this item */
+		const struct mission_item_s *mission_item
+	);
+
+	/* Retrieve a fence vertex, returns sizeof(struct fence_vertex_s) if found */
+	__EXPORT ssize_t
+	dm_read_fence_vertex(
+		unsigned index,			/* The index of the vertex */
+		struct fence_vertex_s *vertex
+	);
+
+	/* Store a fence vertex, returns sizeof(struct fence_vertex_s) if written */
+	__EXPORT ssize_t
+	dm_write_fence_vertex(
+		unsigned index,			/* The index of the vertex */
+		dm_persitence_t persistence,	/* The persistence level of this item */
+		const struct fence_vertex_s *vertex
+	);
+
+	/* Conversion between mission items and their stored records */
+	__EXPORT void dm_pack_mission_item(const struct mission_item_s *mission_item, struct dm_mission_item_s *record);
+	__EXPORT void dm_unpack_mission_item(const struct dm_mission_item_s *record, struct mission_item_s *mission_item);
+	__EXPORT void dm_pack_fence_vertex(const struct fence_vertex_s *vertex, struct dm_fence_vertex_s *record);
+	__EXPORT void dm_unpack_fence_vertex(const struct dm_fence_vertex_s *record, struct fence_vertex_s *vertex);
+
 	/* Retrieve from the data manager store */
 	__EXPORT int
 	dm_clear(
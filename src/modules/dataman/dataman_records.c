@@ -0,0 +1,135 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file dataman_records.c
+ *
+ * Conversion between mission items / fence vertices and the compact
+ * records the data manager stores.
+ */
+
+#include <stdint.h>
+#include <math.h>
+
+#include "dataman.h"
+
+static int32_t
+pack_degrees(double deg)
+{
+	return (int32_t)((deg >= 0.0) ? (deg * 1e7 + 0.5) : (deg * 1e7 - 0.5));
+}
+
+/* fixed point with 'scale' units per unit, saturated to the range of the field */
+static uint16_t
+pack_u16(float value, float scale)
+{
+	float v = value * scale + 0.5f;
+
+	if (!(v > 0.0f))
+		return 0;
+
+	if (v > (float)UINT16_MAX)
+		return UINT16_MAX;
+
+	return (uint16_t)v;
+}
+
+static int16_t
+pack_i16(float value, float scale)
+{
+	float v = value * scale;
+
+	if (!isfinite(v))
+		return 0;
+
+	v += (v >= 0.0f) ? 0.5f : -0.5f;
+
+	/* INT16_MIN is left for DM_YAW_NONE */
+	if (v < (float)(INT16_MIN + 1))
+		return INT16_MIN + 1;
+
+	if (v > (float)INT16_MAX)
+		return INT16_MAX;
+
+	return (int16_t)v;
+}
+
+__EXPORT void
+dm_pack_mission_item(const struct mission_item_s *mission_item, struct dm_mission_item_s *record)
+{
+	record->lat = pack_degrees(mission_item->lat);
+	record->lon = pack_degrees(mission_item->lon);
+	record->altitude = mission_item->altitude;
+	record->yaw = isnan(mission_item->yaw) ? DM_YAW_NONE : pack_i16(mission_item->yaw, 1e4f);
+	record->loiter_radius = pack_u16(mission_item->loiter_radius, 10.0f);
+	record->acceptance_radius = pack_u16(mission_item->acceptance_radius, 10.0f);
+	record->time_inside = pack_u16(mission_item->time_inside, 10.0f);
+	record->pitch_min = pack_i16(mission_item->pitch_min, 100.0f);
+	record->nav_cmd = (uint8_t)mission_item->nav_cmd;
+	record->flags = (mission_item->altitude_is_relative ? DM_MISSION_ITEM_ALT_RELATIVE : 0) |
+			(mission_item->autocontinue ? DM_MISSION_ITEM_AUTOCONTINUE : 0) |
+			((mission_item->origin == ORIGIN_ONBOARD) ? DM_MISSION_ITEM_ORIGIN_ONBOARD : 0) |
+			((mission_item->loiter_direction < 0) ? DM_MISSION_ITEM_LOITER_CCW : 0);
+}
+
+__EXPORT void
+dm_unpack_mission_item(const struct dm_mission_item_s *record, struct mission_item_s *mission_item)
+{
+	mission_item->lat = record->lat * 1e-7;
+	mission_item->lon = record->lon * 1e-7;
+	mission_item->altitude = record->altitude;
+	mission_item->yaw = (record->yaw == DM_YAW_NONE) ? NAN : record->yaw * 1e-4f;
+	mission_item->loiter_radius = record->loiter_radius * 0.1f;
+	mission_item->acceptance_radius = record->acceptance_radius * 0.1f;
+	mission_item->time_inside = record->time_inside * 0.1f;
+	mission_item->pitch_min = record->pitch_min * 0.01f;
+	mission_item->nav_cmd = (enum NAV_CMD)record->nav_cmd;
+	mission_item->altitude_is_relative = (record->flags & DM_MISSION_ITEM_ALT_RELATIVE) != 0;
+	mission_item->autocontinue = (record->flags & DM_MISSION_ITEM_AUTOCONTINUE) != 0;
+	mission_item->origin = (record->flags & DM_MISSION_ITEM_ORIGIN_ONBOARD) ? ORIGIN_ONBOARD : ORIGIN_MAVLINK;
+	mission_item->loiter_direction = (record->flags & DM_MISSION_ITEM_LOITER_CCW) ? -1 : 1;
+}
+
+__EXPORT void
+dm_pack_fence_vertex(const struct fence_vertex_s *vertex, struct dm_fence_vertex_s *record)
+{
+	record->lat = pack_degrees(vertex->lat);
+	record->lon = pack_degrees(vertex->lon);
+}
+
+__EXPORT void
+dm_unpack_fence_vertex(const struct dm_fence_vertex_s *record, struct fence_vertex_s *vertex)
+{
+	vertex->lat = record->lat * 1e-7;
+	vertex->lon = record->lon * 1e-7;
+}
@@ -37,6 +37,7 @@
 
 MODULE_COMMAND	= dataman
 
-SRCS		= dataman.c
+SRCS		= dataman.c \
+		  dataman_records.c
 
 INCLUDE_DIRS	 += $(MAVLINK_SRC)/include/mavlink
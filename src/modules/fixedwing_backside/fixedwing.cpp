@@ -118,8 +118,14 @@ BlockMultiModeBacksideAutopilot::BlockMultiModeBacksideAutopilot(SuperBlock *par
 	_crMax(this, "CR_MAX"),
 	_attPoll(),
 	_lastMissionCmd(),
-	_timeStamp(0)
+	_timeStamp(0),
+	_graph(this)
 {
+	// update the counts in fixedwing.hpp, and the graph size if needed,
+	// when adding blocks
+	ASSERT(_graph.getNumBlocks() == 38 && _graph.getNumParams() == 43 &&
+	       _graph.getNumSubscriptions() == 8 && _graph.getNumPublications() == 1);
+
 	_attPoll.fd = _att.getHandle();
 	_attPoll.events = POLLIN;
 }
@@ -138,7 +144,7 @@ void BlockMultiModeBacksideAutopilot::update()
 	if (dt > 1.0f || dt < 0) return;
 
 	// set dt for all child blocks
-	setDt(dt);
+	_graph.setDt(dt);
 
 	// store old position command before update if new command sent
 	if (_missionCmd.updated()) {
@@ -146,10 +152,10 @@ void BlockMultiModeBacksideAutopilot::update()
 	}
 
 	// check for new updates
-	if (_param_update.updated()) updateParams();
+	if (_param_update.updated()) _graph.updateParams();
 
 	// get new information from subscriptions
-	updateSubscriptions();
+	_graph.updateSubscriptions();
 
 	// default all output to zero unless handled by mode
 	for (unsigned i = 4; i < NUM_ACTUATOR_CONTROLS; i++)
@@ -300,7 +306,7 @@ void BlockMultiModeBacksideAutopilot::update()
 	}
 
 	// update all publications
-	updatePublications();
+	_graph.updatePublications();
 }
 
 BlockMultiModeBacksideAutopilot::~BlockMultiModeBacksideAutopilot()
@@ -310,7 +316,7 @@ BlockMultiModeBacksideAutopilot::~BlockMultiModeBacksideAutopilot()
 	for (unsigned i = 0; i < NUM_ACTUATOR_CONTROLS; i++)
 		_actuators.control[i] = 0.0f;
 
-	updatePublications();
+	_graph.updatePublications();
 }
 
 } // namespace fixedwing
@@ -41,6 +41,7 @@
 
 #include <controllib/blocks.hpp>
 #include <controllib/uorb/blocks.hpp>
+#include <controllib/block/BlockGraph.hpp>
 
 namespace control
 {
@@ -267,6 +268,11 @@ private:
 	position_setpoint_triplet_s _lastMissionCmd;
 	enum {CH_AIL, CH_ELV, CH_RDR, CH_THR};
 	uint64_t _timeStamp;
+
+	// flattened update chain, must follow all child blocks; the tree has
+	// 38 blocks, 43 params, 8 subscriptions and 1 publication, checked in
+	// the constructor
+	BlockGraph<40, 48, 8, 1> _graph;
 public:
 	BlockMultiModeBacksideAutopilot(SuperBlock *parent, const char *name);
 	void update();
@@ -796,6 +796,7 @@ FixedwingAttitudeControl::task_main()
 				rates_sp.yaw = _yaw_ctrl.get_desired_rate();
 
 				rates_sp.timestamp = hrt_absolute_time();
+				rates_sp.timestamp_sample = _att.timestamp_sample;
 
 				if (_rate_sp_pub > 0) {
 					/* publish the attitude setpoint */
@@ -821,7 +822,9 @@ FixedwingAttitudeControl::task_main()
 
 			/* lazily publish the setpoint only once available */
 			_actuators.timestamp = hrt_absolute_time();
+			_actuators.timestamp_sample = _att.timestamp_sample;
 			_actuators_airframe.timestamp = hrt_absolute_time();
+			_actuators_airframe.timestamp_sample = _att.timestamp_sample;
 
 			if (_actuators_0_pub > 0) {
 				/* publish the attitude setpoint */
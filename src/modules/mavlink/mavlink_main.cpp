@@ -855,6 +855,11 @@ int Mavlink::map_mavlink_mission_item_to_mission_item(const mavlink_mission_item
 	mission_item->yaw = _wrap_pi(mavlink_mission_item->param4 * M_DEG_TO_RAD_F);
 	mission_item->loiter_radius = fabsf(mavlink_mission_item->param3);
 	mission_item->loiter_direction = (mavlink_mission_item->param3 > 0) ? 1 : -1; /* 1 if positive CW, -1 if negative CCW */
+	/* dataman stores the command in a byte */
+	if (mavlink_mission_item->command > UINT8_MAX) {
+		return MAV_MISSION_UNSUPPORTED;
+	}
+
 	mission_item->nav_cmd = (NAV_CMD)mavlink_mission_item->command;
 
 	mission_item->time_inside = mavlink_mission_item->param1;
@@ -990,7 +995,7 @@ void Mavlink::mavlink_wpm_send_waypoint(uint8_t sysid, uint8_t compid, uint16_t
 		dm_current = DM_KEY_WAYPOINTS_OFFBOARD_1;
 	}
 
-	if (dm_read(dm_current, seq, &mission_item, len) == len) {
+	if (dm_read_mission_item(dm_current, seq, &mission_item) == len) {
 
 		/* create mission_item_s from mavlink_mission_item_t */
 		mavlink_mission_item_t wp;
@@ -1391,7 +1396,7 @@ void Mavlink::mavlink_wpm_message_handler(const mavlink_message_t *msg)
 					mission.dataman_id = 0;
 				}
 
-				if (dm_write(dm_next, wp.seq, DM_PERSIST_IN_FLIGHT_RESET, &mission_item, len) != len) {
+				if (dm_write_mission_item(dm_next, wp.seq, DM_PERSIST_IN_FLIGHT_RESET, &mission_item) != len) {
 					mavlink_wpm_send_waypoint_ack(_wpm->current_partner_sysid, _wpm->current_partner_compid, MAV_MISSION_ERROR);
 					_wpm->current_state = MAVLINK_WPM_STATE_IDLE;
 					break;
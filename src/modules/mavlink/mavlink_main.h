@@ -77,7 +77,7 @@ enum MAVLINK_WPM_CODES {
 };
 
 
-#define MAVLINK_WPM_MAX_WP_COUNT 255
+#define MAVLINK_WPM_MAX_WP_COUNT NUM_MISSIONS_SUPPORTED
 #define MAVLINK_WPM_PROTOCOL_TIMEOUT_DEFAULT 5000000 ///< Protocol communication timeout in useconds
 #define MAVLINK_WPM_SETPOINT_DELAY_DEFAULT 1000000 ///< When to send a new setpoint
 #define MAVLINK_WPM_PROTOCOL_DELAY_DEFAULT 40000
@@ -0,0 +1,182 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mc_att_control_kernel.cpp
+ *
+ * Allocation-free core of the multicopter attitude and rate controller.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "mc_att_control_kernel.h"
+
+void
+mc_att_kernel_reset(struct mc_att_kernel_state_s *state)
+{
+	memset(state, 0, sizeof(*state));
+}
+
+void
+mc_att_kernel_attitude(const float R[3][3], const float R_sp[3][3], float yaw_sp_move_rate,
+		       const struct mc_att_kernel_gains_s *gains, float rates_sp[3])
+{
+	/* Z axes of current and desired attitude */
+	const float R_z[3] = { R[0][2], R[1][2], R[2][2] };
+	const float R_sp_z[3] = { R_sp[0][2], R_sp[1][2], R_sp[2][2] };
+
+	/* axis and sin(angle) of desired rotation, e_R = R^T * (R_z x R_sp_z) */
+	const float c[3] = {
+		R_z[1] * R_sp_z[2] - R_z[2] * R_sp_z[1],
+		R_z[2] * R_sp_z[0] - R_z[0] * R_sp_z[2],
+		R_z[0] * R_sp_z[1] - R_z[1] * R_sp_z[0]
+	};
+	float e_R[3];
+
+	for (int i = 0; i < 3; i++) {
+		e_R[i] = R[0][i] * c[0] + R[1][i] * c[1] + R[2][i] * c[2];
+	}
+
+	/* calculate angle error */
+	float e_R_z_sin = sqrtf(e_R[0] * e_R[0] + e_R[1] * e_R[1] + e_R[2] * e_R[2]);
+	float e_R_z_cos = R_z[0] * R_sp_z[0] + R_z[1] * R_sp_z[1] + R_z[2] * R_sp_z[2];
+
+	/* calculate weight for yaw control */
+	float yaw_w = R_sp[2][2] * R_sp[2][2];
+
+	/* X axis after roll/pitch only rotation, the only column of R_rp the yaw error needs */
+	float R_rp_x[3];
+
+	if (e_R_z_sin > 0.0f) {
+		/* get axis-angle representation */
+		float e_R_z_angle = atan2f(e_R_z_sin, e_R_z_cos);
+		float a[3] = { e_R[0] / e_R_z_sin, e_R[1] / e_R_z_sin, e_R[2] / e_R_z_sin };
+
+		for (int i = 0; i < 3; i++) {
+			e_R[i] = a[i] * e_R_z_angle;
+		}
+
+		/* first column of I + [a]x * sin + [a]x^2 * (1 - cos) */
+		float v = 1.0f - e_R_z_cos;
+		float m[3] = {
+			e_R_z_cos + v * a[0] * a[0],
+			v * a[0] * a[1] + e_R_z_sin * a[2],
+			v * a[0] * a[2] - e_R_z_sin * a[1]
+		};
+
+		for (int i = 0; i < 3; i++) {
+			R_rp_x[i] = R[i][0] * m[0] + R[i][1] * m[1] + R[i][2] * m[2];
+		}
+
+	} else {
+		/* zero roll/pitch rotation */
+		R_rp_x[0] = R[0][0];
+		R_rp_x[1] = R[1][0];
+		R_rp_x[2] = R[2][0];
+	}
+
+	/* R_rp and R_sp has the same Z axis, calculate yaw error */
+	const float R_sp_x[3] = { R_sp[0][0], R_sp[1][0], R_sp[2][0] };
+	float yaw_sin = (R_rp_x[1] * R_sp_x[2] - R_rp_x[2] * R_sp_x[1]) * R_sp_z[0] +
+			(R_rp_x[2] * R_sp_x[0] - R_rp_x[0] * R_sp_x[2]) * R_sp_z[1] +
+			(R_rp_x[0] * R_sp_x[1] - R_rp_x[1] * R_sp_x[0]) * R_sp_z[2];
+	float yaw_cos = R_rp_x[0] * R_sp_x[0] + R_rp_x[1] * R_sp_x[1] + R_rp_x[2] * R_sp_x[2];
+	e_R[2] = atan2f(yaw_sin, yaw_cos) * yaw_w;
+
+	if (e_R_z_cos < 0.0f) {
+		/* for large thrust vector rotations use another rotation method:
+		 * calculate angle and axis for R -> R_sp rotation directly,
+		 * the quaternion only needs the diagonal of R^T * R_sp */
+		float d[3];
+
+		for (int i = 0; i < 3; i++) {
+			d[i] = R[0][i] * R_sp[0][i] + R[1][i] * R_sp[1][i] + R[2][i] * R_sp[2][i];
+		}
+
+		float q0 = 0.5f * sqrtf(1.0f + d[0] + d[1] + d[2]);
+		float e_R_d[3] = {
+			0.5f * sqrtf(1.0f + d[0] - d[1] - d[2]),
+			0.5f * sqrtf(1.0f - d[0] + d[1] - d[2]),
+			0.5f * sqrtf(1.0f - d[0] - d[1] + d[2])
+		};
+
+		/* normalized axis, scaled by the rotation angle */
+		float len = sqrtf(e_R_d[0] * e_R_d[0] + e_R_d[1] * e_R_d[1] + e_R_d[2] * e_R_d[2]);
+		float scale = 2.0f * atan2f(1.0f, q0) / len;
+
+		/* use fusion of Z axis based rotation and direct rotation */
+		float direct_w = e_R_z_cos * e_R_z_cos * yaw_w;
+
+		for (int i = 0; i < 3; i++) {
+			e_R[i] = e_R[i] * (1.0f - direct_w) + e_R_d[i] * scale * direct_w;
+		}
+	}
+
+	/* calculate angular rates setpoint */
+	for (int i = 0; i < 3; i++) {
+		rates_sp[i] = gains->att_p[i] * e_R[i];
+	}
+
+	/* feed forward yaw setpoint rate */
+	rates_sp[2] += yaw_sp_move_rate * yaw_w * gains->yaw_ff;
+}
+
+void
+mc_att_kernel_rates(struct mc_att_kernel_state_s *state, const struct mc_att_kernel_gains_s *gains,
+		    const float rates_sp[3], const float rates[3], float thrust_sp, float dt,
+		    float att_control[3])
+{
+	float dt_inv = 1.0f / dt;
+	bool integrate = thrust_sp > MIN_TAKEOFF_THRUST;
+
+	for (int i = 0; i < 3; i++) {
+		/* angular rates error */
+		float rates_err = rates_sp[i] - rates[i];
+		att_control[i] = gains->rate_p[i] * rates_err +
+				 gains->rate_d[i] * (state->rates_prev[i] - rates[i]) * dt_inv +
+				 state->rates_int[i];
+		state->rates_prev[i] = rates[i];
+
+		/* update integral only if not saturated on low limit */
+		if (integrate && fabsf(att_control[i]) < thrust_sp) {
+			float rate_i = state->rates_int[i] + gains->rate_i[i] * rates_err * dt;
+
+			if (isfinite(rate_i) && rate_i > -RATES_I_LIMIT && rate_i < RATES_I_LIMIT &&
+			    att_control[i] > -RATES_I_LIMIT && att_control[i] < RATES_I_LIMIT) {
+				state->rates_int[i] = rate_i;
+			}
+		}
+	}
+}
@@ -0,0 +1,103 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mc_att_control_kernel.h
+ *
+ * Allocation-free core of the multicopter attitude and rate controller.
+ *
+ * Same control law as the original matrix based implementation, written
+ * out on plain float arrays: only the rotation matrix columns that are
+ * actually used are formed, the roll/pitch-only rotation is reduced to its
+ * first column and the quaternion fallback only needs the diagonal of
+ * R^T * R_sp. Does not depend on mathlib/CMSIS and builds on the host.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+#define MIN_TAKEOFF_THRUST    0.2f
+#define RATES_I_LIMIT	0.3f
+
+/**
+ * Controller gains, refreshed on parameter updates.
+ */
+struct mc_att_kernel_gains_s {
+	float att_p[3];		/**< P gain for angular error */
+	float rate_p[3];	/**< P gain for angular rate error */
+	float rate_i[3];	/**< I gain for angular rate error */
+	float rate_d[3];	/**< D gain for angular rate error */
+	float yaw_ff;		/**< yaw control feed-forward */
+};
+
+/**
+ * Rate controller state.
+ */
+struct mc_att_kernel_state_s {
+	float rates_prev[3];	/**< angular rates on previous step */
+	float rates_int[3];	/**< angular rates integral error */
+};
+
+/**
+ * Reset the rate controller state.
+ */
+void	mc_att_kernel_reset(struct mc_att_kernel_state_s *state);
+
+/**
+ * Attitude controller.
+ *
+ * @param R		Current attitude, rotation matrix body to NED.
+ * @param R_sp		Attitude setpoint, rotation matrix body to NED.
+ * @param yaw_sp_move_rate	Yaw setpoint rate for the feed forward.
+ * @param gains		Controller gains.
+ * @param rates_sp	Output angular rates setpoint.
+ */
+void	mc_att_kernel_attitude(const float R[3][3], const float R_sp[3][3], float yaw_sp_move_rate,
+			       const struct mc_att_kernel_gains_s *gains, float rates_sp[3]);
+
+/**
+ * Attitude rates controller.
+ *
+ * @param state		Controller state, integral is reset by the caller when disarmed.
+ * @param gains		Controller gains.
+ * @param rates_sp	Angular rates setpoint.
+ * @param rates		Current body angular rates.
+ * @param thrust_sp	Thrust setpoint, the integral only runs above MIN_TAKEOFF_THRUST.
+ * @param dt		Time step in seconds.
+ * @param att_control	Output attitude control vector.
+ */
+void	mc_att_kernel_rates(struct mc_att_kernel_state_s *state, const struct mc_att_kernel_gains_s *gains,
+			    const float rates_sp[3], const float rates[3], float thrust_sp, float dt,
+			    float att_control[3]);
@@ -74,6 +74,8 @@
 #include <mathlib/mathlib.h>
 #include <lib/geo/geo.h>
 
+#include "mc_att_control_kernel.h"
+
 /**
  * Multicopter attitude control app start / stop handling function
  *
@@ -82,8 +84,6 @@
 extern "C" __EXPORT int mc_att_control_main(int argc, char *argv[]);
 
 #define YAW_DEADZONE	0.05f
-#define MIN_TAKEOFF_THRUST    0.2f
-#define RATES_I_LIMIT	0.3f
 
 class MulticopterAttitudeControl
 {
@@ -132,13 +132,10 @@ private:
 
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
 
-	math::Vector<3>		_rates_prev;	/**< angular rates on previous step */
-	math::Vector<3>		_rates_sp;		/**< angular rates setpoint */
-	math::Vector<3>		_rates_int;		/**< angular rates integral error */
+	struct mc_att_kernel_state_s	_kernel_state;	/**< rate controller state */
+	float				_rates_sp[3];	/**< angular rates setpoint */
 	float				_thrust_sp;		/**< thrust setpoint */
-	math::Vector<3>		_att_control;	/**< attitude control vector */
-
-	math::Matrix<3, 3>  _I;				/**< identity matrix */
+	float				_att_control[3];	/**< attitude control vector */
 
 	bool	_reset_yaw_sp;			/**< reset yaw setpoint flag */
 
@@ -161,11 +158,7 @@ private:
 	}		_params_handles;		/**< handles for interesting parameters */
 
 	struct {
-		math::Vector<3> att_p;					/**< P gain for angular error */
-		math::Vector<3> rate_p;				/**< P gain for angular rate error */
-		math::Vector<3> rate_i;				/**< I gain for angular rate error */
-		math::Vector<3> rate_d;				/**< D gain for angular rate error */
-		float yaw_ff;						/**< yaw control feed-forward */
+		struct mc_att_kernel_gains_s gains;	/**< attitude and rate controller gains */
 
 		float rc_scale_yaw;
 	}		_params;
@@ -268,18 +261,12 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 	memset(&_actuators, 0, sizeof(_actuators));
 	memset(&_armed, 0, sizeof(_armed));
 
-	_params.att_p.zero();
-	_params.rate_p.zero();
-	_params.rate_i.zero();
-	_params.rate_d.zero();
+	memset(&_params.gains, 0, sizeof(_params.gains));
 
-	_rates_prev.zero();
-	_rates_sp.zero();
-	_rates_int.zero();
+	mc_att_kernel_reset(&_kernel_state);
+	memset(_rates_sp, 0, sizeof(_rates_sp));
 	_thrust_sp = 0.0f;
-	_att_control.zero();
-
-	_I.identity();
+	memset(_att_control, 0, sizeof(_att_control));
 
 	_params_handles.roll_p			= 	param_find("MC_ROLL_P");
 	_params_handles.roll_rate_p		= 	param_find("MC_ROLLRATE_P");
@@ -332,35 +319,35 @@ MulticopterAttitudeControl::parameters_update()
 
 	/* roll */
 	param_get(_params_handles.roll_p, &v);
-	_params.att_p(0) = v;
+	_params.gains.att_p[0] = v;
 	param_get(_params_handles.roll_rate_p, &v);
-	_params.rate_p(0) = v;
+	_params.gains.rate_p[0] = v;
 	param_get(_params_handles.roll_rate_i, &v);
-	_params.rate_i(0) = v;
+	_params.gains.rate_i[0] = v;
 	param_get(_params_handles.roll_rate_d, &v);
-	_params.rate_d(0) = v;
+	_params.gains.rate_d[0] = v;
 
 	/* pitch */
 	param_get(_params_handles.pitch_p, &v);
-	_params.att_p(1) = v;
+	_params.gains.att_p[1] = v;
 	param_get(_params_handles.pitch_rate_p, &v);
-	_params.rate_p(1) = v;
+	_params.gains.rate_p[1] = v;
 	param_get(_params_handles.pitch_rate_i, &v);
-	_params.rate_i(1) = v;
+	_params.gains.rate_i[1] = v;
 	param_get(_params_handles.pitch_rate_d, &v);
-	_params.rate_d(1) = v;
+	_params.gains.rate_d[1] = v;
 
 	/* yaw */
 	param_get(_params_handles.yaw_p, &v);
-	_params.att_p(2) = v;
+	_params.gains.att_p[2] = v;
 	param_get(_params_handles.yaw_rate_p, &v);
-	_params.rate_p(2) = v;
+	_params.gains.rate_p[2] = v;
 	param_get(_params_handles.yaw_rate_i, &v);
-	_params.rate_i(2) = v;
+	_params.gains.rate_i[2] = v;
 	param_get(_params_handles.yaw_rate_d, &v);
-	_params.rate_d(2) = v;
+	_params.gains.rate_d[2] = v;
 
-	param_get(_params_handles.yaw_ff, &_params.yaw_ff);
+	param_get(_params_handles.yaw_ff, &_params.gains.yaw_ff);
 
 	param_get(_params_handles.rc_scale_yaw, &_params.rc_scale_yaw);
 
@@ -529,15 +516,10 @@ MulticopterAttitudeControl::control_attitude(float dt)
 
 	_thrust_sp = _v_att_sp.thrust;
 
-	/* construct attitude setpoint rotation matrix */
-	math::Matrix<3, 3> R_sp;
-
-	if (_v_att_sp.R_valid) {
-		/* rotation matrix in _att_sp is valid, use it */
-		R_sp.set(&_v_att_sp.R_body[0][0]);
-
-	} else {
+	/* construct attitude setpoint rotation matrix, a valid one in _att_sp is used as is */
+	if (!_v_att_sp.R_valid) {
 		/* rotation matrix in _att_sp is not valid, use euler angles instead */
+		math::Matrix<3, 3> R_sp;
 		R_sp.from_euler(_v_att_sp.roll_body, _v_att_sp.pitch_body, _v_att_sp.yaw_body);
 
 		/* copy rotation matrix back to setpoint struct */
@@ -557,78 +539,8 @@ MulticopterAttitudeControl::control_attitude(float dt)
 		}
 	}
 
-	/* rotation matrix for current state */
-	math::Matrix<3, 3> R;
-	R.set(_v_att.R);
-
 	/* all input data is ready, run controller itself */
-
-	/* try to move thrust vector shortest way, because yaw response is slower than roll/pitch */
-	math::Vector<3> R_z(R(0, 2), R(1, 2), R(2, 2));
-	math::Vector<3> R_sp_z(R_sp(0, 2), R_sp(1, 2), R_sp(2, 2));
-
-	/* axis and sin(angle) of desired rotation */
-	math::Vector<3> e_R = R.transposed() * (R_z % R_sp_z);
-
-	/* calculate angle error */
-	float e_R_z_sin = e_R.length();
-	float e_R_z_cos = R_z * R_sp_z;
-
-	/* calculate weight for yaw control */
-	float yaw_w = R_sp(2, 2) * R_sp(2, 2);
-
-	/* calculate rotation matrix after roll/pitch only rotation */
-	math::Matrix<3, 3> R_rp;
-
-	if (e_R_z_sin > 0.0f) {
-		/* get axis-angle representation */
-		float e_R_z_angle = atan2f(e_R_z_sin, e_R_z_cos);
-		math::Vector<3> e_R_z_axis = e_R / e_R_z_sin;
-
-		e_R = e_R_z_axis * e_R_z_angle;
-
-		/* cross product matrix for e_R_axis */
-		math::Matrix<3, 3> e_R_cp;
-		e_R_cp.zero();
-		e_R_cp(0, 1) = -e_R_z_axis(2);
-		e_R_cp(0, 2) = e_R_z_axis(1);
-		e_R_cp(1, 0) = e_R_z_axis(2);
-		e_R_cp(1, 2) = -e_R_z_axis(0);
-		e_R_cp(2, 0) = -e_R_z_axis(1);
-		e_R_cp(2, 1) = e_R_z_axis(0);
-
-		/* rotation matrix for roll/pitch only rotation */
-		R_rp = R * (_I + e_R_cp * e_R_z_sin + e_R_cp * e_R_cp * (1.0f - e_R_z_cos));
-
-	} else {
-		/* zero roll/pitch rotation */
-		R_rp = R;
-	}
-
-	/* R_rp and R_sp has the same Z axis, calculate yaw error */
-	math::Vector<3> R_sp_x(R_sp(0, 0), R_sp(1, 0), R_sp(2, 0));
-	math::Vector<3> R_rp_x(R_rp(0, 0), R_rp(1, 0), R_rp(2, 0));
-	e_R(2) = atan2f((R_rp_x % R_sp_x) * R_sp_z, R_rp_x * R_sp_x) * yaw_w;
-
-	if (e_R_z_cos < 0.0f) {
-		/* for large thrust vector rotations use another rotation method:
-		 * calculate angle and axis for R -> R_sp rotation directly */
-		math::Quaternion q;
-		q.from_dcm(R.transposed() * R_sp);
-		math::Vector<3> e_R_d = q.imag();
-		e_R_d.normalize();
-		e_R_d *= 2.0f * atan2f(e_R_d.length(), q(0));
-
-		/* use fusion of Z axis based rotation and direct rotation */
-		float direct_w = e_R_z_cos * e_R_z_cos * yaw_w;
-		e_R = e_R * (1.0f - direct_w) + e_R_d * direct_w;
-	}
-
-	/* calculate angular rates setpoint */
-	_rates_sp = _params.att_p.emult(e_R);
-
-	/* feed forward yaw setpoint rate */
-	_rates_sp(2) += yaw_sp_move_rate * yaw_w * _params.yaw_ff;
+	mc_att_kernel_attitude(_v_att.R, _v_att_sp.R_body, yaw_sp_move_rate, &_params.gains, _rates_sp);
 }
 
 /*
@@ -641,33 +553,13 @@ MulticopterAttitudeControl::control_attitude_rates(float dt)
 {
 	/* reset integral if disarmed */
 	if (!_armed.armed) {
-		_rates_int.zero();
+		memset(_kernel_state.rates_int, 0, sizeof(_kernel_state.rates_int));
 	}
 
 	/* current body angular rates */
-	math::Vector<3> rates;
-	rates(0) = _v_att.rollspeed;
-	rates(1) = _v_att.pitchspeed;
-	rates(2) = _v_att.yawspeed;
-
-	/* angular rates error */
-	math::Vector<3> rates_err = _rates_sp - rates;
-	_att_control = _params.rate_p.emult(rates_err) + _params.rate_d.emult(_rates_prev - rates) / dt + _rates_int;
-	_rates_prev = rates;
-
-	/* update integral only if not saturated on low limit */
-	if (_thrust_sp > MIN_TAKEOFF_THRUST) {
-		for (int i = 0; i < 3; i++) {
-			if (fabsf(_att_control(i)) < _thrust_sp) {
-				float rate_i = _rates_int(i) + _params.rate_i(i) * rates_err(i) * dt;
-
-				if (isfinite(rate_i) && rate_i > -RATES_I_LIMIT && rate_i < RATES_I_LIMIT &&
-				    _att_control(i) > -RATES_I_LIMIT && _att_control(i) < RATES_I_LIMIT) {
-					_rates_int(i) = rate_i;
-				}
-			}
-		}
-	}
+	const float rates[3] = { _v_att.rollspeed, _v_att.pitchspeed, _v_att.yawspeed };
+
+	mc_att_kernel_rates(&_kernel_state, &_params.gains, _rates_sp, rates, _thrust_sp, dt, _att_control);
 }
 
 void
@@ -748,11 +640,12 @@ MulticopterAttitudeControl::task_main()
 				control_attitude(dt);
 
 				/* publish attitude rates setpoint */
-				_v_rates_sp.roll = _rates_sp(0);
-				_v_rates_sp.pitch = _rates_sp(1);
-				_v_rates_sp.yaw = _rates_sp(2);
+				_v_rates_sp.roll = _rates_sp[0];
+				_v_rates_sp.pitch = _rates_sp[1];
+				_v_rates_sp.yaw = _rates_sp[2];
 				_v_rates_sp.thrust = _thrust_sp;
 				_v_rates_sp.timestamp = hrt_absolute_time();
+				_v_rates_sp.timestamp_sample = _v_att.timestamp_sample;
 
 				if (_v_rates_sp_pub > 0) {
 					orb_publish(ORB_ID(vehicle_rates_setpoint), _v_rates_sp_pub, &_v_rates_sp);
@@ -764,9 +657,9 @@ MulticopterAttitudeControl::task_main()
 			} else {
 				/* attitude controller disabled, poll rates setpoint topic */
 				vehicle_rates_setpoint_poll();
-				_rates_sp(0) = _v_rates_sp.roll;
-				_rates_sp(1) = _v_rates_sp.pitch;
-				_rates_sp(2) = _v_rates_sp.yaw;
+				_rates_sp[0] = _v_rates_sp.roll;
+				_rates_sp[1] = _v_rates_sp.pitch;
+				_rates_sp[2] = _v_rates_sp.yaw;
 				_thrust_sp = _v_rates_sp.thrust;
 			}
 
@@ -774,11 +667,12 @@ MulticopterAttitudeControl::task_main()
 				control_attitude_rates(dt);
 
 				/* publish actuator controls */
-				_actuators.control[0] = (isfinite(_att_control(0))) ? _att_control(0) : 0.0f;
-				_actuators.control[1] = (isfinite(_att_control(1))) ? _att_control(1) : 0.0f;
-				_actuators.control[2] = (isfinite(_att_control(2))) ? _att_control(2) : 0.0f;
+				_actuators.control[0] = (isfinite(_att_control[0])) ? _att_control[0] : 0.0f;
+				_actuators.control[1] = (isfinite(_att_control[1])) ? _att_control[1] : 0.0f;
+				_actuators.control[2] = (isfinite(_att_control[2])) ? _att_control[2] : 0.0f;
 				_actuators.control[3] = (isfinite(_thrust_sp)) ? _thrust_sp : 0.0f;
 				_actuators.timestamp = hrt_absolute_time();
+				_actuators.timestamp_sample = _v_att.timestamp_sample;
 
 				if (_actuators_0_pub > 0) {
 					orb_publish(ORB_ID(actuator_controls_0), _actuators_0_pub, &_actuators);
@@ -107,10 +107,10 @@ bool Geofence::inside(double lat, double lon, float altitude)
 
 			/* Red until fence is finished */
 			for (unsigned i = 0, j = _verticesCount - 1; i < _verticesCount; j = i++) {
-				if (dm_read(DM_KEY_FENCE_POINTS, i, &temp_vertex_i, sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
+				if (dm_read_fence_vertex(i, &temp_vertex_i) != sizeof(struct fence_vertex_s)) {
 					break;
 				}
-				if (dm_read(DM_KEY_FENCE_POINTS, j, &temp_vertex_j, sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
+				if (dm_read_fence_vertex(j, &temp_vertex_j) != sizeof(struct fence_vertex_s)) {
 					break;
 				}
 
@@ -182,7 +182,7 @@ Geofence::addPoint(int argc, char *argv[])
 	vertex.lat = (float)lat;
 	vertex.lon = (float)lon;
 
-	if (dm_write(DM_KEY_FENCE_POINTS, ix, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) == sizeof(vertex)) {
+	if (dm_write_fence_vertex(ix, DM_PERSIST_POWER_ON_RESET, &vertex) == sizeof(vertex)) {
 		if (last)
 			publishFence((unsigned)ix + 1);
 		return;
@@ -257,7 +257,7 @@ Geofence::loadFromFile(const char *filename)
 					return ERROR;
 			}
 
-			if (dm_write(DM_KEY_FENCE_POINTS, pointCounter, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) != sizeof(vertex))
+			if (dm_write_fence_vertex(pointCounter, DM_PERSIST_POWER_ON_RESET, &vertex) != sizeof(vertex))
 								return ERROR;
 
 			warnx("Geofence: point: %d, lat %.5f: lon: %.5f", pointCounter,  (double)vertex.lat, (double)vertex.lon);
@@ -103,7 +103,7 @@ bool MissionFeasibilityChecker::checkGeofence(dm_item_t dm_current, size_t nMiss
 			static struct mission_item_s missionitem;
 			const ssize_t len = sizeof(struct mission_item_s);
 
-			if (dm_read(dm_current, i, &missionitem, len) != len) {
+			if (dm_read_mission_item(dm_current, i, &missionitem) != len) {
 				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 				return false;
 			}
@@ -127,7 +127,7 @@ bool MissionFeasibilityChecker::checkFixedWingLanding(dm_item_t dm_current, size
 	for (size_t i = 0; i < nMissionItems; i++) {
 		static struct mission_item_s missionitem;
 		const ssize_t len = sizeof(struct mission_item_s);
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
+		if (dm_read_mission_item(dm_current, i, &missionitem) != len) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			return false;
 		}
@@ -135,7 +135,7 @@ bool MissionFeasibilityChecker::checkFixedWingLanding(dm_item_t dm_current, size
 		if (missionitem.nav_cmd == NAV_CMD_LAND) {
 			struct mission_item_s missionitem_previous;
 			if (i != 0) {
-				if (dm_read(dm_current, i-1, &missionitem_previous, len) != len) {
+				if (dm_read_mission_item(dm_current, i-1, &missionitem_previous) != len) {
 					/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 					return false;
 				}
@@ -163,6 +163,7 @@ private:
 	struct position_setpoint_triplet_s		_pos_sp_triplet;	/**< triplet of position setpoints */
 	struct mission_result_s				_mission_result;	/**< mission result for commander/mavlink */
 	struct mission_item_s				_mission_item;		/**< current mission item */
+	struct geo_segment_s				_mission_leg;		/**< leg to the current mission item */
 
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
 
@@ -426,6 +427,7 @@ Navigator::Navigator() :
 
 	memset(&_pos_sp_triplet, 0, sizeof(struct position_setpoint_triplet_s));
 	memset(&_mission_item, 0, sizeof(struct mission_item_s));
+	memset(&_mission_leg, 0, sizeof(struct geo_segment_s));
 
 	memset(&nav_states_str, 0, sizeof(nav_states_str));
 	nav_states_str[0] = "NONE";
@@ -1517,9 +1519,17 @@ Navigator::check_mission_item_reached()
 		if (_mission_item.altitude_is_relative)
 			wp_alt_amsl += _home_pos.alt;
 
-		dist = get_distance_to_point_global_wgs84(_mission_item.lat, _mission_item.lon, wp_alt_amsl,
-				(double)_global_pos.lat, (double)_global_pos.lon, _global_pos.alt,
-				&dist_xy, &dist_z);
+		/* the leg only changes with the mission item, don't redo the trig on every position update */
+		double leg_lat = _pos_sp_triplet.previous.valid ? _pos_sp_triplet.previous.lat : _mission_item.lat;
+		double leg_lon = _pos_sp_triplet.previous.valid ? _pos_sp_triplet.previous.lon : _mission_item.lon;
+
+		if (!geo_segment_matches(&_mission_leg, leg_lat, leg_lon, _mission_item.lat, _mission_item.lon)) {
+			geo_segment_init(&_mission_leg, leg_lat, leg_lon, _mission_item.lat, _mission_item.lon);
+		}
+
+		dist_xy = geo_segment_distance_to_end(&_mission_leg, _global_pos.lat, _global_pos.lon);
+		dist_z = fabsf(_global_pos.alt - wp_alt_amsl);
+		dist = sqrtf(dist_xy * dist_xy + dist_z * dist_z);
 
 		if (_do_takeoff) {
 			if (_global_pos.alt > wp_alt_amsl - acceptance_radius) {
@@ -147,7 +147,7 @@ Mission::get_current_mission_item(struct mission_item_s *new_mission_item, bool
 
 		const ssize_t len = sizeof(struct mission_item_s);
 
-		if (dm_read(DM_KEY_WAYPOINTS_ONBOARD, _current_onboard_mission_index, new_mission_item, len) != len) {
+		if (dm_read_mission_item(DM_KEY_WAYPOINTS_ONBOARD, _current_onboard_mission_index, new_mission_item) != len) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			return ERROR;
 		}
@@ -171,7 +171,7 @@ Mission::get_current_mission_item(struct mission_item_s *new_mission_item, bool
 
 		const ssize_t len = sizeof(struct mission_item_s);
 
-		if (dm_read(dm_current, _current_offboard_mission_index, new_mission_item, len) != len) {
+		if (dm_read_mission_item(dm_current, _current_offboard_mission_index, new_mission_item) != len) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			_current_mission_type = MISSION_TYPE_NONE;
 			return ERROR;
@@ -198,7 +198,7 @@ Mission::get_next_mission_item(struct mission_item_s *new_mission_item)
 
 		const ssize_t len = sizeof(struct mission_item_s);
 
-		if (dm_read(DM_KEY_WAYPOINTS_ONBOARD, _current_onboard_mission_index + 1, new_mission_item, len) != len) {
+		if (dm_read_mission_item(DM_KEY_WAYPOINTS_ONBOARD, _current_onboard_mission_index + 1, new_mission_item) != len) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			return ERROR;
 		}
@@ -218,7 +218,7 @@ Mission::get_next_mission_item(struct mission_item_s *new_mission_item)
 
 		const ssize_t len = sizeof(struct mission_item_s);
 
-		if (dm_read(dm_current, _current_offboard_mission_index + 1, new_mission_item, len) != len) {
+		if (dm_read_mission_item(dm_current, _current_offboard_mission_index + 1, new_mission_item) != len) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			return ERROR;
 		}
@@ -0,0 +1,116 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file flight_recorder.c
+ *
+ * RAM ring of the most recent log messages.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "flight_recorder.h"
+
+int flight_recorder_init(struct flight_recorder_s *fr, int size, uint64_t window)
+{
+	fr->segment_size = size / FLIGHT_RECORDER_SEGMENTS;
+
+	/* the segments but the one being overwritten cover the window */
+	fr->segment_interval = window / (FLIGHT_RECORDER_SEGMENTS - 1);
+	fr->data = malloc(fr->segment_size * FLIGHT_RECORDER_SEGMENTS);
+	fr->segments_cut = 0;
+	flight_recorder_reset(fr);
+	return (fr->data == 0) ? ERROR : OK;
+}
+
+void flight_recorder_reset(struct flight_recorder_s *fr)
+{
+	memset(fr->fill, 0, sizeof(fr->fill));
+	fr->current = 0;
+	fr->segment_start = 0;
+	fr->time_msg_len = 0;
+}
+
+static void flight_recorder_next_segment(struct flight_recorder_s *fr)
+{
+	fr->current = (fr->current + 1) % FLIGHT_RECORDER_SEGMENTS;
+
+	/* keep the time reference for the messages that follow */
+	memcpy(&fr->data[fr->current * fr->segment_size], fr->time_msg, fr->time_msg_len);
+	fr->fill[fr->current] = fr->time_msg_len;
+}
+
+void flight_recorder_begin(struct flight_recorder_s *fr, uint64_t now, const void *time_msg, int size)
+{
+	if (size > FLIGHT_RECORDER_TIME_LEN) {
+		return;
+	}
+
+	memcpy(fr->time_msg, time_msg, size);
+	fr->time_msg_len = size;
+
+	if (now - fr->segment_start >= fr->segment_interval) {
+		/* the TIME message is the first one in the new segment */
+		fr->segment_start = now;
+		flight_recorder_next_segment(fr);
+
+	} else {
+		flight_recorder_write(fr, time_msg, size);
+	}
+}
+
+void flight_recorder_write(struct flight_recorder_s *fr, const void *ptr, int size)
+{
+	if (fr->fill[fr->current] + size > fr->segment_size) {
+		if (fr->time_msg_len + size > fr->segment_size) {
+			/* would never fit */
+			return;
+		}
+
+		fr->segments_cut++;
+		flight_recorder_next_segment(fr);
+	}
+
+	memcpy(&fr->data[fr->current * fr->segment_size + fr->fill[fr->current]], ptr, size);
+	fr->fill[fr->current] += size;
+}
+
+int flight_recorder_get_segment(struct flight_recorder_s *fr, int i, void **ptr)
+{
+	/* the segment after the current one is the oldest */
+	int s = (fr->current + 1 + i) % FLIGHT_RECORDER_SEGMENTS;
+
+	*ptr = &fr->data[s * fr->segment_size];
+	return fr->fill[s];
+}
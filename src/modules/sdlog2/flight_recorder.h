@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file flight_recorder.h
+ *
+ * RAM ring of the most recent log messages, dumped to the log file when
+ * an incident triggers it.
+ *
+ * The ring is split into segments filled one after the other. A new
+ * segment is started when the current one covers its share of the time
+ * window or is full, and replaces the oldest one, so dropping old data
+ * never cuts a message. Every segment starts with a TIME message.
+ */
+
+#ifndef SDLOG2_FLIGHT_RECORDER_H_
+#define SDLOG2_FLIGHT_RECORDER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define FLIGHT_RECORDER_SEGMENTS	8
+#define FLIGHT_RECORDER_TIME_LEN	16	/**< space for the TIME message repeated in each segment */
+
+struct flight_recorder_s {
+	char *data;
+	int segment_size;				/**< bytes per segment */
+	int current;					/**< segment written to */
+	int fill[FLIGHT_RECORDER_SEGMENTS];		/**< bytes used in each segment */
+	uint64_t segment_start;				/**< time the current segment was started */
+	uint64_t segment_interval;			/**< time covered by one segment */
+	uint8_t time_msg[FLIGHT_RECORDER_TIME_LEN];	/**< last TIME message */
+	int time_msg_len;
+	unsigned long segments_cut;			/**< segments full before their time was up */
+};
+
+/**
+ * Allocate the ring.
+ *
+ * @param size		RAM to use in bytes
+ * @param window	time the ring should cover in us, it covers less if
+ *			the messages do not fit into 'size'
+ */
+int flight_recorder_init(struct flight_recorder_s *fr, int size, uint64_t window);
+
+/**
+ * Drop all recorded messages.
+ */
+void flight_recorder_reset(struct flight_recorder_s *fr);
+
+/**
+ * Start a logging cycle with its TIME message, starting a new segment
+ * if the current one has covered its share of the window.
+ */
+void flight_recorder_begin(struct flight_recorder_s *fr, uint64_t now, const void *time_msg, int size);
+
+/**
+ * Record a message, starting a new segment if it does not fit.
+ */
+void flight_recorder_write(struct flight_recorder_s *fr, const void *ptr, int size);
+
+/**
+ * Get a segment, oldest first.
+ *
+ * @param i		segment, 0 is the oldest
+ * @return		number of bytes in the segment, at 'ptr'
+ */
+int flight_recorder_get_segment(struct flight_recorder_s *fr, int i, void **ptr);
+
+#endif
@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file log_rate.c
+ *
+ * Rate limits of the log messages.
+ */
+
+#include <string.h>
+
+#include "log_rate.h"
+
+/* buffer fill in percent at which each level starts, it ends LOG_RATE_HYSTERESIS below */
+static const uint8_t log_rate_thresholds[LOG_RATE_LEVELS] = { 50, 70, 85 };
+#define LOG_RATE_HYSTERESIS	10
+
+static void log_rate_update(struct log_rate_s *r)
+{
+	for (int i = 0; i < LOG_RATE_MSG_MAX; i++) {
+		/* lowest priority is decimated from the first level on, critical never */
+		int steps = r->level + r->prio[i] - LOG_RATE_LEVELS;
+		uint16_t interval = r->profile_interval[i];
+
+		if (steps > 0 && interval < (LOG_RATE_DEGRADED_INTERVAL << (steps - 1))) {
+			interval = LOG_RATE_DEGRADED_INTERVAL << (steps - 1);
+		}
+
+		r->interval[i] = interval;
+	}
+}
+
+void log_rate_init(struct log_rate_s *r, const struct log_rate_profile_s *profiles, int profiles_num, bool adaptive)
+{
+	r->profiles = profiles;
+	r->profiles_num = profiles_num;
+	r->adaptive = adaptive;
+
+	memset(r->prio, LOG_PRIO_NORMAL, sizeof(r->prio));
+
+	for (int i = 0; i < profiles_num; i++) {
+		if (profiles[i].msg_type < LOG_RATE_MSG_MAX) {
+			r->prio[profiles[i].msg_type] = profiles[i].prio;
+		}
+	}
+
+	log_rate_reset(r);
+}
+
+void log_rate_reset(struct log_rate_s *r)
+{
+	memset(r->last, 0, sizeof(r->last));
+	memset(r->profile_last, 0, sizeof(r->profile_last));
+	memset(r->decimated, 0, sizeof(r->decimated));
+	r->level = 0;
+
+	/* force the intervals to be set up */
+	r->phase = LOG_PHASE_NUM;
+	log_rate_set_phase(r, LOG_PHASE_GROUND);
+}
+
+void log_rate_set_phase(struct log_rate_s *r, uint8_t phase)
+{
+	if (phase == r->phase || phase >= LOG_PHASE_NUM) {
+		return;
+	}
+
+	r->phase = phase;
+
+	memset(r->profile_interval, 0, sizeof(r->profile_interval));
+
+	if (r->adaptive) {
+		for (int i = 0; i < r->profiles_num; i++) {
+			if (r->profiles[i].msg_type < LOG_RATE_MSG_MAX) {
+				r->profile_interval[r->profiles[i].msg_type] = r->profiles[i].interval[phase];
+			}
+		}
+	}
+
+	log_rate_update(r);
+}
+
+bool log_rate_update_level(struct log_rate_s *r, int count, int size)
+{
+	int fill = count * 100 / size;
+	int level = r->level;
+
+	while (level < LOG_RATE_LEVELS && fill >= log_rate_thresholds[level]) {
+		level++;
+	}
+
+	while (level > 0 && fill < log_rate_thresholds[level - 1] - LOG_RATE_HYSTERESIS) {
+		level--;
+	}
+
+	if (level == r->level) {
+		return false;
+	}
+
+	r->level = level;
+	log_rate_update(r);
+	return true;
+}
+
+bool log_rate_check(struct log_rate_s *r, uint8_t msg_type, uint64_t now)
+{
+	if (msg_type >= LOG_RATE_MSG_MAX) {
+		return true;
+	}
+
+	/* 32 bit time wraps after 71 minutes, the difference stays valid */
+	uint32_t t = (uint32_t)now;
+	uint32_t elapsed = t - r->last[msg_type];
+	uint32_t profile_elapsed = t - r->profile_last[msg_type];
+	bool profile_due = profile_elapsed == 0 || profile_elapsed >= r->profile_interval[msg_type] * 1000U;
+
+	if (profile_due) {
+		r->profile_last[msg_type] = t;
+	}
+
+	if (elapsed == 0 || elapsed >= r->interval[msg_type] * 1000U) {
+		r->last[msg_type] = t;
+		return true;
+	}
+
+	/* due by its profile, left out for the buffer */
+	if (profile_due) {
+		r->decimated[r->prio[msg_type]]++;
+	}
+
+	return false;
+}
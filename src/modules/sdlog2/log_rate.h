@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file log_rate.h
+ *
+ * Rate limits of the log messages.
+ *
+ * Each message type has a priority and a minimum interval for each
+ * flight phase. When the log buffer fills up because the SD card
+ * stalls, messages are decimated by priority, lowest first, instead of
+ * being lost wherever the buffer happens to be full.
+ */
+
+#ifndef SDLOG2_LOG_RATE_H_
+#define SDLOG2_LOG_RATE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define LOG_RATE_MSG_MAX		72	/**< message types below are rate limited: business messages and raw topics */
+#define LOG_RATE_DEGRADED_INTERVAL	100	/**< interval of the first decimation step in ms, doubled with each level */
+
+enum LOG_PHASE {
+	LOG_PHASE_GROUND = 0,		/**< disarmed */
+	LOG_PHASE_TRANSITION,		/**< takeoff and landing */
+	LOG_PHASE_CRUISE,
+	LOG_PHASE_FAILSAFE,		/**< failsafe, flight recorder triggered */
+	LOG_PHASE_NUM
+};
+
+enum LOG_PRIO {
+	LOG_PRIO_CRITICAL = 0,		/**< never decimated */
+	LOG_PRIO_HIGH,
+	LOG_PRIO_NORMAL,
+	LOG_PRIO_LOW,
+	LOG_PRIO_NUM
+};
+
+#define LOG_RATE_LEVELS			(LOG_PRIO_NUM - 1)
+
+struct log_rate_profile_s {
+	uint8_t msg_type;
+	uint8_t prio;
+	uint16_t interval[LOG_PHASE_NUM];	/**< minimum interval in each phase in ms, 0 for every update */
+};
+
+struct log_rate_s {
+	const struct log_rate_profile_s *profiles;
+	int profiles_num;
+	bool adaptive;				/**< use the intervals of the profiles, only decimate otherwise */
+	uint8_t phase;
+	uint8_t level;				/**< decimation level, 0 while the buffer has room */
+	uint8_t prio[LOG_RATE_MSG_MAX];
+	uint16_t profile_interval[LOG_RATE_MSG_MAX];	/**< interval in the current phase, ms */
+	uint16_t interval[LOG_RATE_MSG_MAX];	/**< interval in the current phase and level, ms */
+	uint32_t last[LOG_RATE_MSG_MAX];	/**< time the message was last written, us */
+	uint32_t profile_last[LOG_RATE_MSG_MAX];	/**< time it was last due by its profile alone, us */
+	unsigned long decimated[LOG_PRIO_NUM];	/**< messages left out because of the buffer level */
+};
+
+/**
+ * Set up the rate limits, message types without profile are of normal
+ * priority and logged on every update.
+ *
+ * @param adaptive	apply the intervals of the profiles, otherwise only
+ *			use their priorities for decimation
+ */
+void log_rate_init(struct log_rate_s *r, const struct log_rate_profile_s *profiles, int profiles_num, bool adaptive);
+
+/**
+ * Back to the first phase and no decimation, clear the statistics.
+ */
+void log_rate_reset(struct log_rate_s *r);
+
+/**
+ * Switch to the intervals of a flight phase.
+ */
+void log_rate_set_phase(struct log_rate_s *r, uint8_t phase);
+
+/**
+ * Adjust the decimation level to the log buffer fill.
+ *
+ * @return true if the level changed
+ */
+bool log_rate_update_level(struct log_rate_s *r, int count, int size);
+
+/**
+ * Check if a message is due and mark it as written. Messages of a type
+ * written more than once in the same cycle share the decision.
+ */
+bool log_rate_check(struct log_rate_s *r, uint8_t msg_type, uint64_t now);
+
+#endif
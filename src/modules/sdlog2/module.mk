@@ -40,4 +40,6 @@ MODULE_COMMAND  = sdlog2
 MODULE_PRIORITY = "SCHED_PRIORITY_MAX-30"
 
 SRCS = sdlog2.c \
-       logbuffer.c
+       logbuffer.c \
+       flight_recorder.c \
+       log_rate.c
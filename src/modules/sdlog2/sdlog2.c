@@ -91,13 +91,25 @@
 #include <mavlink/mavlink_log.h>
 
 #include "logbuffer.h"
+#include "flight_recorder.h"
+#include "log_rate.h"
 #include "sdlog2_format.h"
 #include "sdlog2_messages.h"
 
-#define LOGBUFFER_WRITE_AND_COUNT(_msg) if (logbuffer_write(&lb, &log_msg, LOG_PACKET_SIZE(_msg))) { \
-		log_msgs_written++; \
-	} else { \
-		log_msgs_skipped++; \
+#define LOGBUFFER_WRITE_AND_COUNT(_msg) if (log_rate_check(&rates, LOG_##_msg##_MSG, t)) { \
+		if (logbuffer_write(&lb, &log_msg, LOG_PACKET_SIZE(_msg))) { \
+			log_msgs_written++; \
+		} else { \
+			log_msgs_skipped++; \
+		} \
+	}
+
+/* high-rate message: kept by the flight recorder, to SD only when due */
+#define LOGBUFFER_WRITE_HIGH_RATE_AND_COUNT(_msg) if (record_high_rate) { \
+		flight_recorder_write(&recorder, &log_msg, LOG_PACKET_SIZE(_msg)); \
+	} \
+	if (write_high_rate) { \
+		LOGBUFFER_WRITE_AND_COUNT(_msg); \
 	}
 
 #define LOG_ORB_SUBSCRIBE(_var, _topic) subs.##_var##_sub = orb_subscribe(ORB_ID(##_topic##)); \
@@ -114,6 +126,13 @@ static const int MAX_NO_LOGFILE = 999;		/**< Maximum number of log files */
 static const int LOG_BUFFER_SIZE_DEFAULT = 8192;
 static const int MAX_WRITE_CHUNK = 512;
 static const int MIN_BYTES_TO_WRITE = 512;
+#define LOG_TOPICS_MAX	8			/**< Maximum number of raw topics (-x option) */
+static const int RECORDER_SIZE_DEFAULT = 16384;
+static const int RECORDER_SD_RATE_DEFAULT = 10;
+#define RECORDER_CRASH_ACC	39.2f		/**< impact acceleration triggering the flight recorder, 4 g */
+#define RECORDER_CRASH_TILT_COS	0.0f		/**< cosine of the tilt triggering the flight recorder, upside down */
+#define TAKEOFF_PHASE_TIME	15000000	/**< time after leaving the ground logged as takeoff */
+#define DROP_INTERVAL		1000000		/**< interval of DROP messages */
 
 static const char *log_root = "/fs/microsd/log";
 static int mavlink_fd = -1;
@@ -142,9 +161,85 @@ static bool log_name_timestamp = false;
 /* helper flag to track system state changes */
 static bool flag_system_armed = false;
 
+/* flight recorder (-f option), reasons in FREC messages */
+enum FLIGHT_RECORDER_TRIGGER {
+	FLIGHT_RECORDER_TRIGGER_NONE = 0,
+	FLIGHT_RECORDER_TRIGGER_FAILSAFE,
+	FLIGHT_RECORDER_TRIGGER_COMMAND,
+	FLIGHT_RECORDER_TRIGGER_CRASH
+};
+
+static bool recorder_enabled = false;
+static struct flight_recorder_s recorder;
+static uint64_t recorder_window = 0;			/**< pre- and post-trigger window */
+static uint64_t recorder_trigger_time = 0;		/**< 0 if not triggered */
+static uint8_t recorder_trigger_reason = FLIGHT_RECORDER_TRIGGER_NONE;
+static uint8_t recorder_trigger_request = FLIGHT_RECORDER_TRIGGER_NONE;
+static bool recorder_dump_pending = false;		/**< pre-trigger window not yet written by the writer thread */
+static unsigned long recorder_triggers = 0;
+
+/* message rates (-p option) and decimation when the buffer fills */
+static struct log_rate_s rates;
+
+/* message priorities and intervals in ms, 0 for every update, limited by -r */
+static const struct log_rate_profile_s log_rate_profiles[] = {
+	/*				ground	takeoff/landing	cruise	failsafe */
+	{ LOG_ATT_MSG,	LOG_PRIO_HIGH,		{ 100,	0,	20,	0 } },
+	{ LOG_ATSP_MSG,	LOG_PRIO_HIGH,		{ 100,	0,	20,	0 } },
+	{ LOG_IMU_MSG,	LOG_PRIO_HIGH,		{ 100,	0,	20,	0 } },
+	{ LOG_SENS_MSG,	LOG_PRIO_NORMAL,	{ 200,	0,	100,	0 } },
+	{ LOG_LPOS_MSG,	LOG_PRIO_HIGH,		{ 200,	0,	50,	0 } },
+	{ LOG_LPSP_MSG,	LOG_PRIO_NORMAL,	{ 200,	0,	100,	0 } },
+	{ LOG_GPS_MSG,	LOG_PRIO_HIGH,		{ 0,	0,	0,	0 } },
+	{ LOG_ATTC_MSG,	LOG_PRIO_HIGH,		{ 100,	0,	20,	0 } },
+	{ LOG_STAT_MSG,	LOG_PRIO_CRITICAL,	{ 0,	0,	0,	0 } },
+	{ LOG_RC_MSG,	LOG_PRIO_NORMAL,	{ 200,	0,	100,	0 } },
+	{ LOG_OUT0_MSG,	LOG_PRIO_HIGH,		{ 100,	0,	20,	0 } },
+	{ LOG_AIRS_MSG,	LOG_PRIO_NORMAL,	{ 200,	0,	100,	0 } },
+	{ LOG_ARSP_MSG,	LOG_PRIO_HIGH,		{ 100,	0,	20,	0 } },
+	{ LOG_FLOW_MSG,	LOG_PRIO_LOW,		{ 200,	0,	100,	0 } },
+	{ LOG_GPOS_MSG,	LOG_PRIO_NORMAL,	{ 200,	0,	100,	0 } },
+	{ LOG_GPSP_MSG,	LOG_PRIO_CRITICAL,	{ 0,	0,	0,	0 } },
+	{ LOG_ESC_MSG,	LOG_PRIO_LOW,		{ 500,	100,	200,	100 } },
+	{ LOG_GVSP_MSG,	LOG_PRIO_LOW,		{ 200,	0,	100,	0 } },
+	{ LOG_BATT_MSG,	LOG_PRIO_NORMAL,	{ 1000,	200,	500,	200 } },
+	{ LOG_DIST_MSG,	LOG_PRIO_NORMAL,	{ 200,	0,	100,	0 } },
+	{ LOG_TELE_MSG,	LOG_PRIO_LOW,		{ 1000,	1000,	1000,	1000 } },
+	{ LOG_LAT_MSG,	LOG_PRIO_LOW,		{ 200,	0,	100,	0 } },
+};
+
 static pthread_t logwriter_pthread = 0;
 static pthread_attr_t logwriter_attr;
 
+/* topics logged as raw structs, described by their uORB field layout */
+struct log_topic_s {
+	orb_id_t topic;
+	int sub;
+	uint8_t *packet;		/**< message header followed by the topic struct */
+};
+
+static struct log_topic_s log_topics[LOG_TOPICS_MAX];
+static int log_topics_num = 0;
+
+/* field type names and sizes, indexed by enum orb_field_type */
+static const struct {
+	const char *name;
+	uint8_t size;
+} log_field_types[ORB_FIELD_TYPE_COUNT] = {
+	{ "int8_t", 1 },
+	{ "uint8_t", 1 },
+	{ "int16_t", 2 },
+	{ "uint16_t", 2 },
+	{ "int32_t", 4 },
+	{ "uint32_t", 4 },
+	{ "int64_t", 8 },
+	{ "uint64_t", 8 },
+	{ "float", 4 },
+	{ "double", 8 },
+	{ "bool", 1 },
+	{ "char", 1 },
+};
+
 /**
  * Log buffer writing thread. Open and close file here.
  */
@@ -157,6 +252,11 @@ __EXPORT int sdlog2_main(int argc, char *argv[]);
 
 static bool copy_if_updated(orb_id_t topic, int handle, void *buffer);
 
+/**
+ * Age of the originating sensor sample at publication, 0 if unknown.
+ */
+static uint32_t sample_age(uint64_t timestamp, uint64_t timestamp_sample);
+
 /**
  * Mainloop of sd log deamon.
  */
@@ -187,6 +287,23 @@ static void sdlog2_stop_log(void);
  */
 static int write_formats(int fd);
 
+/**
+ * Write formats of raw topics to log file.
+ */
+static int write_topic_formats(int fd);
+
+/**
+ * Print the field layout of a topic into 'buf', including padding.
+ *
+ * @return length of the complete layout text, as snprintf()
+ */
+static int format_topic_fields(orb_id_t topic, char *buf, int size);
+
+/**
+ * Add a topic to be logged as raw struct.
+ */
+static int add_log_topic(const char *name);
+
 /**
  * Write version message to log file.
  */
@@ -197,6 +314,11 @@ static int write_version(int fd);
  */
 static int write_parameters(int fd);
 
+/**
+ * Write the flight recorder pre-trigger window to log file.
+ */
+static int write_recorder(int fd);
+
 static bool file_exist(const char *filename);
 
 static int file_copy(const char *file_old, const char *file_new);
@@ -222,12 +344,21 @@ sdlog2_usage(const char *reason)
 		fprintf(stderr, "%s\n", reason);
 	}
 
-	errx(1, "usage: sdlog2 {start|stop|status} [-r <log rate>] [-b <buffer size>] -e -a -t\n"
+	errx(1, "usage: sdlog2 {start|stop|status} [-r <log rate>] [-b <buffer size>] [-x <topic>] -e -a -t -p "
+	     "[-f <seconds> [-m <recorder size>] [-s <SD rate>]]\n"
 	     "\t-r\tLog rate in Hz, 0 means unlimited rate\n"
 	     "\t-b\tLog buffer size in KiB, default is 8\n"
+	     "\t-x\tLog uORB topic as raw struct, can be given up to %d times\n"
 	     "\t-e\tEnable logging by default (if not, can be started by command)\n"
 	     "\t-a\tLog only when armed (can be still overriden by command)\n"
-	     "\t-t\tUse date/time for naming log directories and files\n");
+	     "\t-t\tUse date/time for naming log directories and files\n"
+	     "\t-p\tAdapt message rates to the flight phase: full rate during takeoff, landing\n"
+	     "\t\tand failsafe, lower in cruise and on ground\n"
+	     "\t-f\tFlight recorder: keep the last seconds of IMU, attitude, control and output messages\n"
+	     "\t\tin RAM and write them when triggered by failsafe, crash or command (param4 = 1)\n"
+	     "\t-m\tFlight recorder size in KiB, default is %d\n"
+	     "\t-s\tRate of the recorded messages to SD in Hz until triggered, default is %d\n",
+	     LOG_TOPICS_MAX, RECORDER_SIZE_DEFAULT / 1024, RECORDER_SD_RATE_DEFAULT);
 }
 
 /**
@@ -410,6 +541,8 @@ static void *logwriter_thread(void *arg)
 	/* write log messages formats, version and parameters */
 	log_bytes_written += write_formats(log_fd);
 
+	log_bytes_written += write_topic_formats(log_fd);
+
 	log_bytes_written += write_version(log_fd);
 
 	log_bytes_written += write_parameters(log_fd);
@@ -435,6 +568,23 @@ static void *logwriter_thread(void *arg)
 			logbuffer_mark_read(&lb, n);
 		}
 
+		/* the buffer is drained up to a message boundary, the pre-trigger window can go in here */
+		if (recorder_dump_pending && logbuffer_is_empty(logbuf)) {
+			pthread_mutex_unlock(&logbuffer_mutex);
+
+			/* the main thread does not record while the dump is pending */
+			log_bytes_written += write_recorder(log_fd);
+			fsync(log_fd);
+
+			pthread_mutex_lock(&logbuffer_mutex);
+			recorder_dump_pending = false;
+			pthread_mutex_unlock(&logbuffer_mutex);
+
+			n = 0;
+			should_wait = false;
+			continue;
+		}
+
 		/* only wait if no data is available to process */
 		if (should_wait && !logwriter_should_exit) {
 			/* blocking wait for new data at this line */
@@ -472,8 +622,8 @@ static void *logwriter_thread(void *arg)
 		} else {
 			n = 0;
 
-			/* exit only with empty buffer */
-			if (main_thread_should_exit || logwriter_should_exit) {
+			/* exit only with empty buffer and the flight recorder written */
+			if ((main_thread_should_exit || logwriter_should_exit) && !recorder_dump_pending) {
 				break;
 			}
 
@@ -508,6 +658,15 @@ void sdlog2_start_log()
 	start_time = hrt_absolute_time();
 	log_msgs_written = 0;
 	log_msgs_skipped = 0;
+	log_rate_reset(&rates);
+
+	/* nothing recorded for this log yet */
+	if (recorder_enabled) {
+		flight_recorder_reset(&recorder);
+		recorder_trigger_time = 0;
+		recorder_trigger_request = FLIGHT_RECORDER_TRIGGER_NONE;
+		recorder_dump_pending = false;
+	}
 
 	/* initialize log buffer emptying thread */
 	pthread_attr_init(&logwriter_attr);
@@ -577,6 +736,113 @@ int write_formats(int fd)
 	return written;
 }
 
+int format_topic_fields(orb_id_t topic, char *buf, int size)
+{
+	int len = 0;
+	unsigned offset = 0;
+	unsigned pad_count = 0;
+
+	for (const struct orb_field *field = topic->o_fields; ; field++) {
+		unsigned next = (field->name != NULL) ? field->offset : topic->o_size;
+
+		/* describe alignment gaps and bit-fields as padding, so that the layout maps the whole struct */
+		if (next > offset) {
+			len += snprintf((len < size) ? buf + len : NULL, (len < size) ? size - len : 0, "uint8_t[%u] _padding%u;", next - offset, pad_count++);
+		}
+
+		if (field->name == NULL) {
+			break;
+		}
+
+		const char *type_name = log_field_types[field->type].name;
+
+		if (field->count > 1) {
+			len += snprintf((len < size) ? buf + len : NULL, (len < size) ? size - len : 0, "%s[%u] %s;", type_name, field->count, field->name);
+
+		} else {
+			len += snprintf((len < size) ? buf + len : NULL, (len < size) ? size - len : 0, "%s %s;", type_name, field->name);
+		}
+
+		offset = field->offset + field->count * log_field_types[field->type].size;
+	}
+
+	return len;
+}
+
+int write_topic_formats(int fd)
+{
+	struct {
+		LOG_PACKET_HEADER;
+		struct log_TFMT_s body;
+	} log_msg_TFMT = {
+		LOG_PACKET_HEADER_INIT(LOG_TFMT_MSG),
+	};
+
+	int written = 0;
+
+	for (int i = 0; i < log_topics_num; i++) {
+		orb_id_t topic = log_topics[i].topic;
+
+		/* measure first, the layout can be a few KiB for topics with arrays of structs */
+		int format_len = format_topic_fields(topic, NULL, 0);
+		char *format = malloc(format_len + 1);
+
+		if (format == NULL) {
+			warnx("no memory for format of %s", topic->o_name);
+			continue;
+		}
+
+		format_topic_fields(topic, format, format_len + 1);
+
+		log_msg_TFMT.body.type = log_topics[i].packet[2];
+		log_msg_TFMT.body.length = LOG_PACKET_HEADER_LEN + topic->o_size;
+		log_msg_TFMT.body.format_len = format_len;
+		strncpy(log_msg_TFMT.body.name, topic->o_name, sizeof(log_msg_TFMT.body.name));
+
+		written += write(fd, &log_msg_TFMT, sizeof(log_msg_TFMT));
+		written += write(fd, format, format_len);
+
+		free(format);
+	}
+
+	return written;
+}
+
+int add_log_topic(const char *name)
+{
+	if (log_topics_num >= LOG_TOPICS_MAX) {
+		warnx("too many topics, max %d", LOG_TOPICS_MAX);
+		return ERROR;
+	}
+
+	orb_id_t topic = orb_find_topic(name);
+
+	if (topic == NULL || topic->o_fields == NULL) {
+		warnx("topic without field layout: %s", name);
+		return ERROR;
+	}
+
+	struct log_topic_s *t = &log_topics[log_topics_num];
+
+	t->packet = malloc(LOG_PACKET_HEADER_LEN + topic->o_size);
+
+	if (t->packet == NULL) {
+		warnx("no memory for topic %s", name);
+		return ERROR;
+	}
+
+	memset(t->packet, 0, LOG_PACKET_HEADER_LEN + topic->o_size);
+	t->packet[0] = HEAD_BYTE1;
+	t->packet[1] = HEAD_BYTE2;
+	t->packet[2] = LOG_TOPIC_MSG_FIRST + log_topics_num;
+	t->topic = topic;
+	t->sub = -1;
+
+	log_topics_num++;
+
+	return OK;
+}
+
 int write_version(int fd)
 {
 	/* construct version message */
@@ -593,6 +859,45 @@ int write_version(int fd)
 	return write(fd, &log_msg_VER, sizeof(log_msg_VER));
 }
 
+int write_recorder(int fd)
+{
+	/* construct flight recorder message */
+#pragma pack(push, 1)
+	struct {
+		LOG_PACKET_HEADER;
+		struct log_FREC_s body;
+	} log_msg_FREC = {
+		LOG_PACKET_HEADER_INIT(LOG_FREC_MSG),
+	};
+#pragma pack(pop)
+
+	log_msg_FREC.body.trigger_time = recorder_trigger_time;
+	log_msg_FREC.body.reason = recorder_trigger_reason;
+	log_msg_FREC.body.event = LOG_FREC_DUMP_START;
+	int written = write(fd, &log_msg_FREC, sizeof(log_msg_FREC));
+
+	/* segments oldest first, each starts with a TIME message */
+	for (int i = 0; i < FLIGHT_RECORDER_SEGMENTS; i++) {
+		void *ptr;
+		int n = flight_recorder_get_segment(&recorder, i, &ptr);
+
+		if (n > 0) {
+			n = write(fd, ptr, n);
+
+			if (n < 0) {
+				return written;
+			}
+
+			written += n;
+		}
+	}
+
+	log_msg_FREC.body.event = LOG_FREC_DUMP_END;
+	written += write(fd, &log_msg_FREC, sizeof(log_msg_FREC));
+
+	return written;
+}
+
 int write_parameters(int fd)
 {
 	/* construct parameter message */
@@ -647,6 +952,15 @@ bool copy_if_updated(orb_id_t topic, int handle, void *buffer)
 	return updated;
 }
 
+uint32_t sample_age(uint64_t timestamp, uint64_t timestamp_sample)
+{
+	if (timestamp_sample == 0 || timestamp < timestamp_sample) {
+		return 0;
+	}
+
+	return (uint32_t)(timestamp - timestamp_sample);
+}
+
 int sdlog2_thread_main(int argc, char *argv[])
 {
 	mavlink_fd = open(MAVLINK_LOG_DEVICE, 0);
@@ -664,9 +978,17 @@ int sdlog2_thread_main(int argc, char *argv[])
 	/* enable logging when armed (-a option) */
 	bool log_when_armed = false;
 	log_name_timestamp = false;
+	/* flight recorder size and rate of recorded messages to SD (-m, -s options) */
+	int recorder_size = RECORDER_SIZE_DEFAULT;
+	useconds_t recorder_sd_interval = 1000000 / RECORDER_SD_RATE_DEFAULT;
+	recorder_enabled = false;
+	/* message rates by flight phase (-p option) */
+	bool adaptive_rates = false;
 
 	flag_system_armed = false;
 
+	log_topics_num = 0;
+
 	/* work around some stupidity in task_create's argv handling */
 	argc -= 2;
 	argv += 2;
@@ -676,7 +998,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 	 * set error flag instead */
 	bool err_flag = false;
 
-	while ((ch = getopt(argc, argv, "r:b:eat")) != EOF) {
+	while ((ch = getopt(argc, argv, "r:b:x:eatpf:m:s:")) != EOF) {
 		switch (ch) {
 		case 'r': {
 				unsigned long r = strtoul(optarg, NULL, 10);
@@ -700,6 +1022,13 @@ int sdlog2_thread_main(int argc, char *argv[])
 			}
 			break;
 
+		case 'x':
+			if (add_log_topic(optarg) != OK) {
+				err_flag = true;
+			}
+
+			break;
+
 		case 'e':
 			log_on_start = true;
 			break;
@@ -712,6 +1041,44 @@ int sdlog2_thread_main(int argc, char *argv[])
 			log_name_timestamp = true;
 			break;
 
+		case 'p':
+			adaptive_rates = true;
+			break;
+
+		case 'f': {
+				unsigned long w = strtoul(optarg, NULL, 10);
+
+				if (w < 1) {
+					w = 1;
+				}
+
+				recorder_window = w * 1000000;
+				recorder_enabled = true;
+			}
+			break;
+
+		case 'm': {
+				unsigned long s = strtoul(optarg, NULL, 10);
+
+				if (s < 1) {
+					s = 1;
+				}
+
+				recorder_size = 1024 * s;
+			}
+			break;
+
+		case 's': {
+				unsigned long r = strtoul(optarg, NULL, 10);
+
+				if (r <= 0) {
+					r = 1;
+				}
+
+				recorder_sd_interval = 1000000 / r;
+			}
+			break;
+
 		case '?':
 			if (optopt == 'c') {
 				warnx("option -%c requires an argument", optopt);
@@ -763,6 +1130,16 @@ int sdlog2_thread_main(int argc, char *argv[])
 		errx(1, "can't allocate log buffer, exiting");
 	}
 
+	if (recorder_enabled) {
+		warnx("flight recorder: %u s, %i bytes", (unsigned)(recorder_window / 1000000), recorder_size);
+
+		if (OK != flight_recorder_init(&recorder, recorder_size, recorder_window)) {
+			errx(1, "can't allocate flight recorder, exiting");
+		}
+	}
+
+	log_rate_init(&rates, log_rate_profiles, sizeof(log_rate_profiles) / sizeof(log_rate_profiles[0]), adaptive_rates);
+
 	struct vehicle_status_s buf_status;
 
 	struct vehicle_gps_position_s buf_gps_pos;
@@ -825,6 +1202,9 @@ int sdlog2_thread_main(int argc, char *argv[])
 			struct log_BATT_s log_BATT;
 			struct log_DIST_s log_DIST;
 			struct log_TELE_s log_TELE;
+			struct log_LAT_s log_LAT;
+			struct log_FREC_s log_FREC;
+			struct log_DROP_s log_DROP;
 		} body;
 	} log_msg = {
 		LOG_PACKET_HEADER_INIT(0)
@@ -832,6 +1212,10 @@ int sdlog2_thread_main(int argc, char *argv[])
 #pragma pack(pop)
 	memset(&log_msg.body, 0, sizeof(log_msg.body));
 
+	/* latest sensor sample age seen at each stage of the control pipeline */
+	struct log_LAT_s latency;
+	memset(&latency, 0, sizeof(latency));
+
 	struct {
 		int cmd_sub;
 		int status_sub;
@@ -880,6 +1264,10 @@ int sdlog2_thread_main(int argc, char *argv[])
 	subs.telemetry_sub = orb_subscribe(ORB_ID(telemetry_status));
 	subs.range_finder_sub = orb_subscribe(ORB_ID(sensor_range_finder));
 
+	for (int i = 0; i < log_topics_num; i++) {
+		log_topics[i].sub = orb_subscribe(log_topics[i].topic);
+	}
+
 	thread_running = true;
 
 	/* initialize thread synchronization */
@@ -896,6 +1284,16 @@ int sdlog2_thread_main(int argc, char *argv[])
 	/* track changes in distance status */
 	bool dist_bottom_present = false;
 
+	/* track failsafe entry and when recorded messages went to SD last */
+	failsafe_state_t failsafe_state = FAILSAFE_STATE_NORMAL;
+	hrt_abstime high_rate_sd_time = 0;
+
+	/* track the flight phase for the message rates, and when DROP was written last */
+	bool landed = true;
+	bool transition_setpoint = false;
+	hrt_abstime takeoff_time = 0;
+	hrt_abstime drop_time = 0;
+
 	/* enable logging on start if needed */
 	if (log_on_start) {
 		/* check GPS topic to get GPS time */
@@ -923,6 +1321,22 @@ int sdlog2_thread_main(int argc, char *argv[])
 			if (log_when_armed) {
 				handle_status(&buf_status);
 			}
+
+			if (buf_status.failsafe_state != failsafe_state) {
+				if (failsafe_state == FAILSAFE_STATE_NORMAL) {
+					recorder_trigger_request = FLIGHT_RECORDER_TRIGGER_FAILSAFE;
+				}
+
+				failsafe_state = buf_status.failsafe_state;
+			}
+
+			if (buf_status.condition_landed != landed) {
+				if (!buf_status.condition_landed) {
+					takeoff_time = hrt_absolute_time();
+				}
+
+				landed = buf_status.condition_landed;
+			}
 		}
 
 		/* --- GPS POSITION - LOG MANAGEMENT --- */
@@ -938,11 +1352,68 @@ int sdlog2_thread_main(int argc, char *argv[])
 
 		pthread_mutex_lock(&logbuffer_mutex);
 
+		hrt_abstime t = hrt_absolute_time();
+
+		/* the flight recorder keeps the high-rate messages, SD gets them at a lower rate until triggered,
+		 * then at full rate for the post-trigger window */
+		bool record_high_rate = recorder_enabled && recorder_trigger_time == 0;
+		bool write_high_rate = !record_high_rate || t - high_rate_sd_time >= recorder_sd_interval;
+
+		if (record_high_rate && write_high_rate) {
+			high_rate_sd_time = t;
+		}
+
+		if (recorder_trigger_time != 0 && !recorder_dump_pending && t - recorder_trigger_time >= recorder_window) {
+			/* pre-trigger window written and post-trigger window over, start recording again */
+			flight_recorder_reset(&recorder);
+			recorder_trigger_time = 0;
+		}
+
+		/* message rates of the flight phase */
+		uint8_t phase;
+
+		if (buf_status.failsafe_state != FAILSAFE_STATE_NORMAL || recorder_trigger_time != 0) {
+			phase = LOG_PHASE_FAILSAFE;
+
+		} else if (buf_status.arming_state != ARMING_STATE_ARMED && buf_status.arming_state != ARMING_STATE_ARMED_ERROR) {
+			phase = LOG_PHASE_GROUND;
+
+		} else if (landed || transition_setpoint || t - takeoff_time < TAKEOFF_PHASE_TIME) {
+			phase = LOG_PHASE_TRANSITION;
+
+		} else {
+			phase = LOG_PHASE_CRUISE;
+		}
+
+		log_rate_set_phase(&rates, phase);
+
+		/* decimate by priority while the writer thread falls behind */
+		bool level_changed = log_rate_update_level(&rates, logbuffer_count(&lb), lb.size);
+
 		/* write time stamp message */
 		log_msg.msg_type = LOG_TIME_MSG;
-		log_msg.body.log_TIME.t = hrt_absolute_time();
+		log_msg.body.log_TIME.t = t;
 		LOGBUFFER_WRITE_AND_COUNT(TIME);
 
+		/* the recorder keeps the TIME message as reference, before log_msg is reused */
+		if (record_high_rate) {
+			flight_recorder_begin(&recorder, t, &log_msg, LOG_PACKET_SIZE(TIME));
+		}
+
+		/* --- DROPPED MESSAGES --- */
+		if (level_changed || t - drop_time >= DROP_INTERVAL) {
+			drop_time = t;
+			log_msg.msg_type = LOG_DROP_MSG;
+			log_msg.body.log_DROP.skipped = log_msgs_skipped;
+			log_msg.body.log_DROP.dec_high = rates.decimated[LOG_PRIO_HIGH];
+			log_msg.body.log_DROP.dec_normal = rates.decimated[LOG_PRIO_NORMAL];
+			log_msg.body.log_DROP.dec_low = rates.decimated[LOG_PRIO_LOW];
+			log_msg.body.log_DROP.phase = rates.phase;
+			log_msg.body.log_DROP.level = rates.level;
+			log_msg.body.log_DROP.fill = logbuffer_count(&lb) * 100 / lb.size;
+			LOGBUFFER_WRITE_AND_COUNT(DROP);
+		}
+
 		/* --- VEHICLE STATUS --- */
 		if (status_updated) {
 			log_msg.msg_type = LOG_STAT_MSG;
@@ -1012,7 +1483,17 @@ int sdlog2_thread_main(int argc, char *argv[])
 				log_msg.body.log_IMU.mag_x = buf.sensor.magnetometer_ga[0];
 				log_msg.body.log_IMU.mag_y = buf.sensor.magnetometer_ga[1];
 				log_msg.body.log_IMU.mag_z = buf.sensor.magnetometer_ga[2];
-				LOGBUFFER_WRITE_AND_COUNT(IMU);
+				LOGBUFFER_WRITE_HIGH_RATE_AND_COUNT(IMU);
+			}
+
+			/* impact */
+			float acc_sq = buf.sensor.accelerometer_m_s2[0] * buf.sensor.accelerometer_m_s2[0] +
+				       buf.sensor.accelerometer_m_s2[1] * buf.sensor.accelerometer_m_s2[1] +
+				       buf.sensor.accelerometer_m_s2[2] * buf.sensor.accelerometer_m_s2[2];
+
+			if (recorder_enabled && buf_status.arming_state == ARMING_STATE_ARMED &&
+			    acc_sq > RECORDER_CRASH_ACC * RECORDER_CRASH_ACC) {
+				recorder_trigger_request = FLIGHT_RECORDER_TRIGGER_CRASH;
 			}
 
 			if (write_SENS) {
@@ -1038,7 +1519,14 @@ int sdlog2_thread_main(int argc, char *argv[])
 			log_msg.body.log_ATT.gx = buf.att.g_comp[0];
 			log_msg.body.log_ATT.gy = buf.att.g_comp[1];
 			log_msg.body.log_ATT.gz = buf.att.g_comp[2];
-			LOGBUFFER_WRITE_AND_COUNT(ATT);
+			LOGBUFFER_WRITE_HIGH_RATE_AND_COUNT(ATT);
+			latency.att = sample_age(buf.att.timestamp, buf.att.timestamp_sample);
+
+			/* flipped over */
+			if (recorder_enabled && buf_status.arming_state == ARMING_STATE_ARMED &&
+			    cosf(buf.att.roll) * cosf(buf.att.pitch) < RECORDER_CRASH_TILT_COS) {
+				recorder_trigger_request = FLIGHT_RECORDER_TRIGGER_CRASH;
+			}
 		}
 
 		/* --- ATTITUDE SETPOINT --- */
@@ -1048,7 +1536,7 @@ int sdlog2_thread_main(int argc, char *argv[])
 			log_msg.body.log_ATSP.pitch_sp = buf.att_sp.pitch_body;
 			log_msg.body.log_ATSP.yaw_sp = buf.att_sp.yaw_body;
 			log_msg.body.log_ATSP.thrust_sp = buf.att_sp.thrust;
-			LOGBUFFER_WRITE_AND_COUNT(ATSP);
+			LOGBUFFER_WRITE_HIGH_RATE_AND_COUNT(ATSP);
 		}
 
 		/* --- RATES SETPOINT --- */
@@ -1057,14 +1545,21 @@ int sdlog2_thread_main(int argc, char *argv[])
 			log_msg.body.log_ARSP.roll_rate_sp = buf.rates_sp.roll;
 			log_msg.body.log_ARSP.pitch_rate_sp = buf.rates_sp.pitch;
 			log_msg.body.log_ARSP.yaw_rate_sp = buf.rates_sp.yaw;
-			LOGBUFFER_WRITE_AND_COUNT(ARSP);
+			LOGBUFFER_WRITE_HIGH_RATE_AND_COUNT(ARSP);
+			latency.rates_sp = sample_age(buf.rates_sp.timestamp, buf.rates_sp.timestamp_sample);
 		}
 
 		/* --- ACTUATOR OUTPUTS --- */
 		if (copy_if_updated(ORB_ID(actuator_outputs_0), subs.act_outputs_sub, &buf.act_outputs)) {
 			log_msg.msg_type = LOG_OUT0_MSG;
 			memcpy(log_msg.body.log_OUT0.output, buf.act_outputs.output, sizeof(log_msg.body.log_OUT0.output));
-			LOGBUFFER_WRITE_AND_COUNT(OUT0);
+			LOGBUFFER_WRITE_HIGH_RATE_AND_COUNT(OUT0);
+
+			/* one latency record per output update, with the latest age seen at each stage */
+			latency.outputs = sample_age(buf.act_outputs.timestamp, buf.act_outputs.timestamp_sample);
+			log_msg.msg_type = LOG_LAT_MSG;
+			log_msg.body.log_LAT = latency;
+			LOGBUFFER_WRITE_HIGH_RATE_AND_COUNT(LAT);
 		}
 
 		/* --- ACTUATOR CONTROL --- */
@@ -1074,7 +1569,8 @@ int sdlog2_thread_main(int argc, char *argv[])
 			log_msg.body.log_ATTC.pitch = buf.act_controls.control[1];
 			log_msg.body.log_ATTC.yaw = buf.act_controls.control[2];
 			log_msg.body.log_ATTC.thrust = buf.act_controls.control[3];
-			LOGBUFFER_WRITE_AND_COUNT(ATTC);
+			LOGBUFFER_WRITE_HIGH_RATE_AND_COUNT(ATTC);
+			latency.controls = sample_age(buf.act_controls.timestamp, buf.act_controls.timestamp_sample);
 		}
 
 		/* --- LOCAL POSITION --- */
@@ -1144,6 +1640,9 @@ int sdlog2_thread_main(int argc, char *argv[])
 			log_msg.body.log_GPSP.loiter_direction = buf.triplet.current.loiter_direction;
 			log_msg.body.log_GPSP.pitch_min = buf.triplet.current.pitch_min;
 			LOGBUFFER_WRITE_AND_COUNT(GPSP);
+
+			transition_setpoint = buf.triplet.current.valid &&
+					      (buf.triplet.current.type == SETPOINT_TYPE_TAKEOFF || buf.triplet.current.type == SETPOINT_TYPE_LAND);
 		}
 
 		/* --- VICON POSITION --- */
@@ -1242,6 +1741,45 @@ int sdlog2_thread_main(int argc, char *argv[])
 			LOGBUFFER_WRITE_AND_COUNT(DIST);
 		}
 
+		/* --- RAW TOPICS --- */
+		for (int i = 0; i < log_topics_num; i++) {
+			struct log_topic_s *lt = &log_topics[i];
+
+			/* copy straight into the message body, no repacking */
+			if (copy_if_updated(lt->topic, lt->sub, lt->packet + LOG_PACKET_HEADER_LEN) &&
+			    log_rate_check(&rates, lt->packet[2], t)) {
+				if (logbuffer_write(&lb, lt->packet, LOG_PACKET_HEADER_LEN + lt->topic->o_size)) {
+					log_msgs_written++;
+
+				} else {
+					log_msgs_skipped++;
+				}
+			}
+		}
+
+		/* --- FLIGHT RECORDER TRIGGER --- */
+		if (recorder_trigger_request != FLIGHT_RECORDER_TRIGGER_NONE) {
+			if (recorder_enabled && recorder_trigger_time == 0) {
+				recorder_trigger_time = t;
+				recorder_trigger_reason = recorder_trigger_request;
+				recorder_dump_pending = true;
+				recorder_triggers++;
+
+				log_msg.msg_type = LOG_FREC_MSG;
+				log_msg.body.log_FREC.trigger_time = t;
+				log_msg.body.log_FREC.reason = recorder_trigger_reason;
+				log_msg.body.log_FREC.event = LOG_FREC_TRIGGER;
+				LOGBUFFER_WRITE_AND_COUNT(FREC);
+
+				mavlink_log_info(mavlink_fd, "[sdlog2] flight recorder triggered: %u", (unsigned)recorder_trigger_reason);
+
+				/* have the writer thread drain the buffer and write the pre-trigger window */
+				pthread_cond_signal(&logbuffer_cond);
+			}
+
+			recorder_trigger_request = FLIGHT_RECORDER_TRIGGER_NONE;
+		}
+
 		/* signal the other thread new data, but not yet unlock */
 		if (logbuffer_count(&lb) > MIN_BYTES_TO_WRITE) {
 			/* only request write if several packets can be written at once */
@@ -1261,6 +1799,17 @@ int sdlog2_thread_main(int argc, char *argv[])
 
 	free(lb.data);
 
+	if (recorder_enabled) {
+		free(recorder.data);
+	}
+
+	for (int i = 0; i < log_topics_num; i++) {
+		close(log_topics[i].sub);
+		free(log_topics[i].packet);
+	}
+
+	log_topics_num = 0;
+
 	warnx("exiting");
 
 	thread_running = false;
@@ -1276,6 +1825,13 @@ void sdlog2_status()
 
 	warnx("wrote %lu msgs, %4.2f MiB (average %5.3f KiB/s), skipped %lu msgs", log_msgs_written, (double)mebibytes, (double)(kibibytes / seconds), log_msgs_skipped);
 	mavlink_log_info(mavlink_fd, "[sdlog2] wrote %lu msgs, skipped %lu msgs", log_msgs_written, log_msgs_skipped);
+
+	warnx("phase %u, decimation level %u, decimated %lu high, %lu normal, %lu low priority msgs", (unsigned)rates.phase,
+	      (unsigned)rates.level, rates.decimated[LOG_PRIO_HIGH], rates.decimated[LOG_PRIO_NORMAL], rates.decimated[LOG_PRIO_LOW]);
+
+	if (recorder_enabled) {
+		warnx("flight recorder: %lu triggers, %lu segments cut short", recorder_triggers, recorder.segments_cut);
+	}
 }
 
 /**
@@ -1337,7 +1893,11 @@ void handle_command(struct vehicle_command_s *cmd)
 	case VEHICLE_CMD_PREFLIGHT_STORAGE:
 		param = (int)(cmd->param3);
 
-		if (param == 1)	{
+		if ((int)(cmd->param4) == 1) {
+			/* flight recorder trigger, logging goes on as it is */
+			recorder_trigger_request = FLIGHT_RECORDER_TRIGGER_COMMAND;
+
+		} else if (param == 1)	{
 			sdlog2_start_log();
 
 		} else if (param == 0)	{
@@ -276,6 +276,16 @@ struct log_TELE_s {
 	uint8_t txbuf;
 };
 
+/* --- LAT - SENSOR TO ACTUATOR LATENCY --- */
+/* age of the originating sensor sample in us when each stage published, 0 if unknown */
+#define LOG_LAT_MSG 23
+struct log_LAT_s {
+	uint32_t att;
+	uint32_t rates_sp;
+	uint32_t controls;
+	uint32_t outputs;
+};
+
 /********** SYSTEM MESSAGES, ID > 0x80 **********/
 
 /* --- TIME - TIME STAMP --- */
@@ -298,6 +308,44 @@ struct log_PARM_s {
 	float value;
 };
 
+/* --- TFMT - TOPIC FORMAT --- */
+/* variable length: followed by 'format_len' bytes of field layout, e.g. "uint64_t timestamp;float[3] g_comp;" */
+#define LOG_TFMT_MSG 132
+struct log_TFMT_s {
+	uint8_t type;		// message type used for the raw topic
+	uint16_t length;	// full packet length including header
+	uint16_t format_len;
+	char name[32];
+};
+
+/* --- FREC - FLIGHT RECORDER --- */
+/* pre-trigger window follows the trigger in the file, out of time order */
+#define LOG_FREC_MSG 133
+#define LOG_FREC_TRIGGER	0
+#define LOG_FREC_DUMP_START	1
+#define LOG_FREC_DUMP_END	2
+struct log_FREC_s {
+	uint64_t trigger_time;
+	uint8_t reason;		// FLIGHT_RECORDER_TRIGGER_*
+	uint8_t event;		// LOG_FREC_*
+};
+
+/* --- DROP - MESSAGES LEFT OUT --- */
+/* counters since log start, written every second and when the decimation level changes */
+#define LOG_DROP_MSG 134
+struct log_DROP_s {
+	uint32_t skipped;	// lost with the log buffer full
+	uint32_t dec_high;	// decimated for the buffer fill, by priority
+	uint32_t dec_normal;
+	uint32_t dec_low;
+	uint8_t phase;		// LOG_PHASE_*
+	uint8_t level;		// decimation level, 0 for none
+	uint8_t fill;		// log buffer fill in percent
+};
+
+/* raw topic messages, body is the uORB topic struct as published */
+#define LOG_TOPIC_MSG_FIRST 64
+
 #pragma pack(pop)
 
 /* construct list of all message formats */
@@ -324,12 +372,16 @@ static const struct log_format_s log_formats[] = {
 	LOG_FORMAT(BATT, "ffff", "V,VFilt,C,Discharged"),
 	LOG_FORMAT(DIST, "ffB", "Bottom,BottomRate,Flags"),
 	LOG_FORMAT(TELE, "BBBBHHB", "RSSI,RemRSSI,Noise,RemNoise,RXErr,Fixed,TXBuf"),
+	LOG_FORMAT(LAT, "IIII", "Att,RatesSP,Ctrl,Out"),
 
 	/* system-level messages, ID >= 0x80 */
 	// FMT: don't write format of format message, it's useless
 	LOG_FORMAT(TIME, "Q", "StartTime"),
 	LOG_FORMAT(VER, "NZ", "Arch,FwGit"),
 	LOG_FORMAT(PARM, "Nf", "Name,Value"),
+	LOG_FORMAT(FREC, "QBB", "TrigTime,Reason,Event"),
+	LOG_FORMAT(DROP, "IIIIBBB", "Skipped,DecHigh,DecNorm,DecLow,Phase,Level,Fill"),
+	// TFMT: variable length, written separately for each raw topic
 };
 
 static const int log_formats_num = sizeof(log_formats) / sizeof(struct log_format_s);
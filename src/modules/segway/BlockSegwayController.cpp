@@ -13,13 +13,13 @@ void BlockSegwayController::update() {
 	if (dt > 1.0f || dt < 0) return;
 
 	// set dt for all child blocks
-	setDt(dt);
+	_graph.setDt(dt);
 
 	// check for new updates
-	if (_param_update.updated()) updateParams();
+	if (_param_update.updated()) _graph.updateParams();
 
 	// get new information from subscriptions
-	updateSubscriptions();
+	_graph.updateSubscriptions();
 
 	// default all output to zero unless handled by mode
 	for (unsigned i = 2; i < NUM_ACTUATOR_CONTROLS; i++)
@@ -52,7 +52,7 @@ void BlockSegwayController::update() {
 	}
 
 	// update all publications
-	updatePublications();
+	_graph.updatePublications();
 
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <controllib/uorb/blocks.hpp>
+#include <controllib/block/BlockGraph.hpp>
 
 using namespace control;
 
@@ -11,7 +12,8 @@ public:
 		th2v(this, "TH2V"),
 		q2v(this, "Q2V"),
 		_attPoll(),
-		_timeStamp(0)
+		_timeStamp(0),
+		_graph(this)
 	{
 		_attPoll.fd = _att.getHandle();
 		_attPoll.events = POLLIN;
@@ -23,5 +25,7 @@ private:
 	BlockP q2v;
 	struct pollfd _attPoll;
 	uint64_t _timeStamp;
+	// flattened update chain, must follow all child blocks
+	BlockGraph<5, 4, 8, 1> _graph;
 };
 
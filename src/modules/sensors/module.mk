@@ -39,4 +39,5 @@ MODULE_COMMAND	= sensors
 MODULE_PRIORITY	= "SCHED_PRIORITY_MAX-5"
 
 SRCS		= sensors.cpp \
+		  sensor_failover.cpp \
 		  sensor_params.c
@@ -0,0 +1,67 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file sensor_failover.h
+ *
+ * Selection among redundant sensor instances.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Redundant sensors: instances of sensor_gyro / sensor_accel / sensor_mag
+ * watched, and how long the selected instance may be silent before we
+ * fail over to another one.
+ */
+#define SENSOR_COUNT_MAX		3
+#define SENSOR_FAILOVER_TIMEOUT		50000	/* 50 ms */
+
+/**
+ * Pick the instance to use.
+ *
+ * The current instance is kept while it publishes, or if it never has
+ * (startup). Once it is silent for SENSOR_FAILOVER_TIMEOUT, the calibrated
+ * instance that published last takes over; uncalibrated data would be
+ * worse than stale data.
+ *
+ * @param last		Time of the last publication of each instance, 0 if none.
+ * @param current	The instance in use.
+ * @param calibrated	Bit i set if instance i is calibrated.
+ * @param now		The current time.
+ * @return		The instance to use.
+ */
+unsigned	sensor_failover_select(const uint64_t last[SENSOR_COUNT_MAX], unsigned current,
+				       unsigned calibrated, uint64_t now);
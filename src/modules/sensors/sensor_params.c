@@ -190,6 +190,246 @@ PARAM_DEFINE_FLOAT(SENS_ACC_YSCALE, 1.0f);
  */
 PARAM_DEFINE_FLOAT(SENS_ACC_ZSCALE, 1.0f);
 
+/**
+ * Gyro 1 X-axis offset
+ *
+ * Calibration of the gyro instance 1 (/dev/gyro1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR1_XOFF, 0.0f);
+
+/**
+ * Gyro 1 Y-axis offset
+ *
+ * Calibration of the gyro instance 1 (/dev/gyro1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR1_YOFF, 0.0f);
+
+/**
+ * Gyro 1 Z-axis offset
+ *
+ * Calibration of the gyro instance 1 (/dev/gyro1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR1_ZOFF, 0.0f);
+
+/**
+ * Gyro 1 X-axis scaling factor
+ *
+ * Calibration of the gyro instance 1 (/dev/gyro1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR1_XSCALE, 1.0f);
+
+/**
+ * Gyro 1 Y-axis scaling factor
+ *
+ * Calibration of the gyro instance 1 (/dev/gyro1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR1_YSCALE, 1.0f);
+
+/**
+ * Gyro 1 Z-axis scaling factor
+ *
+ * Calibration of the gyro instance 1 (/dev/gyro1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR1_ZSCALE, 1.0f);
+
+/**
+ * Gyro 2 X-axis offset
+ *
+ * Calibration of the gyro instance 2 (/dev/gyro2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR2_XOFF, 0.0f);
+
+/**
+ * Gyro 2 Y-axis offset
+ *
+ * Calibration of the gyro instance 2 (/dev/gyro2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR2_YOFF, 0.0f);
+
+/**
+ * Gyro 2 Z-axis offset
+ *
+ * Calibration of the gyro instance 2 (/dev/gyro2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR2_ZOFF, 0.0f);
+
+/**
+ * Gyro 2 X-axis scaling factor
+ *
+ * Calibration of the gyro instance 2 (/dev/gyro2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR2_XSCALE, 1.0f);
+
+/**
+ * Gyro 2 Y-axis scaling factor
+ *
+ * Calibration of the gyro instance 2 (/dev/gyro2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR2_YSCALE, 1.0f);
+
+/**
+ * Gyro 2 Z-axis scaling factor
+ *
+ * Calibration of the gyro instance 2 (/dev/gyro2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_GYR2_ZSCALE, 1.0f);
+
+/**
+ * Accelerometer 1 X-axis offset
+ *
+ * Calibration of the accel instance 1 (/dev/accel1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC1_XOFF, 0.0f);
+
+/**
+ * Accelerometer 1 Y-axis offset
+ *
+ * Calibration of the accel instance 1 (/dev/accel1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC1_YOFF, 0.0f);
+
+/**
+ * Accelerometer 1 Z-axis offset
+ *
+ * Calibration of the accel instance 1 (/dev/accel1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC1_ZOFF, 0.0f);
+
+/**
+ * Accelerometer 1 X-axis scaling factor
+ *
+ * Calibration of the accel instance 1 (/dev/accel1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC1_XSCALE, 1.0f);
+
+/**
+ * Accelerometer 1 Y-axis scaling factor
+ *
+ * Calibration of the accel instance 1 (/dev/accel1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC1_YSCALE, 1.0f);
+
+/**
+ * Accelerometer 1 Z-axis scaling factor
+ *
+ * Calibration of the accel instance 1 (/dev/accel1), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC1_ZSCALE, 1.0f);
+
+/**
+ * Accelerometer 2 X-axis offset
+ *
+ * Calibration of the accel instance 2 (/dev/accel2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC2_XOFF, 0.0f);
+
+/**
+ * Accelerometer 2 Y-axis offset
+ *
+ * Calibration of the accel instance 2 (/dev/accel2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC2_YOFF, 0.0f);
+
+/**
+ * Accelerometer 2 Z-axis offset
+ *
+ * Calibration of the accel instance 2 (/dev/accel2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC2_ZOFF, 0.0f);
+
+/**
+ * Accelerometer 2 X-axis scaling factor
+ *
+ * Calibration of the accel instance 2 (/dev/accel2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC2_XSCALE, 1.0f);
+
+/**
+ * Accelerometer 2 Y-axis scaling factor
+ *
+ * Calibration of the accel instance 2 (/dev/accel2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC2_YSCALE, 1.0f);
+
+/**
+ * Accelerometer 2 Z-axis scaling factor
+ *
+ * Calibration of the accel instance 2 (/dev/accel2), which is only used for failover
+ * once it has been calibrated.
+ *
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_FLOAT(SENS_ACC2_ZSCALE, 1.0f);
+
 
 /**
  * Differential pressure sensor offset
@@ -253,6 +493,21 @@ PARAM_DEFINE_INT32(SENS_BOARD_ROT, 0);
  */
 PARAM_DEFINE_INT32(SENS_EXT_MAG_ROT, 0);
 
+/**
+ * Sample IMU on data-ready
+ *
+ * If set to 1, the accel and gyro drivers are switched to take a
+ * measurement on each data-ready edge of the sensor instead of polling
+ * it from a timer. Samples then follow the sensor output rate and carry
+ * the time of their edge. Drivers or boards without a data-ready line
+ * keep polling. Takes effect on the next boot.
+ *
+ * @min 0
+ * @max 1
+ * @group Sensor Calibration
+ */
+PARAM_DEFINE_INT32(SENS_DRDY, 0);
+
 
 /**
  * RC Channel 1 Minimum
@@ -66,6 +66,7 @@
 #include <systemlib/param/param.h>
 #include <systemlib/err.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/boot_trace.h>
 #include <conversion/rotation.h>
 
 #include <systemlib/airspeed.h>
@@ -81,6 +82,8 @@
 #include <uORB/topics/differential_pressure.h>
 #include <uORB/topics/airspeed.h>
 
+#include "sensor_failover.h"
+
 #define GYRO_HEALTH_COUNTER_LIMIT_ERROR 20   /* 40 ms downtime at 500 Hz update rate   */
 #define ACC_HEALTH_COUNTER_LIMIT_ERROR  20   /* 40 ms downtime at 500 Hz update rate   */
 #define MAGN_HEALTH_COUNTER_LIMIT_ERROR 100  /* 1000 ms downtime at 100 Hz update rate  */
@@ -133,8 +136,6 @@
  */
 #define PCB_TEMP_ESTIMATE_DEG 5.0f
 
-#define limit_minus_one_to_one(arg) (arg < -1.0f) ? -1.0f : ((arg > 1.0f) ? 1.0f : arg)
-
 /**
  * Sensor app start / stop handling function
  *
@@ -167,6 +168,39 @@ private:
 
 	hrt_abstime	_rc_last_valid;		/**< last time we got a valid RC signal */
 
+	/**
+	 * Channel scaling, compiled from the RCx_MIN/TRIM/MAX/REV/DZ parameters.
+	 */
+	struct rc_channel_scale {
+		float	min;			/**< raw values are constrained to min..max */
+		float	max;
+		float	lower;			/**< below trim - dead zone the lower slope applies */
+		float	upper;			/**< above trim + dead zone the upper slope applies */
+		float	lower_scale;		/**< reverse / (trim - dead zone - min), 0 if unused */
+		float	upper_scale;		/**< reverse / (max - trim - dead zone), 0 if unused */
+	};
+
+	/**
+	 * Mapping of an RC function to its channel and manual control field.
+	 */
+	struct rc_function_map {
+		unsigned	channel;
+		float		*output;	/**< field of _manual_control written by this function */
+		float		sign;		/**< applied before limiting */
+		float		min;		/**< output limits */
+		float		max;
+		float		scale;		/**< RC_SCALE_* factor, applied after limiting */
+	};
+
+	rc_channel_scale _rc_scale[_rc_max_chan_count];
+	rc_function_map	_rc_functions[RC_CHANNELS_FUNCTION_MAX];
+	unsigned	_rc_function_count;	/**< number of mapped functions in _rc_functions */
+
+	/**
+	 * Compile the RC parameters into the channel scaling and function tables.
+	 */
+	void		rc_map_update();
+
 	/**
 	 * Gather and publish RC input data.
 	 */
@@ -182,9 +216,13 @@ private:
 	bool		_hil_enabled;			/**< if true, HIL is active */
 	bool		_publishing;			/**< if true, we are publishing sensor data */
 
-	int		_gyro_sub;			/**< raw gyro data subscription */
-	int		_accel_sub;			/**< raw accel data subscription */
+	int		_gyro_sub[SENSOR_COUNT_MAX];	/**< raw gyro data subscriptions, one per instance */
+	int		_accel_sub[SENSOR_COUNT_MAX];	/**< raw accel data subscriptions, one per instance */
 	int		_mag_sub;			/**< raw mag data subscription */
+	unsigned	_gyro_instance;			/**< gyro instance in use */
+	unsigned	_accel_instance;		/**< accel instance in use */
+	unsigned	_gyro_calibrated;		/**< bit mask of gyro instances with calibration applied */
+	unsigned	_accel_calibrated;		/**< bit mask of accel instances with calibration applied */
 	int 		_rc_sub;			/**< raw rc channels data subscription */
 	int		_baro_sub;			/**< raw baro data subscription */
 	int		_airspeed_sub;			/**< airspeed subscription */
@@ -202,8 +240,11 @@ private:
 	orb_advert_t	_diff_pres_pub;			/**< differential_pressure */
 
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
+	perf_counter_t	_rc_perf;			/**< r/c mapping performance counter */
+	perf_counter_t	_rc_latency_perf;		/**< r/c signal to manual control setpoint latency */
 
 	struct rc_channels_s _rc;			/**< r/c channel data */
+	struct manual_control_setpoint_s _manual_control;	/**< manual control, unmapped functions stay NaN */
 	struct battery_status_s _battery_status;	/**< battery status */
 	struct baro_report _barometer;			/**< barometer data */
 	struct differential_pressure_s _diff_pres;
@@ -224,17 +265,18 @@ private:
 		float dz[_rc_max_chan_count];
 		float scaling_factor[_rc_max_chan_count];
 
-		float gyro_offset[3];
-		float gyro_scale[3];
+		float gyro_offset[SENSOR_COUNT_MAX][3];
+		float gyro_scale[SENSOR_COUNT_MAX][3];
 		float mag_offset[3];
 		float mag_scale[3];
-		float accel_offset[3];
-		float accel_scale[3];
+		float accel_offset[SENSOR_COUNT_MAX][3];
+		float accel_scale[SENSOR_COUNT_MAX][3];
 		float diff_pres_offset_pa;
 		float diff_pres_analog_enabled;
 
 		int board_rotation;
 		int external_mag_rotation;
+		int drdy;
 
 		int rc_map_roll;
 		int rc_map_pitch;
@@ -277,10 +319,10 @@ private:
 		param_t rev[_rc_max_chan_count];
 		param_t dz[_rc_max_chan_count];
 
-		param_t gyro_offset[3];
-		param_t gyro_scale[3];
-		param_t accel_offset[3];
-		param_t accel_scale[3];
+		param_t gyro_offset[SENSOR_COUNT_MAX][3];
+		param_t gyro_scale[SENSOR_COUNT_MAX][3];
+		param_t accel_offset[SENSOR_COUNT_MAX][3];
+		param_t accel_scale[SENSOR_COUNT_MAX][3];
 		param_t mag_offset[3];
 		param_t mag_scale[3];
 		param_t diff_pres_offset_pa;
@@ -320,6 +362,7 @@ private:
 
 		param_t board_rotation;
 		param_t external_mag_rotation;
+		param_t drdy;
 
 	}		_parameter_handles;		/**< handles for interesting parameters */
 
@@ -354,6 +397,20 @@ private:
 	 */
 	void		adc_init();
 
+	/**
+	 * Select the instance of a redundant sensor to use.
+	 *
+	 * Stays with the current instance while it publishes. If it has
+	 * stopped, fails over to the calibrated instance that published last.
+	 *
+	 * @param subs			Subscriptions to the instances of the sensor topic.
+	 * @param current		The instance currently in use.
+	 * @param calibrated		Bit mask of the instances with calibration applied.
+	 * @param name			Sensor name for the failover message.
+	 * @return			The instance to use.
+	 */
+	unsigned	sensor_select(const int *subs, unsigned current, unsigned calibrated, const char *name);
+
 	/**
 	 * Poll the accelerometer for updated data.
 	 *
@@ -437,6 +494,7 @@ Sensors	*g_sensors = nullptr;
 
 Sensors::Sensors() :
 	_rc_last_valid(0),
+	_rc_function_count(0),
 
 	_fd_adc(-1),
 	_last_adc(0),
@@ -447,9 +505,11 @@ Sensors::Sensors() :
 	_publishing(true),
 
 /* subscriptions */
-	_gyro_sub(-1),
-	_accel_sub(-1),
 	_mag_sub(-1),
+	_gyro_instance(0),
+	_accel_instance(0),
+	_gyro_calibrated(0),
+	_accel_calibrated(0),
 	_rc_sub(-1),
 	_baro_sub(-1),
 	_vcontrol_mode_sub(-1),
@@ -467,11 +527,17 @@ Sensors::Sensors() :
 
 /* performance counters */
 	_loop_perf(perf_alloc(PC_ELAPSED, "sensor task update")),
+	_rc_perf(perf_alloc(PC_ELAPSED, "sensors rc")),
+	_rc_latency_perf(perf_alloc(PC_LATENCY, "sensors rc latency")),
 
 	_mag_is_external(false),
 	_battery_discharged(0),
 	_battery_current_timestamp(0)
 {
+	for (unsigned i = 0; i < SENSOR_COUNT_MAX; i++) {
+		_gyro_sub[i] = -1;
+		_accel_sub[i] = -1;
+	}
 
 	/* basic r/c parameters */
 	for (unsigned i = 0; i < _rc_max_chan_count; i++) {
@@ -533,21 +599,30 @@ Sensors::Sensors() :
 	_parameter_handles.rc_fs_mode = param_find("RC_FS_MODE");
 	_parameter_handles.rc_fs_thr = param_find("RC_FS_THR");
 
-	/* gyro offsets */
-	_parameter_handles.gyro_offset[0] = param_find("SENS_GYRO_XOFF");
-	_parameter_handles.gyro_offset[1] = param_find("SENS_GYRO_YOFF");
-	_parameter_handles.gyro_offset[2] = param_find("SENS_GYRO_ZOFF");
-	_parameter_handles.gyro_scale[0] = param_find("SENS_GYRO_XSCALE");
-	_parameter_handles.gyro_scale[1] = param_find("SENS_GYRO_YSCALE");
-	_parameter_handles.gyro_scale[2] = param_find("SENS_GYRO_ZSCALE");
-
-	/* accel offsets */
-	_parameter_handles.accel_offset[0] = param_find("SENS_ACC_XOFF");
-	_parameter_handles.accel_offset[1] = param_find("SENS_ACC_YOFF");
-	_parameter_handles.accel_offset[2] = param_find("SENS_ACC_ZOFF");
-	_parameter_handles.accel_scale[0] = param_find("SENS_ACC_XSCALE");
-	_parameter_handles.accel_scale[1] = param_find("SENS_ACC_YSCALE");
-	_parameter_handles.accel_scale[2] = param_find("SENS_ACC_ZSCALE");
+	/* gyro and accel offsets, SENS_GYRO_* / SENS_ACC_* for instance 0, SENS_GYR1_* / SENS_ACC1_* ... for the others */
+	for (unsigned s = 0; s < SENSOR_COUNT_MAX; s++) {
+		char gyro[10], accel[10], str[17];
+
+		if (s == 0) {
+			strcpy(gyro, "SENS_GYRO");
+			strcpy(accel, "SENS_ACC");
+
+		} else {
+			sprintf(gyro, "SENS_GYR%u", s);
+			sprintf(accel, "SENS_ACC%u", s);
+		}
+
+		for (unsigned axis = 0; axis < 3; axis++) {
+			sprintf(str, "%s_%cOFF", gyro, 'X' + axis);
+			_parameter_handles.gyro_offset[s][axis] = param_find(str);
+			sprintf(str, "%s_%cSCALE", gyro, 'X' + axis);
+			_parameter_handles.gyro_scale[s][axis] = param_find(str);
+			sprintf(str, "%s_%cOFF", accel, 'X' + axis);
+			_parameter_handles.accel_offset[s][axis] = param_find(str);
+			sprintf(str, "%s_%cSCALE", accel, 'X' + axis);
+			_parameter_handles.accel_scale[s][axis] = param_find(str);
+		}
+	}
 
 	/* mag offsets */
 	_parameter_handles.mag_offset[0] = param_find("SENS_MAG_XOFF");
@@ -569,6 +644,8 @@ Sensors::Sensors() :
 	_parameter_handles.board_rotation = param_find("SENS_BOARD_ROT");
 	_parameter_handles.external_mag_rotation = param_find("SENS_EXT_MAG_ROT");
 
+	_parameter_handles.drdy = param_find("SENS_DRDY");
+
 	/* fetch initial parameter values */
 	parameters_update();
 }
@@ -712,21 +789,17 @@ Sensors::parameters_update()
 	_rc.function[AUX_4] = _parameters.rc_map_aux4 - 1;
 	_rc.function[AUX_5] = _parameters.rc_map_aux5 - 1;
 
-	/* gyro offsets */
-	param_get(_parameter_handles.gyro_offset[0], &(_parameters.gyro_offset[0]));
-	param_get(_parameter_handles.gyro_offset[1], &(_parameters.gyro_offset[1]));
-	param_get(_parameter_handles.gyro_offset[2], &(_parameters.gyro_offset[2]));
-	param_get(_parameter_handles.gyro_scale[0], &(_parameters.gyro_scale[0]));
-	param_get(_parameter_handles.gyro_scale[1], &(_parameters.gyro_scale[1]));
-	param_get(_parameter_handles.gyro_scale[2], &(_parameters.gyro_scale[2]));
-
-	/* accel offsets */
-	param_get(_parameter_handles.accel_offset[0], &(_parameters.accel_offset[0]));
-	param_get(_parameter_handles.accel_offset[1], &(_parameters.accel_offset[1]));
-	param_get(_parameter_handles.accel_offset[2], &(_parameters.accel_offset[2]));
-	param_get(_parameter_handles.accel_scale[0], &(_parameters.accel_scale[0]));
-	param_get(_parameter_handles.accel_scale[1], &(_parameters.accel_scale[1]));
-	param_get(_parameter_handles.accel_scale[2], &(_parameters.accel_scale[2]));
+	rc_map_update();
+
+	/* gyro and accel offsets */
+	for (unsigned s = 0; s < SENSOR_COUNT_MAX; s++) {
+		for (unsigned axis = 0; axis < 3; axis++) {
+			param_get(_parameter_handles.gyro_offset[s][axis], &(_parameters.gyro_offset[s][axis]));
+			param_get(_parameter_handles.gyro_scale[s][axis], &(_parameters.gyro_scale[s][axis]));
+			param_get(_parameter_handles.accel_offset[s][axis], &(_parameters.accel_offset[s][axis]));
+			param_get(_parameter_handles.accel_scale[s][axis], &(_parameters.accel_scale[s][axis]));
+		}
+	}
 
 	/* mag offsets */
 	param_get(_parameter_handles.mag_offset[0], &(_parameters.mag_offset[0]));
@@ -753,6 +826,7 @@ Sensors::parameters_update()
 
 	param_get(_parameter_handles.board_rotation, &(_parameters.board_rotation));
 	param_get(_parameter_handles.external_mag_rotation, &(_parameters.external_mag_rotation));
+	param_get(_parameter_handles.drdy, &(_parameters.drdy));
 
 	get_rot_matrix((enum Rotation)_parameters.board_rotation, &_board_rotation);
 	get_rot_matrix((enum Rotation)_parameters.external_mag_rotation, &_external_mag_rotation);
@@ -796,6 +870,10 @@ Sensors::accel_init()
 
 #endif
 
+		/* sample on the data-ready line instead, if the driver can */
+		if (_parameters.drdy)
+			ioctl(fd, SENSORIOCSPOLLRATE, SENSOR_POLLRATE_EXTERNAL);
+
 		close(fd);
 	}
 }
@@ -835,6 +913,10 @@ Sensors::gyro_init()
 
 #endif
 
+		/* sample on the data-ready line instead, if the driver can */
+		if (_parameters.drdy)
+			ioctl(fd, SENSORIOCSPOLLRATE, SENSOR_POLLRATE_EXTERNAL);
+
 		close(fd);
 	}
 }
@@ -918,16 +1000,36 @@ Sensors::adc_init()
 	}
 }
 
+unsigned
+Sensors::sensor_select(const int *subs, unsigned current, unsigned calibrated, const char *name)
+{
+	uint64_t last[SENSOR_COUNT_MAX];
+
+	for (unsigned i = 0; i < SENSOR_COUNT_MAX; i++) {
+		if (orb_stat(subs[i], &last[i]) != OK)
+			last[i] = 0;
+	}
+
+	unsigned best = sensor_failover_select(last, current, calibrated, hrt_absolute_time());
+
+	if (best != current)
+		warnx("%s %u timed out, using %s %u", name, current, name, best);
+
+	return best;
+}
+
 void
 Sensors::accel_poll(struct sensor_combined_s &raw)
 {
 	bool accel_updated;
-	orb_check(_accel_sub, &accel_updated);
+
+	_accel_instance = sensor_select(_accel_sub, _accel_instance, _accel_calibrated, "accel");
+	orb_check(_accel_sub[_accel_instance], &accel_updated);
 
 	if (accel_updated) {
 		struct accel_report	accel_report;
 
-		orb_copy(ORB_ID(sensor_accel), _accel_sub, &accel_report);
+		orb_copy(ORB_ID(sensor_accel), _accel_sub[_accel_instance], &accel_report);
 
 		math::Vector<3> vect(accel_report.x, accel_report.y, accel_report.z);
 		vect = _board_rotation * vect;
@@ -948,12 +1050,14 @@ void
 Sensors::gyro_poll(struct sensor_combined_s &raw)
 {
 	bool gyro_updated;
-	orb_check(_gyro_sub, &gyro_updated);
+
+	_gyro_instance = sensor_select(_gyro_sub, _gyro_instance, _gyro_calibrated, "gyro");
+	orb_check(_gyro_sub[_gyro_instance], &gyro_updated);
 
 	if (gyro_updated) {
 		struct gyro_report	gyro_report;
 
-		orb_copy(ORB_ID(sensor_gyro), _gyro_sub, &gyro_report);
+		orb_copy(ORB_ID(sensor_gyro), _gyro_sub[_gyro_instance], &gyro_report);
 
 		math::Vector<3> vect(gyro_report.x, gyro_report.y, gyro_report.z);
 		vect = _board_rotation * vect;
@@ -1089,38 +1193,93 @@ Sensors::parameter_update_poll(bool forced)
 		/* update parameters */
 		parameters_update();
 
-		/* update sensor offsets */
-		int fd = open(GYRO_DEVICE_PATH, 0);
-		struct gyro_scale gscale = {
-			_parameters.gyro_offset[0],
-			_parameters.gyro_scale[0],
-			_parameters.gyro_offset[1],
-			_parameters.gyro_scale[1],
-			_parameters.gyro_offset[2],
-			_parameters.gyro_scale[2],
-		};
+		/*
+		 * Update sensor offsets. Class instance N (/dev/gyroN, /dev/gyro
+		 * for 0) is calibrated by its own parameter set, the drivers
+		 * register it and advertise orb instance N in the same order. Only
+		 * instances that took their calibration are used for failover.
+		 */
+		_gyro_calibrated = 0;
+		_accel_calibrated = 0;
 
-		if (OK != ioctl(fd, GYROIOCSSCALE, (long unsigned int)&gscale))
-			warn("WARNING: failed to set scale / offsets for gyro");
+		for (unsigned s = 0; s < SENSOR_COUNT_MAX; s++) {
+			char path[20];
 
-		close(fd);
+			if (s == 0) {
+				strcpy(path, GYRO_DEVICE_PATH);
 
-		fd = open(ACCEL_DEVICE_PATH, 0);
-		struct accel_scale ascale = {
-			_parameters.accel_offset[0],
-			_parameters.accel_scale[0],
-			_parameters.accel_offset[1],
-			_parameters.accel_scale[1],
-			_parameters.accel_offset[2],
-			_parameters.accel_scale[2],
-		};
+			} else {
+				sprintf(path, "%s%u", GYRO_DEVICE_PATH, s);
+			}
 
-		if (OK != ioctl(fd, ACCELIOCSSCALE, (long unsigned int)&ascale))
-			warn("WARNING: failed to set scale / offsets for accel");
+			int fd = open(path, 0);
 
-		close(fd);
+			/* only the primary is required */
+			if (fd < 0) {
+				if (s == 0)
+					warn("WARNING: no gyro");
+
+				continue;
+			}
+
+			struct gyro_scale gscale = {
+				_parameters.gyro_offset[s][0],
+				_parameters.gyro_scale[s][0],
+				_parameters.gyro_offset[s][1],
+				_parameters.gyro_scale[s][1],
+				_parameters.gyro_offset[s][2],
+				_parameters.gyro_scale[s][2],
+			};
+
+			if (OK != ioctl(fd, GYROIOCSSCALE, (long unsigned int)&gscale)) {
+				warn("WARNING: failed to set scale / offsets for gyro %u", s);
+
+			} else {
+				_gyro_calibrated |= 1 << s;
+			}
+
+			close(fd);
+		}
+
+		for (unsigned s = 0; s < SENSOR_COUNT_MAX; s++) {
+			char path[20];
 
-		fd = open(MAG_DEVICE_PATH, 0);
+			if (s == 0) {
+				strcpy(path, ACCEL_DEVICE_PATH);
+
+			} else {
+				sprintf(path, "%s%u", ACCEL_DEVICE_PATH, s);
+			}
+
+			int fd = open(path, 0);
+
+			if (fd < 0) {
+				if (s == 0)
+					warn("WARNING: no accel");
+
+				continue;
+			}
+
+			struct accel_scale ascale = {
+				_parameters.accel_offset[s][0],
+				_parameters.accel_scale[s][0],
+				_parameters.accel_offset[s][1],
+				_parameters.accel_scale[s][1],
+				_parameters.accel_offset[s][2],
+				_parameters.accel_scale[s][2],
+			};
+
+			if (OK != ioctl(fd, ACCELIOCSSCALE, (long unsigned int)&ascale)) {
+				warn("WARNING: failed to set scale / offsets for accel %u", s);
+
+			} else {
+				_accel_calibrated |= 1 << s;
+			}
+
+			close(fd);
+		}
+
+		int fd = open(MAG_DEVICE_PATH, 0);
 		struct mag_scale mscale = {
 			_parameters.mag_offset[0],
 			_parameters.mag_scale[0],
@@ -1264,6 +1423,95 @@ Sensors::adc_poll(struct sensor_combined_s &raw)
 	}
 }
 
+void
+Sensors::rc_map_update()
+{
+	/* channel scaling, divisions and dead zone handling are resolved here once */
+	for (unsigned i = 0; i < _rc_max_chan_count; i++) {
+		rc_channel_scale &c = _rc_scale[i];
+
+		float dz = (_parameters.dz[i] > 0.0f) ? _parameters.dz[i] : 0.0f;
+
+		c.min = _parameters.min[i];
+		c.max = _parameters.max[i];
+		c.lower = _parameters.trim[i] - dz;
+		c.upper = _parameters.trim[i] + dz;
+
+		/*
+		 * Scale around the mid point differently for lower and upper range,
+		 * as they don't share the same endpoints and slope. If trim is at
+		 * (or the dead zone reaches) an endpoint, that half can never be
+		 * entered after constraining to min..max, and its slope is unused.
+		 */
+		c.lower_scale = _parameters.rev[i] / (c.lower - c.min);
+		c.upper_scale = _parameters.rev[i] / (c.max - c.upper);
+
+		if (!isfinite(c.lower_scale) || c.lower <= c.min)
+			c.lower_scale = 0.0f;
+
+		if (!isfinite(c.upper_scale) || c.upper >= c.max)
+			c.upper_scale = 0.0f;
+	}
+
+	/* scale output, only if the factor is sane */
+	float scale_roll = (isfinite(_parameters.rc_scale_roll) && _parameters.rc_scale_roll > 0.0f) ? _parameters.rc_scale_roll : 1.0f;
+	float scale_pitch = (isfinite(_parameters.rc_scale_pitch) && _parameters.rc_scale_pitch > 0.0f) ? _parameters.rc_scale_pitch : 1.0f;
+	float scale_yaw = (isfinite(_parameters.rc_scale_yaw) && _parameters.rc_scale_yaw > 0.0f) ? _parameters.rc_scale_yaw : 1.0f;
+	float scale_flaps = (isfinite(_parameters.rc_scale_flaps) && _parameters.rc_scale_flaps > 0.0f) ? _parameters.rc_scale_flaps : 1.0f;
+
+	/* functions without a mapping are never written and stay NaN */
+	memset(&_manual_control, 0, sizeof(_manual_control));
+
+	const struct {
+		enum RC_CHANNELS_FUNCTION function;
+		float *output;
+		float sign;
+		float min;
+		float max;
+		float scale;
+	} functions[] = {
+		/* roll input - rolling right is stick-wise and rotation-wise positive */
+		{ ROLL,		&_manual_control.roll,			1.0f,	-1.0f,	1.0f,	scale_roll },
+		/*
+		 * pitch input - stick down is negative, but stick down is pitching up (pos) in NED,
+		 * so reverse sign.
+		 */
+		{ PITCH,	&_manual_control.pitch,			-1.0f,	-1.0f,	1.0f,	scale_pitch },
+		/* yaw input - stick right is positive and positive rotation */
+		{ YAW,		&_manual_control.yaw,			1.0f,	-1.0f,	1.0f,	scale_yaw },
+		{ THROTTLE,	&_manual_control.throttle,		1.0f,	0.0f,	1.0f,	1.0f },
+		{ FLAPS,	&_manual_control.flaps,			1.0f,	-1.0f,	1.0f,	scale_flaps },
+		{ MODE,		&_manual_control.mode_switch,		1.0f,	-1.0f,	1.0f,	1.0f },
+		{ ASSISTED,	&_manual_control.assisted_switch,	1.0f,	-1.0f,	1.0f,	1.0f },
+		{ MISSION,	&_manual_control.mission_switch,	1.0f,	-1.0f,	1.0f,	1.0f },
+		{ RETURN,	&_manual_control.return_switch,		1.0f,	-1.0f,	1.0f,	1.0f },
+		{ AUX_1,	&_manual_control.aux1,			1.0f,	-1.0f,	1.0f,	1.0f },
+		{ AUX_2,	&_manual_control.aux2,			1.0f,	-1.0f,	1.0f,	1.0f },
+		{ AUX_3,	&_manual_control.aux3,			1.0f,	-1.0f,	1.0f,	1.0f },
+		{ AUX_4,	&_manual_control.aux4,			1.0f,	-1.0f,	1.0f,	1.0f },
+		{ AUX_5,	&_manual_control.aux5,			1.0f,	-1.0f,	1.0f,	1.0f },
+	};
+
+	_rc_function_count = 0;
+
+	for (unsigned i = 0; i < sizeof(functions) / sizeof(functions[0]); i++) {
+		*functions[i].output = NAN;
+
+		int channel = _rc.function[functions[i].function];
+
+		if (channel < 0 || channel >= (int)_rc_max_chan_count)
+			continue;
+
+		rc_function_map &f = _rc_functions[_rc_function_count++];
+		f.channel = channel;
+		f.output = functions[i].output;
+		f.sign = functions[i].sign;
+		f.min = functions[i].min;
+		f.max = functions[i].max;
+		f.scale = functions[i].scale;
+	}
+}
+
 void
 Sensors::rc_poll()
 {
@@ -1279,28 +1527,6 @@ Sensors::rc_poll()
 		if (rc_input.rc_lost)
 			return;
 
-		struct manual_control_setpoint_s manual_control;
-		struct actuator_controls_s actuator_group_3;
-
-		/* initialize to default values */
-		manual_control.roll = NAN;
-		manual_control.pitch = NAN;
-		manual_control.yaw = NAN;
-		manual_control.throttle = NAN;
-
-		manual_control.mode_switch = NAN;
-		manual_control.return_switch = NAN;
-		manual_control.assisted_switch = NAN;
-		manual_control.mission_switch = NAN;
-//		manual_control.auto_offboard_input_switch = NAN;
-
-		manual_control.flaps = NAN;
-		manual_control.aux1 = NAN;
-		manual_control.aux2 = NAN;
-		manual_control.aux3 = NAN;
-		manual_control.aux4 = NAN;
-		manual_control.aux5 = NAN;
-
 		/* require at least four channels to consider the signal valid */
 		if (rc_input.channel_count < 4)
 			return;
@@ -1317,6 +1543,8 @@ Sensors::rc_poll()
 			}
 		}
 
+		perf_begin(_rc_perf);
+
 		unsigned channel_limit = rc_input.channel_count;
 
 		if (channel_limit > _rc_max_chan_count)
@@ -1325,150 +1553,60 @@ Sensors::rc_poll()
 		/* we are accepting this message */
 		_rc_last_valid = rc_input.timestamp_last_signal;
 
-		/* Read out values from raw message */
-		for (unsigned int i = 0; i < channel_limit; i++) {
-
-			/*
-			 * 1) Constrain to min/max values, as later processing depends on bounds.
-			 */
-			if (rc_input.values[i] < _parameters.min[i])
-				rc_input.values[i] = _parameters.min[i];
-
-			if (rc_input.values[i] > _parameters.max[i])
-				rc_input.values[i] = _parameters.max[i];
-
-			/*
-			 * 2) Scale around the mid point differently for lower and upper range.
-			 *
-			 * This is necessary as they don't share the same endpoints and slope.
-			 *
-			 * First normalize to 0..1 range with correct sign (below or above center),
-			 * the total range is 2 (-1..1).
-			 * If center (trim) == min, scale to 0..1, if center (trim) == max,
-			 * scale to -1..0.
-			 *
-			 * As the min and max bounds were enforced in step 1), division by zero
-			 * cannot occur, as for the case of center == min or center == max the if
-			 * statement is mutually exclusive with the arithmetic NaN case.
-			 *
-			 * DO NOT REMOVE OR ALTER STEP 1!
-			 */
-			if (rc_input.values[i] > (_parameters.trim[i] + _parameters.dz[i])) {
-				_rc.chan[i].scaled = (rc_input.values[i] - _parameters.trim[i] - _parameters.dz[i]) / (float)(_parameters.max[i] - _parameters.trim[i] - _parameters.dz[i]);
-
-			} else if (rc_input.values[i] < (_parameters.trim[i] - _parameters.dz[i])) {
-				_rc.chan[i].scaled = (rc_input.values[i] - _parameters.trim[i] + _parameters.dz[i]) / (float)(_parameters.trim[i] - _parameters.min[i] - _parameters.dz[i]);
-
-			} else {
-				/* in the configured dead zone, output zero */
-				_rc.chan[i].scaled = 0.0f;
-			}
-
-			_rc.chan[i].scaled *= _parameters.rev[i];
-
-			/* handle any parameter-induced blowups */
-			if (!isfinite(_rc.chan[i].scaled))
-				_rc.chan[i].scaled = 0.0f;
-		}
-
-		_rc.chan_count = rc_input.channel_count;
-		_rc.timestamp = rc_input.timestamp_last_signal;
-
-		manual_control.timestamp = rc_input.timestamp_last_signal;
-
-		/* roll input - rolling right is stick-wise and rotation-wise positive */
-		manual_control.roll = limit_minus_one_to_one(_rc.chan[_rc.function[ROLL]].scaled);
 		/*
-		 * pitch input - stick down is negative, but stick down is pitching up (pos) in NED,
-		 * so reverse sign.
+		 * Read out values from raw message. The same branch-free sequence
+		 * runs for every channel, the scaling was compiled in rc_map_update().
 		 */
-		manual_control.pitch = limit_minus_one_to_one(-1.0f * _rc.chan[_rc.function[PITCH]].scaled);
-		/* yaw input - stick right is positive and positive rotation */
-		manual_control.yaw = limit_minus_one_to_one(_rc.chan[_rc.function[YAW]].scaled);
-		/* throttle input */
-		manual_control.throttle = _rc.chan[_rc.function[THROTTLE]].scaled;
+		for (unsigned i = 0; i < channel_limit; i++) {
+			const rc_channel_scale &c = _rc_scale[i];
 
-		if (manual_control.throttle < 0.0f) manual_control.throttle = 0.0f;
+			/* constrain to min/max values, the slopes are only valid within bounds */
+			float value = rc_input.values[i];
+			value = (value < c.min) ? c.min : value;
+			value = (value > c.max) ? c.max : value;
 
-		if (manual_control.throttle > 1.0f) manual_control.throttle = 1.0f;
+			/* in the configured dead zone both terms, and the output, are zero */
+			float above = value - c.upper;
+			float below = value - c.lower;
+			above = (above > 0.0f) ? above : 0.0f;
+			below = (below < 0.0f) ? below : 0.0f;
 
-		/* scale output */
-		if (isfinite(_parameters.rc_scale_roll) && _parameters.rc_scale_roll > 0.0f) {
-			manual_control.roll *= _parameters.rc_scale_roll;
+			_rc.chan[i].scaled = above * c.upper_scale + below * c.lower_scale;
 		}
 
-		if (isfinite(_parameters.rc_scale_pitch) && _parameters.rc_scale_pitch > 0.0f) {
-			manual_control.pitch *= _parameters.rc_scale_pitch;
-		}
+		_rc.chan_count = rc_input.channel_count;
+		_rc.timestamp = rc_input.timestamp_last_signal;
 
-		if (isfinite(_parameters.rc_scale_yaw) && _parameters.rc_scale_yaw > 0.0f) {
-			manual_control.yaw *= _parameters.rc_scale_yaw;
-		}
+		_manual_control.timestamp = rc_input.timestamp_last_signal;
 
-		/* flaps */
-		if (_rc.function[FLAPS] >= 0) {
+		/* mapped functions, a channel the receiver did not send reads as NaN */
+		for (unsigned i = 0; i < _rc_function_count; i++) {
+			const rc_function_map &f = _rc_functions[i];
 
-			manual_control.flaps = limit_minus_one_to_one(_rc.chan[_rc.function[FLAPS]].scaled);
+			if (f.channel < channel_limit) {
+				float value = f.sign * _rc.chan[f.channel].scaled;
+				value = (value < f.min) ? f.min : value;
+				value = (value > f.max) ? f.max : value;
+				*f.output = value * f.scale;
 
-			if (isfinite(_parameters.rc_scale_flaps) && _parameters.rc_scale_flaps > 0.0f) {
-				manual_control.flaps *= _parameters.rc_scale_flaps;
+			} else {
+				*f.output = NAN;
 			}
 		}
 
-		/* mode switch input */
-		if (_rc.function[MODE] >= 0) {
-			manual_control.mode_switch = limit_minus_one_to_one(_rc.chan[_rc.function[MODE]].scaled);
-		}
-
-		/* assisted switch input */
-		if (_rc.function[ASSISTED] >= 0) {
-			manual_control.assisted_switch = limit_minus_one_to_one(_rc.chan[_rc.function[ASSISTED]].scaled);
-		}
-
-		/* mission switch input */
-		if (_rc.function[MISSION] >= 0) {
-			manual_control.mission_switch = limit_minus_one_to_one(_rc.chan[_rc.function[MISSION]].scaled);
-		}
-
-		/* return switch input */
-		if (_rc.function[RETURN] >= 0) {
-			manual_control.return_switch = limit_minus_one_to_one(_rc.chan[_rc.function[RETURN]].scaled);
-		}
-
-//		if (_rc.function[OFFBOARD_MODE] >= 0) {
-//			manual_control.auto_offboard_input_switch = limit_minus_one_to_one(_rc.chan[_rc.function[OFFBOARD_MODE]].scaled);
-//		}
-
-		/* aux functions, only assign if valid mapping is present */
-		if (_rc.function[AUX_1] >= 0) {
-			manual_control.aux1 = limit_minus_one_to_one(_rc.chan[_rc.function[AUX_1]].scaled);
-		}
-
-		if (_rc.function[AUX_2] >= 0) {
-			manual_control.aux2 = limit_minus_one_to_one(_rc.chan[_rc.function[AUX_2]].scaled);
-		}
-
-		if (_rc.function[AUX_3] >= 0) {
-			manual_control.aux3 = limit_minus_one_to_one(_rc.chan[_rc.function[AUX_3]].scaled);
-		}
-
-		if (_rc.function[AUX_4] >= 0) {
-			manual_control.aux4 = limit_minus_one_to_one(_rc.chan[_rc.function[AUX_4]].scaled);
-		}
+		/* copy from mapped manual control to control group 3 */
+		struct actuator_controls_s actuator_group_3;
 
-		if (_rc.function[AUX_5] >= 0) {
-			manual_control.aux5 = limit_minus_one_to_one(_rc.chan[_rc.function[AUX_5]].scaled);
-		}
+		actuator_group_3.control[0] = _manual_control.roll;
+		actuator_group_3.control[1] = _manual_control.pitch;
+		actuator_group_3.control[2] = _manual_control.yaw;
+		actuator_group_3.control[3] = _manual_control.throttle;
+		actuator_group_3.control[4] = _manual_control.flaps;
+		actuator_group_3.control[5] = _manual_control.aux1;
+		actuator_group_3.control[6] = _manual_control.aux2;
+		actuator_group_3.control[7] = _manual_control.aux3;
 
-		/* copy from mapped manual control to control group 3 */
-		actuator_group_3.control[0] = manual_control.roll;
-		actuator_group_3.control[1] = manual_control.pitch;
-		actuator_group_3.control[2] = manual_control.yaw;
-		actuator_group_3.control[3] = manual_control.throttle;
-		actuator_group_3.control[4] = manual_control.flaps;
-		actuator_group_3.control[5] = manual_control.aux1;
-		actuator_group_3.control[6] = manual_control.aux2;
-		actuator_group_3.control[7] = manual_control.aux3;
+		perf_end(_rc_perf);
 
 		/* check if ready for publishing */
 		if (_rc_pub > 0) {
@@ -1481,12 +1619,15 @@ Sensors::rc_poll()
 
 		/* check if ready for publishing */
 		if (_manual_control_pub > 0) {
-			orb_publish(ORB_ID(manual_control_setpoint), _manual_control_pub, &manual_control);
+			orb_publish(ORB_ID(manual_control_setpoint), _manual_control_pub, &_manual_control);
 
 		} else {
-			_manual_control_pub = orb_advertise(ORB_ID(manual_control_setpoint), &manual_control);
+			_manual_control_pub = orb_advertise(ORB_ID(manual_control_setpoint), &_manual_control);
 		}
 
+		/* time from the receiver frame to the setpoint being available */
+		perf_latency(_rc_latency_perf, hrt_absolute_time() - rc_input.timestamp_last_signal);
+
 		/* check if ready for publishing */
 		if (_actuator_group_3_pub > 0) {
 			orb_publish(ORB_ID(actuator_controls_3), _actuator_group_3_pub, &actuator_group_3);
@@ -1515,11 +1656,23 @@ Sensors::task_main()
 	baro_init();
 	adc_init();
 
+	boot_trace_mark("sensors_init");
+
 	/*
 	 * do subscriptions
 	 */
-	_gyro_sub = orb_subscribe(ORB_ID(sensor_gyro));
-	_accel_sub = orb_subscribe(ORB_ID(sensor_accel));
+	for (unsigned i = 0; i < SENSOR_COUNT_MAX; i++) {
+		_gyro_sub[i] = orb_subscribe_multi(ORB_ID(sensor_gyro), i);
+		_accel_sub[i] = orb_subscribe_multi(ORB_ID(sensor_accel), i);
+
+		/* rate limit gyro to 250 Hz (the gyro signal is lowpassed accordingly earlier) */
+		orb_set_interval(_gyro_sub[i], 4);
+	}
+
+	/*
+	 * The mag is not failed over: the primary one may be external, with
+	 * its own rotation and calibration.
+	 */
 	_mag_sub = orb_subscribe(ORB_ID(sensor_mag));
 	_rc_sub = orb_subscribe(ORB_ID(input_rc));
 	_baro_sub = orb_subscribe(ORB_ID(sensor_baro));
@@ -1531,9 +1684,6 @@ Sensors::task_main()
 	/* rate limit vehicle status updates to 5Hz */
 	orb_set_interval(_vcontrol_mode_sub, 200);
 
-	/* rate limit gyro to 250 Hz (the gyro signal is lowpassed accordingly earlier) */
-	orb_set_interval(_gyro_sub, 4);
-
 	/*
 	 * do advertisements
 	 */
@@ -1563,21 +1713,31 @@ Sensors::task_main()
 	/* advertise the sensor_combined topic and make the initial publication */
 	_sensor_pub = orb_advertise(ORB_ID(sensor_combined), &raw);
 
+	boot_trace_mark("sensors_publish");
+
 	/* wakeup source(s) */
-	struct pollfd fds[1];
+	struct pollfd fds[2];
 
 	/* use the gyro to pace output - XXX BROKEN if we are using the L3GD20 */
-	fds[0].fd = _gyro_sub;
 	fds[0].events = POLLIN;
 
+	/* handle r/c input at the receiver frame rate rather than on the next gyro update */
+	fds[1].fd = _rc_sub;
+	fds[1].events = POLLIN;
+
 	while (!_task_should_exit) {
 
+		/* follow the gyro in use */
+		fds[0].fd = _gyro_sub[_gyro_instance];
+
 		/* wait for up to 100ms for data */
 		int pret = poll(&fds[0], (sizeof(fds) / sizeof(fds[0])), 100);
 
-		/* timed out - periodic check for _task_should_exit, etc. */
-		if (pret == 0)
+		/* timed out - periodic check for _task_should_exit, and whether the gyro has failed */
+		if (pret == 0) {
+			_gyro_instance = sensor_select(_gyro_sub, _gyro_instance, _gyro_calibrated, "gyro");
 			continue;
+		}
 
 		/* this is undesirable but not much we can do - might want to flag unhappy status */
 		if (pret < 0) {
@@ -1585,6 +1745,12 @@ Sensors::task_main()
 			continue;
 		}
 
+		/* only r/c input changed */
+		if (!(fds[0].revents & POLLIN)) {
+			rc_poll();
+			continue;
+		}
+
 		perf_begin(_loop_perf);
 
 		/* check vehicle status for changes to publication state */
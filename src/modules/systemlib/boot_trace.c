@@ -0,0 +1,114 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file boot_trace.c
+ * Boot time trace.
+ */
+
+#include <nuttx/config.h>
+#include <nuttx/arch.h>
+#include <stdio.h>
+#include <string.h>
+#include <drivers/drv_hrt.h>
+
+#include "boot_trace.h"
+
+struct boot_trace_mark_s {
+	hrt_abstime	time;
+	char		label[BOOT_TRACE_LABEL_LEN];
+};
+
+static struct boot_trace_mark_s	boot_trace_marks[BOOT_TRACE_MAX];
+static unsigned			boot_trace_count;
+static unsigned			boot_trace_dropped;
+
+void
+boot_trace_mark(const char *label)
+{
+	hrt_abstime now = hrt_absolute_time();
+
+	irqstate_t flags = irqsave();
+
+	if (boot_trace_count < BOOT_TRACE_MAX) {
+		struct boot_trace_mark_s *mark = &boot_trace_marks[boot_trace_count];
+
+		mark->time = now;
+		strncpy(mark->label, label, sizeof(mark->label) - 1);
+		mark->label[sizeof(mark->label) - 1] = '\0';
+
+		boot_trace_count++;
+
+	} else {
+		boot_trace_dropped++;
+	}
+
+	irqrestore(flags);
+}
+
+uint64_t
+boot_trace_find(const char *label)
+{
+	/* marks are never removed, entries below the count are stable */
+	unsigned count = boot_trace_count;
+
+	for (unsigned i = 0; i < count; i++) {
+		if (!strncmp(boot_trace_marks[i].label, label, BOOT_TRACE_LABEL_LEN - 1))
+			return boot_trace_marks[i].time;
+	}
+
+	return 0;
+}
+
+void
+boot_trace_print(void)
+{
+	unsigned count = boot_trace_count;
+	hrt_abstime last = 0;
+
+	printf("   time ms  delta ms  mark\n");
+
+	for (unsigned i = 0; i < count; i++) {
+		struct boot_trace_mark_s *mark = &boot_trace_marks[i];
+
+		printf("%10u %9u  %s\n",
+		       (unsigned)(mark->time / 1000),
+		       (unsigned)((mark->time - last) / 1000),
+		       mark->label);
+
+		last = mark->time;
+	}
+
+	if (boot_trace_dropped > 0)
+		printf("%u marks dropped\n", boot_trace_dropped);
+}
@@ -0,0 +1,82 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file boot_trace.h
+ * Boot time trace.
+ *
+ * Startup scripts and applications record named marks while the system boots;
+ * the marks are kept with their hrt timestamp and can be listed with the
+ * boottrace command. Marks also serve to synchronise scripts with apps or
+ * scripts that were started in the background.
+ */
+
+#ifndef _SYSTEMLIB_BOOT_TRACE_H
+#define _SYSTEMLIB_BOOT_TRACE_H
+
+#include <stdint.h>
+
+__BEGIN_DECLS
+
+/** maximum number of marks kept, later marks are dropped */
+#define BOOT_TRACE_MAX		48
+
+/** maximum mark label length, including the terminator */
+#define BOOT_TRACE_LABEL_LEN	24
+
+/**
+ * Record a mark.
+ *
+ * Safe to call from any task.
+ *
+ * @param label			The mark label, truncated to BOOT_TRACE_LABEL_LEN - 1 characters.
+ */
+__EXPORT extern void		boot_trace_mark(const char *label);
+
+/**
+ * Find a mark.
+ *
+ * @param label			The mark label.
+ * @return			The hrt time of the first mark with this label, or 0 if
+ *				there is no such mark.
+ */
+__EXPORT extern uint64_t	boot_trace_find(const char *label);
+
+/**
+ * Print all marks with their time since boot and since the previous mark.
+ */
+__EXPORT extern void		boot_trace_print(void);
+
+__END_DECLS
+
+#endif
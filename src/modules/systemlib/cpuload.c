@@ -43,6 +43,7 @@
  */
 #include <nuttx/config.h>
 #include <nuttx/sched.h>
+#include <nuttx/arch.h>
 
 #include <sys/types.h>
 #include <stdint.h>
@@ -53,6 +54,9 @@
 #include <debug.h>
 
 #include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
 
 #include <arch/board/board.h>
 #include <drivers/drv_hrt.h>
@@ -61,6 +65,10 @@
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION
 
+#if (CONFIG_MAX_TASKS & (CONFIG_MAX_TASKS - 1)) != 0
+#error "CONFIG_MAX_TASKS must be a power of two for the task slot mapping"
+#endif
+
 __EXPORT void sched_note_start(FAR struct tcb_s *tcb);
 __EXPORT void sched_note_stop(FAR struct tcb_s *tcb);
 __EXPORT void sched_note_switch(FAR struct tcb_s *pFromTcb, FAR struct tcb_s *pToTcb);
@@ -78,6 +86,8 @@ void cpuload_initialize_once()
 		system_load.tasks[i].valid = false;
 	}
 
+	system_load.trace.events = NULL;
+
 	uint64_t now = hrt_absolute_time();
 
 	int static_tasks_count = 2;	// there are at least 2 threads that should be initialized statically - "idle" and "init"
@@ -104,66 +114,136 @@ void cpuload_initialize_once()
 
 void sched_note_start(FAR struct tcb_s *tcb)
 {
-	/* search first free slot */
-	int i;
+	struct system_load_taskinfo_s *task = &system_load.tasks[CPULOAD_SLOT(tcb->pid)];
+
+	task->start_time = hrt_absolute_time();
+	task->total_runtime = 0;
+	task->curr_start_time = 0;
+	task->tcb = tcb;
+	task->valid = true;
+	system_load.total_count++;
+}
 
-	for (i = 1; i < CONFIG_MAX_TASKS; i++) {
-		if (!system_load.tasks[i].valid) {
-			/* slot is available */
-			system_load.tasks[i].start_time = hrt_absolute_time();
-			system_load.tasks[i].total_runtime = 0;
-			system_load.tasks[i].curr_start_time = 0;
-			system_load.tasks[i].tcb = tcb;
-			system_load.tasks[i].valid = true;
-			system_load.total_count++;
-			break;
-		}
+void sched_note_stop(FAR struct tcb_s *tcb)
+{
+	struct system_load_taskinfo_s *task = &system_load.tasks[CPULOAD_SLOT(tcb->pid)];
+
+	if (task->valid && task->tcb == tcb) {
+		/* mark slot as free */
+		task->valid = false;
+		task->total_runtime = 0;
+		task->curr_start_time = 0;
+		task->tcb = NULL;
+		system_load.total_count--;
 	}
 }
 
-void sched_note_stop(FAR struct tcb_s *tcb)
+void sched_note_switch(FAR struct tcb_s *pFromTcb, FAR struct tcb_s *pToTcb)
 {
-	int i;
+	uint64_t new_time = hrt_absolute_time();
+
+	/* task ending its current scheduling run */
+	struct system_load_taskinfo_s *from = &system_load.tasks[CPULOAD_SLOT(pFromTcb->pid)];
+	from->total_runtime += new_time - from->curr_start_time;
+
+	/* task starting its next scheduling run */
+	system_load.tasks[CPULOAD_SLOT(pToTcb->pid)].curr_start_time = new_time;
+
+	/* called with interrupts disabled, the ring can not change underneath */
+	struct system_load_switch_s *events = system_load.trace.events;
+
+	if (events != NULL) {
+		struct system_load_switch_s *e = &events[system_load.trace.next];
+		e->time = (uint32_t)new_time;
+		e->from = pFromTcb->pid;
+		e->to = pToTcb->pid;
 
-	for (i = 1; i < CONFIG_MAX_TASKS; i++) {
-		if (system_load.tasks[i].tcb->pid == tcb->pid) {
-			/* mark slot as fee */
-			system_load.tasks[i].valid = false;
-			system_load.tasks[i].total_runtime = 0;
-			system_load.tasks[i].curr_start_time = 0;
-			system_load.tasks[i].tcb = NULL;
-			system_load.total_count--;
-			break;
+		if (++system_load.trace.next >= system_load.trace.size) {
+			system_load.trace.next = 0;
 		}
+
+		system_load.trace.count++;
 	}
 }
 
-void sched_note_switch(FAR struct tcb_s *pFromTcb, FAR struct tcb_s *pToTcb)
+int cpuload_trace_start(unsigned size)
 {
-	uint64_t new_time = hrt_absolute_time();
+	if (system_load.trace.events != NULL) {
+		return -EBUSY;
+	}
 
-	/* Kind of inefficient: find both tasks and update times */
-	uint8_t both_found = 0;
+	struct system_load_switch_s *events = malloc(size * sizeof(struct system_load_switch_s));
 
-	for (int i = 0; i < CONFIG_MAX_TASKS; i++) {
-		/* Task ending its current scheduling run */
-		if (system_load.tasks[i].tcb->pid == pFromTcb->pid) {
-			//if (system_load.tasks[i].curr_start_time != 0)
-			{
-				system_load.tasks[i].total_runtime += new_time - system_load.tasks[i].curr_start_time;
+	if (size == 0 || events == NULL) {
+		free(events);
+		return -ENOMEM;
+	}
+
+	irqstate_t flags = irqsave();
+	system_load.trace.size = size;
+	system_load.trace.next = 0;
+	system_load.trace.count = 0;
+	system_load.trace.events = events;
+	irqrestore(flags);
+
+	return OK;
+}
+
+int cpuload_trace_stop(const char *path)
+{
+	/* detach the ring first, the writes below can take a while */
+	irqstate_t flags = irqsave();
+	struct system_load_switch_s *events = system_load.trace.events;
+	struct system_load_trace_s trace = system_load.trace;
+	system_load.trace.events = NULL;
+	irqrestore(flags);
+
+	if (events == NULL) {
+		return -ENOENT;
+	}
+
+	int ret = OK;
+
+	if (path != NULL) {
+		FILE *f = fopen(path, "w");
+
+		if (f == NULL) {
+			ret = -errno;
+
+		} else {
+			/* names of the live tasks, exited tasks only show up by PID */
+			for (int i = 0; i < CONFIG_MAX_TASKS; i++) {
+				if (system_load.tasks[i].valid && system_load.tasks[i].tcb != NULL) {
+#if CONFIG_TASK_NAME_SIZE > 0
+					fprintf(f, "task,%d,%s\n", system_load.tasks[i].tcb->pid, system_load.tasks[i].tcb->name);
+#else
+					fprintf(f, "task,%d,%d\n", system_load.tasks[i].tcb->pid, system_load.tasks[i].tcb->pid);
+#endif
+				}
 			}
-			both_found++;
 
-		} else if (system_load.tasks[i].tcb->pid == pToTcb->pid) {
-			system_load.tasks[i].curr_start_time = new_time;
-			both_found++;
-		}
+			/* oldest event first */
+			unsigned n = (trace.count < trace.size) ? trace.count : trace.size;
+			unsigned idx = (trace.count < trace.size) ? 0 : trace.next;
 
-		/* Do only iterate as long as needed */
-		if (both_found == 2) {
-			break;
+			for (unsigned i = 0; i < n; i++) {
+				fprintf(f, "switch,%u,%d,%d\n", (unsigned)events[idx].time, events[idx].from, events[idx].to);
+
+				if (++idx >= trace.size) {
+					idx = 0;
+				}
+			}
+
+			if (trace.count > trace.size) {
+				fprintf(f, "dropped,%u\n", trace.count - trace.size);
+			}
+
+			fclose(f);
 		}
 	}
+
+	free(events);
+	return ret;
 }
 
 #endif /* CONFIG_SCHED_INSTRUMENTATION */
@@ -47,9 +47,32 @@ struct system_load_taskinfo_s {
 	bool valid;						///< Task is currently active / valid
 };
 
+/**
+ * Slot of a task in system_load.tasks.
+ *
+ * NuttX hands out PIDs such that the lower bits are unique among the live
+ * tasks (its own PID hash table works the same way), so the slot is found
+ * without searching.
+ */
+#define CPULOAD_SLOT(_pid)	((_pid) & (CONFIG_MAX_TASKS - 1))
+
+struct system_load_switch_s {
+	uint32_t time;				///< Lower 32 bits of the switch time in microseconds
+	int16_t from;				///< PID of the task giving up the CPU
+	int16_t to;				///< PID of the task taking over
+};
+
+struct system_load_trace_s {
+	struct system_load_switch_s *events;	///< Ring of context switches, NULL if not tracing
+	unsigned size;				///< Number of events the ring holds
+	unsigned next;				///< Index the next event is written to
+	unsigned count;				///< Events recorded since the start, may exceed size
+};
+
 struct system_load_s {
 	uint64_t start_time;			///< Global start time of measurements
 	struct system_load_taskinfo_s tasks[CONFIG_MAX_TASKS];
+	struct system_load_trace_s trace;
 	uint8_t initialized;
 	int total_count;
 	int running_count;
@@ -60,6 +83,25 @@ __EXPORT extern struct system_load_s system_load;
 
 __EXPORT void cpuload_initialize_once(void);
 
+/**
+ * Start recording context switches into a ring.
+ *
+ * @param size		Number of switches the ring holds, the oldest are overwritten.
+ * @return		OK on success, -EBUSY if already tracing, -ENOMEM if the ring can not be allocated.
+ */
+__EXPORT int cpuload_trace_start(unsigned size);
+
+/**
+ * Stop recording context switches.
+ *
+ * The trace is written as text lines "task,<pid>,<name>" for the live tasks,
+ * followed by "switch,<time us>,<from pid>,<to pid>", oldest first.
+ *
+ * @param path		File to write the trace to, or NULL to discard it.
+ * @return		OK on success, -ENOENT if not tracing, negative errno if the file could not be written.
+ */
+__EXPORT int cpuload_trace_stop(const char *path);
+
 __END_DECLS
 
 #endif
@@ -143,6 +143,40 @@ Mixer::skipline(const char *buf, unsigned &buflen)
 	return nullptr;
 }
 
+const char *
+Mixer::findrecord(const char *buf, unsigned &buflen, uint8_t tag, unsigned &len)
+{
+	if ((buflen < MIXER_REC_HDR_SIZE) || ((uint8_t)buf[0] != tag))
+		return nullptr;
+
+	len = (uint8_t)buf[1];
+
+	/* the record may have been split, wait for the rest */
+	if (buflen < MIXER_REC_HDR_SIZE + len)
+		return nullptr;
+
+	buflen -= MIXER_REC_HDR_SIZE + len;
+	return buf + MIXER_REC_HDR_SIZE;
+}
+
+float
+Mixer::record_value(const char *buf)
+{
+	int16_t value = (uint8_t)buf[0] | ((uint8_t)buf[1] << 8);
+
+	return value / 10000.0f;
+}
+
+void
+Mixer::record_scaler(const char *buf, mixer_scaler_s &scaler)
+{
+	scaler.negative_scale	= record_value(&buf[0]);
+	scaler.positive_scale	= record_value(&buf[2]);
+	scaler.offset		= record_value(&buf[4]);
+	scaler.min_output	= record_value(&buf[6]);
+	scaler.max_output	= record_value(&buf[8]);
+}
+
 /****************************************************************************/
 
 NullMixer::NullMixer() :
@@ -194,3 +228,14 @@ NullMixer::from_text(const char *buf, unsigned &buflen)
 
 	return nm;
 }
+
+NullMixer *
+NullMixer::from_record(const char *buf, unsigned &buflen)
+{
+	unsigned len;
+
+	if (findrecord(buf, buflen, MIXER_REC_NULL, len) == nullptr)
+		return nullptr;
+
+	return new NullMixer;
+}
@@ -230,6 +230,36 @@ protected:
 	 */
 	static const char *		skipline(const char *buf, unsigned &buflen);
 
+	/**
+	 * Consume a compiled record
+	 *
+	 * @param buf			The buffer to operate on.
+	 * @param buflen		length of the buffer, adjusted to reflect
+	 *				the bytes consumed.
+	 * @param tag			record tag expected.
+	 * @param len			set to the length of the record payload.
+	 * @return			The record payload, or nullptr if the tag
+	 *				does not match or the record is incomplete.
+	 */
+	static const char *		findrecord(const char *buf, unsigned &buflen, uint8_t tag, unsigned &len);
+
+	/**
+	 * Read a value from a compiled record
+	 *
+	 * @param buf			Pointer to the little-endian value, no
+	 *				alignment required.
+	 * @return			The value in units of 1/10000.
+	 */
+	static float			record_value(const char *buf);
+
+	/**
+	 * Read a scaler from a compiled record
+	 *
+	 * @param buf			Pointer to the MIXER_REC_SCALER_SIZE bytes of the scaler.
+	 * @param scaler		The scaler to fill in.
+	 */
+	static void			record_scaler(const char *buf, mixer_scaler_s &scaler);
+
 private:
 };
 
@@ -335,6 +365,20 @@ public:
 	 */
 	static NullMixer		*from_text(const char *buf, unsigned &buflen);
 
+	/**
+	 * Factory method.
+	 *
+	 * Given a pointer to a buffer starting with a compiled record of the
+	 * mixer, returns a pointer to a new instance of the mixer.
+	 *
+	 * @param buf			Buffer containing the compiled record.
+	 * @param buflen		Length of the buffer in bytes, adjusted
+	 *				to reflect the bytes consumed.
+	 * @return			A new NullMixer instance, or nullptr
+	 *				if the record is bad or incomplete.
+	 */
+	static NullMixer		*from_record(const char *buf, unsigned &buflen);
+
 	virtual unsigned		mix(float *outputs, unsigned space);
 	virtual void			groups_required(uint32_t &groups);
 };
@@ -380,6 +424,26 @@ public:
 			const char *buf,
 			unsigned &buflen);
 
+	/**
+	 * Factory method with full external configuration.
+	 *
+	 * Given a pointer to a buffer starting with a compiled record of the
+	 * mixer, returns a pointer to a new instance of the mixer.
+	 *
+	 * @param control_cb		The callback to invoke when fetching a
+	 *				control value.
+	 * @param cb_handle		Handle passed to the control callback.
+	 * @param buf			Buffer containing the compiled record.
+	 * @param buflen		Length of the buffer in bytes, adjusted
+	 *				to reflect the bytes consumed.
+	 * @return			A new SimpleMixer instance, or nullptr
+	 *				if the record is bad or incomplete.
+	 */
+	static SimpleMixer		*from_record(Mixer::ControlCallback control_cb,
+			uintptr_t cb_handle,
+			const char *buf,
+			unsigned &buflen);
+
 	/**
 	 * Factory method for PWM/PPM input to internal float representation.
 	 *
@@ -509,6 +573,26 @@ public:
 			const char *buf,
 			unsigned &buflen);
 
+	/**
+	 * Factory method.
+	 *
+	 * Given a pointer to a buffer starting with a compiled record of the
+	 * mixer, returns a pointer to a new instance of the mixer.
+	 *
+	 * @param control_cb		The callback to invoke when fetching a
+	 *				control value.
+	 * @param cb_handle		Handle passed to the control callback.
+	 * @param buf			Buffer containing the compiled record.
+	 * @param buflen		Length of the buffer in bytes, adjusted
+	 *				to reflect the bytes consumed.
+	 * @return			A new MultirotorMixer instance, or nullptr
+	 *				if the record is bad or incomplete.
+	 */
+	static MultirotorMixer		*from_record(Mixer::ControlCallback control_cb,
+			uintptr_t cb_handle,
+			const char *buf,
+			unsigned &buflen);
+
 	virtual unsigned		mix(float *outputs, unsigned space);
 	virtual void			groups_required(uint32_t &groups);
 
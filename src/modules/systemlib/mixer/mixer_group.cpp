@@ -154,7 +154,7 @@ MixerGroup::load_from_buf(const char *buf, unsigned &buflen)
 		/*
 		 * Use the next character as a hint to decide which mixer class to construct.
 		 */
-		switch (*p) {
+		switch ((uint8_t)*p) {
 		case 'Z':
 			m = NullMixer::from_text(p, resid);
 			break;
@@ -167,6 +167,18 @@ MixerGroup::load_from_buf(const char *buf, unsigned &buflen)
 			m = MultirotorMixer::from_text(_control_cb, _cb_handle, p, resid);
 			break;
 
+		case MIXER_REC_NULL:
+			m = NullMixer::from_record(p, resid);
+			break;
+
+		case MIXER_REC_SIMPLE:
+			m = SimpleMixer::from_record(_control_cb, _cb_handle, p, resid);
+			break;
+
+		case MIXER_REC_MULTIROTOR:
+			m = MultirotorMixer::from_record(_control_cb, _cb_handle, p, resid);
+			break;
+
 		default:
 			/* it's probably junk or whitespace, skip a byte and retry */
 			buflen--;
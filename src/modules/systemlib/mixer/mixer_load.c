@@ -41,6 +41,9 @@
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <systemlib/err.h>
+
+#include <drivers/drv_mixer.h>
 
 #include "mixer_load.h"
 
@@ -56,6 +59,26 @@ int load_mixer_file(const char *fname, char *buf, unsigned maxlen)
 		return -1;
 	}
 
+	/* compiled mixers are loaded as they are */
+	int c = fgetc(fp);
+
+	if (c != EOF && (c & MIXER_REC_FLAG)) {
+		buf[0] = c;
+		size_t len = 1 + fread(&buf[1], 1, maxlen - 1, fp);
+
+		fclose(fp);
+
+		if (len >= maxlen) {
+			warnx("mixer too long");
+			return -1;
+		}
+
+		buf[len] = '\0';
+		return 0;
+	}
+
+	ungetc(c, fp);
+
 	/* read valid lines from the file into a buffer */
 	buf[0] = '\0';
 	for (;;) {
@@ -90,6 +113,7 @@ int load_mixer_file(const char *fname, char *buf, unsigned maxlen)
 		/* if the line is too long to fit in the buffer, bail */
 		if ((strlen(line) + strlen(buf) + 1) >= maxlen) {
 			warnx("line too long");
+			fclose(fp);
 			return -1;
 		}
 
@@ -97,6 +121,24 @@ int load_mixer_file(const char *fname, char *buf, unsigned maxlen)
 		strcat(buf, line);
 	}
 
+	fclose(fp);
 	return 0;
 }
 
+unsigned mixer_buf_length(const char *buf, unsigned maxlen)
+{
+	unsigned len = 0;
+
+	while (len < maxlen && buf[len] != '\0') {
+		if ((buf[len] & MIXER_REC_FLAG) && (len + 1) < maxlen) {
+			/* compiled record, skip it including any zeros it contains */
+			len += MIXER_REC_HDR_SIZE + (uint8_t)buf[len + 1];
+
+		} else {
+			len++;
+		}
+	}
+
+	return (len < maxlen) ? len : maxlen;
+}
+
@@ -44,8 +44,30 @@
 
 __BEGIN_DECLS
 
+/**
+ * Load a mixer file into a NUL terminated buffer for MIXERIOCLOADBUF.
+ *
+ * Text files are reduced to the definition lines, compiled files are
+ * loaded as they are.
+ *
+ * @param fname		The mixer file.
+ * @param buf		The buffer to load the file to.
+ * @param maxlen	Size of the buffer.
+ * @return		Zero on success, -1 on error.
+ */
 __EXPORT int load_mixer_file(const char *fname, char *buf, unsigned maxlen);
 
+/**
+ * Length of a mixer buffer as passed with MIXERIOCLOADBUF.
+ *
+ * Like strnlen(), but skips over compiled records which may contain zeros.
+ *
+ * @param buf		The mixer buffer.
+ * @param maxlen	Maximum length to scan.
+ * @return		The length of the buffer without the terminating NUL.
+ */
+__EXPORT unsigned mixer_buf_length(const char *buf, unsigned maxlen);
+
 __END_DECLS
 
 #endif
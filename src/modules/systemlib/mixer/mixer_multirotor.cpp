@@ -273,6 +273,35 @@ MultirotorMixer::from_text(Mixer::ControlCallback control_cb, uintptr_t cb_handl
 		       s[3] / 10000.0f);
 }
 
+MultirotorMixer *
+MultirotorMixer::from_record(Mixer::ControlCallback control_cb, uintptr_t cb_handle, const char *buf, unsigned &buflen)
+{
+	unsigned len;
+
+	buf = findrecord(buf, buflen, MIXER_REC_MULTIROTOR, len);
+
+	if (buf == nullptr) {
+		debug("multirotor record incomplete");
+		return nullptr;
+	}
+
+	if ((len != 9) || ((uint8_t)buf[0] >= MultirotorMixer::MAX_GEOMETRY)) {
+		debug("bad multirotor record");
+		return nullptr;
+	}
+
+	debug("adding multirotor mixer %u", (uint8_t)buf[0]);
+
+	return new MultirotorMixer(
+		       control_cb,
+		       cb_handle,
+		       (MultirotorMixer::Geometry)(uint8_t)buf[0],
+		       record_value(&buf[1]),
+		       record_value(&buf[3]),
+		       record_value(&buf[5]),
+		       record_value(&buf[7]));
+}
+
 unsigned
 MultirotorMixer::mix(float *outputs, unsigned space)
 {
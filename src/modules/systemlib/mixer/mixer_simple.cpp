@@ -204,6 +204,64 @@ out:
 	return sm;
 }
 
+SimpleMixer *
+SimpleMixer::from_record(Mixer::ControlCallback control_cb, uintptr_t cb_handle, const char *buf, unsigned &buflen)
+{
+	SimpleMixer *sm = nullptr;
+	mixer_simple_s *mixinfo = nullptr;
+	unsigned inputs;
+	unsigned len;
+
+	buf = findrecord(buf, buflen, MIXER_REC_SIMPLE, len);
+
+	if (buf == nullptr) {
+		debug("simple record incomplete");
+		goto out;
+	}
+
+	inputs = (len > 0) ? (uint8_t)buf[0] : 0;
+
+	if (len != 1 + MIXER_REC_SCALER_SIZE + inputs * (2 + MIXER_REC_SCALER_SIZE)) {
+		debug("simple record length %u does not match %u input(s)", len, inputs);
+		goto out;
+	}
+
+	mixinfo = (mixer_simple_s *)malloc(MIXER_SIMPLE_SIZE(inputs));
+
+	if (mixinfo == nullptr) {
+		debug("could not allocate memory for mixer info");
+		goto out;
+	}
+
+	mixinfo->control_count = inputs;
+	record_scaler(&buf[1], mixinfo->output_scaler);
+	buf += 1 + MIXER_REC_SCALER_SIZE;
+
+	for (unsigned i = 0; i < inputs; i++) {
+		mixinfo->controls[i].control_group = buf[0];
+		mixinfo->controls[i].control_index = buf[1];
+		record_scaler(&buf[2], mixinfo->controls[i].scaler);
+		buf += 2 + MIXER_REC_SCALER_SIZE;
+	}
+
+	sm = new SimpleMixer(control_cb, cb_handle, mixinfo);
+
+	if (sm != nullptr) {
+		mixinfo = nullptr;
+		debug("loaded mixer with %d input(s)", inputs);
+
+	} else {
+		debug("could not allocate memory for mixer");
+	}
+
+out:
+
+	if (mixinfo != nullptr)
+		free(mixinfo);
+
+	return sm;
+}
+
 SimpleMixer *
 SimpleMixer::pwm_input(Mixer::ControlCallback control_cb, uintptr_t cb_handle, unsigned input, uint16_t min, uint16_t mid, uint16_t max)
 {
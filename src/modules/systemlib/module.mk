@@ -39,6 +39,7 @@ SRCS		 = err.c \
 		   hx_stream.c \
 		   perf_counter.c \
 		   param/param.c \
+		   param/param_journal.c \
 		   bson/tinybson.c \
 		   conversions.c \
 		   cpuload.c \
@@ -52,5 +53,6 @@ SRCS		 = err.c \
 		   rc_check.c \
 		   otp.c \
 		   board_serial.c \
+		   boot_trace.c \
 		   pwm_limit/pwm_limit.c
 
@@ -55,6 +55,7 @@
 #include <drivers/drv_hrt.h>
 
 #include "systemlib/param/param.h"
+#include "systemlib/param/param_journal.h"
 #include "systemlib/uthash/utarray.h"
 #include "systemlib/bson/tinybson.h"
 
@@ -90,6 +91,15 @@ UT_array	*param_values;
 /** array info for the modified parameters array */
 const UT_icd	param_icd = {sizeof(struct param_wbuf_s), NULL, NULL, NULL};
 
+/**
+ * set when the unsaved flags no longer tell what the journal is missing, because a
+ * parameter was reset or the values were exported elsewhere; the journal then needs a compaction
+ */
+static bool param_compact_pending = false;
+
+/** default files with this prefix are raw MTD partitions and use the journal format */
+#define PARAM_JOURNAL_PATH_PREFIX	"/fs/mtd"
+
 /** parameter update topic */
 ORB_DEFINE(parameter_update, struct parameter_update_s);
 
@@ -458,6 +468,7 @@ param_reset(param_t param)
 		if (s != NULL) {
 			int pos = utarray_eltidx(param_values, s);
 			utarray_erase(param_values, pos, 1);
+			param_compact_pending = true;
 		}
 	}
 
@@ -478,6 +489,7 @@ param_reset_all(void)
 
 	/* mark as reset / deleted */
 	param_values = NULL;
+	param_compact_pending = true;
 
 	param_unlock();
 
@@ -505,13 +517,121 @@ param_get_default_file(void)
 	return (param_user_file != NULL) ? param_user_file : param_default_file;
 }
 
+static bool
+param_file_is_journal(const char *filename)
+{
+	return !strncmp(filename, PARAM_JOURNAL_PATH_PREFIX, strlen(PARAM_JOURNAL_PATH_PREFIX));
+}
+
+/**
+ * Write the parameters to the journal.
+ *
+ * Only values changed since the last save are appended; the complete set
+ * is written as a compaction if the journal is new, full, or a parameter
+ * was reset.
+ */
+static int
+param_journal_save(int fd)
+{
+	struct param_journal_s journal;
+	struct param_wbuf_s *s = NULL;
+	int ret = param_journal_open(&journal, fd);
+	bool compact = param_compact_pending;
+
+	if (ret == -ENOENT) {
+		compact = true;
+
+	} else if (ret != 0) {
+		return ret;
+	}
+
+	param_lock();
+
+	if (!compact && param_values != NULL) {
+		while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
+			if (!s->unsaved)
+				continue;
+
+			ret = param_journal_append(&journal, param_name(s->param), param_type(s->param),
+						   param_get_value_ptr(s->param), param_size(s->param));
+
+			if (ret == -ENOSPC) {
+				compact = true;
+				break;
+			}
+
+			if (ret != 0)
+				goto out;
+
+			s->unsaved = false;
+		}
+	}
+
+	if (compact) {
+		param_journal_compact(&journal);
+
+		s = NULL;
+
+		while (param_values != NULL &&
+		       (s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
+			ret = param_journal_append(&journal, param_name(s->param), param_type(s->param),
+						   param_get_value_ptr(s->param), param_size(s->param));
+
+			if (ret != 0)
+				goto out;
+		}
+
+		ret = param_journal_commit(&journal);
+
+		if (ret != 0)
+			goto out;
+
+		s = NULL;
+
+		while (param_values != NULL &&
+		       (s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
+			s->unsaved = false;
+		}
+
+		param_compact_pending = false;
+	}
+
+out:
+	param_unlock();
+
+	return ret;
+}
+
 int
 param_save_default(void)
 {
-	int res;
+	return param_save_file(param_get_default_file());
+}
+
+int
+param_save_file(const char *filename)
+{
+	int res = OK;
 	int fd;
 
-	const char *filename = param_get_default_file();
+	if (param_file_is_journal(filename)) {
+		fd = open(filename, O_RDWR);
+
+		if (fd < 0) {
+			warn("failed to open param file: %s", filename);
+			return ERROR;
+		}
+
+		res = param_journal_save(fd);
+		close(fd);
+
+		if (res != OK) {
+			warnx("failed to write parameter journal: %s (%d)", filename, res);
+			return ERROR;
+		}
+
+		return OK;
+	}
 
 	/* write parameters to temp file */
 	fd = open(filename, O_WRONLY | O_CREAT);
@@ -648,6 +768,7 @@ param_export(int fd, bool only_unsaved)
 			continue;
 
 		s->unsaved = false;
+		param_compact_pending = true;
 
 		/* append the appropriate BSON type object */
 		switch (param_type(s->param)) {
@@ -838,17 +959,76 @@ out:
 	return result;
 }
 
+static void
+param_journal_replay_callback(void *arg, const char *name, uint16_t type, const void *val, unsigned len)
+{
+	bool mark_saved = *(bool *)arg;
+	param_t param = param_find(name);
+
+	if (param == PARAM_INVALID) {
+		debug("ignoring unrecognised parameter '%s'", name);
+		return;
+	}
+
+	if (val == NULL) {
+		param_reset(param);
+
+	} else if (type == param_type(param) && len == param_size(param)) {
+		/* copy out, the record value is not aligned */
+		union param_value_u v;
+		void *tmp = NULL;
+
+		if (len <= sizeof(v)) {
+			memcpy(&v, val, len);
+			param_set_internal(param, &v, mark_saved);
+
+		} else if ((tmp = malloc(len)) != NULL) {
+			memcpy(tmp, val, len);
+			param_set_internal(param, tmp, mark_saved);
+			free(tmp);
+		}
+
+	} else {
+		debug("unexpected type or size for '%s'", name);
+	}
+}
+
+/**
+ * Import from a journal or a BSON file.
+ */
+static int
+param_import_any(int fd, bool mark_saved)
+{
+	struct param_journal_s journal;
+
+	/* a journal is recognised by its bank headers, anything else is BSON */
+	if (param_journal_open(&journal, fd) == 0) {
+		int result = param_journal_replay(&journal, param_journal_replay_callback, &mark_saved);
+		return (result < 0) ? result : 0;
+	}
+
+	lseek(fd, 0, SEEK_SET);
+
+	return param_import_internal(fd, mark_saved);
+}
+
 int
 param_import(int fd)
 {
-	return param_import_internal(fd, false);
+	return param_import_any(fd, false);
 }
 
 int
 param_load(int fd)
 {
 	param_reset_all();
-	return param_import_internal(fd, true);
+
+	int result = param_import_any(fd, true);
+
+	/* the storage matches the loaded values */
+	param_compact_pending = false;
+
+	return result;
 }
 
 void
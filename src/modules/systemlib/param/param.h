@@ -202,7 +202,7 @@ __EXPORT int		param_export(int fd, bool only_unsaved);
  *
  * This function merges the imported parameters with the current parameter set.
  *
- * @param fd		File descriptor to import from.  (Currently expected to be a file.)
+ * @param fd		File descriptor to import from, a BSON file or a parameter journal.
  * @return		Zero on success, nonzero if an error occurred during import.
  *			Note that in the failure case, parameters may be inconsistent.
  */
@@ -261,6 +261,17 @@ __EXPORT const char*	param_get_default_file(void);
  */
 __EXPORT int 		param_save_default(void);
 
+/**
+ * Save parameters to a file.
+ *
+ * Files on the raw MTD partition are written in the journal format, others
+ * as BSON like param_export.
+ *
+ * @param filename	Path to the parameter file.
+ * @return		Zero on success.
+ */
+__EXPORT int 		param_save_file(const char *filename);
+
 /**
  * Load parameters from the default parameter file.
  *
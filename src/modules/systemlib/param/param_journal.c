@@ -0,0 +1,295 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file param_journal.c
+ *
+ * Append-only parameter journal, see param_journal.h for the storage layout.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <crc32.h>
+
+#include "param_journal.h"
+
+/** longest parameter name accepted in a record */
+#define PARAM_JOURNAL_NAME_MAX	32
+
+/** longest value accepted in a record */
+#define PARAM_JOURNAL_VALUE_MAX	255
+
+static int
+journal_pread(int fd, void *buf, size_t len, off_t offset)
+{
+	if (lseek(fd, offset, SEEK_SET) != offset)
+		return -EIO;
+
+	if (read(fd, buf, len) != (ssize_t)len)
+		return -EIO;
+
+	return 0;
+}
+
+static int
+journal_pwrite(int fd, const void *buf, size_t len, off_t offset)
+{
+	if (lseek(fd, offset, SEEK_SET) != offset)
+		return -EIO;
+
+	if (write(fd, buf, len) != (ssize_t)len)
+		return -EIO;
+
+	return 0;
+}
+
+static uint32_t
+journal_header_crc(const struct param_journal_header_s *hdr)
+{
+	return crc32part((const uint8_t *)hdr, offsetof(struct param_journal_header_s, crc), 0);
+}
+
+static uint32_t
+journal_record_crc(uint32_t generation, const struct param_journal_record_s *rec, const uint8_t *payload)
+{
+	uint32_t crc = crc32part((const uint8_t *)&generation, sizeof(generation), 0);
+
+	crc = crc32part((const uint8_t *)&rec->type, sizeof(*rec) - offsetof(struct param_journal_record_s, type), crc);
+	return crc32part(payload, rec->name_len + rec->value_len, crc);
+}
+
+/**
+ * Read the record at 'offset' in the active bank.
+ *
+ * @return		The size of the record, or 0 if there is no valid record at offset.
+ */
+static unsigned
+journal_read_record(struct param_journal_s *j, off_t offset, struct param_journal_record_s *rec, uint8_t *payload)
+{
+	off_t base = j->bank * j->bank_size;
+
+	if (offset + (off_t)sizeof(*rec) > j->bank_size)
+		return 0;
+
+	if (journal_pread(j->fd, rec, sizeof(*rec), base + offset))
+		return 0;
+
+	unsigned payload_len = rec->name_len + rec->value_len;
+
+	/* erased or stale storage, the CRC check below would catch it as well */
+	if (rec->name_len == 0 || rec->name_len > PARAM_JOURNAL_NAME_MAX ||
+	    offset + (off_t)(sizeof(*rec) + payload_len) > j->bank_size)
+		return 0;
+
+	if (journal_pread(j->fd, payload, payload_len, base + offset + sizeof(*rec)))
+		return 0;
+
+	if (journal_record_crc(j->generation, rec, payload) != rec->crc)
+		return 0;
+
+	return sizeof(*rec) + payload_len;
+}
+
+int
+param_journal_open(struct param_journal_s *j, int fd)
+{
+	struct param_journal_header_s hdr[2];
+	bool hdr_valid[2];
+	off_t size = lseek(fd, 0, SEEK_END);
+
+	j->fd = fd;
+	j->bank_size = size / 2;
+	j->valid = false;
+
+	if (size < 0)
+		return -EIO;
+
+	if (j->bank_size < (off_t)(sizeof(struct param_journal_header_s) + sizeof(struct param_journal_record_s)))
+		return -EINVAL;
+
+	for (unsigned i = 0; i < 2; i++) {
+		hdr_valid[i] = (journal_pread(fd, &hdr[i], sizeof(hdr[i]), i * j->bank_size) == 0) &&
+			       (hdr[i].magic == PARAM_JOURNAL_MAGIC) &&
+			       (hdr[i].crc == journal_header_crc(&hdr[i]));
+	}
+
+	if (!hdr_valid[0] && !hdr_valid[1]) {
+		/* no journal, make the next compaction start with bank 0 */
+		j->bank = 1;
+		j->generation = 0;
+		j->end = sizeof(struct param_journal_header_s);
+		return -ENOENT;
+	}
+
+	/* the newer bank is active; compare as difference to cope with wrap-around */
+	if (hdr_valid[0] && (!hdr_valid[1] || (int32_t)(hdr[0].generation - hdr[1].generation) > 0)) {
+		j->bank = 0;
+
+	} else {
+		j->bank = 1;
+	}
+
+	j->generation = hdr[j->bank].generation;
+	j->valid = true;
+
+	/* find the end of the records */
+	struct param_journal_record_s rec;
+	uint8_t payload[PARAM_JOURNAL_NAME_MAX + PARAM_JOURNAL_VALUE_MAX];
+	unsigned len;
+
+	j->end = sizeof(struct param_journal_header_s);
+
+	while ((len = journal_read_record(j, j->end, &rec, payload)) > 0)
+		j->end += len;
+
+	return 0;
+}
+
+int
+param_journal_replay(struct param_journal_s *j, param_journal_cb cb, void *arg)
+{
+	struct param_journal_record_s rec;
+	uint8_t payload[PARAM_JOURNAL_NAME_MAX + PARAM_JOURNAL_VALUE_MAX];
+	char name[PARAM_JOURNAL_NAME_MAX + 1];
+	off_t offset = sizeof(struct param_journal_header_s);
+	unsigned len;
+	int count = 0;
+
+	if (!j->valid)
+		return -ENOENT;
+
+	while (offset < j->end && (len = journal_read_record(j, offset, &rec, payload)) > 0) {
+		memcpy(name, payload, rec.name_len);
+		name[rec.name_len] = '\0';
+
+		if (rec.value_len > 0) {
+			cb(arg, name, rec.type, payload + rec.name_len, rec.value_len);
+
+		} else {
+			cb(arg, name, rec.type, NULL, 0);
+		}
+
+		offset += len;
+		count++;
+	}
+
+	return count;
+}
+
+int
+param_journal_append(struct param_journal_s *j, const char *name, uint16_t type, const void *val, unsigned len)
+{
+	/* record header and payload are written in one go, a torn write fails the CRC */
+	uint8_t buf[2 * sizeof(struct param_journal_record_s) + PARAM_JOURNAL_NAME_MAX + PARAM_JOURNAL_VALUE_MAX];
+	struct param_journal_record_s rec;
+	uint8_t *payload = &buf[sizeof(rec)];
+	size_t name_len = strlen(name);
+
+	if (name_len == 0 || name_len > PARAM_JOURNAL_NAME_MAX || len > PARAM_JOURNAL_VALUE_MAX)
+		return -EINVAL;
+
+	rec.type = type;
+	rec.name_len = name_len;
+	rec.value_len = (val != NULL) ? len : 0;
+
+	unsigned size = sizeof(rec) + rec.name_len + rec.value_len;
+
+	if (j->end + (off_t)size > j->bank_size)
+		return -ENOSPC;
+
+	memcpy(payload, name, rec.name_len);
+
+	if (rec.value_len > 0)
+		memcpy(payload + rec.name_len, val, rec.value_len);
+
+	rec.crc = journal_record_crc(j->generation, &rec, payload);
+	memcpy(buf, &rec, sizeof(rec));
+
+	/*
+	 * Terminate the records with an empty header. An aborted compaction may
+	 * have left records of the same generation behind, which must not be
+	 * picked up once the bank gets committed.
+	 */
+	unsigned write_size = size;
+
+	if (j->end + (off_t)(size + sizeof(rec)) <= j->bank_size) {
+		memset(&buf[size], 0, sizeof(rec));
+		write_size += sizeof(rec);
+	}
+
+	int ret = journal_pwrite(j->fd, buf, write_size, j->bank * j->bank_size + j->end);
+
+	if (ret == 0)
+		j->end += size;
+
+	return ret;
+}
+
+void
+param_journal_compact(struct param_journal_s *j)
+{
+	j->bank = 1 - j->bank;
+	j->generation++;
+	j->end = sizeof(struct param_journal_header_s);
+}
+
+int
+param_journal_commit(struct param_journal_s *j)
+{
+	struct param_journal_header_s hdr;
+
+	hdr.magic = PARAM_JOURNAL_MAGIC;
+	hdr.generation = j->generation;
+	hdr.crc = journal_header_crc(&hdr);
+
+	/* an empty bank has no terminating record yet */
+	if (j->end == sizeof(hdr) && j->end + (off_t)sizeof(struct param_journal_record_s) <= j->bank_size) {
+		struct param_journal_record_s term;
+		memset(&term, 0, sizeof(term));
+		journal_pwrite(j->fd, &term, sizeof(term), j->bank * j->bank_size + j->end);
+	}
+
+	/* the records must be on storage before the header makes them live */
+	fsync(j->fd);
+
+	int ret = journal_pwrite(j->fd, &hdr, sizeof(hdr), j->bank * j->bank_size);
+
+	if (ret == 0) {
+		fsync(j->fd);
+		j->valid = true;
+	}
+
+	return ret;
+}
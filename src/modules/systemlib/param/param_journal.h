@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file param_journal.h
+ *
+ * Append-only parameter journal for byte-addressable storage (FRAM/EEPROM
+ * MTD partitions).
+ *
+ * The storage is split into two banks. The active bank starts with a header
+ * carrying a generation number, followed by records of changed parameters.
+ * Saving a parameter appends one record; when the active bank is full, the
+ * complete set of changed parameters is compacted into the other bank and
+ * committed by writing its header last, so an interrupted compaction leaves
+ * the previous bank intact.
+ *
+ * Every record is protected by a CRC32 seeded with the bank generation, so
+ * records left over from an older generation are never replayed.
+ *
+ * The journal only works on a file descriptor and does not depend on the
+ * parameter store itself.
+ */
+
+#ifndef _SYSTEMLIB_PARAM_PARAM_JOURNAL_H
+#define _SYSTEMLIB_PARAM_PARAM_JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h>
+
+__BEGIN_DECLS
+
+/** journal magic, "PJNL" */
+#define PARAM_JOURNAL_MAGIC	0x4c4e4a50
+
+/**
+ * Bank header, written last when a bank is committed.
+ */
+struct param_journal_header_s {
+	uint32_t	magic;
+	uint32_t	generation;
+	uint32_t	crc;		/**< CRC32 of magic and generation */
+};
+
+/**
+ * Record header, followed by name_len bytes of name (not terminated)
+ * and value_len bytes of value. A record with value_len 0 resets the
+ * parameter to its default.
+ */
+struct param_journal_record_s {
+	uint32_t	crc;		/**< CRC32 of the rest of the record, seeded with the generation */
+	uint16_t	type;		/**< param_type_t of the value */
+	uint8_t		name_len;
+	uint8_t		value_len;
+};
+
+/**
+ * Journal state.
+ */
+struct param_journal_s {
+	int		fd;
+	off_t		bank_size;	/**< size of one bank in bytes */
+	unsigned	bank;		/**< bank records are appended to, 0 or 1 */
+	uint32_t	generation;	/**< generation of that bank */
+	off_t		end;		/**< offset of the next record, relative to the bank */
+	bool		valid;		/**< true if a committed bank was found */
+};
+
+/**
+ * Callback invoked for every replayed record, in the order they were written.
+ *
+ * @param arg		The argument passed to param_journal_replay.
+ * @param name		The zero-terminated parameter name.
+ * @param type		The param_type_t of the value.
+ * @param val		The value, or NULL for a reset record.
+ * @param len		The value length, 0 for a reset record.
+ */
+typedef void (*param_journal_cb)(void *arg, const char *name, uint16_t type, const void *val, unsigned len);
+
+/**
+ * Open the journal on a file or device.
+ *
+ * Locates the most recent committed bank and the end of its records.
+ *
+ * @param j		The journal state to initialise.
+ * @param fd		Open read/write descriptor of the storage; the storage size is taken from its end.
+ * @return		0 if a journal was found, -ENOENT if the storage holds no journal
+ *			(j is still usable for a compaction), other negative errno on error.
+ */
+__EXPORT int		param_journal_open(struct param_journal_s *j, int fd);
+
+/**
+ * Replay all records of the active bank.
+ *
+ * @param j		The journal opened with param_journal_open.
+ * @param cb		Callback for each record.
+ * @param arg		Argument passed to the callback.
+ * @return		The number of replayed records, or a negative errno.
+ */
+__EXPORT int		param_journal_replay(struct param_journal_s *j, param_journal_cb cb, void *arg);
+
+/**
+ * Append a record to the active bank.
+ *
+ * @param j		The journal.
+ * @param name		The parameter name.
+ * @param type		The param_type_t of the value.
+ * @param val		The value, or NULL to record a reset.
+ * @param len		The value length (at most 255), 0 to record a reset.
+ * @return		0 on success, -ENOSPC if the bank is full, other negative errno on error.
+ */
+__EXPORT int		param_journal_append(struct param_journal_s *j, const char *name, uint16_t type,
+		const void *val, unsigned len);
+
+/**
+ * Start a compaction into the inactive bank.
+ *
+ * Following param_journal_append calls write to the new bank, which only
+ * becomes active with param_journal_commit.
+ *
+ * @param j		The journal.
+ */
+__EXPORT void		param_journal_compact(struct param_journal_s *j);
+
+/**
+ * Commit the bank written since param_journal_compact.
+ *
+ * @param j		The journal.
+ * @return		0 on success, negative errno on error.
+ */
+__EXPORT int		param_journal_commit(struct param_journal_s *j);
+
+__END_DECLS
+
+#endif /* _SYSTEMLIB_PARAM_PARAM_JOURNAL_H */
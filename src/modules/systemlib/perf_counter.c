@@ -39,6 +39,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/queue.h>
 #include <drivers/drv_hrt.h>
 
@@ -87,6 +88,25 @@ struct perf_ctr_interval {
 
 };
 
+/**
+ * Upper bounds of the PC_LATENCY histogram buckets in microseconds, the last
+ * bucket collects everything above.
+ */
+static const uint16_t latency_buckets[] = { 250, 500, 1000, 2000, 4000, 8000, 16000 };
+#define LATENCY_BUCKET_COUNT	(sizeof(latency_buckets) / sizeof(latency_buckets[0]) + 1)
+
+/**
+ * PC_LATENCY counter.
+ */
+struct perf_ctr_latency {
+	struct perf_ctr_header	hdr;
+	uint64_t		event_count;
+	uint64_t		time_total;
+	uint64_t		time_least;
+	uint64_t		time_most;
+	uint32_t		histogram[LATENCY_BUCKET_COUNT];
+};
+
 /**
  * List of all known counters.
  */
@@ -111,6 +131,10 @@ perf_alloc(enum perf_counter_type type, const char *name)
 		ctr = (perf_counter_t)calloc(sizeof(struct perf_ctr_interval), 1);
 		break;
 
+	case PC_LATENCY:
+		ctr = (perf_counter_t)calloc(sizeof(struct perf_ctr_latency), 1);
+		break;
+
 	default:
 		break;
 	}
@@ -243,7 +267,36 @@ perf_cancel(perf_counter_t handle)
 	}
 }
 
+void
+perf_latency(perf_counter_t handle, uint64_t latency)
+{
+	if (handle == NULL)
+		return;
+
+	switch (handle->type) {
+	case PC_LATENCY: {
+			struct perf_ctr_latency *pcl = (struct perf_ctr_latency *)handle;
+			unsigned bucket = 0;
+
+			while (bucket < LATENCY_BUCKET_COUNT - 1 && latency >= latency_buckets[bucket])
+				bucket++;
+
+			pcl->histogram[bucket]++;
+			pcl->event_count++;
+			pcl->time_total += latency;
+
+			if ((pcl->time_least > latency) || (pcl->event_count == 1))
+				pcl->time_least = latency;
 
+			if (pcl->time_most < latency)
+				pcl->time_most = latency;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
 
 void
 perf_reset(perf_counter_t handle)
@@ -276,6 +329,16 @@ perf_reset(perf_counter_t handle)
 		pci->time_most = 0;
 		break;
 	}
+
+	case PC_LATENCY: {
+		struct perf_ctr_latency *pcl = (struct perf_ctr_latency *)handle;
+		pcl->event_count = 0;
+		pcl->time_total = 0;
+		pcl->time_least = 0;
+		pcl->time_most = 0;
+		memset(pcl->histogram, 0, sizeof(pcl->histogram));
+		break;
+	}
 	}
 }
 
@@ -317,6 +380,28 @@ perf_print_counter(perf_counter_t handle)
 		break;
 	}
 
+	case PC_LATENCY: {
+		struct perf_ctr_latency *pcl = (struct perf_ctr_latency *)handle;
+
+		printf("%s: %llu events, %llu avg, min %lluus max %lluus\n",
+		       handle->name,
+		       pcl->event_count,
+		       (pcl->event_count > 0) ? pcl->time_total / pcl->event_count : 0,
+		       pcl->time_least,
+		       pcl->time_most);
+
+		for (unsigned i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+			if (i < LATENCY_BUCKET_COUNT - 1) {
+				printf("  <%uus: %u", latency_buckets[i], (unsigned)pcl->histogram[i]);
+
+			} else {
+				printf("  >=%uus: %u\n", latency_buckets[i - 1], (unsigned)pcl->histogram[i]);
+			}
+		}
+
+		break;
+	}
+
 	default:
 		break;
 	}
@@ -342,6 +427,11 @@ perf_event_count(perf_counter_t handle)
 		return pci->event_count;
 	}
 
+	case PC_LATENCY: {
+		struct perf_ctr_latency *pcl = (struct perf_ctr_latency *)handle;
+		return pcl->event_count;
+	}
+
 	default:
 		break;
 	}
@@ -47,7 +47,8 @@
 enum perf_counter_type {
 	PC_COUNT,		/**< count the number of times an event occurs */
 	PC_ELAPSED,		/**< measure the time elapsed performing an event */
-	PC_INTERVAL		/**< measure the interval between instances of an event */
+	PC_INTERVAL,		/**< measure the interval between instances of an event */
+	PC_LATENCY		/**< histogram of externally measured latencies */
 };
 
 struct perf_ctr_header;
@@ -111,6 +112,18 @@ __EXPORT extern void		perf_end(perf_counter_t handle);
  */
 __EXPORT extern void		perf_cancel(perf_counter_t handle);
 
+/**
+ * Record a latency.
+ *
+ * This call applies to counters that collect latencies measured by the caller,
+ * e.g. the age of a sensor sample when the output derived from it is written;
+ * PC_LATENCY etc.
+ *
+ * @param handle		The handle returned from perf_alloc.
+ * @param latency		The latency in microseconds.
+ */
+__EXPORT extern void		perf_latency(perf_counter_t handle, uint64_t latency);
+
 /**
  * Reset a performance counter.
  *
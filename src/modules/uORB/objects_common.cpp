@@ -43,8 +43,13 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
+
 #include <drivers/drv_orb_dev.h>
 
+/* field layout descriptors of the topics/ structs, used by ORB_DEFINE_FIELDS */
+#include "topic_fields.h"
+
 #include <drivers/drv_mag.h>
 ORB_DEFINE(sensor_mag, struct mag_report);
 
@@ -67,132 +72,150 @@ ORB_DEFINE(output_pwm, struct pwm_output_values);
 ORB_DEFINE(input_rc, struct rc_input_values);
 
 #include "topics/vehicle_attitude.h"
-ORB_DEFINE(vehicle_attitude, struct vehicle_attitude_s);
+ORB_DEFINE_FIELDS(vehicle_attitude, vehicle_attitude_s);
 
 #include "topics/sensor_combined.h"
-ORB_DEFINE(sensor_combined, struct sensor_combined_s);
+ORB_DEFINE_FIELDS(sensor_combined, sensor_combined_s);
 
 #include "topics/vehicle_gps_position.h"
-ORB_DEFINE(vehicle_gps_position, struct vehicle_gps_position_s);
+ORB_DEFINE_FIELDS(vehicle_gps_position, vehicle_gps_position_s);
 
 #include "topics/home_position.h"
-ORB_DEFINE(home_position, struct home_position_s);
+ORB_DEFINE_FIELDS(home_position, home_position_s);
 
 #include "topics/vehicle_status.h"
-ORB_DEFINE(vehicle_status, struct vehicle_status_s);
+ORB_DEFINE_FIELDS(vehicle_status, vehicle_status_s);
 
 #include "topics/safety.h"
-ORB_DEFINE(safety, struct safety_s);
+ORB_DEFINE_FIELDS(safety, safety_s);
 
 #include "topics/battery_status.h"
-ORB_DEFINE(battery_status, struct battery_status_s);
+ORB_DEFINE_FIELDS(battery_status, battery_status_s);
 
 #include "topics/servorail_status.h"
-ORB_DEFINE(servorail_status, struct servorail_status_s);
+ORB_DEFINE_FIELDS(servorail_status, servorail_status_s);
 
 #include "topics/system_power.h"
-ORB_DEFINE(system_power, struct system_power_s);
+ORB_DEFINE_FIELDS(system_power, system_power_s);
 
 #include "topics/vehicle_global_position.h"
-ORB_DEFINE(vehicle_global_position, struct vehicle_global_position_s);
+ORB_DEFINE_FIELDS(vehicle_global_position, vehicle_global_position_s);
 
 #include "topics/vehicle_local_position.h"
-ORB_DEFINE(vehicle_local_position, struct vehicle_local_position_s);
+ORB_DEFINE_FIELDS(vehicle_local_position, vehicle_local_position_s);
 
 #include "topics/vehicle_vicon_position.h"
-ORB_DEFINE(vehicle_vicon_position, struct vehicle_vicon_position_s);
+ORB_DEFINE_FIELDS(vehicle_vicon_position, vehicle_vicon_position_s);
 
 #include "topics/vehicle_rates_setpoint.h"
-ORB_DEFINE(vehicle_rates_setpoint, struct vehicle_rates_setpoint_s);
+ORB_DEFINE_FIELDS(vehicle_rates_setpoint, vehicle_rates_setpoint_s);
 
 #include "topics/rc_channels.h"
-ORB_DEFINE(rc_channels, struct rc_channels_s);
+ORB_DEFINE_FIELDS(rc_channels, rc_channels_s);
 
 #include "topics/vehicle_command.h"
-ORB_DEFINE(vehicle_command, struct vehicle_command_s);
+ORB_DEFINE_FIELDS(vehicle_command, vehicle_command_s);
 
 #include "topics/vehicle_control_mode.h"
-ORB_DEFINE(vehicle_control_mode, struct vehicle_control_mode_s);
+ORB_DEFINE_FIELDS(vehicle_control_mode, vehicle_control_mode_s);
 
 #include "topics/vehicle_local_position_setpoint.h"
-ORB_DEFINE(vehicle_local_position_setpoint, struct vehicle_local_position_setpoint_s);
+ORB_DEFINE_FIELDS(vehicle_local_position_setpoint, vehicle_local_position_setpoint_s);
 
 #include "topics/vehicle_bodyframe_speed_setpoint.h"
-ORB_DEFINE(vehicle_bodyframe_speed_setpoint, struct vehicle_bodyframe_speed_setpoint_s);
+ORB_DEFINE_FIELDS(vehicle_bodyframe_speed_setpoint, vehicle_bodyframe_speed_setpoint_s);
 
 #include "topics/position_setpoint_triplet.h"
-ORB_DEFINE(position_setpoint_triplet, struct position_setpoint_triplet_s);
+ORB_DEFINE_FIELDS(position_setpoint_triplet, position_setpoint_triplet_s);
 
 #include "topics/vehicle_global_velocity_setpoint.h"
-ORB_DEFINE(vehicle_global_velocity_setpoint, struct vehicle_global_velocity_setpoint_s);
+ORB_DEFINE_FIELDS(vehicle_global_velocity_setpoint, vehicle_global_velocity_setpoint_s);
 
 #include "topics/mission.h"
-ORB_DEFINE(mission, struct mission_s);
-ORB_DEFINE(onboard_mission, struct mission_s);
+ORB_DEFINE_FIELDS(mission, mission_s);
+ORB_DEFINE_FIELDS(onboard_mission, mission_s);
 
 #include "topics/mission_result.h"
-ORB_DEFINE(mission_result, struct mission_result_s);
+ORB_DEFINE_FIELDS(mission_result, mission_result_s);
 
 #include "topics/fence.h"
 ORB_DEFINE(fence, unsigned);
 
 #include "topics/vehicle_attitude_setpoint.h"
-ORB_DEFINE(vehicle_attitude_setpoint, struct vehicle_attitude_setpoint_s);
+ORB_DEFINE_FIELDS(vehicle_attitude_setpoint, vehicle_attitude_setpoint_s);
 
 #include "topics/manual_control_setpoint.h"
-ORB_DEFINE(manual_control_setpoint, struct manual_control_setpoint_s);
+ORB_DEFINE_FIELDS(manual_control_setpoint, manual_control_setpoint_s);
 
 #include "topics/vehicle_control_debug.h"
-ORB_DEFINE(vehicle_control_debug, struct vehicle_control_debug_s);
+ORB_DEFINE_FIELDS(vehicle_control_debug, vehicle_control_debug_s);
 
 #include "topics/offboard_control_setpoint.h"
-ORB_DEFINE(offboard_control_setpoint, struct offboard_control_setpoint_s);
+ORB_DEFINE_FIELDS(offboard_control_setpoint, offboard_control_setpoint_s);
 
 #include "topics/optical_flow.h"
-ORB_DEFINE(optical_flow, struct optical_flow_s);
+ORB_DEFINE_FIELDS(optical_flow, optical_flow_s);
 
 #include "topics/filtered_bottom_flow.h"
-ORB_DEFINE(filtered_bottom_flow, struct filtered_bottom_flow_s);
+ORB_DEFINE_FIELDS(filtered_bottom_flow, filtered_bottom_flow_s);
 
 #include "topics/omnidirectional_flow.h"
-ORB_DEFINE(omnidirectional_flow, struct omnidirectional_flow_s);
+ORB_DEFINE_FIELDS(omnidirectional_flow, omnidirectional_flow_s);
 
 #include "topics/airspeed.h"
-ORB_DEFINE(airspeed, struct airspeed_s);
+ORB_DEFINE_FIELDS(airspeed, airspeed_s);
 
 #include "topics/differential_pressure.h"
-ORB_DEFINE(differential_pressure, struct differential_pressure_s);
+ORB_DEFINE_FIELDS(differential_pressure, differential_pressure_s);
 
 #include "topics/subsystem_info.h"
-ORB_DEFINE(subsystem_info, struct subsystem_info_s);
+ORB_DEFINE_FIELDS(subsystem_info, subsystem_info_s);
 
 /* actuator controls, as requested by controller */
 #include "topics/actuator_controls.h"
-ORB_DEFINE(actuator_controls_0, struct actuator_controls_s);
-ORB_DEFINE(actuator_controls_1, struct actuator_controls_s);
-ORB_DEFINE(actuator_controls_2, struct actuator_controls_s);
-ORB_DEFINE(actuator_controls_3, struct actuator_controls_s);
+ORB_DEFINE_FIELDS(actuator_controls_0, actuator_controls_s);
+ORB_DEFINE_FIELDS(actuator_controls_1, actuator_controls_s);
+ORB_DEFINE_FIELDS(actuator_controls_2, actuator_controls_s);
+ORB_DEFINE_FIELDS(actuator_controls_3, actuator_controls_s);
 
 #include "topics/actuator_armed.h"
-ORB_DEFINE(actuator_armed, struct actuator_armed_s);
+ORB_DEFINE_FIELDS(actuator_armed, actuator_armed_s);
 
 #include "topics/actuator_outputs.h"
-ORB_DEFINE(actuator_outputs_0, struct actuator_outputs_s);
-ORB_DEFINE(actuator_outputs_1, struct actuator_outputs_s);
-ORB_DEFINE(actuator_outputs_2, struct actuator_outputs_s);
-ORB_DEFINE(actuator_outputs_3, struct actuator_outputs_s);
+ORB_DEFINE_FIELDS(actuator_outputs_0, actuator_outputs_s);
+ORB_DEFINE_FIELDS(actuator_outputs_1, actuator_outputs_s);
+ORB_DEFINE_FIELDS(actuator_outputs_2, actuator_outputs_s);
+ORB_DEFINE_FIELDS(actuator_outputs_3, actuator_outputs_s);
 
 #include "topics/telemetry_status.h"
-ORB_DEFINE(telemetry_status, struct telemetry_status_s);
+ORB_DEFINE_FIELDS(telemetry_status, telemetry_status_s);
 
 #include "topics/debug_key_value.h"
-ORB_DEFINE(debug_key_value, struct debug_key_value_s);
+ORB_DEFINE_FIELDS(debug_key_value, debug_key_value_s);
 
 #include "topics/navigation_capabilities.h"
-ORB_DEFINE(navigation_capabilities, struct navigation_capabilities_s);
+ORB_DEFINE_FIELDS(navigation_capabilities, navigation_capabilities_s);
 
 #include "topics/esc_status.h"
-ORB_DEFINE(esc_status, struct esc_status_s);
+ORB_DEFINE_FIELDS(esc_status, esc_status_s);
 
 #include "topics/encoders.h"
-ORB_DEFINE(encoders, struct encoders_s);
+ORB_DEFINE_FIELDS(encoders, encoders_s);
+
+/* topics which can be looked up by name, see orb_find_topic() */
+static const struct orb_metadata *const orb_topics_with_fields[] = {
+	ORB_TOPICS_WITH_FIELDS
+	NULL
+};
+
+orb_id_t
+orb_find_topic(const char *name)
+{
+	for (unsigned i = 0; orb_topics_with_fields[i] != NULL; i++) {
+		if (!strcmp(orb_topics_with_fields[i]->o_name, name)) {
+			return orb_topics_with_fields[i];
+		}
+	}
+
+	return NULL;
+}
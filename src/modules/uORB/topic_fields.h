@@ -0,0 +1,756 @@
+/*
+ * Generated by Tools/px_generate_uorb_topic_fields.py from the uORB topic headers.
+ * Do not edit, re-run 'make topic_fields' after changing a topic struct.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "topics/actuator_armed.h"
+#include "topics/actuator_controls.h"
+#include "topics/actuator_controls_effective.h"
+#include "topics/actuator_outputs.h"
+#include "topics/airspeed.h"
+#include "topics/battery_status.h"
+#include "topics/debug_key_value.h"
+#include "topics/differential_pressure.h"
+#include "topics/encoders.h"
+#include "topics/esc_status.h"
+#include "topics/fence.h"
+#include "topics/filtered_bottom_flow.h"
+#include "topics/home_position.h"
+#include "topics/manual_control_setpoint.h"
+#include "topics/mission.h"
+#include "topics/mission_result.h"
+#include "topics/navigation_capabilities.h"
+#include "topics/offboard_control_setpoint.h"
+#include "topics/omnidirectional_flow.h"
+#include "topics/optical_flow.h"
+#include "topics/parameter_update.h"
+#include "topics/position_setpoint_triplet.h"
+#include "topics/rc_channels.h"
+#include "topics/safety.h"
+#include "topics/sensor_combined.h"
+#include "topics/servorail_status.h"
+#include "topics/subsystem_info.h"
+#include "topics/system_power.h"
+#include "topics/telemetry_status.h"
+#include "topics/vehicle_attitude.h"
+#include "topics/vehicle_attitude_setpoint.h"
+#include "topics/vehicle_bodyframe_speed_setpoint.h"
+#include "topics/vehicle_command.h"
+#include "topics/vehicle_control_debug.h"
+#include "topics/vehicle_control_mode.h"
+#include "topics/vehicle_global_position.h"
+#include "topics/vehicle_global_velocity_setpoint.h"
+#include "topics/vehicle_gps_position.h"
+#include "topics/vehicle_local_position.h"
+#include "topics/vehicle_local_position_setpoint.h"
+#include "topics/vehicle_rates_setpoint.h"
+#include "topics/vehicle_status.h"
+#include "topics/vehicle_vicon_position.h"
+
+#define __ORB_FIELD(_tag, _member, _count, _type) \
+	{ #_member, offsetof(struct _tag, _member), _count, _type }
+#define __ORB_FIELD_ENUM(_tag, _member, _count) \
+	__ORB_FIELD(_tag, _member, _count, ORB_FIELD_ENUM_TYPE(sizeof(((struct _tag *)0)->_member) / (_count)))
+
+static const struct orb_field __orb_fields_vehicle_attitude_s[] = {
+	__ORB_FIELD(vehicle_attitude_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_attitude_s, timestamp_sample, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_attitude_s, roll, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, pitch, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, yaw, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, rollspeed, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, pitchspeed, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, yawspeed, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, rollacc, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, pitchacc, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, yawacc, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, rate_offsets, 3, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, R, 3 * 3, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, q, 4, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, g_comp, 3, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_s, R_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_attitude_s, q_valid, 1, ORB_FIELD_BOOL),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_sensor_combined_s[] = {
+	__ORB_FIELD(sensor_combined_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(sensor_combined_s, gyro_raw, 3, ORB_FIELD_INT16),
+	__ORB_FIELD(sensor_combined_s, gyro_rad_s, 3, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, accelerometer_raw, 3, ORB_FIELD_INT16),
+	__ORB_FIELD(sensor_combined_s, accelerometer_m_s2, 3, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, accelerometer_mode, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(sensor_combined_s, accelerometer_range_m_s2, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, accelerometer_timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(sensor_combined_s, magnetometer_raw, 3, ORB_FIELD_INT16),
+	__ORB_FIELD(sensor_combined_s, magnetometer_ga, 3, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, magnetometer_mode, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(sensor_combined_s, magnetometer_range_ga, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, magnetometer_cuttoff_freq_hz, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, magnetometer_timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(sensor_combined_s, baro_pres_mbar, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, baro_alt_meter, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, baro_temp_celcius, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, adc_voltage_v, 4, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, mcu_temp_celcius, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, baro_timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(sensor_combined_s, differential_pressure_pa, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(sensor_combined_s, differential_pressure_timestamp, 1, ORB_FIELD_UINT64),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_gps_position_s[] = {
+	__ORB_FIELD(vehicle_gps_position_s, timestamp_position, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_gps_position_s, lat, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(vehicle_gps_position_s, lon, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(vehicle_gps_position_s, alt, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(vehicle_gps_position_s, timestamp_variance, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_gps_position_s, s_variance_m_s, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_gps_position_s, p_variance_m, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_gps_position_s, c_variance_rad, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_gps_position_s, fix_type, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_gps_position_s, eph_m, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_gps_position_s, epv_m, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_gps_position_s, timestamp_velocity, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_gps_position_s, vel_m_s, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_gps_position_s, vel_n_m_s, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_gps_position_s, vel_e_m_s, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_gps_position_s, vel_d_m_s, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_gps_position_s, cog_rad, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_gps_position_s, vel_ned_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_gps_position_s, timestamp_time, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_gps_position_s, time_gps_usec, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_gps_position_s, timestamp_satellites, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_gps_position_s, satellites_visible, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_gps_position_s, satellite_prn, 20, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_gps_position_s, satellite_used, 20, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_gps_position_s, satellite_elevation, 20, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_gps_position_s, satellite_azimuth, 20, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_gps_position_s, satellite_snr, 20, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_gps_position_s, satellite_info_available, 1, ORB_FIELD_BOOL),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_home_position_s[] = {
+	__ORB_FIELD(home_position_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(home_position_s, lat, 1, ORB_FIELD_DOUBLE),
+	__ORB_FIELD(home_position_s, lon, 1, ORB_FIELD_DOUBLE),
+	__ORB_FIELD(home_position_s, alt, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_status_s[] = {
+	__ORB_FIELD(vehicle_status_s, counter, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(vehicle_status_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD_ENUM(vehicle_status_s, main_state, 1),
+	__ORB_FIELD(vehicle_status_s, set_nav_state, 1, ORB_FIELD_UINT32),
+	__ORB_FIELD(vehicle_status_s, set_nav_state_timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD_ENUM(vehicle_status_s, arming_state, 1),
+	__ORB_FIELD_ENUM(vehicle_status_s, hil_state, 1),
+	__ORB_FIELD_ENUM(vehicle_status_s, failsafe_state, 1),
+	__ORB_FIELD(vehicle_status_s, system_type, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(vehicle_status_s, system_id, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(vehicle_status_s, component_id, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(vehicle_status_s, is_rotary_wing, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD_ENUM(vehicle_status_s, mode_switch, 1),
+	__ORB_FIELD_ENUM(vehicle_status_s, return_switch, 1),
+	__ORB_FIELD_ENUM(vehicle_status_s, assisted_switch, 1),
+	__ORB_FIELD_ENUM(vehicle_status_s, mission_switch, 1),
+	__ORB_FIELD(vehicle_status_s, condition_battery_voltage_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_system_in_air_restore, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_system_sensors_initialized, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_system_returned_to_home, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_auto_mission_available, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_global_position_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_launch_position_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_home_position_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_local_position_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_local_altitude_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_airspeed_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, condition_landed, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, rc_signal_found_once, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, rc_signal_lost, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, rc_input_blocked, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, offboard_control_signal_found_once, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, offboard_control_signal_lost, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, offboard_control_signal_weak, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, offboard_control_signal_lost_interval, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_status_s, data_link_found_once, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, data_link_lost, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_status_s, onboard_control_sensors_present, 1, ORB_FIELD_UINT32),
+	__ORB_FIELD(vehicle_status_s, onboard_control_sensors_enabled, 1, ORB_FIELD_UINT32),
+	__ORB_FIELD(vehicle_status_s, onboard_control_sensors_health, 1, ORB_FIELD_UINT32),
+	__ORB_FIELD(vehicle_status_s, load, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_status_s, battery_voltage, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_status_s, battery_current, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_status_s, battery_remaining, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD_ENUM(vehicle_status_s, battery_warning, 1),
+	__ORB_FIELD(vehicle_status_s, drop_rate_comm, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(vehicle_status_s, errors_comm, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(vehicle_status_s, errors_count1, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(vehicle_status_s, errors_count2, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(vehicle_status_s, errors_count3, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(vehicle_status_s, errors_count4, 1, ORB_FIELD_UINT16),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_safety_s[] = {
+	__ORB_FIELD(safety_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(safety_s, safety_switch_available, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(safety_s, safety_off, 1, ORB_FIELD_BOOL),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_battery_status_s[] = {
+	__ORB_FIELD(battery_status_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(battery_status_s, voltage_v, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(battery_status_s, voltage_filtered_v, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(battery_status_s, current_a, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(battery_status_s, discharged_mah, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_servorail_status_s[] = {
+	__ORB_FIELD(servorail_status_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(servorail_status_s, voltage_v, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(servorail_status_s, rssi_v, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_system_power_s[] = {
+	__ORB_FIELD(system_power_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(system_power_s, voltage5V_v, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_global_position_s[] = {
+	__ORB_FIELD(vehicle_global_position_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_global_position_s, global_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_global_position_s, baro_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_global_position_s, time_gps_usec, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_global_position_s, lat, 1, ORB_FIELD_DOUBLE),
+	__ORB_FIELD(vehicle_global_position_s, lon, 1, ORB_FIELD_DOUBLE),
+	__ORB_FIELD(vehicle_global_position_s, alt, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_global_position_s, vel_n, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_global_position_s, vel_e, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_global_position_s, vel_d, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_global_position_s, yaw, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_global_position_s, baro_alt, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_local_position_s[] = {
+	__ORB_FIELD(vehicle_local_position_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_local_position_s, xy_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_local_position_s, z_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_local_position_s, v_xy_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_local_position_s, v_z_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_local_position_s, x, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_s, y, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_s, z, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_s, vx, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_s, vy, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_s, vz, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_s, yaw, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_s, xy_global, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_local_position_s, z_global, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_local_position_s, ref_timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_local_position_s, ref_lat, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(vehicle_local_position_s, ref_lon, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(vehicle_local_position_s, ref_alt, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_s, landed, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_local_position_s, dist_bottom, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_s, dist_bottom_rate, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_s, surface_bottom_timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_local_position_s, dist_bottom_valid, 1, ORB_FIELD_BOOL),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_vicon_position_s[] = {
+	__ORB_FIELD(vehicle_vicon_position_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_vicon_position_s, valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_vicon_position_s, x, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_vicon_position_s, y, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_vicon_position_s, z, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_vicon_position_s, roll, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_vicon_position_s, pitch, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_vicon_position_s, yaw, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_rates_setpoint_s[] = {
+	__ORB_FIELD(vehicle_rates_setpoint_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_rates_setpoint_s, timestamp_sample, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_rates_setpoint_s, roll, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_rates_setpoint_s, pitch, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_rates_setpoint_s, yaw, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_rates_setpoint_s, thrust, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_rc_channels_s[] = {
+	__ORB_FIELD(rc_channels_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(rc_channels_s, timestamp_last_valid, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(rc_channels_s, chan[0].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[1].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[2].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[3].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[4].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[5].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[6].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[7].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[8].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[9].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[10].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[11].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[12].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[13].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan[14].scaled, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(rc_channels_s, chan_count, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(rc_channels_s, function_name, RC_CHANNELS_FUNCTION_MAX * 20, ORB_FIELD_CHAR),
+	__ORB_FIELD(rc_channels_s, function, RC_CHANNELS_FUNCTION_MAX, ORB_FIELD_INT8),
+	__ORB_FIELD(rc_channels_s, rssi, 1, ORB_FIELD_UINT8),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_command_s[] = {
+	__ORB_FIELD(vehicle_command_s, param1, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_command_s, param2, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_command_s, param3, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_command_s, param4, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_command_s, param5, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_command_s, param6, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_command_s, param7, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD_ENUM(vehicle_command_s, command, 1),
+	__ORB_FIELD(vehicle_command_s, target_system, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_command_s, target_component, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_command_s, source_system, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_command_s, source_component, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(vehicle_command_s, confirmation, 1, ORB_FIELD_UINT8),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_control_mode_s[] = {
+	__ORB_FIELD(vehicle_control_mode_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_control_mode_s, flag_armed, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_external_manual_override_ok, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_system_hil_enabled, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_control_manual_enabled, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_control_auto_enabled, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_control_rates_enabled, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_control_attitude_enabled, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_control_velocity_enabled, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_control_position_enabled, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_control_altitude_enabled, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_control_climb_rate_enabled, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_control_mode_s, flag_control_termination_enabled, 1, ORB_FIELD_BOOL),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_local_position_setpoint_s[] = {
+	__ORB_FIELD(vehicle_local_position_setpoint_s, x, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_setpoint_s, y, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_setpoint_s, z, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_local_position_setpoint_s, yaw, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_bodyframe_speed_setpoint_s[] = {
+	__ORB_FIELD(vehicle_bodyframe_speed_setpoint_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_bodyframe_speed_setpoint_s, vx, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_bodyframe_speed_setpoint_s, vy, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_bodyframe_speed_setpoint_s, thrust_sp, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_bodyframe_speed_setpoint_s, yaw_sp, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_position_setpoint_triplet_s[] = {
+	__ORB_FIELD(position_setpoint_triplet_s, previous.valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD_ENUM(position_setpoint_triplet_s, previous.type, 1),
+	__ORB_FIELD(position_setpoint_triplet_s, previous.lat, 1, ORB_FIELD_DOUBLE),
+	__ORB_FIELD(position_setpoint_triplet_s, previous.lon, 1, ORB_FIELD_DOUBLE),
+	__ORB_FIELD(position_setpoint_triplet_s, previous.alt, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, previous.yaw, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, previous.loiter_radius, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, previous.loiter_direction, 1, ORB_FIELD_INT8),
+	__ORB_FIELD(position_setpoint_triplet_s, previous.pitch_min, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, current.valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD_ENUM(position_setpoint_triplet_s, current.type, 1),
+	__ORB_FIELD(position_setpoint_triplet_s, current.lat, 1, ORB_FIELD_DOUBLE),
+	__ORB_FIELD(position_setpoint_triplet_s, current.lon, 1, ORB_FIELD_DOUBLE),
+	__ORB_FIELD(position_setpoint_triplet_s, current.alt, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, current.yaw, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, current.loiter_radius, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, current.loiter_direction, 1, ORB_FIELD_INT8),
+	__ORB_FIELD(position_setpoint_triplet_s, current.pitch_min, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, next.valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD_ENUM(position_setpoint_triplet_s, next.type, 1),
+	__ORB_FIELD(position_setpoint_triplet_s, next.lat, 1, ORB_FIELD_DOUBLE),
+	__ORB_FIELD(position_setpoint_triplet_s, next.lon, 1, ORB_FIELD_DOUBLE),
+	__ORB_FIELD(position_setpoint_triplet_s, next.alt, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, next.yaw, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, next.loiter_radius, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(position_setpoint_triplet_s, next.loiter_direction, 1, ORB_FIELD_INT8),
+	__ORB_FIELD(position_setpoint_triplet_s, next.pitch_min, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD_ENUM(position_setpoint_triplet_s, nav_state, 1),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_global_velocity_setpoint_s[] = {
+	__ORB_FIELD(vehicle_global_velocity_setpoint_s, vx, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_global_velocity_setpoint_s, vy, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_global_velocity_setpoint_s, vz, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_mission_s[] = {
+	__ORB_FIELD(mission_s, dataman_id, 1, ORB_FIELD_INT32),
+	__ORB_FIELD(mission_s, count, 1, ORB_FIELD_UINT32),
+	__ORB_FIELD(mission_s, current_index, 1, ORB_FIELD_INT32),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_mission_result_s[] = {
+	__ORB_FIELD(mission_result_s, mission_reached, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(mission_result_s, mission_index_reached, 1, ORB_FIELD_UINT32),
+	__ORB_FIELD(mission_result_s, index_current_mission, 1, ORB_FIELD_UINT32),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_attitude_setpoint_s[] = {
+	__ORB_FIELD(vehicle_attitude_setpoint_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, roll_body, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, pitch_body, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, yaw_body, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, R_body, 3 * 3, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, R_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, q_d, 4, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, q_d_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, q_e, 4, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, q_e_valid, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, thrust, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_attitude_setpoint_s, roll_reset_integral, 1, ORB_FIELD_BOOL),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_manual_control_setpoint_s[] = {
+	__ORB_FIELD(manual_control_setpoint_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(manual_control_setpoint_s, roll, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, pitch, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, yaw, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, throttle, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, mode_switch, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, return_switch, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, assisted_switch, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, mission_switch, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, flaps, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, aux1, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, aux2, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, aux3, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, aux4, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(manual_control_setpoint_s, aux5, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_vehicle_control_debug_s[] = {
+	__ORB_FIELD(vehicle_control_debug_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(vehicle_control_debug_s, roll_p, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, roll_i, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, roll_d, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, roll_rate_p, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, roll_rate_i, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, roll_rate_d, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, pitch_p, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, pitch_i, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, pitch_d, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, pitch_rate_p, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, pitch_rate_i, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, pitch_rate_d, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, yaw_p, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, yaw_i, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, yaw_d, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, yaw_rate_p, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, yaw_rate_i, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(vehicle_control_debug_s, yaw_rate_d, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_offboard_control_setpoint_s[] = {
+	__ORB_FIELD(offboard_control_setpoint_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD_ENUM(offboard_control_setpoint_s, mode, 1),
+	__ORB_FIELD(offboard_control_setpoint_s, armed, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(offboard_control_setpoint_s, p1, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(offboard_control_setpoint_s, p2, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(offboard_control_setpoint_s, p3, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(offboard_control_setpoint_s, p4, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(offboard_control_setpoint_s, override_mode_switch, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(offboard_control_setpoint_s, aux1_cam_pan_flaps, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(offboard_control_setpoint_s, aux2_cam_tilt, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(offboard_control_setpoint_s, aux3_cam_zoom, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(offboard_control_setpoint_s, aux4_cam_roll, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_optical_flow_s[] = {
+	__ORB_FIELD(optical_flow_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(optical_flow_s, flow_raw_x, 1, ORB_FIELD_INT16),
+	__ORB_FIELD(optical_flow_s, flow_raw_y, 1, ORB_FIELD_INT16),
+	__ORB_FIELD(optical_flow_s, flow_comp_x_m, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(optical_flow_s, flow_comp_y_m, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(optical_flow_s, ground_distance_m, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(optical_flow_s, quality, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(optical_flow_s, sensor_id, 1, ORB_FIELD_UINT8),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_filtered_bottom_flow_s[] = {
+	__ORB_FIELD(filtered_bottom_flow_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(filtered_bottom_flow_s, sumx, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(filtered_bottom_flow_s, sumy, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(filtered_bottom_flow_s, vx, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(filtered_bottom_flow_s, vy, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_omnidirectional_flow_s[] = {
+	__ORB_FIELD(omnidirectional_flow_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(omnidirectional_flow_s, left, 10, ORB_FIELD_UINT16),
+	__ORB_FIELD(omnidirectional_flow_s, right, 10, ORB_FIELD_UINT16),
+	__ORB_FIELD(omnidirectional_flow_s, front_distance_m, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(omnidirectional_flow_s, quality, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(omnidirectional_flow_s, sensor_id, 1, ORB_FIELD_UINT8),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_airspeed_s[] = {
+	__ORB_FIELD(airspeed_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(airspeed_s, indicated_airspeed_m_s, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(airspeed_s, true_airspeed_m_s, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_differential_pressure_s[] = {
+	__ORB_FIELD(differential_pressure_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(differential_pressure_s, error_count, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(differential_pressure_s, differential_pressure_pa, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(differential_pressure_s, differential_pressure_raw_pa, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(differential_pressure_s, max_differential_pressure_pa, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(differential_pressure_s, voltage, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(differential_pressure_s, temperature, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_subsystem_info_s[] = {
+	__ORB_FIELD(subsystem_info_s, present, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(subsystem_info_s, enabled, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(subsystem_info_s, ok, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD_ENUM(subsystem_info_s, subsystem_type, 1),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_actuator_controls_s[] = {
+	__ORB_FIELD(actuator_controls_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(actuator_controls_s, timestamp_sample, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(actuator_controls_s, control, NUM_ACTUATOR_CONTROLS, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_actuator_armed_s[] = {
+	__ORB_FIELD(actuator_armed_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(actuator_armed_s, armed, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(actuator_armed_s, ready_to_arm, 1, ORB_FIELD_BOOL),
+	__ORB_FIELD(actuator_armed_s, lockdown, 1, ORB_FIELD_BOOL),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_actuator_outputs_s[] = {
+	__ORB_FIELD(actuator_outputs_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(actuator_outputs_s, timestamp_sample, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(actuator_outputs_s, output, NUM_ACTUATOR_OUTPUTS, ORB_FIELD_FLOAT),
+	__ORB_FIELD(actuator_outputs_s, noutputs, 1, ORB_FIELD_UINT32),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_telemetry_status_s[] = {
+	__ORB_FIELD(telemetry_status_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD_ENUM(telemetry_status_s, type, 1),
+	__ORB_FIELD(telemetry_status_s, rssi, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(telemetry_status_s, remote_rssi, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(telemetry_status_s, rxerrors, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(telemetry_status_s, fixed, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(telemetry_status_s, noise, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(telemetry_status_s, remote_noise, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD(telemetry_status_s, txbuf, 1, ORB_FIELD_UINT8),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_debug_key_value_s[] = {
+	__ORB_FIELD(debug_key_value_s, timestamp_ms, 1, ORB_FIELD_UINT32),
+	__ORB_FIELD(debug_key_value_s, key, 10, ORB_FIELD_CHAR),
+	__ORB_FIELD(debug_key_value_s, value, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_navigation_capabilities_s[] = {
+	__ORB_FIELD(navigation_capabilities_s, turn_distance, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(navigation_capabilities_s, landing_horizontal_slope_displacement, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(navigation_capabilities_s, landing_slope_angle_rad, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(navigation_capabilities_s, landing_flare_length, 1, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_esc_status_s[] = {
+	__ORB_FIELD(esc_status_s, counter, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(esc_status_s, esc_count, 1, ORB_FIELD_UINT8),
+	__ORB_FIELD_ENUM(esc_status_s, esc_connectiontype, 1),
+	__ORB_FIELD(esc_status_s, esc[0].esc_address, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD_ENUM(esc_status_s, esc[0].esc_vendor, 1),
+	__ORB_FIELD(esc_status_s, esc[0].esc_version, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[0].esc_voltage, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[0].esc_current, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[0].esc_rpm, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[0].esc_temperature, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[0].esc_setpoint, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(esc_status_s, esc[0].esc_setpoint_raw, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[0].esc_state, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[0].esc_errorcount, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[1].esc_address, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD_ENUM(esc_status_s, esc[1].esc_vendor, 1),
+	__ORB_FIELD(esc_status_s, esc[1].esc_version, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[1].esc_voltage, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[1].esc_current, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[1].esc_rpm, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[1].esc_temperature, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[1].esc_setpoint, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(esc_status_s, esc[1].esc_setpoint_raw, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[1].esc_state, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[1].esc_errorcount, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[2].esc_address, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD_ENUM(esc_status_s, esc[2].esc_vendor, 1),
+	__ORB_FIELD(esc_status_s, esc[2].esc_version, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[2].esc_voltage, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[2].esc_current, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[2].esc_rpm, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[2].esc_temperature, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[2].esc_setpoint, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(esc_status_s, esc[2].esc_setpoint_raw, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[2].esc_state, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[2].esc_errorcount, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[3].esc_address, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD_ENUM(esc_status_s, esc[3].esc_vendor, 1),
+	__ORB_FIELD(esc_status_s, esc[3].esc_version, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[3].esc_voltage, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[3].esc_current, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[3].esc_rpm, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[3].esc_temperature, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[3].esc_setpoint, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(esc_status_s, esc[3].esc_setpoint_raw, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[3].esc_state, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[3].esc_errorcount, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[4].esc_address, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD_ENUM(esc_status_s, esc[4].esc_vendor, 1),
+	__ORB_FIELD(esc_status_s, esc[4].esc_version, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[4].esc_voltage, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[4].esc_current, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[4].esc_rpm, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[4].esc_temperature, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[4].esc_setpoint, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(esc_status_s, esc[4].esc_setpoint_raw, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[4].esc_state, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[4].esc_errorcount, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[5].esc_address, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD_ENUM(esc_status_s, esc[5].esc_vendor, 1),
+	__ORB_FIELD(esc_status_s, esc[5].esc_version, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[5].esc_voltage, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[5].esc_current, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[5].esc_rpm, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[5].esc_temperature, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[5].esc_setpoint, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(esc_status_s, esc[5].esc_setpoint_raw, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[5].esc_state, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[5].esc_errorcount, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[6].esc_address, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD_ENUM(esc_status_s, esc[6].esc_vendor, 1),
+	__ORB_FIELD(esc_status_s, esc[6].esc_version, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[6].esc_voltage, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[6].esc_current, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[6].esc_rpm, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[6].esc_temperature, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[6].esc_setpoint, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(esc_status_s, esc[6].esc_setpoint_raw, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[6].esc_state, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[6].esc_errorcount, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[7].esc_address, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD_ENUM(esc_status_s, esc[7].esc_vendor, 1),
+	__ORB_FIELD(esc_status_s, esc[7].esc_version, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[7].esc_voltage, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[7].esc_current, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[7].esc_rpm, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[7].esc_temperature, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[7].esc_setpoint, 1, ORB_FIELD_FLOAT),
+	__ORB_FIELD(esc_status_s, esc[7].esc_setpoint_raw, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[7].esc_state, 1, ORB_FIELD_UINT16),
+	__ORB_FIELD(esc_status_s, esc[7].esc_errorcount, 1, ORB_FIELD_UINT16),
+	{ NULL, 0, 0, 0 }
+};
+
+static const struct orb_field __orb_fields_encoders_s[] = {
+	__ORB_FIELD(encoders_s, timestamp, 1, ORB_FIELD_UINT64),
+	__ORB_FIELD(encoders_s, counts, NUM_ENCODERS, ORB_FIELD_INT64),
+	__ORB_FIELD(encoders_s, velocity, NUM_ENCODERS, ORB_FIELD_FLOAT),
+	{ NULL, 0, 0, 0 }
+};
+
+#define ORB_TOPICS_WITH_FIELDS \
+	ORB_ID(vehicle_attitude), \
+	ORB_ID(sensor_combined), \
+	ORB_ID(vehicle_gps_position), \
+	ORB_ID(home_position), \
+	ORB_ID(vehicle_status), \
+	ORB_ID(safety), \
+	ORB_ID(battery_status), \
+	ORB_ID(servorail_status), \
+	ORB_ID(system_power), \
+	ORB_ID(vehicle_global_position), \
+	ORB_ID(vehicle_local_position), \
+	ORB_ID(vehicle_vicon_position), \
+	ORB_ID(vehicle_rates_setpoint), \
+	ORB_ID(rc_channels), \
+	ORB_ID(vehicle_command), \
+	ORB_ID(vehicle_control_mode), \
+	ORB_ID(vehicle_local_position_setpoint), \
+	ORB_ID(vehicle_bodyframe_speed_setpoint), \
+	ORB_ID(position_setpoint_triplet), \
+	ORB_ID(vehicle_global_velocity_setpoint), \
+	ORB_ID(mission), \
+	ORB_ID(onboard_mission), \
+	ORB_ID(mission_result), \
+	ORB_ID(vehicle_attitude_setpoint), \
+	ORB_ID(manual_control_setpoint), \
+	ORB_ID(vehicle_control_debug), \
+	ORB_ID(offboard_control_setpoint), \
+	ORB_ID(optical_flow), \
+	ORB_ID(filtered_bottom_flow), \
+	ORB_ID(omnidirectional_flow), \
+	ORB_ID(airspeed), \
+	ORB_ID(differential_pressure), \
+	ORB_ID(subsystem_info), \
+	ORB_ID(actuator_controls_0), \
+	ORB_ID(actuator_controls_1), \
+	ORB_ID(actuator_controls_2), \
+	ORB_ID(actuator_controls_3), \
+	ORB_ID(actuator_armed), \
+	ORB_ID(actuator_outputs_0), \
+	ORB_ID(actuator_outputs_1), \
+	ORB_ID(actuator_outputs_2), \
+	ORB_ID(actuator_outputs_3), \
+	ORB_ID(telemetry_status), \
+	ORB_ID(debug_key_value), \
+	ORB_ID(navigation_capabilities), \
+	ORB_ID(esc_status), \
+	ORB_ID(encoders),
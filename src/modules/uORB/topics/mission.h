@@ -46,7 +46,7 @@
 #include <stdbool.h>
 #include "../uORB.h"
 
-#define NUM_MISSIONS_SUPPORTED 256
+#define NUM_MISSIONS_SUPPORTED 2000
 
 /* compatible to mavlink MAV_CMD */
 enum NAV_CMD {
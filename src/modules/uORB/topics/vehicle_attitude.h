@@ -59,6 +59,7 @@
 struct vehicle_attitude_s {
 
 	uint64_t timestamp;	/**< in microseconds since system start          */
+	uint64_t timestamp_sample;	/**< timestamp of the sensor_combined sample the estimate is based on */
 
 	/* This is similar to the mavlink message ATTITUDE, but for onboard use */
 
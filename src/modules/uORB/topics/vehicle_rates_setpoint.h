@@ -50,6 +50,7 @@
 struct vehicle_rates_setpoint_s
 {
 	uint64_t timestamp; /**< in microseconds since system start */
+	uint64_t timestamp_sample; /**< timestamp of the sensor sample the setpoint is derived from, 0 if unknown */
 
 	float roll;	/**< body angular rates in NED frame		*/
 	float pitch;	/**< body angular rates in NED frame		*/
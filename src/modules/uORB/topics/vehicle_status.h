@@ -215,6 +215,9 @@ struct vehicle_status_s
 	bool offboard_control_signal_weak;
 	uint64_t offboard_control_signal_lost_interval;	/**< interval in microseconds without an offboard control message */
 
+	bool data_link_found_once;
+	bool data_link_lost;				/**< true if the telemetry radio stopped reporting its status */
+
 	/* see SYS_STATUS mavlink message for the following */
 	uint32_t onboard_control_sensors_present;
 	uint32_t onboard_control_sensors_enabled;
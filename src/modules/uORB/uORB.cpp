@@ -82,13 +82,24 @@ enum Flavor {
 };
 
 int
-node_mkpath(char *buf, Flavor f, const struct orb_metadata *meta)
+node_mkpath(char *buf, Flavor f, const struct orb_metadata *meta, int instance = 0)
 {
 	unsigned len;
 
-	len = snprintf(buf, orb_maxpath, "/%s/%s",
-		       (f == PUBSUB) ? "obj" : "param",
-		       meta->o_name);
+	if ((instance < 0) || (instance >= ORB_MULTI_MAX_INSTANCES))
+		return -EINVAL;
+
+	/* instance 0 keeps the plain topic name */
+	if (instance == 0) {
+		len = snprintf(buf, orb_maxpath, "/%s/%s",
+			       (f == PUBSUB) ? "obj" : "param",
+			       meta->o_name);
+
+	} else {
+		len = snprintf(buf, orb_maxpath, "/%s/%s%d",
+			       (f == PUBSUB) ? "obj" : "param",
+			       meta->o_name, instance);
+	}
 
 	if (len >= orb_maxpath)
 		return -ENAMETOOLONG;
@@ -556,25 +567,25 @@ ORBDevMaster::ioctl(struct file *filp, int cmd, unsigned long arg)
 
 	switch (cmd) {
 	case ORBIOCADVERTISE: {
-			const struct orb_metadata *meta = (const struct orb_metadata *)arg;
+			const struct orb_advertdata *adv = (const struct orb_advertdata *)arg;
 			const char *objname;
 			char nodepath[orb_maxpath];
 			ORBDevNode *node;
 
 			/* construct a path to the node - this also checks the node name */
-			ret = node_mkpath(nodepath, _flavor, meta);
+			ret = node_mkpath(nodepath, _flavor, adv->meta, adv->instance);
 
 			if (ret != OK)
 				return ret;
 
 			/* driver wants a permanent copy of the node name, so make one here */
-			objname = strdup(meta->o_name);
+			objname = strdup(strrchr(nodepath, '/') + 1);
 
 			if (objname == nullptr)
 				return -ENOMEM;
 
 			/* construct the new node */
-			node = new ORBDevNode(meta, objname, nodepath);
+			node = new ORBDevNode(adv->meta, objname, nodepath);
 
 			/* initialise the node - this may fail if e.g. a node with this name already exists */
 			if (node != nullptr)
@@ -700,6 +711,53 @@ test()
 	orb_unsubscribe(sfd);
 	close(pfd);
 
+	/* multi-instance: instance 0 is taken above, so we get the next ones */
+	int instance0, instance1;
+	int sfd0, sfd1;
+
+	t.val = 10;
+	orb_advert_t pfd0 = orb_advertise_multi(ORB_ID(orb_test), &t, &instance0);
+	t.val = 11;
+	orb_advert_t pfd1 = orb_advertise_multi(ORB_ID(orb_test), &t, &instance1);
+
+	/* nodes are never removed, repeated test runs use up the instances */
+	if ((pfd0 < 0 || pfd1 < 0) && errno == EBUSY)
+		return test_note("PASS, all instances taken, multi-instance test skipped");
+
+	if (pfd0 < 0 || pfd1 < 0)
+		return test_fail("multi advertise failed: %d", errno);
+
+	if (instance0 == 0 || instance1 == instance0)
+		return test_fail("multi instances %d and %d", instance0, instance1);
+
+	test_note("multi instances %d and %d, %u published", instance0, instance1, orb_group_count(ORB_ID(orb_test)));
+
+	if (OK != orb_exists(ORB_ID(orb_test), instance1))
+		return test_fail("instance %d does not exist", instance1);
+
+	sfd0 = orb_subscribe_multi(ORB_ID(orb_test), instance0);
+	sfd1 = orb_subscribe_multi(ORB_ID(orb_test), instance1);
+
+	if (sfd0 < 0 || sfd1 < 0)
+		return test_fail("multi subscribe failed: %d", errno);
+
+	t.val = 12;
+
+	if (OK != orb_publish(ORB_ID(orb_test), pfd1, &t))
+		return test_fail("multi publish failed");
+
+	if (OK != orb_check(sfd0, &updated) || updated)
+		return test_fail("instance %d updated by instance %d", instance0, instance1);
+
+	if (OK != orb_copy(ORB_ID(orb_test), sfd0, &u) || u.val != 10)
+		return test_fail("multi copy(0) mismatch: %d expected 10", u.val);
+
+	if (OK != orb_copy(ORB_ID(orb_test), sfd1, &u) || u.val != 12)
+		return test_fail("multi copy(1) mismatch: %d expected 12", u.val);
+
+	orb_unsubscribe(sfd0);
+	orb_unsubscribe(sfd1);
+
 #if 0
 	/* this is a hacky test that exploits the sensors app to test rate-limiting */
 
@@ -837,10 +895,11 @@ void debug(const char *fmt, ...)
  *       we tried to advertise.
  */
 int
-node_advertise(const struct orb_metadata *meta)
+node_advertise(const struct orb_metadata *meta, int instance)
 {
 	int fd = -1;
 	int ret = ERROR;
+	struct orb_advertdata adv = { meta, instance };
 
 	/* open the control device */
 	fd = open(TOPIC_MASTER_DEVICE_PATH, 0);
@@ -849,7 +908,7 @@ node_advertise(const struct orb_metadata *meta)
 		goto out;
 
 	/* advertise the object */
-	ret = ioctl(fd, ORBIOCADVERTISE, (unsigned long)(uintptr_t)meta);
+	ret = ioctl(fd, ORBIOCADVERTISE, (unsigned long)(uintptr_t)&adv);
 
 	/* it's OK if it already exists */
 	if ((OK != ret) && (EEXIST == errno))
@@ -870,7 +929,7 @@ out:
  * advertisers.
  */
 int
-node_open(Flavor f, const struct orb_metadata *meta, const void *data, bool advertiser)
+node_open(Flavor f, const struct orb_metadata *meta, const void *data, bool advertiser, int instance = 0)
 {
 	char path[orb_maxpath];
 	int fd, ret;
@@ -895,7 +954,7 @@ node_open(Flavor f, const struct orb_metadata *meta, const void *data, bool adve
 	/*
 	 * Generate the path to the node and try to open it.
 	 */
-	ret = node_mkpath(path, f, meta);
+	ret = node_mkpath(path, f, meta, instance);
 
 	if (ret != OK) {
 		errno = -ret;
@@ -909,7 +968,7 @@ node_open(Flavor f, const struct orb_metadata *meta, const void *data, bool adve
 	if (fd < 0) {
 
 		/* try to create the node */
-		ret = node_advertise(meta);
+		ret = node_advertise(meta, instance);
 
 		/* on success, try the open again */
 		if (ret == OK)
@@ -952,12 +1011,65 @@ orb_advertise(const struct orb_metadata *meta, const void *data)
 	return advertiser;
 }
 
+orb_advert_t
+orb_advertise_multi(const struct orb_metadata *meta, const void *data, int *instance)
+{
+	for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++) {
+		int result, fd;
+		hrt_abstime last_update;
+		orb_advert_t advertiser;
+
+		/*
+		 * Open the instance as the advertiser; this fails while another
+		 * advertiser has it open, so the check and the initial publication
+		 * below cannot race with another orb_advertise_multi().
+		 */
+		fd = node_open(PUBSUB, meta, data, true, i);
+
+		if (fd == ERROR) {
+			if (errno == ENOENT || errno == EINVAL)
+				return ERROR;
+
+			continue;
+		}
+
+		/* someone has published this instance before, try the next one */
+		if ((ioctl(fd, ORBIOCLASTUPDATE, (unsigned long)&last_update) != OK) || (last_update != 0)) {
+			close(fd);
+			continue;
+		}
+
+		result = ioctl(fd, ORBIOCGADVERTISER, (unsigned long)&advertiser);
+
+		/* the advertiser must perform an initial publish to initialise the object */
+		if (result == OK)
+			result = orb_publish(meta, advertiser, data);
+
+		close(fd);
+
+		if (result == ERROR)
+			return ERROR;
+
+		*instance = i;
+		return advertiser;
+	}
+
+	errno = EBUSY;
+	return ERROR;
+}
+
 int
 orb_subscribe(const struct orb_metadata *meta)
 {
 	return node_open(PUBSUB, meta, nullptr, false);
 }
 
+int
+orb_subscribe_multi(const struct orb_metadata *meta, unsigned instance)
+{
+	return node_open(PUBSUB, meta, nullptr, false, instance);
+}
+
 int
 orb_unsubscribe(int handle)
 {
@@ -1006,3 +1118,37 @@ orb_set_interval(int handle, unsigned interval)
 	return ioctl(handle, ORBIOCSETINTERVAL, interval * 1000);
 }
 
+int
+orb_exists(const struct orb_metadata *meta, int instance)
+{
+	char path[orb_maxpath];
+	hrt_abstime last_update = 0;
+	int fd;
+
+	if ((meta == nullptr) || (node_mkpath(path, PUBSUB, meta, instance) != OK))
+		return ERROR;
+
+	/* do not create the node if it does not exist */
+	fd = open(path, O_RDONLY);
+
+	if (fd < 0)
+		return ERROR;
+
+	ioctl(fd, ORBIOCLASTUPDATE, (unsigned long)&last_update);
+	close(fd);
+
+	return (last_update != 0) ? OK : ERROR;
+}
+
+unsigned
+orb_group_count(const struct orb_metadata *meta)
+{
+	unsigned count = 0;
+
+	for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++) {
+		if (orb_exists(meta, i) == OK)
+			count++;
+	}
+
+	return count;
+}
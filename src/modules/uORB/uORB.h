@@ -40,18 +40,58 @@
  */
 
 #include <sys/types.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 // Hack until everything is using this header
 #include <systemlib/visibility.h>
 
+/**
+ * Field types used in topic field layout descriptors.
+ */
+enum orb_field_type {
+	ORB_FIELD_INT8 = 0,
+	ORB_FIELD_UINT8,
+	ORB_FIELD_INT16,
+	ORB_FIELD_UINT16,
+	ORB_FIELD_INT32,
+	ORB_FIELD_UINT32,
+	ORB_FIELD_INT64,
+	ORB_FIELD_UINT64,
+	ORB_FIELD_FLOAT,
+	ORB_FIELD_DOUBLE,
+	ORB_FIELD_BOOL,
+	ORB_FIELD_CHAR,
+	ORB_FIELD_TYPE_COUNT
+};
+
+/**
+ * Selects the integer field type matching the size of an enum member.
+ */
+#define ORB_FIELD_ENUM_TYPE(_size)	((_size) == 1 ? ORB_FIELD_INT8 : ((_size) == 2 ? ORB_FIELD_INT16 : ORB_FIELD_INT32))
+
+/**
+ * Layout descriptor of one (possibly array) field of a topic struct.
+ *
+ * Descriptors are generated from the topic headers by
+ * Tools/px_generate_uorb_topic_fields.py; a list is terminated
+ * by an entry with a NULL name.
+ */
+struct orb_field {
+	const char *name;		/**< member designator, e.g. "g_comp" or "current.lat" */
+	uint16_t offset;		/**< offset of the field in the struct */
+	uint16_t count;			/**< number of array elements, 1 for scalars */
+	uint8_t type;			/**< element type, see enum orb_field_type */
+};
+
 /**
  * Object metadata.
  */
 struct orb_metadata {
 	const char *o_name;		/**< unique object name */
 	const size_t o_size;		/**< object size */
+	const struct orb_field *o_fields;	/**< field layout or NULL if unknown */
 };
 
 typedef const struct orb_metadata *orb_id_t;
@@ -101,7 +141,26 @@ typedef const struct orb_metadata *orb_id_t;
 #define ORB_DEFINE(_name, _struct)			\
 	const struct orb_metadata __orb_##_name = {	\
 		#_name,					\
-		sizeof(_struct)				\
+		sizeof(_struct),			\
+		NULL					\
+	}; struct hack
+
+/**
+ * Define (instantiate) the uORB metadata for a topic, including its
+ * field layout.
+ *
+ * The field layout is taken from the descriptor generated for the struct
+ * in topic_fields.h, so this is only usable where that header is included.
+ *
+ * @param _name		The name of the topic.
+ * @param _tag		The tag of the structure the topic provides,
+ *			without the 'struct' keyword.
+ */
+#define ORB_DEFINE_FIELDS(_name, _tag)			\
+	const struct orb_metadata __orb_##_name = {	\
+		#_name,					\
+		sizeof(struct _tag),			\
+		__orb_fields_##_tag			\
 	}; struct hack
 
 __BEGIN_DECLS
@@ -140,6 +199,31 @@ typedef intptr_t	orb_advert_t;
  */
 extern orb_advert_t orb_advertise(const struct orb_metadata *meta, const void *data) __EXPORT;
 
+/**
+ * Maximum number of instances of one topic, see orb_advertise_multi().
+ */
+#define ORB_MULTI_MAX_INSTANCES	4
+
+/**
+ * Advertise as the publisher of a new instance of a topic.
+ *
+ * This lets several publishers of the same kind of data, e.g. redundant
+ * sensors, publish in parallel: each advertisement takes the lowest
+ * instance that has not been published yet. Instance 0 is the node that
+ * orb_advertise() and orb_subscribe() use, so existing subscribers see the
+ * first publisher.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @param data		A pointer to the initial data to be published.
+ * @param instance	Set to the instance of the topic that was advertised.
+ * @return		ERROR on error, otherwise returns a handle
+ *			that can be used to publish to the topic.
+ *			If all ORB_MULTI_MAX_INSTANCES instances are taken
+ *			this function will return -1 and set errno to EBUSY.
+ */
+extern orb_advert_t orb_advertise_multi(const struct orb_metadata *meta, const void *data, int *instance) __EXPORT;
+
 /**
  * Publish new data to a topic.
  *
@@ -183,6 +267,20 @@ extern int	orb_publish(const struct orb_metadata *meta, orb_advert_t handle, con
  */
 extern int	orb_subscribe(const struct orb_metadata *meta) __EXPORT;
 
+/**
+ * Subscribe to an instance of a topic.
+ *
+ * Behaves like orb_subscribe(), which is the same as subscribing to
+ * instance 0. The instance does not need to be advertised yet.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @param instance	The instance of the topic, 0 ... ORB_MULTI_MAX_INSTANCES - 1.
+ * @return		ERROR on error, otherwise returns a handle
+ *			that can be used to read and update the topic.
+ */
+extern int	orb_subscribe_multi(const struct orb_metadata *meta, unsigned instance) __EXPORT;
+
 /**
  * Unsubscribe from a topic.
  *
@@ -259,6 +357,36 @@ extern int	orb_stat(int handle, uint64_t *time) __EXPORT;
  */
 extern int	orb_set_interval(int handle, unsigned interval) __EXPORT;
 
+/**
+ * Check whether an instance of a topic has been published.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @param instance	The instance of the topic.
+ * @return		OK if the instance has been published, ERROR otherwise.
+ */
+extern int	orb_exists(const struct orb_metadata *meta, int instance) __EXPORT;
+
+/**
+ * Count the published instances of a topic.
+ *
+ * @param meta		The uORB metadata (usually from the ORB_ID() macro)
+ *			for the topic.
+ * @return		The number of instances that have been published.
+ */
+extern unsigned	orb_group_count(const struct orb_metadata *meta) __EXPORT;
+
+/**
+ * Look up the metadata of a topic that has a field layout.
+ *
+ * Only topics defined with ORB_DEFINE_FIELDS() can be found; this lets
+ * generic consumers such as loggers handle topics by name.
+ *
+ * @param name		The name of the topic, e.g. "vehicle_attitude".
+ * @return		The topic metadata, or NULL if no such topic is known.
+ */
+extern orb_id_t	orb_find_topic(const char *name) __EXPORT;
+
 __END_DECLS
 
 #endif /* _UORB_UORB_H */
@@ -0,0 +1,98 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file boottrace.c
+ *
+ * Record, wait for and show boot trace marks.
+ */
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <systemlib/err.h>
+#include <systemlib/boot_trace.h>
+
+__EXPORT int boottrace_main(int argc, char *argv[]);
+
+static void
+usage(const char *reason)
+{
+	if (reason != NULL)
+		warnx("%s", reason);
+
+	errx(1, "usage: boottrace {mark <label>|wait <label> [<timeout ms>]|show}");
+}
+
+int
+boottrace_main(int argc, char *argv[])
+{
+	if (argc < 2)
+		usage(NULL);
+
+	if (!strcmp(argv[1], "mark")) {
+		if (argc < 3)
+			usage("missing label");
+
+		boot_trace_mark(argv[2]);
+		exit(0);
+	}
+
+	if (!strcmp(argv[1], "wait")) {
+		if (argc < 3)
+			usage("missing label");
+
+		/* wait for a script or app running in the background to reach a mark */
+		unsigned timeout = (argc > 3) ? strtoul(argv[3], NULL, 0) : 5000;
+
+		for (unsigned waited = 0; boot_trace_find(argv[2]) == 0; waited += 10) {
+			if (waited >= timeout)
+				errx(1, "timeout waiting for %s", argv[2]);
+
+			usleep(10000);
+		}
+
+		exit(0);
+	}
+
+	if (!strcmp(argv[1], "show")) {
+		boot_trace_print();
+		exit(0);
+	}
+
+	usage("unrecognised command");
+}
@@ -138,19 +138,9 @@ param_main(int argc, char *argv[])
 static void
 do_save(const char* param_file_name)
 {
-	/* create the file */
-	int fd = open(param_file_name, O_WRONLY | O_CREAT);
-
-	if (fd < 0)
-		err(1, "opening '%s' failed", param_file_name);
-
-	int result = param_export(fd, false);
-	close(fd);
-
-	if (result < 0) {
-		(void)unlink(param_file_name);
+	/* the MTD partition must be written as a journal, a BSON export would leave stale bank headers */
+	if (param_save_file(param_file_name) != OK)
 		errx(1, "error exporting to '%s'", param_file_name);
-	}
 
 	exit(0);
 }
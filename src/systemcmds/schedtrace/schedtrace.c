@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file schedtrace.c
+ *
+ * Record context switches for a timeline view of the scheduler.
+ */
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <systemlib/err.h>
+#include <systemlib/cpuload.h>
+
+__EXPORT int schedtrace_main(int argc, char *argv[]);
+
+static void
+usage(const char *reason)
+{
+	if (reason != NULL)
+		warnx("%s", reason);
+
+	errx(1, "usage: schedtrace {start [<events>]|stop [<file>]|status}");
+}
+
+int
+schedtrace_main(int argc, char *argv[])
+{
+	if (argc < 2)
+		usage(NULL);
+
+	if (!strcmp(argv[1], "start")) {
+		/* 8 bytes per switch, the default covers about a second of a busy system */
+		unsigned size = (argc > 2) ? strtoul(argv[2], NULL, 0) : 2048;
+		int ret = cpuload_trace_start(size);
+
+		if (ret != OK)
+			errx(1, "start failed (%d)", ret);
+
+		exit(0);
+	}
+
+	if (!strcmp(argv[1], "stop")) {
+		const char *path = (argc > 2) ? argv[2] : "/fs/microsd/schedtrace.csv";
+		int ret = cpuload_trace_stop(path);
+
+		if (ret != OK)
+			errx(1, "stop failed (%d)", ret);
+
+		warnx("trace written to %s", path);
+		exit(0);
+	}
+
+	if (!strcmp(argv[1], "status")) {
+		if (system_load.trace.events == NULL) {
+			warnx("not tracing");
+
+		} else {
+			warnx("%u switches recorded, ring of %u", system_load.trace.count, system_load.trace.size);
+		}
+
+		exit(0);
+	}
+
+	usage("unrecognised command");
+}
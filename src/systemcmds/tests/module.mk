@@ -33,4 +33,5 @@ SRCS			 = test_adc.c \
 			   test_rc.c \
 			   test_conv.cpp \
 			   test_mount.c \
-			   test_mtd.c
+			   test_mtd.c \
+			   test_spi_bus.cpp
@@ -53,12 +53,17 @@
 #include <systemlib/systemlib.h>
 #include <drivers/drv_hrt.h>
 #include <semaphore.h>
+#include <string.h>
+#include <math.h>
 
 
 #include "tests.h"
 
 #include "dataman/dataman.h"
 
+/* Items written per task, spread over the whole index range */
+#define NUM_TEST_ITEMS 256
+
 static sem_t *sems;
 
 static int
@@ -83,11 +88,11 @@ task_main(int argc, char *argv[])
 	srand(hrt_absolute_time() ^ my_id);
 	unsigned hit = 0, miss = 0;
 	wstart = hrt_absolute_time();
-	for (unsigned i = 0; i < NUM_MISSIONS_SUPPORTED; i++) {
+	for (unsigned i = 0; i < NUM_TEST_ITEMS; i++) {
 		memset(buffer, my_id, sizeof(buffer));
 		buffer[1] = i;
-		unsigned hash = i ^ my_id;
-		unsigned len = (hash & 63) + 2;
+		unsigned hash = (i * (NUM_MISSIONS_SUPPORTED / NUM_TEST_ITEMS)) ^ my_id;
+		unsigned len = (hash % (DM_KEY_WAYPOINTS_OFFBOARD_1_SIZE - 1)) + 2;
 
 		int ret = dm_write(DM_KEY_WAYPOINTS_OFFBOARD_1, hash, DM_PERSIST_IN_FLIGHT_RESET, buffer, len);
 		warnx("ret: %d", ret);
@@ -100,9 +105,9 @@ task_main(int argc, char *argv[])
 	rstart = hrt_absolute_time();
 	wend = rstart;
 
-	for (unsigned i = 0; i < NUM_MISSIONS_SUPPORTED; i++) {
-		unsigned hash = i ^ my_id;
-		unsigned len2, len = (hash & 63) + 2;
+	for (unsigned i = 0; i < NUM_TEST_ITEMS; i++) {
+		unsigned hash = (i * (NUM_MISSIONS_SUPPORTED / NUM_TEST_ITEMS)) ^ my_id;
+		unsigned len2, len = (hash % (DM_KEY_WAYPOINTS_OFFBOARD_1_SIZE - 1)) + 2;
 		if ((len2 = dm_read(DM_KEY_WAYPOINTS_OFFBOARD_1, hash, buffer, sizeof(buffer))) < 2) {
 			warnx("%d read failed length test, index %d", my_id, hash);
 			goto fail;
@@ -113,7 +118,7 @@ task_main(int argc, char *argv[])
 				warnx("%d read failed length test, index %d, wanted %d, got %d", my_id, hash, len, len2);
 				goto fail;
 			}
-			if (buffer[1] != i) {
+			if ((unsigned char)buffer[1] != i) {
 				warnx("%d data verification failed, index %d, wanted %d, got %d", my_id, hash, my_id, buffer[1]);
 				goto fail;
 			}
@@ -123,7 +128,7 @@ task_main(int argc, char *argv[])
 	}
 	rend = hrt_absolute_time();
 	warnx("Test %d pass, hit %d, miss %d, io time read %llums. write %llums.",
-		my_id, hit, miss, (rend - rstart) / NUM_MISSIONS_SUPPORTED / 1000, (wend - wstart) / NUM_MISSIONS_SUPPORTED / 1000);
+		my_id, hit, miss, (rend - rstart) / NUM_TEST_ITEMS / 1000, (wend - wstart) / NUM_TEST_ITEMS / 1000);
 	sem_post(sems + my_id);
 	return 0;
 fail:
@@ -133,6 +138,68 @@ fail:
 	return -1;
 }
 
+/* store and retrieve a mission item at the last index, it has to survive the compaction within its resolution */
+static int
+test_mission_item(void)
+{
+	struct mission_item_s item, item2;
+	hrt_abstime start, mid, end;
+	const ssize_t len = sizeof(struct mission_item_s);
+
+	memset(&item, 0, sizeof(item));
+	item.altitude_is_relative = true;
+	item.lat = 47.3977419;
+	item.lon = 8.5455938;
+	item.altitude = 488.5f;
+	item.yaw = -1.5708f;
+	item.loiter_radius = 25.0f;
+	item.loiter_direction = -1;
+	item.nav_cmd = NAV_CMD_LOITER_TIME_LIMIT;
+	item.acceptance_radius = 3.5f;
+	item.time_inside = 12.5f;
+	item.pitch_min = 0.0f;
+	item.autocontinue = true;
+	item.origin = ORIGIN_MAVLINK;
+
+	start = hrt_absolute_time();
+
+	if (dm_write_mission_item(DM_KEY_WAYPOINTS_OFFBOARD_1, NUM_MISSIONS_SUPPORTED - 1, DM_PERSIST_IN_FLIGHT_RESET, &item) != len) {
+		warnx("mission item write failed");
+		return -1;
+	}
+
+	mid = hrt_absolute_time();
+
+	if (dm_read_mission_item(DM_KEY_WAYPOINTS_OFFBOARD_1, NUM_MISSIONS_SUPPORTED - 1, &item2) != len) {
+		warnx("mission item read failed");
+		return -1;
+	}
+
+	end = hrt_absolute_time();
+
+	if (fabs(item2.lat - item.lat) > 1e-7 || fabs(item2.lon - item.lon) > 1e-7 ||
+	    item2.altitude != item.altitude || fabsf(item2.yaw - item.yaw) > 1e-4f ||
+	    item2.loiter_radius != item.loiter_radius || item2.loiter_direction != item.loiter_direction ||
+	    item2.nav_cmd != item.nav_cmd || item2.acceptance_radius != item.acceptance_radius ||
+	    item2.time_inside != item.time_inside || item2.altitude_is_relative != item.altitude_is_relative ||
+	    item2.autocontinue != item.autocontinue || item2.origin != item.origin) {
+		warnx("mission item verification failed");
+		return -1;
+	}
+
+	/* commands that do not fit the record are refused, not truncated */
+	item.nav_cmd = (enum NAV_CMD)300;
+
+	if (dm_write_mission_item(DM_KEY_WAYPOINTS_OFFBOARD_1, NUM_MISSIONS_SUPPORTED - 1, DM_PERSIST_IN_FLIGHT_RESET, &item) != -1) {
+		warnx("mission item with command 300 stored");
+		return -1;
+	}
+
+	warnx("Mission item pass, %d waypoints of %d bytes per list, io time read %lluus, write %lluus.",
+		NUM_MISSIONS_SUPPORTED, DM_KEY_WAYPOINTS_OFFBOARD_1_SIZE, end - mid, mid - start);
+	return 0;
+}
+
 int test_dataman(int argc, char *argv[])
 {
 	int i, num_tasks = 4;
@@ -161,6 +228,8 @@ int test_dataman(int argc, char *argv[])
 		sem_destroy(sems + i);
 	}
 	free(sems);
+	if (test_mission_item() != 0)
+		return -1;
 	dm_restart(DM_INIT_REASON_IN_FLIGHT);
 	for (i = 0; i < NUM_MISSIONS_SUPPORTED; i++) {
 		if (dm_read(DM_KEY_WAYPOINTS_OFFBOARD_1, i, buffer, sizeof(buffer)) != 0)
@@ -91,7 +91,7 @@ int test_mixer(int argc, char *argv[])
 	char		buf[2048];
 
 	load_mixer_file(filename, &buf[0], sizeof(buf));
-	unsigned loaded = strlen(buf);
+	unsigned loaded = mixer_buf_length(buf, sizeof(buf));
 
 	warnx("loaded: \n\"%s\"\n (%d chars)", &buf[0], loaded);
 
@@ -359,7 +359,7 @@ int test_mixer(int argc, char *argv[])
 		filename = "/etc/mixers/FMU_quad_w.mix";
 
 	load_mixer_file(filename, &buf[0], sizeof(buf));
-	loaded = strlen(buf);
+	loaded = mixer_buf_length(buf, sizeof(buf));
 
 	warnx("loaded: \n\"%s\"\n (%d chars)", &buf[0], loaded);
 
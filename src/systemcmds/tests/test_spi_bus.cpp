@@ -0,0 +1,314 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2014 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_spi_bus.cpp
+ * Tests the SPI transaction scheduler against a simulated bus.
+ */
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include <systemlib/err.h>
+#include <drivers/drv_hrt.h>
+#include <drivers/device/spi_bus.h>
+
+#include "tests.h"
+
+namespace
+{
+
+/**
+ * Bus that answers every transfer with the inverted bytes it was sent and
+ * takes about the time a 1 MHz bus would, plus an adjustable delay.
+ */
+class SimulatedBus : public device::SPIBus
+{
+public:
+	SimulatedBus() : SPIBus(0, nullptr), count(0), delay(1000), result(OK) {}
+
+	device::SPITransaction	*order[8];
+	volatile unsigned	count;
+	volatile unsigned	delay;		/**< us */
+	volatile int		result;		/**< returned by every exchange */
+
+protected:
+	virtual int exchange(device::SPITransaction *t) {
+		for (unsigned i = 0; i < t->len; i++) {
+			if (t->recv != nullptr)
+				t->recv[i] = (t->send != nullptr) ? ~t->send[i] : 0xff;
+		}
+
+		if (count < sizeof(order) / sizeof(order[0]))
+			order[count] = t;
+
+		count++;
+
+		usleep(8 * t->len + delay);
+
+		return result;
+	}
+};
+
+struct client {
+	device::SPITransaction	t;
+	uint8_t			buf[8];
+	volatile unsigned	done;
+	volatile int		result;
+};
+
+void
+client_done(void *arg, int result)
+{
+	struct client *c = (struct client *)arg;
+
+	c->result = result;
+	c->done++;
+}
+
+void
+client_init(struct client *c, uint8_t priority, uint8_t pattern)
+{
+	memset(c, 0, sizeof(*c));
+	memset(c->buf, pattern, sizeof(c->buf));
+	c->t.send = c->buf;
+	c->t.recv = c->buf;
+	c->t.len = sizeof(c->buf);
+	c->t.callback = client_done;
+	c->t.arg = c;
+	c->t.priority = priority;
+}
+
+bool
+wait_done(struct client *c, unsigned count)
+{
+	for (unsigned i = 0; i < 100; i++) {
+		if (c->done >= count)
+			return true;
+
+		usleep(1000);
+	}
+
+	return false;
+}
+
+struct client	hrt_client;
+int		hrt_submit_result;
+int		hrt_resubmit_result;
+SimulatedBus	*hrt_bus;
+
+void
+hrt_submit(void *arg)
+{
+	/* interrupt context, like a sensor polled from the hrt */
+	hrt_submit_result = hrt_bus->submit(&hrt_client.t);
+	hrt_resubmit_result = hrt_bus->submit(&hrt_client.t);
+}
+
+/* blocking transfer of a transaction in this frame, which is gone once it returns */
+int
+stack_transfer(SimulatedBus *bus, uint8_t pattern, bool *data_ok)
+{
+	device::SPITransaction t;
+	uint8_t buf[8];
+
+	memset(&t, 0, sizeof(t));
+	memset(buf, pattern, sizeof(buf));
+	t.send = buf;
+	t.recv = buf;
+	t.len = sizeof(buf);
+	t.priority = device::SPIBus::PRIORITY_HIGHEST;
+
+	int ret = bus->transfer(&t);
+
+	*data_ok = (buf[0] == (uint8_t)~pattern) && (buf[7] == (uint8_t)~pattern);
+
+	return ret;
+}
+
+/* reuse the stack the transaction of stack_transfer() was on */
+void
+stack_scribble()
+{
+	volatile uint8_t junk[256];
+
+	for (unsigned i = 0; i < sizeof(junk); i++)
+		junk[i] = 0xa5;
+}
+
+} // namespace
+
+int test_spi_bus(int argc, char *argv[])
+{
+	SimulatedBus bus;
+	int ret = 0;
+
+	if (bus.start() != OK) {
+		warnx("failed to start the bus worker");
+		return 1;
+	}
+
+	/* a low priority transfer occupies the bus while the others queue up */
+	struct client baro, mag, gyro, imu, gyro2;
+	client_init(&baro, device::SPIBus::PRIORITY_LOW, 0x11);
+	client_init(&mag, device::SPIBus::PRIORITY_NORMAL, 0x22);
+	client_init(&gyro, device::SPIBus::PRIORITY_HIGH, 0x33);
+	client_init(&imu, device::SPIBus::PRIORITY_HIGHEST, 0x44);
+	client_init(&gyro2, device::SPIBus::PRIORITY_HIGH, 0x55);
+
+	bus.submit(&baro.t);
+	usleep(100);
+	bus.submit(&mag.t);
+	bus.submit(&gyro.t);
+	bus.submit(&gyro2.t);
+	bus.submit(&imu.t);
+
+	if (!wait_done(&mag, 1) || !wait_done(&gyro2, 1)) {
+		warnx("FAIL: transfers did not complete");
+		return 1;
+	}
+
+	device::SPITransaction *expected[] = { &baro.t, &imu.t, &gyro.t, &gyro2.t, &mag.t };
+
+	for (unsigned i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+		if (bus.order[i] != expected[i]) {
+			warnx("FAIL: transfer %u served out of priority order", i);
+			ret = 1;
+		}
+	}
+
+	if (imu.result != OK || imu.buf[0] != (uint8_t)~0x44 || imu.buf[7] != (uint8_t)~0x44) {
+		warnx("FAIL: wrong data or result in completion");
+		ret = 1;
+	}
+
+	/* queueing from interrupt context, a still pending transaction is refused */
+	struct hrt_call call;
+	memset(&call, 0, sizeof(call));
+	client_init(&hrt_client, device::SPIBus::PRIORITY_HIGHEST, 0x66);
+	hrt_bus = &bus;
+	hrt_submit_result = hrt_resubmit_result = 1;
+	hrt_call_after(&call, 1000, hrt_submit, nullptr);
+
+	if (!wait_done(&hrt_client, 1)) {
+		warnx("FAIL: transfer queued from interrupt context did not complete");
+		ret = 1;
+
+	} else if (hrt_submit_result != OK || hrt_resubmit_result != -EBUSY || hrt_client.buf[3] != (uint8_t)~0x66) {
+		warnx("FAIL: interrupt context submit %d / %d", hrt_submit_result, hrt_resubmit_result);
+		ret = 1;
+	}
+
+	hrt_cancel(&call);
+
+	/* blocking transfer, as used from thread context */
+	struct client sync;
+	client_init(&sync, device::SPIBus::PRIORITY_LOW, 0x77);
+	unsigned before = bus.count;
+
+	if (bus.transfer(&sync.t) != OK || bus.count != before + 1 || sync.buf[5] != (uint8_t)~0x77) {
+		warnx("FAIL: blocking transfer");
+		ret = 1;
+	}
+
+	/* bus errors reach the caller */
+	client_init(&sync, device::SPIBus::PRIORITY_LOW, 0x77);
+	bus.result = -EIO;
+
+	if (bus.transfer(&sync.t) != -EIO) {
+		warnx("FAIL: bus error not returned by the blocking transfer");
+		ret = 1;
+	}
+
+	struct client failing;
+	client_init(&failing, device::SPIBus::PRIORITY_NORMAL, 0x88);
+	bus.submit(&failing.t);
+
+	if (!wait_done(&failing, 1) || failing.result != -EIO) {
+		warnx("FAIL: bus error not passed to the completion");
+		ret = 1;
+	}
+
+	bus.result = OK;
+
+	/* a transfer still queued behind a slow one times out and is never performed */
+	struct client slow;
+	client_init(&slow, device::SPIBus::PRIORITY_LOW, 0x99);
+	bus.delay = 200000;
+	bus.submit(&slow.t);
+	usleep(10000);
+	bus.delay = 1000;
+	before = bus.count;
+	bool data_ok;
+
+	if (stack_transfer(&bus, 0xaa, &data_ok) != -ETIMEDOUT) {
+		warnx("FAIL: queued blocking transfer did not time out");
+		ret = 1;
+	}
+
+	stack_scribble();
+
+	if (!wait_done(&slow, 1) || bus.count != before + 1) {
+		warnx("FAIL: timed out transfer still performed");
+		ret = 1;
+	}
+
+	/* one that is in progress when the timeout fires is waited for, its frame is still in use */
+	bus.delay = 200000;
+
+	if (stack_transfer(&bus, 0xbb, &data_ok) != OK || !data_ok) {
+		warnx("FAIL: transfer in progress not waited for");
+		ret = 1;
+	}
+
+	bus.delay = 1000;
+	stack_scribble();
+	client_init(&sync, device::SPIBus::PRIORITY_LOW, 0x77);
+
+	if (bus.transfer(&sync.t) != OK || sync.buf[0] != (uint8_t)~0x77) {
+		warnx("FAIL: bus unusable after the timeouts");
+		ret = 1;
+	}
+
+	bus.print_info();
+	bus.stop();
+
+	if (ret == 0)
+		warnx("SPI bus scheduler test passed");
+
+	return ret;
+}
@@ -110,6 +110,7 @@ const struct {
 	{"conv",		test_conv,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"mount",		test_mount,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"mtd",			test_mtd,	0},
+	{"spi_bus",		test_spi_bus,	0},
 #ifndef ARDUPILOT_BUILD
 	{"mathlib",		test_mathlib,	0},
 #endif